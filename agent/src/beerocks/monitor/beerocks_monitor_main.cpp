@@ -8,10 +8,12 @@
 
 #include "monitor_thread.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_logging.h>
+#include <bcl/beerocks_metrics_server.h>
 #include <bcl/beerocks_os_utils.h>
+#include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_version.h>
-#include <easylogging++.h>
 
 // Do not use this macro anywhere else in ire process
 // It should only be there in one place in each executable module
@@ -20,6 +22,7 @@ BEEROCKS_INIT_BEEROCKS_VERSION
 static bool g_running = true;
 static int s_signal   = 0;
 static std::string monitor_iface;
+static int monitor_slave_num = -1;
 
 // Pointer to logger instance
 static beerocks::logging *s_pLogger = nullptr;
@@ -86,12 +89,16 @@ static void init_signals()
 static bool parse_arguments(int argc, char *argv[])
 {
     int opt;
-    while ((opt = getopt(argc, argv, "i:")) != -1) {
+    while ((opt = getopt(argc, argv, "i:n:")) != -1) {
         switch (opt) {
         case 'i': {
             monitor_iface.assign(optarg);
             break;
         }
+        case 'n': {
+            monitor_slave_num = beerocks::string_utils::stoi(optarg);
+            break;
+        }
         case '?': {
             if (isprint(optopt)) {
                 LOG(ERROR) << "Unknown option -" << optopt << "!";
@@ -128,7 +135,7 @@ int main(int argc, char *argv[])
 
     //get command line options
     if (!parse_arguments(argc, argv)) {
-        std::cout << "Usage: " << argv[0] << " -i <monitor iface>" << std::endl;
+        std::cout << "Usage: " << argv[0] << " -i <monitor iface> [-n <slave num>]" << std::endl;
         return 0;
     }
 
@@ -157,6 +164,7 @@ int main(int argc, char *argv[])
               << " Build date " << BEEROCKS_BUILD_DATE << std::endl
               << std::endl;
     beerocks::version::log_version(argc, argv);
+    logger.start_cmdu_trace();
 
     // Redirect stdout / stderr to file
     if (logger.get_log_files_enabled()) {
@@ -175,6 +183,13 @@ int main(int argc, char *argv[])
         beerocks_slave_conf.temp_path + std::string(BEEROCKS_SLAVE_UDS) + "_" + monitor_iface;
     son::monitor_thread monitor(slave_uds, monitor_iface, beerocks_slave_conf, logger);
     if (monitor.init()) {
+        // Each monitor exports its own metrics, on the ports following the son_slave ones
+        std::unique_ptr<beerocks::metrics_server> metrics;
+        if (monitor_slave_num >= 0) {
+            metrics = beerocks::metrics_server::start_from_config(
+                beerocks_slave_conf.metrics_port, 1 + beerocks::IRE_MAX_SLAVES + monitor_slave_num);
+        }
+
         auto touch_time_stamp_timeout = std::chrono::steady_clock::now();
         while (g_running) {
 
@@ -8,9 +8,11 @@
 
 #include "monitor_db.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
+
+#include <algorithm>
 
 using namespace son;
 using namespace beerocks;
@@ -223,6 +225,35 @@ void monitor_sta_node::reset_poll_data()
     m_sta_stats.rx_phy_rate_100kb_min              = 0;
     m_sta_stats.tx_phy_rate_100kb_acc              = 0;
     m_sta_stats.rx_phy_rate_100kb_acc              = 0;
+    m_sta_stats.packets_acc                        = 0;
+}
+
+void monitor_sta_node::clear_poll_counters(uint16_t window_ms)
+{
+    m_sta_stats.delta_ms                = window_ms;
+    m_sta_stats.hal_stats.tx_packets    = 0;
+    m_sta_stats.hal_stats.tx_bytes      = 0;
+    m_sta_stats.hal_stats.rx_packets    = 0;
+    m_sta_stats.hal_stats.rx_bytes      = 0;
+    m_sta_stats.hal_stats.retrans_count = 0;
+}
+
+bool monitor_sta_node::is_poll_due(uint32_t poll_id, bool poll_last)
+{
+    if (poll_id < poll_next_id) {
+        return false;
+    }
+    return poll_interval == 1 || poll_last;
+}
+
+void monitor_sta_node::poll_schedule(uint32_t poll_id, bool active, uint8_t max_interval)
+{
+    if (active) {
+        poll_interval = 1;
+    } else if (poll_interval < max_interval) {
+        poll_interval = std::min<int>(poll_interval * 2, max_interval);
+    }
+    poll_next_id = poll_id + poll_interval;
 }
 
 /////////////////////////////////////////////
@@ -298,56 +329,103 @@ int monitor_db::get_vap_id(const std::string &bssid)
     return beerocks::IFACE_ID_INVALID;
 }
 
-monitor_sta_node *monitor_db::sta_find(const std::string sta_mac)
+monitor_sta_node *monitor_db::sta_find(const std::string &sta_mac)
 {
-    auto it = sta_nodes.find(sta_mac);
-    if (it != sta_nodes.end()) {
-        return it->second;
+    auto it = sta_mac_index.find(sta_mac);
+    if (it != sta_mac_index.end()) {
+        return &sta_slots[it->second];
     }
     return nullptr;
 }
 
-monitor_sta_node *monitor_db::sta_find_by_ipv4(const std::string ipv4)
+monitor_sta_node *monitor_db::sta_find_by_ipv4(const std::string &ipv4)
 {
-    for (auto kv : sta_nodes) {
-        if (kv.second->get_ipv4() == ipv4) {
-            return kv.second;
-        }
+    auto it = sta_ipv4_index.find(ipv4);
+    if (it != sta_ipv4_index.end()) {
+        return &sta_slots[it->second];
     }
     return nullptr;
 }
 
-monitor_sta_node *monitor_db::sta_add(const std::string sta_mac, const int8_t vap_id)
+bool monitor_db::sta_set_ipv4(const std::string &sta_mac, const std::string &ipv4)
+{
+    auto it = sta_mac_index.find(sta_mac);
+    if (it == sta_mac_index.end()) {
+        return false;
+    }
+    auto slot      = it->second;
+    auto &sta_node = sta_slots[slot];
+
+    auto ipv4_it = sta_ipv4_index.find(sta_node.get_ipv4());
+    if (ipv4_it != sta_ipv4_index.end() && ipv4_it->second == slot) {
+        sta_ipv4_index.erase(ipv4_it);
+    }
+    sta_node.set_ipv4(ipv4);
+    if (!ipv4.empty()) {
+        sta_ipv4_index[ipv4] = slot;
+    }
+    return true;
+}
+
+monitor_sta_node *monitor_db::sta_add(const std::string &sta_mac, const int8_t vap_id)
 {
-    auto node = new monitor_sta_node(vap_id, sta_mac);
-    sta_nodes.insert(std::make_pair(sta_mac, node));
+    auto it = sta_mac_index.find(sta_mac);
+    if (it != sta_mac_index.end()) {
+        LOG(WARNING) << "sta " << sta_mac << " already exists, replacing it";
+        sta_erase(sta_mac);
+    }
+
+    size_t slot;
+    if (!sta_free_slots.empty()) {
+        slot = sta_free_slots.back();
+        sta_free_slots.pop_back();
+        sta_slots[slot]      = monitor_sta_node(vap_id, sta_mac);
+        sta_slots_used[slot] = true;
+    } else {
+        slot = sta_slots.size();
+        sta_slots.emplace_back(vap_id, sta_mac);
+        sta_slots_used.push_back(true);
+    }
+    sta_mac_index[sta_mac] = slot;
+
     auto vap_node = vap_get_by_id(vap_id);
     if (vap_node) {
         vap_node->sta_count_inc();
     }
-    return node;
+    return &sta_slots[slot];
 }
 
-void monitor_db::sta_erase(const std::string sta_mac)
+void monitor_db::sta_erase(const std::string &sta_mac)
 {
-    auto it = sta_nodes.find(sta_mac);
-    if (it != sta_nodes.end()) {
-        auto vap_id = it->second->get_vap_id();
-        delete it->second;
-        sta_nodes.erase(it);
-        auto vap_node = vap_get_by_id(vap_id);
-        if (vap_node) {
-            vap_node->sta_count_dec();
-        }
+    auto it = sta_mac_index.find(sta_mac);
+    if (it == sta_mac_index.end()) {
+        return;
+    }
+    auto slot      = it->second;
+    auto &sta_node = sta_slots[slot];
+    auto vap_id    = sta_node.get_vap_id();
+
+    auto ipv4_it = sta_ipv4_index.find(sta_node.get_ipv4());
+    if (ipv4_it != sta_ipv4_index.end() && ipv4_it->second == slot) {
+        sta_ipv4_index.erase(ipv4_it);
+    }
+    sta_mac_index.erase(it);
+    sta_slots_used[slot] = false;
+    sta_free_slots.push_back(slot);
+
+    auto vap_node = vap_get_by_id(vap_id);
+    if (vap_node) {
+        vap_node->sta_count_dec();
     }
 }
 
 void monitor_db::sta_erase_all()
 {
-    for (auto it = sta_nodes.begin(); it != sta_nodes.end(); it++) {
-        delete it->second;
-    }
-    sta_nodes.clear();
+    sta_slots.clear();
+    sta_slots_used.clear();
+    sta_free_slots.clear();
+    sta_mac_index.clear();
+    sta_ipv4_index.clear();
 }
 
 std::chrono::steady_clock::time_point monitor_db::get_poll_next_time() { return poll_next_time; }
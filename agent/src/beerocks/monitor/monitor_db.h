@@ -38,8 +38,7 @@ public:
 
     int8_t get_vap_id() { return vap_id; }
 
-    void set_ipv4(std::string ip) { ipv4 = ip; }
-    std::string get_ipv4() { return ipv4; }
+    const std::string &get_ipv4() { return ipv4; }
 
     void set_bridge_4addr_mac(const std::string bridge_mac_4addr_)
     {
@@ -47,7 +46,7 @@ public:
     }
     std::string get_bridge_4addr_mac() { return bridge_mac_4addr; }
 
-    std::string get_mac() { return mac; }
+    const std::string &get_mac() { return mac; }
 
     void set_arp_state(eArpState state) { arp_state = state; }
     eArpState get_arp_state() { return arp_state; }
@@ -86,12 +85,58 @@ public:
     uint32_t get_rx_packets();
     void reset_poll_data();
 
+    /**
+     * @brief Clear the per-window counters of a station which was not sampled in the window.
+     *
+     * The HAL counters hold the deltas of the last sampling, reporting them again would count
+     * the same traffic in every window until the station is sampled again.
+     *
+     * @param window_ms Duration of the measurement window.
+     */
+    void clear_poll_counters(uint16_t window_ms);
+
+    // Adaptive polling //
+    /**
+     * @brief Check if the station should be sampled on the current poll.
+     *
+     * Stations polled at the fast rate are sampled on every poll, idle stations only on the
+     * last poll of the measurement windows they are scheduled in.
+     *
+     * @param poll_id Id of the current measurement window.
+     * @param poll_last Whether the current poll is the last of the measurement window.
+     * @return true if the station should be sampled.
+     */
+    bool is_poll_due(uint32_t poll_id, bool poll_last);
+
+    /**
+     * @brief Schedule the next sampling of the station, on the last poll of a window.
+     *
+     * Active stations are sampled every measurement window. The interval of idle stations
+     * is doubled on every sampling, up to max_interval windows.
+     *
+     * @param poll_id Id of the current measurement window.
+     * @param active Whether the station was active during the window.
+     * @param max_interval Maximal number of windows between two samplings.
+     */
+    void poll_schedule(uint32_t poll_id, bool active, uint8_t max_interval);
+
+    /**
+     * @brief Go back to the fast polling rate, starting from the next poll.
+     */
+    void poll_reset()
+    {
+        poll_interval = 1;
+        poll_next_id  = 0;
+    }
+    uint8_t get_poll_interval() { return poll_interval; }
+
     friend std::ostream &operator<<(std::ostream &os, const monitor_sta_node &sta_node);
     friend std::ostream &operator<<(std::ostream &os, const monitor_sta_node *sta_node);
 
     // Statistics //
     struct SStaStats {
         uint8_t poll_cnt                                       = 0;
+        uint32_t poll_id                                       = 0;
         uint16_t delta_ms                                      = 0;
         std::chrono::steady_clock::time_point last_update_time = std::chrono::steady_clock::now();
 
@@ -104,6 +149,7 @@ public:
         uint16_t rx_phy_rate_100kb_avg = 0;
         uint16_t rx_phy_rate_100kb_min = 0;
         uint16_t rx_phy_rate_100kb_acc = 0;
+        uint32_t packets_acc           = 0;
 
         bwl::SStaStats hal_stats = {};
 
@@ -121,6 +167,10 @@ public:
     std::chrono::steady_clock::time_point idle_detected_start_time;
 
 private:
+    // Set through monitor_db::sta_set_ipv4() which keeps the ipv4 index up to date
+    void set_ipv4(const std::string &ip) { ipv4 = ip; }
+    friend class monitor_db;
+
     int8_t vap_id = beerocks::IFACE_ID_INVALID;
     std::string ipv4;
     /*
@@ -136,6 +186,8 @@ private:
     uint8_t arp_recv_count  = 0;
     uint8_t arp_retry_count = 0;
     std::list<uint16_t> pending_rx_rssi_requests_id;
+    uint8_t poll_interval = 1; // measurement windows between two samplings
+    uint32_t poll_next_id = 0; // first measurement window to sample the station in
     std::chrono::steady_clock::time_point last_change_time;
     std::chrono::steady_clock::time_point arp_time = std::chrono::steady_clock::now();
     SStaStats m_sta_stats;
@@ -192,6 +244,8 @@ public:
 
         bwl::SVapStats hal_stats = {};
 
+        bool sta_polled = false; // stations sampled during the current measurement window
+
         uint8_t client_tx_load_tot_prev      = 0;
         uint8_t client_rx_load_tot_prev      = 0;
         uint8_t client_tx_load_tot_curr      = 0;
@@ -298,18 +352,32 @@ public:
     void vap_erase_all();
 
     // STA's //
-    monitor_sta_node *sta_add(const std::string sta_mac, const int8_t vap_id);
-    void sta_erase(const std::string sta_mac);
+    /**
+     * Stations are stored in a flat table of slots, indexed by mac and ipv4 address.
+     * The slots of removed stations are reused, so the node pointers returned by the
+     * functions below are only valid until the next sta_add().
+     */
+    monitor_sta_node *sta_add(const std::string &sta_mac, const int8_t vap_id);
+    void sta_erase(const std::string &sta_mac);
     void sta_erase_all();
-    monitor_sta_node *sta_find(const std::string mac);
-    monitor_sta_node *sta_find_by_ipv4(const std::string ipv4);
-    std::unordered_map<std::string, monitor_sta_node *>::iterator sta_begin()
-    {
-        return sta_nodes.begin();
-    }
-    std::unordered_map<std::string, monitor_sta_node *>::iterator sta_end()
+    monitor_sta_node *sta_find(const std::string &mac);
+    monitor_sta_node *sta_find_by_ipv4(const std::string &ipv4);
+    bool sta_set_ipv4(const std::string &sta_mac, const std::string &ipv4);
+
+    /**
+     * @brief Number of station slots, including the free ones.
+     */
+    size_t sta_slots_count() { return sta_slots.size(); }
+
+    /**
+     * @brief Get the station of a slot.
+     *
+     * @param slot Slot index, lower than sta_slots_count().
+     * @return Station node, nullptr if the slot is free.
+     */
+    monitor_sta_node *sta_get_by_slot(size_t slot)
     {
-        return sta_nodes.end();
+        return sta_slots_used[slot] ? &sta_slots[slot] : nullptr;
     }
 
     // Monitor parameters //
@@ -334,6 +402,9 @@ public:
     const int MONITOR_DB_MEASUREMENT_WINDOW_MSEC = (4 * MONITOR_DB_POLLING_RATE_MSEC);
     const int MONITOR_DB_AP_POLLING_RATE_SEC     = 5;
 
+    const uint8_t MONITOR_DB_STA_MAX_POLL_INTERVAL   = 8;
+    const uint32_t MONITOR_DB_STA_ACTIVE_PACKETS_MIN = 10;
+
     const int MONITOR_ARP_TIMEOUT_MSEC = 550;
     const int MONITOR_ARP_PKT_NUM      = 6;
 
@@ -349,7 +420,12 @@ private:
     std::chrono::steady_clock::time_point ap_poll_next_time;
     monitor_radio_node radio_node;
     std::unordered_map<int8_t, std::shared_ptr<monitor_vap_node>> vap_nodes;
-    std::unordered_map<std::string, monitor_sta_node *> sta_nodes;
+
+    std::vector<monitor_sta_node> sta_slots;
+    std::vector<bool> sta_slots_used;
+    std::vector<size_t> sta_free_slots;
+    std::unordered_map<std::string, size_t> sta_mac_index;
+    std::unordered_map<std::string, size_t> sta_ipv4_index;
 
     int8_t ap_tx_enabled      = 0;
     int8_t ap_hostapd_enabled = 2;
@@ -8,16 +8,20 @@
 
 #include "monitor_rssi.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_monitor.h>
 
+#include <algorithm>
+
 using namespace beerocks;
 using namespace net;
 using namespace son;
 
+static const size_t MAX_RX_RSSI_NOTIFICATIONS_PER_BATCH = 32;
+
 monitor_rssi::monitor_rssi(ieee1905_1::CmduMessageTx &cmdu_tx_) : cmdu_tx(cmdu_tx_)
 {
     mon_db                   = nullptr;
@@ -193,9 +197,12 @@ void monitor_rssi::process()
 {
     bool poll_last = mon_db->is_last_poll();
 
-    for (auto it = mon_db->sta_begin(); it != mon_db->sta_end(); ++it) {
-        auto sta_mac  = it->first;
-        auto sta_node = it->second;
+    for (size_t slot = 0; slot < mon_db->sta_slots_count(); slot++) {
+        auto sta_node = mon_db->sta_get_by_slot(slot);
+        if (sta_node == nullptr) {
+            continue;
+        }
+        auto &sta_mac = sta_node->get_mac();
 
         auto sta_vap_id = sta_node->get_vap_id();
         auto arp_state  = sta_node->get_arp_state();
@@ -225,26 +232,18 @@ void monitor_rssi::process()
                      sta_stats.rx_rssi_curr <= conf_rx_rssi_notification_threshold_dbm)) {
                     sta_stats.rx_rssi_prev = sta_stats.rx_rssi_curr;
 
-                    auto notification = message_com::create_vs_message<
-                        beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION>(
-                        cmdu_tx);
-                    if (notification == nullptr) {
-                        LOG(ERROR) << "Failed building "
-                                      "ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUES message!";
-                        break;
-                    }
-
-                    notification->params().result.mac = network_utils::mac_from_string(sta_mac);
-                    notification->params().rx_rssi    = sta_stats.rx_rssi_curr;
-                    notification->params().rx_snr     = sta_stats.rx_snr_curr;
-                    notification->params().rx_packets = 100; //dummy value
-                    notification->params().rx_phy_rate_100kb = sta_stats.rx_phy_rate_100kb_min;
-                    notification->params().tx_phy_rate_100kb = sta_stats.tx_phy_rate_100kb_min;
-                    notification->params().vap_id            = sta_vap_id;
-                    message_com::send_cmdu(slave_socket, cmdu_tx);
-                    LOG(DEBUG) << "state IDLE, DELTA notification MAC: " << sta_mac
-                               << " RX RSSI: " << int(sta_stats.rx_rssi_curr)
-                               << " delta_val=" << int(delta_val);
+                    beerocks_message::sNodeRssiMeasurement measurement = {};
+                    measurement.result.mac        = network_utils::mac_from_string(sta_mac);
+                    measurement.rx_rssi           = sta_stats.rx_rssi_curr;
+                    measurement.rx_snr            = sta_stats.rx_snr_curr;
+                    measurement.rx_packets        = 100; //dummy value
+                    measurement.rx_phy_rate_100kb = sta_stats.rx_phy_rate_100kb_min;
+                    measurement.tx_phy_rate_100kb = sta_stats.tx_phy_rate_100kb_min;
+                    measurement.vap_id            = sta_vap_id;
+                    m_rx_rssi_notifications.push_back(measurement);
+                    LOG_BINARY(DEBUG,
+                               "state IDLE, DELTA notification MAC: {} RX RSSI: {} delta_val={}",
+                               sta_mac, int(sta_stats.rx_rssi_curr), int(delta_val));
                 }
             }
             if (arp_enabled() && !conf_disable_initiative_arp) {
@@ -328,14 +327,13 @@ void monitor_rssi::process()
                 bool is_4addr_client    = (sta_bridge_4addr_mac != network_utils::ZERO_MAC_STRING);
                 std::string arp_dst_mac = is_4addr_client ? sta_bridge_4addr_mac : sta_mac;
 
-                LOG(DEBUG) << "state: SEND_ARP -> "
-                           << (sta_node->get_arp_burst() ? "WAIT_FIRST_REPLY" : "WAIT_REPLY")
-                           << ", arp_iface = " << arp_iface
-                           << ", arp_iface_ipv4 = " << arp_iface_ipv4
-                           << ", arp_iface_mac = " << arp_iface_mac
-                           << ", is_4addr_client = " << int(is_4addr_client)
-                           << ", sta_mac = " << sta_mac << ", dest_ip = " << sta_node->get_ipv4()
-                           << ", dst_mac = " << arp_dst_mac;
+                LOG_BINARY(DEBUG,
+                           "state: SEND_ARP -> {}, arp_iface = {}, arp_iface_ipv4 = {}, "
+                           "arp_iface_mac = {}, is_4addr_client = {}, sta_mac = {}, dest_ip = {}, "
+                           "dst_mac = {}",
+                           sta_node->get_arp_burst() ? "WAIT_FIRST_REPLY" : "WAIT_REPLY", arp_iface,
+                           arp_iface_ipv4, arp_iface_mac, int(is_4addr_client), sta_mac,
+                           sta_node->get_ipv4(), arp_dst_mac);
 
                 network_utils::arp_send(arp_iface, sta_node->get_ipv4(), arp_iface_ipv4,
                                         network_utils::mac_from_string(arp_dst_mac),
@@ -352,9 +350,67 @@ void monitor_rssi::process()
             monitor_idle_station(sta_mac, sta_node);
         }
     }
+
+    send_rx_rssi_notifications();
+}
+
+void monitor_rssi::send_rx_rssi_notifications()
+{
+    if (m_rx_rssi_notifications.empty()) {
+        return;
+    }
+
+    // A single notification is sent as is
+    if (m_rx_rssi_notifications.size() == 1) {
+        auto notification = message_com::create_vs_message<
+            beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION>(cmdu_tx);
+        if (notification == nullptr) {
+            LOG(ERROR) << "Failed building "
+                          "ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION message!";
+        } else {
+            notification->params() = m_rx_rssi_notifications.front();
+            message_com::send_cmdu(slave_socket, cmdu_tx);
+        }
+        m_rx_rssi_notifications.clear();
+        return;
+    }
+
+    for (size_t offset = 0; offset < m_rx_rssi_notifications.size();
+         offset += MAX_RX_RSSI_NOTIFICATIONS_PER_BATCH) {
+        auto count = std::min(m_rx_rssi_notifications.size() - offset,
+                              MAX_RX_RSSI_NOTIFICATIONS_PER_BATCH);
+
+        auto notification = message_com::create_vs_message<
+            beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>(
+            cmdu_tx);
+        if (notification == nullptr) {
+            LOG(ERROR) << "Failed building "
+                          "ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION message!";
+            break;
+        }
+
+        if (!notification->alloc_measurements(count)) {
+            LOG(ERROR) << "Failed allocating " << count << " rx rssi measurements";
+            break;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            auto entry = notification->measurements(i);
+            if (!std::get<0>(entry)) {
+                LOG(ERROR) << "Failed to get rx rssi measurement entry " << i;
+                m_rx_rssi_notifications.clear();
+                return;
+            }
+            std::get<1>(entry) = m_rx_rssi_notifications[offset + i];
+        }
+
+        message_com::send_cmdu(slave_socket, cmdu_tx);
+    }
+    m_rx_rssi_notifications.clear();
 }
 
-void monitor_rssi::send_rssi_measurement_response(std::string &sta_mac, monitor_sta_node *sta_node)
+void monitor_rssi::send_rssi_measurement_response(const std::string &sta_mac,
+                                                  monitor_sta_node *sta_node)
 {
     auto id_list    = sta_node->get_rx_rssi_request_id_list();
     auto &sta_stats = sta_node->get_stats();
@@ -380,13 +436,13 @@ void monitor_rssi::send_rssi_measurement_response(std::string &sta_mac, monitor_
         response->params().tx_phy_rate_100kb = sta_stats.tx_phy_rate_100kb_min;
 
         message_com::send_cmdu(slave_socket, cmdu_tx);
-        LOG(DEBUG) << "RSSI_MEASUREMENT_RESPONSE sta_mac=" << sta_mac
-                   << " rx_rssi: " << int(response->params().rx_rssi) << " id=" << request_id;
+        LOG_BINARY(DEBUG, "RSSI_MEASUREMENT_RESPONSE sta_mac={} rx_rssi: {} id={}", sta_mac,
+                   int(response->params().rx_rssi), request_id);
     }
     sta_node->clear_rx_rssi_request_id_list();
 }
 
-void monitor_rssi::monitor_idle_station(std::string &sta_mac, monitor_sta_node *sta_node)
+void monitor_rssi::monitor_idle_station(const std::string &sta_mac, monitor_sta_node *sta_node)
 {
     auto current_time = std::chrono::steady_clock::now();
     auto &sta_stats   = sta_node->get_stats();
@@ -14,8 +14,11 @@
 #include <bcl/beerocks_message_structs.h>
 #include <bcl/network/socket.h>
 
+#include <beerocks/tlvf/beerocks_message_common.h>
 #include <tlvf/CmduMessageTx.h>
 
+#include <vector>
+
 const unsigned DEFAULT_IDLE_UNIT_TX_THRESHOLD = 50000;
 const unsigned DEFAULT_IDLE_UNIT_RX_THRESHOLD = 50000;
 const unsigned DEFAULT_IDLE_UNIT_TIME_MS      = 1000;
@@ -40,8 +43,9 @@ public:
     bool is_5ghz                                = false;
 
 private:
-    void send_rssi_measurement_response(std::string &sta_mac, monitor_sta_node *sta_node);
-    void monitor_idle_station(std::string &sta_mac, monitor_sta_node *sta_node);
+    void send_rssi_measurement_response(const std::string &sta_mac, monitor_sta_node *sta_node);
+    void monitor_idle_station(const std::string &sta_mac, monitor_sta_node *sta_node);
+    void send_rx_rssi_notifications();
 
     bool arp_enabled() { return arp_socket > 0; }
 
@@ -54,6 +58,10 @@ private:
     unsigned m_idle_unit_rx_threshold;
     unsigned m_idle_unit_time_ms;
 
+    // RX RSSI change notifications of the current poll, sent together once all the stations
+    // are processed
+    std::vector<beerocks_message::sNodeRssiMeasurement> m_rx_rssi_notifications;
+
     ieee1905_1::CmduMessageTx &cmdu_tx;
 };
 
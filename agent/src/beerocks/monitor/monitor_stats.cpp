@@ -8,9 +8,9 @@
 
 #include "monitor_stats.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/network/socket.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_monitor.h>
@@ -150,9 +150,8 @@ void monitor_stats::process()
         ap_stats_msg.client_tx_load_percent = radio_stats.client_tx_load_tot_curr;
         ap_stats_msg.client_rx_load_percent = radio_stats.client_rx_load_tot_curr;
 
-        for (auto it = mon_db->sta_begin(); it != mon_db->sta_end(); ++it) {
-            auto sta_mac  = it->first;
-            auto sta_node = it->second;
+        for (size_t slot = 0; slot < mon_db->sta_slots_count(); slot++) {
+            auto sta_node = mon_db->sta_get_by_slot(slot);
             if (sta_node == nullptr) {
                 continue;
             }
@@ -167,7 +166,7 @@ void monitor_stats::process()
             uint8_t num_of_stas = response->sta_stats_size();
             auto &sta_stats_msg = std::get<1>(response->sta_stats(num_of_stas - 1));
 
-            sta_stats_msg.mac               = network_utils::mac_from_string(sta_mac);
+            sta_stats_msg.mac               = network_utils::mac_from_string(sta_node->get_mac());
             sta_stats_msg.rx_packets        = sta_stats.hal_stats.rx_packets;
             sta_stats_msg.tx_packets        = sta_stats.hal_stats.tx_packets;
             sta_stats_msg.tx_bytes          = sta_stats.hal_stats.tx_bytes;
@@ -206,12 +205,10 @@ void monitor_stats::process()
     radio_stats.active_client_count_curr = 0;
 
     //calculations for each sta on the radio
-    for (auto it = mon_db->sta_begin(); it != mon_db->sta_end(); ++it) {
-        auto sta_mac  = it->first;
-        auto sta_node = it->second;
+    for (size_t slot = 0; slot < mon_db->sta_slots_count(); slot++) {
+        auto sta_node = mon_db->sta_get_by_slot(slot);
         if (sta_node == nullptr) {
-            LOG(ERROR) << "sta_node == nullptr !";
-            return;
+            continue;
         }
 
         calculate_client_load(sta_node, radio_node, conf_active_client_th);
@@ -8,13 +8,15 @@
 
 #include "monitor_thread.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
+#include <bcl/son/son_wireless_utils.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 
-#include <cmath>
+#include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 using namespace beerocks;
@@ -25,6 +27,9 @@ using namespace son;
 #define OPERATION_SUCCESS 0
 #define OPERATION_FAIL -1
 
+// sChannelScanResults is 158 bytes, a batch fits a CMDU
+#define MAX_CHANNEL_SCAN_RESULTS_PER_BATCH 20
+
 monitor_thread::monitor_thread(const std::string &slave_uds_, const std::string &monitor_iface_,
                                beerocks::config_file::sConfigSlave &beerocks_slave_conf_,
                                beerocks::logging &logger_)
@@ -363,13 +368,16 @@ void monitor_thread::after_select(bool timeout)
         // Process internal events
         if (mon_hal_int_events && read_ready(mon_hal_int_events)) {
             clear_ready(mon_hal_int_events);
-            // NOTE: A callback (hal_event_handler()) will be invoked for pending events
+            // NOTE: A callback (hal_event_handler()) will be invoked for all the pending events
             if (!mon_wlan_hal->process_int_events()) {
                 LOG(ERROR) << "process_int_events() failed!";
                 thread_last_error_code = MONITOR_THREAD_ERROR_REPORT_PROCESS_FAIL;
                 stop_monitor_thread();
                 return;
             }
+
+            // Send the remaining channel scan results of the processed events
+            send_channel_scan_results();
         }
 
         // Process nl events
@@ -488,36 +496,77 @@ bool monitor_thread::update_sta_stats()
 {
     auto poll_cnt  = mon_db.get_poll_cnt();
     auto poll_last = mon_db.is_last_poll();
+    auto poll_id   = mon_db.get_poll_id();
 
-    for (auto it = mon_db.sta_begin(); it != mon_db.sta_end(); ++it) {
-
-        auto sta_mac  = it->first;
-        auto sta_node = it->second;
+    // The stats of all the stations of a VAP are read at once, so a VAP is sampled as a whole
+    // as soon as one of its stations is due, and skipped only while all of them are idle
+    std::unordered_set<int8_t> due_vap_ids;
+    for (size_t slot = 0; slot < mon_db.sta_slots_count(); slot++) {
 
+        auto sta_node = mon_db.sta_get_by_slot(slot);
         if (sta_node == nullptr) {
-            LOG(WARNING) << "Invalid node pointer for STA = " << sta_mac;
             continue;
         }
 
-        auto vap_node   = mon_db.vap_get_by_id(sta_node->get_vap_id());
-        auto &sta_stats = sta_node->get_stats();
+        // Stations with a pending measurement are polled at the fast rate
+        if (sta_node->get_arp_state() != monitor_sta_node::IDLE ||
+            !sta_node->get_rx_rssi_request_id_list().empty() || sta_node->enable_idle_monitor) {
+            sta_node->poll_reset();
+        }
 
-        // Update the stats
-        if (!mon_wlan_hal->update_stations_stats(vap_node->get_iface(), sta_mac,
-                                                 sta_stats.hal_stats)) {
-            LOG(ERROR) << "Failed updating STA (" << sta_mac << ") statistics!";
+        if (sta_node->is_poll_due(poll_id, poll_last)) {
+            due_vap_ids.insert(sta_node->get_vap_id());
+        }
+    }
+
+    // Group the stations by VAP, the stats of all the stations of a VAP are updated at once
+    std::unordered_map<std::string, bwl::mon_wlan_hal::sta_stats_map_t> vaps_sta_stats;
+    std::vector<monitor_sta_node *> polled_sta_nodes;
+    for (size_t slot = 0; slot < mon_db.sta_slots_count(); slot++) {
+
+        auto sta_node = mon_db.sta_get_by_slot(slot);
+        if (sta_node == nullptr || due_vap_ids.find(sta_node->get_vap_id()) == due_vap_ids.end()) {
+            continue;
+        }
+        auto &sta_mac = sta_node->get_mac();
+
+        auto vap_node = mon_db.vap_get_by_id(sta_node->get_vap_id());
+        if (vap_node == nullptr) {
+            LOG(WARNING) << "Invalid VAP node pointer for STA = " << sta_mac;
+            continue;
+        }
+        vap_node->get_stats().sta_polled = true;
+
+        vaps_sta_stats[vap_node->get_iface()][sta_mac] = &sta_node->get_stats().hal_stats;
+        polled_sta_nodes.push_back(sta_node);
+    }
+
+    // Update the stats
+    for (auto &vap_sta_stats : vaps_sta_stats) {
+        if (!mon_wlan_hal->update_vap_stations_stats(vap_sta_stats.first, vap_sta_stats.second)) {
+            LOG(ERROR) << "Failed updating the statistics of the stations of "
+                       << vap_sta_stats.first;
             return false;
         }
+    }
 
-        // Reset STA poll data
-        if (poll_cnt == 0) {
+    for (auto sta_node : polled_sta_nodes) {
+
+        auto &sta_stats = sta_node->get_stats();
+
+        // Reset STA poll data on the first sample of the station in the measurement window
+        if (poll_cnt == 0 || sta_stats.poll_id != poll_id) {
             sta_node->reset_poll_data();
+            sta_stats.poll_id = poll_id;
         }
+        bool first_sample = (sta_stats.poll_cnt == 0);
         sta_stats.poll_cnt++;
 
+        sta_stats.packets_acc += sta_stats.hal_stats.rx_packets + sta_stats.hal_stats.tx_packets;
+
         // Update TX Phy Rate
         auto val = sta_stats.hal_stats.tx_phy_rate_100kb;
-        if (poll_cnt == 0 || val < sta_stats.tx_phy_rate_100kb_min) {
+        if (first_sample || val < sta_stats.tx_phy_rate_100kb_min) {
             sta_stats.tx_phy_rate_100kb_min = val;
         }
         sta_stats.tx_phy_rate_100kb_acc += val;
@@ -528,7 +577,7 @@ bool monitor_thread::update_sta_stats()
 
         // Update RX Phy Rate
         val = sta_stats.hal_stats.rx_phy_rate_100kb;
-        if (poll_cnt == 0 || val < sta_stats.rx_phy_rate_100kb_min) {
+        if (first_sample || val < sta_stats.rx_phy_rate_100kb_min) {
             sta_stats.rx_phy_rate_100kb_min = val;
         }
         sta_stats.rx_phy_rate_100kb_acc += val;
@@ -538,15 +587,17 @@ bool monitor_thread::update_sta_stats()
         }
 
         // Update RSSI
+        bool changed = false;
         if (poll_last) {
             if (sta_stats.hal_stats.rx_rssi_watt_samples_cnt > 0) {
                 float rssi_watt = sta_stats.hal_stats.rx_rssi_watt /
                                   float(sta_stats.hal_stats.rx_rssi_watt_samples_cnt);
-                float rssi_db = 10 * log10(rssi_watt);
-                if (sta_stats.rx_rssi_curr != int8_t(rssi_db)) {
+                auto rssi_db = son::wireless_utils::watt_to_db(rssi_watt);
+                if (sta_stats.rx_rssi_curr != rssi_db) {
                     sta_node->set_last_change_time();
+                    changed = true;
                 }
-                sta_stats.rx_rssi_curr = int8_t(rssi_db);
+                sta_stats.rx_rssi_curr = rssi_db;
                 //LOG(INFO)  << sta_mac << ", rx_rssi=" << int(rssi_db);
             }
 
@@ -558,11 +609,12 @@ bool monitor_thread::update_sta_stats()
             if (sta_stats.hal_stats.rx_snr_watt_samples_cnt > 0) {
                 float snr_watt = sta_stats.hal_stats.rx_snr_watt /
                                  float(sta_stats.hal_stats.rx_snr_watt_samples_cnt);
-                float snr_db = 10 * log10(snr_watt);
-                if (sta_stats.rx_snr_curr != int8_t(snr_db)) {
+                auto snr_db = son::wireless_utils::watt_to_db(snr_watt);
+                if (sta_stats.rx_snr_curr != snr_db) {
                     sta_node->set_last_change_time();
+                    changed = true;
                 }
-                sta_stats.rx_snr_curr = int8_t(snr_db);
+                sta_stats.rx_snr_curr = snr_db;
                 //LOG(INFO)  << sta_mac << ", rx_snr=" << int(snr_db);
             }
 
@@ -575,6 +627,24 @@ bool monitor_thread::update_sta_stats()
             std::chrono::duration_cast<std::chrono::milliseconds>(now - sta_stats.last_update_time);
         sta_stats.delta_ms         = float(time_span.count());
         sta_stats.last_update_time = now;
+
+        // Schedule the next sampling, stations with changing signal or traffic stay at the
+        // fast rate
+        if (poll_last) {
+            bool active =
+                changed || sta_stats.packets_acc >= mon_db.MONITOR_DB_STA_ACTIVE_PACKETS_MIN;
+            sta_node->poll_schedule(poll_id, active, mon_db.MONITOR_DB_STA_MAX_POLL_INTERVAL);
+        }
+    }
+
+    // Stations not sampled during the window must not report their last sample again
+    if (poll_last) {
+        for (size_t slot = 0; slot < mon_db.sta_slots_count(); slot++) {
+            auto sta_node = mon_db.sta_get_by_slot(slot);
+            if (sta_node && sta_node->get_stats().poll_id != poll_id) {
+                sta_node->clear_poll_counters(mon_db.MONITOR_DB_MEASUREMENT_WINDOW_MSEC);
+            }
+        }
     }
 
     return true;
@@ -623,6 +693,20 @@ bool monitor_thread::update_ap_stats()
         radio_stats.total_retrans_count += vap_stats.hal_stats.retrans_count;
         radio_stats.sta_count += vap_node->sta_get_count();
 
+        // Traffic on a VAP whose stations were all idle means one of them woke up, go back to
+        // the fast rate instead of waiting for the next scheduled sampling
+        if (!vap_stats.sta_polled &&
+            vap_stats.hal_stats.rx_packets + vap_stats.hal_stats.tx_packets >=
+                mon_db.MONITOR_DB_STA_ACTIVE_PACKETS_MIN) {
+            for (size_t slot = 0; slot < mon_db.sta_slots_count(); slot++) {
+                auto sta_node = mon_db.sta_get_by_slot(slot);
+                if (sta_node && sta_node->get_vap_id() == vap_id) {
+                    sta_node->poll_reset();
+                }
+            }
+        }
+        vap_stats.sta_polled = false;
+
         // Update the measurement timestamp
         auto now = std::chrono::steady_clock::now();
         auto time_span =
@@ -757,7 +841,7 @@ bool monitor_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
         }
 
         sta_node = mon_db.sta_add(sta_mac, vap_id);
-        sta_node->set_ipv4(sta_ipv4);
+        mon_db.sta_set_ipv4(sta_mac, sta_ipv4);
         sta_node->set_bridge_4addr_mac(set_bridge_4addr_mac);
 
         response->success() = true;
@@ -786,12 +870,10 @@ bool monitor_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
         std::string sta_mac  = network_utils::mac_to_string(notification->mac());
         std::string sta_ipv4 = network_utils::ipv4_to_string(notification->ipv4());
 
-        auto sta_node = mon_db.sta_find(sta_mac);
-        if (!sta_node) {
+        if (!mon_db.sta_set_ipv4(sta_mac, sta_ipv4)) {
             LOG(ERROR) << "sta " << sta_mac << " hasn't been found on mon_db";
             return false;
         }
-        sta_node->set_ipv4(sta_ipv4);
         break;
     }
 #ifdef BEEROCKS_RDKB
@@ -1239,13 +1321,64 @@ bool monitor_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
     return true;
 }
 
-bool monitor_thread::hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event_ptr)
+void monitor_thread::send_channel_scan_results()
 {
-    if (!event_ptr) {
-        LOG(ERROR) << "Invalid event!";
-        return false;
+    if (m_channel_scan_results.empty()) {
+        return;
     }
 
+    // A single result is sent as is, the slave handles it the same way
+    if (m_channel_scan_results.size() == 1) {
+        auto notification = message_com::create_vs_message<
+            beerocks_message::cACTION_MONITOR_CHANNEL_SCAN_RESULTS_NOTIFICATION>(cmdu_tx);
+        if (!notification) {
+            LOG(ERROR) << "Failed building cACTION_MONITOR_CHANNEL_SCAN_RESULTS_NOTIFICATION msg";
+            m_channel_scan_results.clear();
+            return;
+        }
+
+        notification->scan_results() = m_channel_scan_results.front();
+        notification->is_dump()      = 1;
+        message_com::send_cmdu(slave_socket, cmdu_tx);
+        m_channel_scan_results.clear();
+        return;
+    }
+
+    for (size_t offset = 0; offset < m_channel_scan_results.size();
+         offset += MAX_CHANNEL_SCAN_RESULTS_PER_BATCH) {
+        size_t count = std::min<size_t>(m_channel_scan_results.size() - offset,
+                                        MAX_CHANNEL_SCAN_RESULTS_PER_BATCH);
+
+        auto notification = message_com::create_vs_message<
+            beerocks_message::cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION>(cmdu_tx);
+        if (!notification) {
+            LOG(ERROR) << "Failed building cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION";
+            break;
+        }
+
+        if (!notification->alloc_results(count)) {
+            LOG(ERROR) << "Failed allocating " << count << " channel scan results";
+            break;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            auto result = notification->results(i);
+            if (!std::get<0>(result)) {
+                LOG(ERROR) << "Failed to get channel scan result " << i;
+                m_channel_scan_results.clear();
+                return;
+            }
+            std::get<1>(result) = m_channel_scan_results[offset + i];
+        }
+
+        message_com::send_cmdu(slave_socket, cmdu_tx);
+    }
+
+    m_channel_scan_results.clear();
+}
+
+bool monitor_thread::hal_event_handler(const bwl::base_wlan_hal::hal_event_t &hal_event)
+{
     if (!slave_socket) {
         LOG(ERROR) << "slave_socket == nullptr";
         return false;
@@ -1253,8 +1386,8 @@ bool monitor_thread::hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event
 
     // Monitor Event & Data
     typedef bwl::mon_wlan_hal::Event Event;
-    auto event = (Event)(event_ptr->first);
-    auto data  = event_ptr->second.get();
+    auto event = (Event)(hal_event.first);
+    auto data  = hal_event.second.get();
 
     switch (event) {
 
@@ -1503,8 +1636,10 @@ bool monitor_thread::hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event
 
         message_com::send_cmdu(slave_socket, cmdu_tx);
     } break;
-    case Event::Channel_Scan_New_Results_Ready:
-    case Event::Channel_Scan_Dump_Result: {
+    case Event::Channel_Scan_New_Results_Ready: {
+        // Results of a previous dump go first
+        send_channel_scan_results();
+
         auto notification = message_com::create_vs_message<
             beerocks_message::cACTION_MONITOR_CHANNEL_SCAN_RESULTS_NOTIFICATION>(cmdu_tx);
         if (!notification) {
@@ -1512,71 +1647,77 @@ bool monitor_thread::hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event
             return false;
         }
 
-        // If event == Channel_Scan_New_Results_Ready do nothing since is_dump's default is 0
-        if (event == Event::Channel_Scan_Dump_Result) {
-            auto msg = static_cast<bwl::sCHANNEL_SCAN_RESULTS_NOTIFICATION *>(data);
-
-            auto &in_result  = msg->channel_scan_results;
-            auto &out_result = notification->scan_results();
-
-            // Arrays
-            string_utils::copy_string(out_result.ssid, in_result.ssid,
-                                      beerocks::message::WIFI_SSID_MAX_LENGTH);
-            std::copy_n(in_result.bssid.oct, sizeof(out_result.bssid.oct), out_result.bssid.oct);
-            std::copy(in_result.basic_data_transfer_rates_kbps.begin(),
-                      in_result.basic_data_transfer_rates_kbps.end(),
-                      out_result.basic_data_transfer_rates_kbps);
-            std::copy(in_result.supported_data_transfer_rates_kbps.begin(),
-                      in_result.supported_data_transfer_rates_kbps.end(),
-                      out_result.supported_data_transfer_rates_kbps);
-
-            // Primery values
-            out_result.channel             = in_result.channel;
-            out_result.signal_strength_dBm = in_result.signal_strength_dBm;
-            out_result.beacon_period_ms    = in_result.beacon_period_ms;
-            out_result.noise_dBm           = in_result.noise_dBm;
-            out_result.dtim_period         = in_result.dtim_period;
-            out_result.channel_utilization = in_result.channel_utilization;
-
-            // Enums
-            out_result.mode = beerocks_message::eChannelScanResultMode(uint8_t(in_result.mode));
-            out_result.operating_frequency_band =
-                beerocks_message::eChannelScanResultOperatingFrequencyBand(
-                    uint8_t(in_result.operating_frequency_band));
-            out_result.operating_standards = beerocks_message::eChannelScanResultStandards(
-                uint8_t(in_result.operating_standards));
-            out_result.operating_channel_bandwidth =
-                beerocks_message::eChannelScanResultChannelBandwidth(
-                    uint8_t(in_result.operating_channel_bandwidth));
-
-            // Enum list
-            int i = 0;
-            std::for_each(in_result.security_mode_enabled.begin(),
-                          in_result.security_mode_enabled.end(),
-                          [&i, &out_result](bwl::eChannelScanResultSecurityMode e) {
-                              out_result.security_mode_enabled[i++] =
-                                  beerocks_message::eChannelScanResultSecurityMode(uint8_t(e));
-                          });
-            i = 0;
-            std::for_each(in_result.encryption_mode.begin(), in_result.encryption_mode.end(),
-                          [&i, &out_result](bwl::eChannelScanResultEncryptionMode e) {
-                              out_result.encryption_mode[i++] =
-                                  beerocks_message::eChannelScanResultEncryptionMode(uint8_t(e));
-                          });
-            i = 0;
-            std::for_each(in_result.supported_standards.begin(),
-                          in_result.supported_standards.end(),
-                          [&i, &out_result](bwl::eChannelScanResultStandards e) {
-                              out_result.supported_standards[i++] =
-                                  beerocks_message::eChannelScanResultStandards(uint8_t(e));
-                          });
-
-            notification->is_dump() = 1;
-        }
-
+        // is_dump's default is 0, notification that results are ready
         message_com::send_cmdu(slave_socket, cmdu_tx);
     } break;
+    case Event::Channel_Scan_Dump_Result: {
+        auto msg = static_cast<bwl::sCHANNEL_SCAN_RESULTS_NOTIFICATION *>(data);
+
+        // The results are sent in batches, once a batch is full or the events are processed
+        m_channel_scan_results.emplace_back();
+
+        auto &in_result  = msg->channel_scan_results;
+        auto &out_result = m_channel_scan_results.back();
+
+        // Arrays
+        string_utils::copy_string(out_result.ssid, in_result.ssid,
+                                  beerocks::message::WIFI_SSID_MAX_LENGTH);
+        std::copy_n(in_result.bssid.oct, sizeof(out_result.bssid.oct), out_result.bssid.oct);
+        std::copy(in_result.basic_data_transfer_rates_kbps.begin(),
+                  in_result.basic_data_transfer_rates_kbps.end(),
+                  out_result.basic_data_transfer_rates_kbps);
+        std::copy(in_result.supported_data_transfer_rates_kbps.begin(),
+                  in_result.supported_data_transfer_rates_kbps.end(),
+                  out_result.supported_data_transfer_rates_kbps);
+
+        // Primery values
+        out_result.channel             = in_result.channel;
+        out_result.signal_strength_dBm = in_result.signal_strength_dBm;
+        out_result.beacon_period_ms    = in_result.beacon_period_ms;
+        out_result.noise_dBm           = in_result.noise_dBm;
+        out_result.dtim_period         = in_result.dtim_period;
+        out_result.channel_utilization = in_result.channel_utilization;
+
+        // Enums
+        out_result.mode = beerocks_message::eChannelScanResultMode(uint8_t(in_result.mode));
+        out_result.operating_frequency_band =
+            beerocks_message::eChannelScanResultOperatingFrequencyBand(
+                uint8_t(in_result.operating_frequency_band));
+        out_result.operating_standards = beerocks_message::eChannelScanResultStandards(
+            uint8_t(in_result.operating_standards));
+        out_result.operating_channel_bandwidth =
+            beerocks_message::eChannelScanResultChannelBandwidth(
+                uint8_t(in_result.operating_channel_bandwidth));
+
+        // Enum list
+        int i = 0;
+        std::for_each(in_result.security_mode_enabled.begin(),
+                      in_result.security_mode_enabled.end(),
+                      [&i, &out_result](bwl::eChannelScanResultSecurityMode e) {
+                          out_result.security_mode_enabled[i++] =
+                              beerocks_message::eChannelScanResultSecurityMode(uint8_t(e));
+                      });
+        i = 0;
+        std::for_each(in_result.encryption_mode.begin(), in_result.encryption_mode.end(),
+                      [&i, &out_result](bwl::eChannelScanResultEncryptionMode e) {
+                          out_result.encryption_mode[i++] =
+                              beerocks_message::eChannelScanResultEncryptionMode(uint8_t(e));
+                      });
+        i = 0;
+        std::for_each(in_result.supported_standards.begin(), in_result.supported_standards.end(),
+                      [&i, &out_result](bwl::eChannelScanResultStandards e) {
+                          out_result.supported_standards[i++] =
+                              beerocks_message::eChannelScanResultStandards(uint8_t(e));
+                      });
+
+        if (m_channel_scan_results.size() >= MAX_CHANNEL_SCAN_RESULTS_PER_BATCH) {
+            send_channel_scan_results();
+        }
+    } break;
     case Event::Channel_Scan_Finished: {
+        // Results of the dump go first
+        send_channel_scan_results();
+
         auto notification = message_com::create_vs_message<
             beerocks_message::cACTION_MONITOR_CHANNEL_SCAN_FINISHED_NOTIFICATION>(cmdu_tx);
         if (!notification) {
@@ -1587,6 +1728,9 @@ bool monitor_thread::hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event
         message_com::send_cmdu(slave_socket, cmdu_tx);
     } break;
     case Event::Channel_Scan_Abort: {
+        // Results of the dump go first
+        send_channel_scan_results();
+
         auto notification = message_com::create_vs_message<
             beerocks_message::cACTION_MONITOR_CHANNEL_SCAN_ABORT_NOTIFICATION>(cmdu_tx);
         if (!notification) {
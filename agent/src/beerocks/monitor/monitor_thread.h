@@ -24,6 +24,8 @@
 // Monitor HAL
 #include <bwl/mon_wlan_hal.h>
 
+#include <vector>
+
 namespace son {
 class monitor_thread : public beerocks::socket_thread {
 public:
@@ -55,7 +57,12 @@ protected:
 
 private:
     void stop_monitor_thread();
-    bool hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event_ptr);
+    bool hal_event_handler(const bwl::base_wlan_hal::hal_event_t &hal_event);
+
+    /**
+     * @brief Send the pending channel scan results to the slave, in batches.
+     */
+    void send_channel_scan_results();
 
     bool update_ap_stats();
     bool update_sta_stats();
@@ -105,6 +112,9 @@ private:
 
     int hal_command_failures_count = 0;
 
+    // Channel scan results of the current dump, not sent yet
+    std::vector<beerocks_message::sChannelScanResults> m_channel_scan_results;
+
     std::shared_ptr<bwl::mon_wlan_hal> mon_wlan_hal;
     bool mon_hal_attached           = false;
     bwl::HALState last_attach_state = bwl::HALState::Uninitialized;
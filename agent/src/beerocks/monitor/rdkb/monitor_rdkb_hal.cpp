@@ -8,9 +8,9 @@
 
 #include "monitor_rdkb_hal.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_monitor.h>
@@ -11,7 +11,7 @@
 #include <bcl/network/network_utils.h>
 #include <beerocks/tlvf/beerocks_message.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 #include "backhaul_manager/backhaul_manager_thread.h"
 
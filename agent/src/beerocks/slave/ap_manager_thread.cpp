@@ -8,10 +8,10 @@
 
 #include "ap_manager_thread.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_apmanager.h>
@@ -384,7 +384,7 @@ void ap_manager_thread::after_select(bool timeout)
 
         // Process internal events
         if (read_ready(ap_hal_int_events)) {
-            // A callback (hal_event_handler()) will invoked for pending events
+            // A callback (hal_event_handler()) will be invoked for all the pending events
             clear_ready(ap_hal_int_events);
             if (!ap_wlan_hal->process_int_events()) {
                 LOG(ERROR) << "process_int_events() failed!";
@@ -993,13 +993,8 @@ bool ap_manager_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_
     return true;
 }
 
-bool ap_manager_thread::hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event_ptr)
+bool ap_manager_thread::hal_event_handler(const bwl::base_wlan_hal::hal_event_t &hal_event)
 {
-    if (!event_ptr) {
-        LOG(ERROR) << "Invalid event!";
-        return false;
-    }
-
     if (!slave_socket) {
         LOG(ERROR) << "slave_socket == nullptr";
         return false;
@@ -1007,8 +1002,8 @@ bool ap_manager_thread::hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t ev
 
     // AP Event & Data
     typedef bwl::ap_wlan_hal::Event Event;
-    auto event = (Event)(event_ptr->first);
-    auto data  = event_ptr->second.get();
+    auto event = (Event)(hal_event.first);
+    auto data  = hal_event.second.get();
 
     switch (event) {
 
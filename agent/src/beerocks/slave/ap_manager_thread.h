@@ -66,7 +66,7 @@ protected:
     virtual std::string print_cmdu_types(const beerocks::message::sUdsHeader *cmdu_header) override;
 
 private:
-    bool hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event_ptr);
+    bool hal_event_handler(const bwl::base_wlan_hal::hal_event_t &hal_event);
     // bool hostap_handle_event(std::string& event, void* event_obj);
     void handle_hostapd_attached();
     bool handle_ap_enabled(int vap_id);
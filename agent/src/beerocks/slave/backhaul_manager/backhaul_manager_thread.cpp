@@ -10,9 +10,9 @@
 
 #include "../tlvf_utils.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_backhaul.h>
@@ -341,7 +341,7 @@ void backhaul_manager::after_select(bool timeout)
 
         // Process internal events
         if (read_ready(soc->sta_hal_int_events)) {
-            // A callback (hal_event_handler()) will invoked for pending events
+            // A callback (hal_event_handler()) will be invoked for all the pending events
             soc->sta_wlan_hal->process_int_events();
             clear_ready(soc->sta_hal_int_events);
         }
@@ -2288,21 +2288,16 @@ bool backhaul_manager::send_slaves_enable()
     return true;
 }
 
-bool backhaul_manager::hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event_ptr,
+bool backhaul_manager::hal_event_handler(const bwl::base_wlan_hal::hal_event_t &hal_event,
                                          std::string iface)
 {
-    if (!event_ptr) {
-        LOG(ERROR) << "Invalid event!";
-        return false;
-    }
-
     // TODO: TEMP!
-    LOG(DEBUG) << "Got event " << int(event_ptr->first) << " from iface " << iface;
+    LOG(DEBUG) << "Got event " << int(hal_event.first) << " from iface " << iface;
 
     // AP Event & Data
     typedef bwl::sta_wlan_hal::Event Event;
-    auto event = (Event)(event_ptr->first);
-    auto data  = event_ptr->second.get();
+    auto event = (Event)(hal_event.first);
+    auto data  = hal_event.second.get();
 
     switch (event) {
 
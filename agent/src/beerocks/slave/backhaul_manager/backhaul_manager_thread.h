@@ -86,7 +86,7 @@ private:
     bool handle_client_capability_query(ieee1905_1::CmduMessageRx &cmdu_rx,
                                         const std::string &src_mac);
     //bool sta_handle_event(const std::string &iface,const std::string& event_name, void* event_obj);
-    bool hal_event_handler(bwl::base_wlan_hal::hal_event_ptr_t event_ptr, std::string iface);
+    bool hal_event_handler(const bwl::base_wlan_hal::hal_event_t &hal_event, std::string iface);
 
     bool is_eth_link_up();
     void get_scan_measurement();
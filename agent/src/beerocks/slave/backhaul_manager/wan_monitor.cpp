@@ -8,9 +8,9 @@
 
 #include "wan_monitor.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_logging.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <errno.h>           // errno
 #include <linux/netlink.h>   // Netlink
@@ -11,11 +11,13 @@
 #include "son_slave_thread.h"
 
 #include <bcl/beerocks_config_file.h>
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_logging.h>
+#include <bcl/beerocks_metrics_server.h>
+#include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/beerocks_version.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 // Do not use this macro anywhere else in ire process
 // It should only be there in one place in each executable module
@@ -163,6 +165,7 @@ static void fill_son_slave_config(beerocks::config_file::sConfigSlave &beerocks_
     son_slave_conf.hostap_ant_gain =
         beerocks::string_utils::stoi(beerocks_slave_conf.hostap_ant_gain[slave_num]);
     son_slave_conf.radio_identifier = beerocks_slave_conf.radio_identifier[slave_num];
+    son_slave_conf.slave_num        = slave_num;
     son_slave_conf.backhaul_wireless_iface =
         get_sta_iface_from_hostap_iface(son_slave_conf.hostap_iface);
     son_slave_conf.backhaul_wireless_iface_filter_low =
@@ -285,6 +288,7 @@ static int run_beerocks_slave(beerocks::config_file::sConfigSlave &beerocks_slav
               << BEEROCKS_BUILD_DATE << std::endl
               << std::endl;
     beerocks::version::log_version(argc, argv);
+    slave_logger.start_cmdu_trace();
 
     versionfile.open(beerocks_slave_conf.temp_path + "beerocks_slave_version");
     versionfile << BEEROCKS_VERSION << std::endl << BEEROCKS_REVISION;
@@ -328,6 +332,9 @@ static int run_beerocks_slave(beerocks::config_file::sConfigSlave &beerocks_slav
         beerocks::backhaul_manager backhaul_mgr(beerocks_slave_conf, slave_ap_ifaces,
                                                 slave_sta_ifaces, stop_on_failure_attempts);
 
+        auto metrics =
+            beerocks::metrics_server::start_from_config(beerocks_slave_conf.metrics_port);
+
         // Start backhaul manager
         if (!backhaul_mgr.start()) {
             LOG(ERROR) << "backhaul_mgr.start()";
@@ -379,6 +386,10 @@ static int run_beerocks_slave(beerocks::config_file::sConfigSlave &beerocks_slav
             }
         }
 
+        if (metrics) {
+            metrics->stop();
+        }
+
         LOG(DEBUG) << "backhaul_mgr.stop()";
         backhaul_mgr.stop();
 
@@ -406,6 +417,7 @@ static int run_son_slave(int slave_num, beerocks::config_file::sConfigSlave &bee
               << " Build date " << BEEROCKS_BUILD_DATE << std::endl
               << std::endl;
     beerocks::version::log_version(argc, argv);
+    slave_logger.start_cmdu_trace();
 
     //redirect stdout / stderr to file
     //int fd_log_file_std = beerocks::os_utils::redirect_console_std("/dev/null");
@@ -429,6 +441,10 @@ static int run_son_slave(int slave_num, beerocks::config_file::sConfigSlave &bee
 
     son::slave_thread son_slave(son_slave_conf, slave_logger);
     if (son_slave.init()) {
+        // Each son_slave process exports its own metrics, on the port following the agent's
+        auto metrics = beerocks::metrics_server::start_from_config(beerocks_slave_conf.metrics_port,
+                                                                   1 + slave_num);
+
         auto touch_time_stamp_timeout = std::chrono::steady_clock::now();
         while (g_running) {
 
@@ -449,6 +465,9 @@ static int run_son_slave(int slave_num, beerocks::config_file::sConfigSlave &bee
                 break;
             }
         }
+        if (metrics) {
+            metrics->stop();
+        }
         son_slave.stop();
     } else {
         LOG(ERROR) << "son_slave.init(), slave_num=" << slave_num;
@@ -8,8 +8,8 @@
 
 #include "platform_manager_thread.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_platform.h>
@@ -10,11 +10,11 @@
 #include "../monitor/monitor_thread.h"
 #include "tlvf_utils.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/beerocks_version.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_1905_vs.h>
@@ -315,6 +315,9 @@ bool slave_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
             return false;
         }
 
+        metrics::scoped_timer timer(
+            cmdu_handle_time(m_cmdu_handle_time, beerocks_header->action(),
+                             beerocks_header->action_op()));
         switch (beerocks_header->action()) {
         case beerocks_message::ACTION_CONTROL: {
             return handle_cmdu_control_message(sd, beerocks_header);
@@ -336,6 +339,8 @@ bool slave_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
         }
         }
     } else { // IEEE 1905.1 message
+        metrics::scoped_timer timer(
+            cmdu_handle_time(m_cmdu_handle_time, uint16_t(cmdu_rx.getMessageType())));
         return handle_cmdu_control_ieee1905_1_message(sd, cmdu_rx);
     }
     return true;
@@ -586,47 +591,9 @@ bool slave_thread::handle_cmdu_control_message(Socket *sd,
             LOG(ERROR) << "addClass ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST failed";
             return false;
         }
-        auto hostap_mac = network_utils::mac_to_string(request_in->params().mac);
-        bool forbackhaul =
-            (is_backhaul_manager && backhaul_params.backhaul_is_wireless) ? true : false;
-
-        if (request_in->params().cross && (request_in->params().ipv4.oct[0] == 0) &&
-            forbackhaul) { //if backhaul manager and wireless send to backhaul else front.
-            auto request_out = message_com::create_vs_message<
-                beerocks_message::cACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(
-                cmdu_tx, beerocks_header->id());
-            if (request_out == nullptr) {
-                LOG(ERROR) << "Failed building ACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST "
-                              "message!";
-                return false;
-            }
-
-            request_out->params() = request_in->params();
-            message_com::send_cmdu(backhaul_manager_socket, cmdu_tx);
-        } else if (request_in->params().cross &&
-                   (request_in->params().ipv4.oct[0] ==
-                    0)) { // unconnected client cross --> send to ap_manager
-            auto request_out = message_com::create_vs_message<
-                beerocks_message::cACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(
-                cmdu_tx, beerocks_header->id());
-            if (request_out == nullptr) {
-                LOG(ERROR) << "Failed building ACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_REQUEST "
-                              "message!";
-                return false;
-            }
-            request_out->params() = request_in->params();
-            message_com::send_cmdu(ap_manager_socket, cmdu_tx);
-        } else {
-            auto request_out = message_com::create_vs_message<
-                beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(
-                cmdu_tx, beerocks_header->id());
-            if (request_out == nullptr) {
-                LOG(ERROR)
-                    << "Failed building ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_REQUEST message!";
-                return false;
-            }
-            request_out->params() = request_in->params();
-            message_com::send_cmdu(monitor_socket, cmdu_tx);
+        if (!forward_client_rx_rssi_measurement_request(request_in->params(),
+                                                        beerocks_header->id())) {
+            return false;
         }
 
         LOG(INFO) << "rx_rssi measurement request for client mac=" << request_in->params().mac
@@ -638,6 +605,36 @@ bool slave_thread::handle_cmdu_control_message(Socket *sd,
                   << " id=" << int(beerocks_header->id());
         break;
     }
+    case beerocks_message::ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST: {
+        auto request_in = beerocks_header->addClass<
+            beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST>();
+        if (request_in == nullptr) {
+            LOG(ERROR) << "addClass ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST failed";
+            return false;
+        }
+
+        // Each entry carries the id of the task which requested it, so the responses are
+        // routed back the same way as the ones of single requests
+        int requests_size = request_in->requests_size();
+        LOG(DEBUG) << "received ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST, requests="
+                   << requests_size;
+        for (int i = 0; i < requests_size; i++) {
+            auto entry = request_in->requests(i);
+            if (!std::get<0>(entry)) {
+                LOG(ERROR) << "Failed to get rx_rssi measurement request entry " << i;
+                return false;
+            }
+            auto &request = std::get<1>(entry);
+            if (!forward_client_rx_rssi_measurement_request(request.params, request.request_id)) {
+                return false;
+            }
+            LOG(DEBUG) << "rx_rssi measurement request for client mac=" << request.params.mac
+                       << " channel=" << int(request.params.channel)
+                       << " cross=" << int(request.params.cross)
+                       << " id=" << int(request.request_id);
+        }
+        break;
+    }
     case beerocks_message::ACTION_CONTROL_CLIENT_DISCONNECT_REQUEST: {
         auto request_in =
             beerocks_header
@@ -2738,6 +2735,40 @@ bool slave_thread::handle_cmdu_monitor_message(Socket *sd,
         send_cmdu_to_controller(cmdu_tx);
         break;
     }
+    case beerocks_message::ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION: {
+        auto notification_in = beerocks_header->addClass<
+            beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>();
+        if (notification_in == nullptr) {
+            LOG(ERROR)
+                << "addClass cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION failed";
+            return false;
+        }
+
+        auto notification_out = message_com::create_vs_message<
+            beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>(
+            cmdu_tx);
+        if (notification_out == nullptr) {
+            LOG(ERROR) << "Failed building message!";
+            return false;
+        }
+
+        int measurements_size = notification_in->measurements_size();
+        if (!notification_out->alloc_measurements(measurements_size)) {
+            LOG(ERROR) << "Failed allocating " << measurements_size << " rx rssi measurements";
+            return false;
+        }
+        for (int i = 0; i < measurements_size; i++) {
+            auto entry_in  = notification_in->measurements(i);
+            auto entry_out = notification_out->measurements(i);
+            if (!std::get<0>(entry_in) || !std::get<0>(entry_out)) {
+                LOG(ERROR) << "Failed to get rx rssi measurement entry " << i;
+                return false;
+            }
+            std::get<1>(entry_out) = std::get<1>(entry_in);
+        }
+        send_cmdu_to_controller(cmdu_tx);
+        break;
+    }
     case beerocks_message::ACTION_MONITOR_STEERING_EVENT_CLIENT_ACTIVITY_NOTIFICATION: {
         auto notification_in = beerocks_header->addClass<
             beerocks_message::cACTION_MONITOR_STEERING_EVENT_CLIENT_ACTIVITY_NOTIFICATION>();
@@ -2877,6 +2908,40 @@ bool slave_thread::handle_cmdu_monitor_message(Socket *sd,
         send_cmdu_to_controller(cmdu_tx);
         break;
     }
+    case beerocks_message::ACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION: {
+        auto notification_in = beerocks_header->addClass<
+            beerocks_message::cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION>();
+        if (!notification_in) {
+            LOG(ERROR) << "addClass cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION failed";
+            return false;
+        }
+
+        auto notification_out = message_com::create_vs_message<
+            beerocks_message::cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION>(cmdu_tx);
+        if (!notification_out) {
+            LOG(ERROR)
+                << "Failed building cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION !";
+            return false;
+        }
+
+        int results_size = notification_in->results_size();
+        if (!notification_out->alloc_results(results_size)) {
+            LOG(ERROR) << "Failed allocating " << results_size << " channel scan results";
+            return false;
+        }
+        for (int i = 0; i < results_size; i++) {
+            auto result_in  = notification_in->results(i);
+            auto result_out = notification_out->results(i);
+            if (!std::get<0>(result_in) || !std::get<0>(result_out)) {
+                LOG(ERROR) << "Failed to get channel scan result " << i;
+                return false;
+            }
+            std::get<1>(result_out) = std::get<1>(result_in);
+        }
+
+        send_cmdu_to_controller(cmdu_tx);
+        break;
+    }
     case beerocks_message::ACTION_MONITOR_CHANNEL_SCAN_FINISHED_NOTIFICATION: {
         auto notification_in =
             beerocks_header
@@ -3602,7 +3667,8 @@ void slave_thread::monitor_start()
     {
         file_name = BEEROCKS_BIN_PATH + std::string(BEEROCKS_MONITOR);
     }
-    std::string cmd = file_name + " -i " + config.hostap_iface;
+    std::string cmd =
+        file_name + " -i " + config.hostap_iface + " -n " + std::to_string(config.slave_num);
     SYSTEM_CALL(cmd, 2, true);
 }
 
@@ -4163,6 +4229,17 @@ bool slave_thread::parse_intel_join_response(Socket *sd, beerocks::beerocks_head
         message_com::send_cmdu(platform_manager_socket, cmdu_tx);
         LOG(DEBUG) << "send ACTION_PLATFORM_MASTER_SLAVE_VERSIONS_NOTIFICATION";
 
+        // Advertise the optional features this agent supports to the controller
+        auto features_notification = message_com::create_vs_message<
+            beerocks_message::cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION>(cmdu_tx);
+        if (features_notification == nullptr) {
+            LOG(ERROR) << "Failed building ACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION message!";
+            return false;
+        }
+        features_notification->features() = beerocks::SLAVE_FEATURE_RSSI_MEASUREMENT_BATCH;
+        send_cmdu_to_controller(cmdu_tx);
+        LOG(DEBUG) << "send ACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION";
+
         son_config = joined_response->config();
         log_son_config();
 
@@ -4735,3 +4812,46 @@ bool slave_thread::autoconfig_wsc_add_m1()
     std::copy_n(attributes->buffer(), m1_auth_buf_len, m1_auth_buf);
     return true;
 }
+
+bool slave_thread::forward_client_rx_rssi_measurement_request(
+    const beerocks_message::sNodeRssiMeasurementRequest &params, uint16_t id)
+{
+    bool forbackhaul =
+        (is_backhaul_manager && backhaul_params.backhaul_is_wireless) ? true : false;
+
+    if (params.cross && (params.ipv4.oct[0] == 0) &&
+        forbackhaul) { //if backhaul manager and wireless send to backhaul else front.
+        auto request_out = message_com::create_vs_message<
+            beerocks_message::cACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(cmdu_tx, id);
+        if (request_out == nullptr) {
+            LOG(ERROR) << "Failed building ACTION_BACKHAUL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST "
+                          "message!";
+            return false;
+        }
+
+        request_out->params() = params;
+        message_com::send_cmdu(backhaul_manager_socket, cmdu_tx);
+    } else if (params.cross &&
+               (params.ipv4.oct[0] == 0)) { // unconnected client cross --> send to ap_manager
+        auto request_out = message_com::create_vs_message<
+            beerocks_message::cACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(cmdu_tx, id);
+        if (request_out == nullptr) {
+            LOG(ERROR) << "Failed building ACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_REQUEST "
+                          "message!";
+            return false;
+        }
+        request_out->params() = params;
+        message_com::send_cmdu(ap_manager_socket, cmdu_tx);
+    } else {
+        auto request_out = message_com::create_vs_message<
+            beerocks_message::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(cmdu_tx, id);
+        if (request_out == nullptr) {
+            LOG(ERROR)
+                << "Failed building ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_REQUEST message!";
+            return false;
+        }
+        request_out->params() = params;
+        message_com::send_cmdu(monitor_socket, cmdu_tx);
+    }
+    return true;
+}
@@ -13,6 +13,7 @@
 
 #include <bcl/beerocks_backport.h>
 #include <bcl/beerocks_logging.h>
+#include <bcl/beerocks_metrics.h>
 #include <bcl/beerocks_socket_thread.h>
 
 #include <beerocks/tlvf/beerocks_header.h>
@@ -55,6 +56,7 @@ public:
         int hostap_ant_gain;
         std::string radio_identifier; //mAP RUID
         bool no_vendor_specific;
+        int slave_num;
     } sSlaveConfig;
 
     typedef struct {
@@ -219,6 +221,10 @@ private:
 
     ap_manager_thread *ap_manager = nullptr;
 
+    // Handling time of the received CMDUs, by message type
+    beerocks::metrics::histogram_map<> m_cmdu_handle_time{
+        "beerocks_cmdu_handle_seconds", "Time spent handling a received CMDU, by message type"};
+
     // Encryption support - move to common library
     bool autoconfig_wsc_calculate_keys(WSC::m2 &m2, uint8_t authkey[32], uint8_t keywrapkey[16]);
     bool autoconfig_wsc_parse_m2_encrypted_settings(WSC::m2 &m2, uint8_t authkey[32],
@@ -250,6 +256,17 @@ private:
     bool handle_client_association_request(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx);
     bool handle_client_steering_request(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx);
     bool handle_ack_message(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx);
+
+    /**
+     * @brief Forward a client rx rssi measurement request to the module which should perform it
+     * (backhaul manager, ap manager or monitor).
+     *
+     * @param params Measurement request parameters.
+     * @param id Id of the requesting controller task, used as the id of the forwarded request.
+     * @return true on success, false otherwise.
+     */
+    bool forward_client_rx_rssi_measurement_request(
+        const beerocks_message::sNodeRssiMeasurementRequest &params, uint16_t id);
 };
 
 } // namespace son
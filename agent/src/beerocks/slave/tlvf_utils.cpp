@@ -8,8 +8,8 @@
 
 #include "tlvf_utils.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <tlvf/wfa_map/tlvApRadioBasicCapabilities.h>
 
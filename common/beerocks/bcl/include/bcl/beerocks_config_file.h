@@ -28,6 +28,11 @@ public:
         std::string files_auto_roll;
         std::string stdout_enabled;
         std::string syslog_enabled;
+        std::string async_enabled;
+        std::string async_queue_size;
+        std::string async_overflow;
+        std::string binary_enabled;
+        std::string cmdu_trace_records;
     };
 
     // config file parameters master / slave
@@ -37,6 +42,7 @@ public:
         std::string vendor;
         std::string model;
         std::string ucc_listener_port;
+        std::string metrics_port;
         std::string load_dfs_reentry;
         std::string load_client_band_steering;
         std::string load_client_optimal_path_roaming;
@@ -52,6 +58,7 @@ public:
         std::string load_health_check;
         std::string load_monitor_on_vaps;
         std::string load_rdkb_extensions;
+        std::string load_topology_snapshot;
         std::string global_restricted_channels;
         std::string diagnostics_measurements_polling_rate_sec;
         std::string ire_rssi_report_rate_sec;
@@ -83,6 +90,7 @@ public:
         std::string channel_selection_long_delay;
         std::string roaming_sticky_client_rssi_threshold;
         std::string credentials_change_timeout_sec;
+        std::string task_worker_threads;
         //[log]
         SConfigLog sLog;
     } sConfigMaster;
@@ -94,6 +102,7 @@ public:
         std::string vendor;
         std::string model;
         std::string ucc_listener_port;
+        std::string metrics_port;
         std::string enable_arp_monitor;
         std::string enable_keep_alive;
         std::string debug_disable_arp;
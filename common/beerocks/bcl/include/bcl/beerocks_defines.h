@@ -424,6 +424,11 @@ enum eSlaveJoinResponseErrCode {
     JOIN_RESP_REJECT,
 };
 
+// Optional features of the agent, advertised to the controller after the join
+enum eSlaveFeature : uint32_t {
+    SLAVE_FEATURE_RSSI_MEASUREMENT_BATCH = 0x1,
+};
+
 enum eApActiveMode : uint8_t { AP_IDLE_MODE = 0, AP_ACTIVE_MODE, AP_INVALID_MODE };
 
 enum eBssType {
@@ -0,0 +1,323 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BEEROCKS_LOG_H_
+#define _BEEROCKS_LOG_H_
+
+#include <easylogging++.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+/**
+ * Logging facade over easylogging++, to be included instead of easylogging++.h.
+ *
+ * LOG() and LOG_IF() check the log level before the streamed expression is evaluated, so the
+ * arguments of a disabled log (string conversions, buffer dumps...) cost nothing:
+ * - Levels below BEEROCKS_LOG_MIN_LEVEL are compiled out.
+ * - Levels disabled in the log settings of the module are skipped by a single atomic load.
+ */
+
+// Severity of the compiled in logs: 0 - trace, 1 - debug, 2 - info, 3 - warning, 4 - error,
+// 5 - fatal
+#ifndef BEEROCKS_LOG_MIN_LEVEL
+#define BEEROCKS_LOG_MIN_LEVEL 0
+#endif
+
+#define BEEROCKS_LOG_SEVERITY_TRACE 0
+#define BEEROCKS_LOG_SEVERITY_DEBUG 1
+#define BEEROCKS_LOG_SEVERITY_INFO 2
+#define BEEROCKS_LOG_SEVERITY_WARNING 3
+#define BEEROCKS_LOG_SEVERITY_ERROR 4
+#define BEEROCKS_LOG_SEVERITY_FATAL 5
+
+#define BEEROCKS_LOG_LEVEL_TRACE el::Level::Trace
+#define BEEROCKS_LOG_LEVEL_DEBUG el::Level::Debug
+#define BEEROCKS_LOG_LEVEL_INFO el::Level::Info
+#define BEEROCKS_LOG_LEVEL_WARNING el::Level::Warning
+#define BEEROCKS_LOG_LEVEL_ERROR el::Level::Error
+#define BEEROCKS_LOG_LEVEL_FATAL el::Level::Fatal
+
+// Constant false for the compiled out levels, so the whole log statement is optimized out
+#define BEEROCKS_LOG_ENABLED(LEVEL)                                                                \
+    (BEEROCKS_LOG_SEVERITY_##LEVEL >= BEEROCKS_LOG_MIN_LEVEL &&                                    \
+     beerocks::log::is_enabled(BEEROCKS_LOG_LEVEL_##LEVEL))
+
+#undef LOG
+#define LOG(LEVEL)                                                                                 \
+    !BEEROCKS_LOG_ENABLED(LEVEL)                                                                   \
+        ? (void)0                                                                                  \
+        : beerocks::log::voidify() & CLOG(LEVEL, ELPP_CURR_FILE_LOGGER_ID)
+
+#undef LOG_IF
+#define LOG_IF(condition, LEVEL)                                                                   \
+    !(BEEROCKS_LOG_ENABLED(LEVEL) && (condition))                                                  \
+        ? (void)0                                                                                  \
+        : beerocks::log::voidify() & CLOG(LEVEL, ELPP_CURR_FILE_LOGGER_ID)
+
+/**
+ * Structured binary log: LOG_BINARY(LEVEL, "format with {} and {}", arg1, arg2);
+ *
+ * The arguments may be integers, enums, floating point numbers, booleans and strings.
+ * With binary logging enabled (log_binary_enabled, requires log_async_enabled), only the format
+ * id and the raw arguments are queued and written to <module>.blog, decoded offline by
+ * tools/beerocks_blog_decoder.py. Otherwise the message is formatted and logged as by LOG().
+ */
+#define LOG_BINARY(LEVEL, format, ...)                                                             \
+    do {                                                                                           \
+        if (BEEROCKS_LOG_ENABLED(LEVEL)) {                                                         \
+            static beerocks::log::binary_site _beerocks_log_site(                                 \
+                __FILE__, __LINE__, BEEROCKS_LOG_LEVEL_##LEVEL, BEEROCKS_LOG_SEVERITY_##LEVEL,     \
+                format);                                                                           \
+            beerocks::log::log_binary(_beerocks_log_site, ELPP_FUNC, ##__VA_ARGS__);               \
+        }                                                                                          \
+    } while (0)
+
+namespace beerocks {
+namespace log {
+
+/**
+ * @brief Bitmask of the el::Level enabled in the log settings of the module, set by
+ * logging::apply_settings().
+ */
+extern std::atomic<uint32_t> enabled_levels;
+
+inline bool is_enabled(el::Level level)
+{
+    return enabled_levels.load(std::memory_order_relaxed) & static_cast<uint32_t>(level);
+}
+
+/**
+ * Turns the log stream expression into void, for the conditional operator of LOG().
+ */
+struct voidify {
+    template <typename T> void operator&(const T &) {}
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/////////////////////////////// Binary logging ///////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Binary log file format, all the integers in host byte order:
+ * - File header: "BLOG" followed by the uint8_t version.
+ * - Records, starting with the uint16_t length of the record (including the length itself):
+ *   - Format record: 'F', uint32_t id, uint8_t severity, uint32_t line,
+ *     uint16_t length + file name, uint16_t length + format.
+ *   - Event record: 'E', uint32_t id, uint64_t time (usec since epoch), uint8_t number of
+ *     arguments, and per argument a tag followed by the value:
+ *     'i' int64_t, 'u' uint64_t, 'd' double, 'b' uint8_t, 's' uint16_t length + characters.
+ *     Arguments which do not fit in BINARY_RECORD_MAX_LEN are truncated.
+ *
+ * The format record of a call site is written by the writer thread, from the registry of the call
+ * sites, before the first event record of the call site in each file. Events logged by several
+ * threads therefore never reach the file before the format they refer to.
+ */
+constexpr char BINARY_MAGIC[]          = "BLOG";
+constexpr uint8_t BINARY_VERSION       = 1;
+constexpr size_t BINARY_RECORD_MAX_LEN = 512;
+
+/**
+ * Call site of a LOG_BINARY().
+ */
+struct binary_site {
+    constexpr binary_site(const char *file_, int line_, el::Level level_, int severity_,
+                          const char *format_)
+        : file(file_), line(line_), level(level_), severity(severity_), format(format_)
+    {
+    }
+
+    const char *file;
+    int line;
+    el::Level level;
+    int severity;
+    const char *format;
+
+    std::atomic<uint32_t> id{0}; // Set once registered
+};
+
+/**
+ * @brief Whether binary logging is enabled.
+ */
+bool binary_enabled();
+
+/**
+ * @brief Register a call site, on its first binary log.
+ *
+ * @param site Call site, which must outlive the binary logging.
+ * @return Id of the call site.
+ */
+uint32_t register_binary_site(binary_site &site);
+
+/**
+ * @brief Queue a binary record to the log file.
+ *
+ * @param data Record.
+ * @param len Length of the record.
+ * @param block Wait for room in the queue instead of dropping the record.
+ * @return false if the record was dropped.
+ */
+bool write_binary(const uint8_t *data, size_t len, bool block);
+
+/**
+ * Builder of a binary record, truncated to BINARY_RECORD_MAX_LEN.
+ */
+class binary_record {
+public:
+    binary_record() { put_raw(uint16_t(0)); }
+
+    /**
+     * @brief Get the record, with its length set.
+     */
+    const uint8_t *data()
+    {
+        auto len = uint16_t(m_size);
+        std::memcpy(m_buf, &len, sizeof(len));
+        return m_buf;
+    }
+
+    size_t size() const { return m_size; }
+
+    template <typename T> void put_raw(const T &value)
+    {
+        if (m_size + sizeof(value) <= sizeof(m_buf)) {
+            std::memcpy(m_buf + m_size, &value, sizeof(value));
+            m_size += sizeof(value);
+        }
+    }
+
+    void put_string(const char *str, size_t len)
+    {
+        auto room = (m_size + sizeof(uint16_t) < sizeof(m_buf))
+                        ? sizeof(m_buf) - m_size - sizeof(uint16_t)
+                        : 0;
+        len = std::min(std::min(len, room), size_t(UINT16_MAX));
+        put_raw(uint16_t(len));
+        std::memcpy(m_buf + m_size, str, len);
+        m_size += len;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_same<T, bool>::value>::type put_arg(const T &value)
+    {
+        put_raw('b');
+        put_raw(uint8_t(value));
+    }
+
+    template <typename T>
+    typename std::enable_if<(std::is_integral<T>::value && std::is_signed<T>::value) ||
+                            std::is_enum<T>::value>::type
+    put_arg(const T &value)
+    {
+        put_raw('i');
+        put_raw(int64_t(value));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value &&
+                            !std::is_same<T, bool>::value>::type
+    put_arg(const T &value)
+    {
+        put_raw('u');
+        put_raw(uint64_t(value));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type put_arg(const T &value)
+    {
+        put_raw('d');
+        put_raw(double(value));
+    }
+
+    void put_arg(const char *value)
+    {
+        put_raw('s');
+        put_string(value, value ? std::strlen(value) : 0);
+    }
+
+    void put_arg(const std::string &value)
+    {
+        put_raw('s');
+        put_string(value.data(), value.size());
+    }
+
+    void put_args() {}
+
+    template <typename T, typename... Args> void put_args(const T &arg, const Args &... args)
+    {
+        put_arg(arg);
+        put_args(args...);
+    }
+
+private:
+    uint8_t m_buf[BINARY_RECORD_MAX_LEN];
+    size_t m_size = 0;
+};
+
+/**
+ * @brief Write the text of a binary log, replacing each {} of the format with an argument.
+ */
+inline void format_text(std::ostream &os, const char *format)
+{
+    os << format;
+}
+
+template <typename T, typename... Args>
+void format_text(std::ostream &os, const char *format, const T &arg, const Args &... args)
+{
+    auto placeholder = std::strstr(format, "{}");
+    if (!placeholder) {
+        os << format;
+        return;
+    }
+    os.write(format, placeholder - format);
+    os << arg;
+    format_text(os, placeholder + 2, args...);
+}
+
+template <typename... Args>
+void log_binary(binary_site &site, const char *func, const Args &... args)
+{
+    if (!binary_enabled()) {
+        std::stringstream text;
+        format_text(text, site.format, args...);
+        el::base::Writer(site.level, site.file, site.line, func)
+                .construct(1, ELPP_CURR_FILE_LOGGER_ID)
+            << text.str();
+        return;
+    }
+
+    uint32_t id = site.id.load(std::memory_order_acquire);
+    if (!id) {
+        id = register_binary_site(site);
+    }
+
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+                   .count();
+
+    binary_record record;
+    record.put_raw('E');
+    record.put_raw(id);
+    record.put_raw(uint64_t(now));
+    record.put_raw(uint8_t(sizeof...(args)));
+    record.put_args(args...);
+    write_binary(record.data(), record.size(),
+                 site.level == el::Level::Error || site.level == el::Level::Fatal);
+}
+
+} // namespace log
+} // namespace beerocks
+
+#endif // _BEEROCKS_LOG_H_
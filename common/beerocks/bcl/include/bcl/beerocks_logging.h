@@ -94,6 +94,16 @@ public:
     bool get_log_files_auto_roll();
     bool get_stdout_enabled();
     bool get_syslog_enabled();
+    bool get_async_enabled();
+    uint32_t get_cmdu_trace_records();
+
+    /**
+     * @brief Start tracing the CMDUs of the process into the /prplmesh_trace.<module name> shared
+     * memory segment, if enabled by log_cmdu_trace_records (see mapf/common/cmdu_trace.h).
+     *
+     * @return true if tracing is started, false if disabled or on failure.
+     */
+    bool start_cmdu_trace();
 
     void set_log_level_state(const eLogLevel &log_level, const bool &new_state);
 
@@ -108,6 +118,7 @@ protected:
     bool save_settings(const std::string &config_file_path);
 
     void set_log_path(std::string log_path);
+    std::string resolve_log_filepath();
     void eval_settings();
 
     static void handle_logging_rollover(const char *, std::size_t);
@@ -128,6 +139,15 @@ private:
     bool m_stdout_enabled = true;
     bool m_syslog_enabled = false;
 
+    // Asynchronous logging, see AsyncLogSink
+    bool m_async_enabled           = false;
+    size_t m_async_queue_size      = 0;
+    bool m_async_block_on_overflow = false;
+    bool m_binary_enabled          = false;
+
+    // Size of the CMDU trace ring buffer, 0 if disabled
+    uint32_t m_cmdu_trace_records = 0;
+
     settings_t m_settings_map;
 };
 
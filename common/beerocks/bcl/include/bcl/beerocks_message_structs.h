@@ -20,6 +20,7 @@ typedef struct {
     uint8_t dst_bridge_mac[net::MAC_ADDR_LEN] = {};
     uint8_t src_bridge_mac[net::MAC_ADDR_LEN] = {};
     uint16_t length                           = 0;
+    uint32_t trace_id                         = 0; // CMDU trace id of the message, 0 if none
 } __attribute__((packed)) sUdsHeader;
 
 //////////////////// tlvf includes /////////////////////////////
@@ -0,0 +1,283 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BEEROCKS_METRICS_H_
+#define _BEEROCKS_METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace beerocks {
+namespace metrics {
+
+/**
+ * Runtime metrics of the process: counters, gauges and latency histograms.
+ *
+ * Metrics are registered once (registration takes a lock) and the returned references remain
+ * valid for the lifetime of the process, so the hot paths keep them and update them without
+ * locking. The registry is exported in the Prometheus text format, by the local metrics server
+ * (see beerocks_metrics_server.h) and the BML metrics query.
+ */
+
+typedef std::vector<std::pair<std::string, std::string>> labels_t;
+
+/**
+ * Monotonic counter, sharded per thread so that concurrent increments do not contend on the
+ * same cache line.
+ */
+class counter {
+public:
+    void inc(uint64_t value = 1)
+    {
+        m_shards[shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const;
+
+private:
+    static constexpr size_t SHARDS     = 16;
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct sShard {
+        std::atomic<uint64_t> value{0};
+        char padding[CACHE_LINE - sizeof(std::atomic<uint64_t>)];
+    };
+
+    // Index of the shard of the calling thread, threads are assigned shards round robin
+    static size_t shard_index();
+
+    sShard m_shards[SHARDS];
+};
+
+/**
+ * Value which may go up and down, such as a queue depth.
+ */
+class gauge {
+public:
+    void set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+    void add(int64_t value) { m_value.fetch_add(value, std::memory_order_relaxed); }
+    int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_value{0};
+};
+
+/**
+ * Latency histogram with log-linear buckets (HDR style), in microseconds.
+ *
+ * Each power of two range is split into SUB_BUCKETS linear buckets, so the relative error of
+ * a recorded value is below 1 / SUB_BUCKETS over the whole range, with a fixed number of
+ * buckets. Values above the last bucket are counted in it.
+ */
+class histogram {
+public:
+    static constexpr size_t SUB_BUCKETS_BITS = 2;
+    static constexpr size_t SUB_BUCKETS      = 1 << SUB_BUCKETS_BITS;
+    static constexpr size_t NUM_BUCKETS      = 128; // Up to 2^33 usec (~2.4 hours)
+
+    void observe(uint64_t usec)
+    {
+        m_buckets[bucket_index(usec)].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(usec, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Bucket of a value.
+     */
+    static size_t bucket_index(uint64_t usec);
+
+    /**
+     * @brief Exclusive upper bound of the values of a bucket, in microseconds.
+     */
+    static uint64_t bucket_upper_bound(size_t index);
+
+    struct sSnapshot {
+        uint64_t buckets[NUM_BUCKETS];
+        uint64_t count;
+        uint64_t sum;
+
+        /**
+         * @brief Estimate a quantile of the recorded values.
+         *
+         * @param quantile Quantile, between 0 and 1.
+         * @return Upper bound of the bucket of the quantile in microseconds, 0 if empty.
+         */
+        uint64_t quantile(double quantile) const;
+    };
+
+    /**
+     * @brief Read the histogram, while it may be updated.
+     *
+     * The buckets, count and sum are read one after the other, so they may be off by the
+     * values recorded during the read.
+     */
+    void snapshot(sSnapshot &snapshot) const;
+
+private:
+    std::atomic<uint64_t> m_buckets[NUM_BUCKETS] = {};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+};
+
+/**
+ * Records the time elapsed from its construction to its destruction into a histogram.
+ */
+class scoped_timer {
+public:
+    explicit scoped_timer(histogram &histogram)
+        : m_histogram(histogram), m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~scoped_timer()
+    {
+        m_histogram.observe(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - m_start)
+                                .count());
+    }
+
+private:
+    histogram &m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Registry of the metrics of the process.
+ *
+ * A metric is identified by its name and its labels. Getting a registered metric returns the
+ * existing instance, so modules may get the same metric independently.
+ */
+class registry {
+public:
+    static registry &instance();
+
+    /**
+     * @brief Get a counter, registering it on first use.
+     *
+     * @param name Metric name, in the Prometheus naming convention (beerocks_..._total).
+     * @param help Description of the metric.
+     * @param labels Labels of the metric instance.
+     * @return The counter, a detached instance if the name is registered with another type.
+     */
+    counter &get_counter(const std::string &name, const std::string &help,
+                         const labels_t &labels = labels_t());
+
+    /**
+     * @brief Get a gauge, registering it on first use.
+     *
+     * @see get_counter()
+     */
+    gauge &get_gauge(const std::string &name, const std::string &help,
+                     const labels_t &labels = labels_t());
+
+    /**
+     * @brief Get a latency histogram, registering it on first use.
+     *
+     * Histograms are exported in seconds, the name should end with _seconds.
+     *
+     * @see get_counter()
+     */
+    histogram &get_histogram(const std::string &name, const std::string &help,
+                             const labels_t &labels = labels_t());
+
+    /**
+     * @brief Write all the metrics in the Prometheus text exposition format (version 0.0.4).
+     *
+     * Only the non empty buckets of the histograms are written, the cumulative counts of the
+     * omitted buckets are those of the preceding written bucket.
+     */
+    void write_prometheus(std::ostream &os) const;
+
+    std::string to_prometheus() const;
+
+private:
+    registry() {}
+
+    enum class eType { COUNTER, GAUGE, HISTOGRAM };
+
+    struct sFamily {
+        eType type;
+        std::string help;
+        // By formatted labels, only the map of the type of the family is used
+        std::map<std::string, std::unique_ptr<counter>> counters;
+        std::map<std::string, std::unique_ptr<gauge>> gauges;
+        std::map<std::string, std::unique_ptr<histogram>> histograms;
+    };
+
+    sFamily *get_family(const std::string &name, const std::string &help, eType type);
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, sFamily> m_families;
+};
+
+/**
+ * Histograms of a metric by a key, such as a message type, for the hot path of a single
+ * thread. The histogram of a key is taken from the registry the first time the key is seen,
+ * and then looked up locally without locking.
+ */
+template <typename Key = uint32_t> class histogram_map {
+public:
+    histogram_map(const std::string &name, const std::string &help) : m_name(name), m_help(help)
+    {
+    }
+
+    /**
+     * @brief Get the histogram of a key.
+     *
+     * @param key Key of the histogram.
+     * @param make_labels Returns the labels_t of the key, only called the first time.
+     */
+    template <typename LabelsFunc> histogram &get(const Key &key, const LabelsFunc &make_labels)
+    {
+        auto it = m_histograms.find(key);
+        if (it != m_histograms.end()) {
+            return *it->second;
+        }
+
+        auto &new_histogram = registry::instance().get_histogram(m_name, m_help, make_labels());
+        m_histograms[key]   = &new_histogram;
+        return new_histogram;
+    }
+
+private:
+    const std::string m_name;
+    const std::string m_help;
+    std::unordered_map<Key, histogram *> m_histograms;
+};
+
+/**
+ * @brief Histogram of the handling time of a received IEEE 1905.1 CMDU.
+ *
+ * @param handle_time Histograms of the handling time of the thread.
+ * @param message_type CMDU message type.
+ */
+histogram &cmdu_handle_time(histogram_map<> &handle_time, uint16_t message_type);
+
+/**
+ * @brief Histogram of the handling time of a received vendor specific CMDU.
+ *
+ * @param handle_time Histograms of the handling time of the thread.
+ * @param action Beerocks action of the message.
+ * @param action_op Action op of the message.
+ */
+histogram &cmdu_handle_time(histogram_map<> &handle_time, uint8_t action, uint8_t action_op);
+
+} // namespace metrics
+} // namespace beerocks
+
+#endif // _BEEROCKS_METRICS_H_
@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BEEROCKS_METRICS_SERVER_H_
+#define _BEEROCKS_METRICS_SERVER_H_
+
+#include "beerocks_thread_base.h"
+#include "network/socket.h"
+
+#include <memory>
+
+namespace beerocks {
+
+/**
+ * Minimal HTTP server exposing the metrics registry of the process in the Prometheus text
+ * format on http://127.0.0.1:<port>/metrics, for a local scraper or exporter.
+ *
+ * Requests are served one at a time by the server thread, only GET is supported.
+ */
+class metrics_server : public thread_base {
+public:
+    explicit metrics_server(int port);
+    virtual ~metrics_server();
+
+    /**
+     * @brief Start a metrics server on the port of the configuration file.
+     *
+     * @param port metrics_port of the configuration file, empty or 0 disables the server.
+     * @param port_offset Added to the port, for the processes started per radio.
+     * @return The running server, nullptr if disabled or on failure.
+     */
+    static std::unique_ptr<metrics_server> start_from_config(const std::string &port,
+                                                             int port_offset = 0);
+
+protected:
+    virtual bool init() override;
+    virtual bool work() override;
+
+private:
+    void handle_request(Socket *sd);
+    bool send_response(Socket *sd, const std::string &status, const std::string &body);
+
+    static constexpr int SELECT_TIMEOUT_MSC  = 500;
+    static constexpr long READ_TIMEOUT_MSC   = 1000;
+    static constexpr size_t MAX_REQUEST_SIZE = 1024;
+
+    const int m_port;
+    std::unique_ptr<SocketServer> m_server_socket;
+    SocketSelect m_select;
+};
+
+} // namespace beerocks
+
+#endif // _BEEROCKS_METRICS_SERVER_H_
@@ -10,7 +10,7 @@
 #define _BEEROCKS_PROMISE_H_
 
 #include "../../common/include/mapf/common/err.h"
-#include <easylogging++.h>
+#include "beerocks_log.h"
 #include <pthread.h>
 #include <sys/time.h>
 
@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BEEROCKS_SHARED_OBJECT_POOL_H_
+#define _BEEROCKS_SHARED_OBJECT_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace beerocks {
+
+/**
+ * Pool of objects handed out as shared pointers.
+ *
+ * An object returns to the pool once every user released its shared pointer, and is handed
+ * out again as is: the caller of get() is responsible for resetting it. Objects are only
+ * allocated while the pool is smaller than its maximal size, then get() falls back to plain
+ * allocations.
+ *
+ * get() must always be called from the same thread, the objects may be released from any
+ * thread.
+ */
+template <typename T> class shared_object_pool {
+public:
+    explicit shared_object_pool(size_t max_size) : m_max_size(max_size) {}
+
+    std::shared_ptr<T> get()
+    {
+        for (size_t i = 0; i < m_objects.size(); i++) {
+            auto &object = m_objects[m_next];
+            m_next       = (m_next + 1) % m_objects.size();
+
+            // Only the pool holds the object, synchronize with its last release
+            if (object.use_count() == 1) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return object;
+            }
+        }
+
+        auto object = std::make_shared<T>();
+        if (m_objects.size() < m_max_size) {
+            m_objects.push_back(object);
+        }
+        return object;
+    }
+
+    size_t size() const { return m_objects.size(); }
+
+private:
+    const size_t m_max_size;
+    size_t m_next = 0;
+    std::vector<std::shared_ptr<T>> m_objects;
+};
+
+} // namespace beerocks
+
+#endif // _BEEROCKS_SHARED_OBJECT_POOL_H_
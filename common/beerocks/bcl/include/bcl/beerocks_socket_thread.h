@@ -10,6 +10,7 @@
 #define _BEEROCKS_SOCKET_THREAD_H_
 
 #include "beerocks_message_structs.h"
+#include "beerocks_metrics.h"
 #include "beerocks_thread_base.h"
 #include "network/socket.h"
 
@@ -68,6 +69,16 @@ private:
     bool handle_cmdu_message_uds(Socket *sd);
     bool verify_cmdu(message::sUdsHeader *uds_header);
 
+    /**
+     * @brief Handle the parsed cmdu_rx in the CMDU trace scope of its trace id, recording its
+     * reception.
+     *
+     * @param sd Socket the CMDU was received on, nullptr if received from the local bus.
+     * @param uds_header UDS header of the CMDU, which carries its trace id.
+     * @return The result of handle_cmdu().
+     */
+    bool handle_cmdu_traced(Socket *sd, message::sUdsHeader *uds_header);
+
     uint8_t rx_buffer[message::MESSAGE_BUFFER_LENGTH];
     uint8_t tx_buffer[message::MESSAGE_BUFFER_LENGTH];
     uint8_t cert_tx_buffer[message::MESSAGE_BUFFER_LENGTH];
@@ -80,6 +91,10 @@ private:
 
     int server_max_connections;
     SocketSelect select;
+
+    // Transport queues depth, registered by init() with the name of the thread
+    metrics::gauge *m_ready_events     = nullptr; // Sockets (and bus) ready on the last wake up
+    metrics::gauge *m_rx_pending_bytes = nullptr; // Left in a UDS socket after reading a message
 };
 
 } // namespace beerocks
@@ -0,0 +1,85 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BEEROCKS_SPSC_QUEUE_H_
+#define _BEEROCKS_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace beerocks {
+
+/**
+ * Bounded lock-free FIFO queue, for one producer thread and one consumer thread.
+ * The producer and the consumer may also be the same thread.
+ */
+template <typename T> class spsc_queue {
+public:
+    explicit spsc_queue(size_t capacity) : m_items(capacity + 1) {}
+
+    /**
+     * @brief Push an item, called by the producer only.
+     *
+     * @param item Item to push.
+     * @return false if the queue is full.
+     */
+    bool push(T &&item)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto next = increment(tail);
+        if (next == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        m_items[tail] = std::move(item);
+        m_tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop all the queued items, called by the consumer only.
+     *
+     * @param items Vector to append the popped items to.
+     * @return Number of popped items.
+     */
+    size_t pop_all(std::vector<T> &items)
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto tail = m_tail.load(std::memory_order_acquire);
+
+        size_t count = 0;
+        for (; head != tail; head = increment(head), count++) {
+            items.push_back(std::move(m_items[head]));
+            m_items[head] = T();
+        }
+
+        m_head.store(head, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return m_items.size() - 1; }
+
+private:
+    size_t increment(size_t index) const { return (index + 1 == m_items.size()) ? 0 : index + 1; }
+
+    // One slot is kept empty to tell a full queue from an empty one
+    std::vector<T> m_items;
+
+    std::atomic<size_t> m_head{0}; // next item to pop, owned by the consumer
+    std::atomic<size_t> m_tail{0}; // next free slot, owned by the producer
+};
+
+} // namespace beerocks
+
+#endif // _BEEROCKS_SPSC_QUEUE_H_
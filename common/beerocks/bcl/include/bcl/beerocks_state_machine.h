@@ -13,7 +13,7 @@
 #include <list>
 #include <unordered_map>
 
-#include <easylogging++.h>
+#include "beerocks_log.h"
 
 namespace beerocks {
 
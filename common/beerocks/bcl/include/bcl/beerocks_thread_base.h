@@ -9,7 +9,7 @@
 #ifndef _BEEROCKS_THREAD_BASE_H_
 #define _BEEROCKS_THREAD_BASE_H_
 
-#define THREAD_LOG(a) (LOG(a) << get_name() << ": ")
+#define THREAD_LOG(a) LOG(a) << get_name() << ": "
 
 #include <atomic>
 #include <string>
@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BEEROCKS_WORKER_POOL_H_
+#define _BEEROCKS_WORKER_POOL_H_
+
+#include "beerocks_thread_base.h"
+#include "beerocks_thread_safe_queue.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace beerocks {
+
+/**
+ * Bounded pool of worker threads executing jobs from a shared queue.
+ * Jobs must not access state owned by other threads, any input they need
+ * should be copied into the job when it is created.
+ */
+class worker_pool {
+public:
+    typedef std::function<void()> job_t;
+
+    explicit worker_pool(size_t max_pending_jobs = 256) : m_max_pending_jobs(max_pending_jobs) {}
+    ~worker_pool();
+
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param workers_num Number of worker threads.
+     * @param name Name prefix of the worker threads.
+     * @return true on success, false otherwise.
+     */
+    bool start(size_t workers_num, const std::string &name = "worker");
+
+    /**
+     * @brief Stop the worker threads, jobs that were not started yet are dropped.
+     */
+    void stop();
+
+    /**
+     * @brief Queue a job for execution by one of the worker threads.
+     *
+     * @param job Job to execute.
+     * @return false if the pool is not started or the pending jobs limit is reached.
+     */
+    bool enqueue(const job_t &job);
+
+    size_t workers_num() const { return m_workers.size(); }
+    size_t pending_jobs() const { return m_pending_jobs; }
+
+private:
+    class worker : public thread_base {
+    public:
+        explicit worker(worker_pool &pool) : m_pool(pool) {}
+        virtual ~worker() {}
+
+    protected:
+        virtual bool init() override { return true; }
+        virtual bool work() override;
+
+    private:
+        worker_pool &m_pool;
+    };
+
+    thread_safe_queue<job_t> m_jobs;
+    std::atomic<size_t> m_pending_jobs{0};
+    const size_t m_max_pending_jobs;
+    std::vector<std::unique_ptr<worker>> m_workers;
+};
+
+} // namespace beerocks
+
+#endif // _BEEROCKS_WORKER_POOL_H_
@@ -40,8 +40,9 @@ namespace beerocks {
 namespace net {
 
 enum eNetworkStructsConsts {
-    MAC_ADDR_LEN = 6,
-    IP_ADDR_LEN  = 4,
+    MAC_ADDR_LEN        = 6,
+    MAC_ADDR_STRING_LEN = 17, // "xx:xx:xx:xx:xx:xx", without the null terminator
+    IP_ADDR_LEN         = 4,
 };
 
 typedef struct sIpv4Addr {
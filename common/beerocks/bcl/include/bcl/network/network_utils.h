@@ -12,9 +12,9 @@
 #include "../beerocks_os_utils.h"
 #include "socket.h"
 
+#include "../beerocks_log.h"
 #include "net_struct.h"
 #include <cstdint>
-#include <easylogging++.h>
 #include <string>
 #include <vector>
 
@@ -83,9 +83,26 @@ public:
     static std::string mac_to_string(const sMacAddr &mac);
     static std::string mac_to_string(const uint8_t *mac_address);
 
+    /**
+     * @brief Format a mac address as "xx:xx:xx:xx:xx:xx", without allocating.
+     *
+     * @param[in] mac_address Mac address, MAC_ADDR_LEN bytes.
+     * @param[out] buf Formatted mac address, null terminated.
+     */
+    static void mac_to_string(const uint8_t *mac_address, char (&buf)[MAC_ADDR_STRING_LEN + 1]);
+
     static sMacAddr mac_from_string(const std::string &mac);
     static void mac_from_string(uint8_t *buf, const std::string &mac);
 
+    /**
+     * @brief Parse a "xx:xx:xx:xx:xx:xx" mac address, in lower or upper case.
+     *
+     * @param[in] str Null terminated string.
+     * @param[out] mac Parsed mac address, unchanged on failure.
+     * @return false if the string is not a mac address.
+     */
+    static bool parse_mac(const char *str, sMacAddr &mac);
+
     static bool is_valid_mac(std::string mac);
 
     static std::string ipv4_to_string(const net::sIpv4Addr &ip);
@@ -139,12 +156,16 @@ public:
 
 inline std::ostream &operator<<(std::ostream &os, const sMacAddr &addr)
 {
-    return os << beerocks::net::network_utils::mac_to_string(addr);
+    char buf[beerocks::net::MAC_ADDR_STRING_LEN + 1];
+    beerocks::net::network_utils::mac_to_string(addr.oct, buf);
+    return os << buf;
 }
 
 inline el::base::MessageBuilder &operator<<(el::base::MessageBuilder &log, const sMacAddr &addr)
 {
-    return log << beerocks::net::network_utils::mac_to_string(addr);
+    char buf[beerocks::net::MAC_ADDR_STRING_LEN + 1];
+    beerocks::net::network_utils::mac_to_string(addr.oct, buf);
+    return log << buf;
 }
 
 #endif //_NETWORK_UTILS_H_
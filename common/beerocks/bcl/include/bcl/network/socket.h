@@ -107,7 +107,9 @@ public:
     SocketServer() {}
     SocketServer(const std::string &uds_path, int connections,
                  SocketMode mode = SocketModeBlocking);
-    SocketServer(int port, int connections, SocketMode mode = SocketModeBlocking);
+    // Listens on all the interfaces, unless bind_ip is set
+    SocketServer(int port, int connections, SocketMode mode = SocketModeBlocking,
+                 const std::string &bind_ip = std::string());
     Socket *acceptConnections();
 };
 
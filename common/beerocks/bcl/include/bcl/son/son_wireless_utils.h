@@ -107,16 +107,36 @@ public:
         std::vector<beerocks::message::sWifiChannel> channels;
     } sChannelPreference;
 
+    // The estimations log their inputs and results unless verbose is false,
+    // which is required when they run outside of a beerocks thread (task workers)
     static sPhyUlParams
     estimate_ul_params(int ul_rssi, uint16_t sta_phy_tx_rate_100kb,
                        const beerocks::message::sRadioCapabilities *capabilities,
-                       beerocks::eWiFiBandwidth ap_bw, bool is_5ghz);
-    static int estimate_dl_rssi(int ul_rssi, int tx_power, const sPhyApParams &ap_params);
+                       beerocks::eWiFiBandwidth ap_bw, bool is_5ghz, bool verbose = true);
+    static int estimate_dl_rssi(int ul_rssi, int tx_power, const sPhyApParams &ap_params,
+                                bool verbose = true);
     static double estimate_ap_tx_phy_rate(int estimated_dl_rssi,
                                           const beerocks::message::sRadioCapabilities *capabilities,
-                                          beerocks::eWiFiBandwidth ap_bw, bool is_5ghz);
+                                          beerocks::eWiFiBandwidth ap_bw, bool is_5ghz,
+                                          bool verbose = true);
 
     static double get_load_max_bit_rate_mbps(double phy_rate_100kb);
+
+    /**
+     * @brief Convert a signal level in dB to the linear (watt) domain, using a lookup table.
+     *
+     * @param db Signal level in dB.
+     * @return pow(10, db / 10).
+     */
+    static float db_to_watt(int8_t db);
+
+    /**
+     * @brief Convert a signal level in the linear (watt) domain to dB, using a lookup table.
+     *
+     * @param watt Signal level in the linear domain.
+     * @return 10 * log10(watt) rounded to the nearest dB, clamped to the int8_t range.
+     */
+    static int8_t watt_to_db(float watt);
     static bool get_mcs_from_rate(const uint16_t rate, const beerocks::eWiFiAntMode ant_mode,
                                   const beerocks::eWiFiBandwidth bw, uint8_t &mcs,
                                   uint8_t &short_gi);
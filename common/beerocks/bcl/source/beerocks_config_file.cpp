@@ -28,7 +28,12 @@ static bool read_log_section(std::string config_file_path, config_file::SConfigL
         std::make_tuple("log_files_path=", &sLogConf.files_path, mandatory),
         std::make_tuple("log_files_auto_roll=", &sLogConf.files_auto_roll, mandatory),
         std::make_tuple("log_stdout_enabled=", &sLogConf.stdout_enabled, mandatory),
-        std::make_tuple("log_syslog_enabled=", &sLogConf.syslog_enabled, optional)};
+        std::make_tuple("log_syslog_enabled=", &sLogConf.syslog_enabled, optional),
+        std::make_tuple("log_async_enabled=", &sLogConf.async_enabled, optional),
+        std::make_tuple("log_async_queue_size=", &sLogConf.async_queue_size, optional),
+        std::make_tuple("log_async_overflow=", &sLogConf.async_overflow, optional),
+        std::make_tuple("log_binary_enabled=", &sLogConf.binary_enabled, optional),
+        std::make_tuple("log_cmdu_trace_records=", &sLogConf.cmdu_trace_records, optional)};
 
     std::string section = "log";
     bool ret_val        = config_file::read_config_file(config_file_path, log_conf_args, section);
@@ -51,6 +56,7 @@ bool config_file::read_master_config_file(std::string config_file_path, sConfigM
         std::make_tuple("vendor=", &conf.vendor, mandatory_master),
         std::make_tuple("model=", &conf.model, mandatory_master),
         std::make_tuple("ucc_listener_port=", &conf.ucc_listener_port, mandatory_master),
+        std::make_tuple("metrics_port=", &conf.metrics_port, 0),
         std::make_tuple("load_dfs_reentry=", &conf.load_dfs_reentry, 0),
         std::make_tuple("load_client_band_steering=", &conf.load_client_band_steering,
                         mandatory_master),
@@ -70,6 +76,7 @@ bool config_file::read_master_config_file(std::string config_file_path, sConfigM
         std::make_tuple("load_health_check=", &conf.load_health_check, 0),
         std::make_tuple("load_monitor_on_vaps=", &conf.load_monitor_on_vaps, 0),
         std::make_tuple("load_rdkb_extensions=", &conf.load_rdkb_extensions, 0),
+        std::make_tuple("load_topology_snapshot=", &conf.load_topology_snapshot, 0),
         std::make_tuple("global_restricted_channels=", &conf.global_restricted_channels, 0),
         std::make_tuple("diagnostics_measurements_polling_rate_sec=",
                         &conf.diagnostics_measurements_polling_rate_sec, 0),
@@ -129,6 +136,7 @@ bool config_file::read_master_config_file(std::string config_file_path, sConfigM
                         mandatory_master),
         std::make_tuple("credentials_change_timeout_sec=", &conf.credentials_change_timeout_sec,
                         mandatory_master),
+        std::make_tuple("task_worker_threads=", &conf.task_worker_threads, 0),
     };
 
     bool ret_val = (read_config_file(config_file_path, master_conf_args, config_type) &&
@@ -151,6 +159,7 @@ bool config_file::read_slave_config_file(std::string config_file_path, sConfigSl
             std::make_tuple("vendor=", &conf.vendor, mandatory_slave),
             std::make_tuple("model=", &conf.model, mandatory_slave),
             std::make_tuple("ucc_listener_port=", &conf.ucc_listener_port, mandatory_slave),
+            std::make_tuple("metrics_port=", &conf.metrics_port, 0),
             std::make_tuple("enable_arp_monitor=", &conf.enable_arp_monitor, mandatory_slave),
             std::make_tuple("enable_keep_alive=", &conf.enable_keep_alive, mandatory_slave),
             std::make_tuple("debug_disable_arp=", &conf.debug_disable_arp, 0),
@@ -6,19 +6,30 @@
  * See LICENSE file for more details.
  */
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_logging.h>
 #include <bcl/beerocks_os_utils.h>
 #include <bcl/network/socket.h>
 
+#include <mapf/common/cmdu_trace.h>
+
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
 #include <iostream>
 #include <linux/limits.h>
+#include <memory>
+#include <mutex>
+#include <syslog.h>
+#include <thread>
 #include <unistd.h>
-
-#include <easylogging++.h>
+#include <vector>
 
 #define LOG_MAX_LEVELS 6
 #define LOGGING_DEFAULT_MAX_SIZE (size_t)100000
+#define LOGGING_DEFAULT_ASYNC_QUEUE_SIZE (size_t)65536
+#define LOGGING_MIN_ASYNC_QUEUE_SIZE (size_t)4096
 
 class RollMonitor : public el::LogDispatchCallback {
 public:
@@ -123,6 +134,654 @@ private:
     std::string m_module_name;
 };
 
+/**
+ * Byte ring buffer of pre-formatted log records, written by a single logging thread and read by
+ * the AsyncLogSink writer thread.
+ *
+ * Each record is an sRecordHeader followed by the log line and the syslog line. The positions
+ * are free running byte counters, wrapped around the buffer size on access.
+ */
+class LogRing {
+public:
+    enum eFlags : uint8_t {
+        FLAG_TO_FILE   = 0x01,
+        FLAG_TO_STDOUT = 0x02,
+        FLAG_TO_SYSLOG = 0x04,
+        FLAG_BINARY    = 0x08, // The line is a binary record (see beerocks_log.h)
+    };
+
+    struct sRecordHeader {
+        uint32_t line_len;
+        uint32_t syslog_line_len;
+        uint8_t flags;
+        uint8_t syslog_priority;
+    };
+
+    explicit LogRing(size_t size) : m_buf(size) {}
+
+    size_t size() const { return m_buf.size(); }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    bool half_full() const
+    {
+        return (m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire)) >
+               m_buf.size() / 2;
+    }
+
+    /**
+     * @brief Push a record, called by the owning logging thread only.
+     *
+     * @return false if the ring does not have room for the record.
+     */
+    bool push(const sRecordHeader &header, const char *line, const char *syslog_line)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto len  = sizeof(header) + header.line_len + header.syslog_line_len;
+        if (len > m_buf.size() - (tail - m_head.load(std::memory_order_acquire))) {
+            return false;
+        }
+
+        write(tail, &header, sizeof(header));
+        write(tail + sizeof(header), line, header.line_len);
+        write(tail + sizeof(header) + header.line_len, syslog_line, header.syslog_line_len);
+
+        m_tail.store(tail + len, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop all the queued records, called by the writer thread only.
+     *
+     * @param handler Called with the header, the log line and the syslog line of each record.
+     */
+    template <typename F> void pop_all(std::string &line, std::string &syslog_line, F handler)
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto tail = m_tail.load(std::memory_order_acquire);
+
+        while (head != tail) {
+            sRecordHeader header;
+            read(head, &header, sizeof(header));
+            head += sizeof(header);
+
+            line.resize(header.line_len);
+            read(head, &line[0], header.line_len);
+            head += header.line_len;
+
+            syslog_line.resize(header.syslog_line_len);
+            read(head, &syslog_line[0], header.syslog_line_len);
+            head += header.syslog_line_len;
+
+            handler(header, line, syslog_line);
+        }
+
+        m_head.store(head, std::memory_order_release);
+    }
+
+private:
+    void write(size_t pos, const void *data, size_t len)
+    {
+        auto offset = pos % m_buf.size();
+        auto first  = std::min(len, m_buf.size() - offset);
+        std::copy_n(static_cast<const char *>(data), first, &m_buf[offset]);
+        std::copy_n(static_cast<const char *>(data) + first, len - first, &m_buf[0]);
+    }
+
+    void read(size_t pos, void *data, size_t len) const
+    {
+        auto offset = pos % m_buf.size();
+        auto first  = std::min(len, m_buf.size() - offset);
+        std::copy_n(&m_buf[offset], first, static_cast<char *>(data));
+        std::copy_n(&m_buf[0], len - first, static_cast<char *>(data) + first);
+    }
+
+    std::vector<char> m_buf;
+
+    std::atomic<size_t> m_head{0}; // next record to pop, owned by the writer thread
+    std::atomic<size_t> m_tail{0}; // end of the last pushed record, owned by the logging thread
+};
+
+namespace beerocks {
+namespace log {
+// Call site of a binary log, by id (see register_binary_site())
+static const binary_site *get_binary_site(uint32_t id);
+} // namespace log
+} // namespace beerocks
+
+/**
+ * Asynchronous log sink, replacing the easylogging default dispatcher (which writes on the
+ * logging thread) when async logging is enabled.
+ *
+ * The log lines are formatted on the logging thread and queued in a LogRing owned by that thread,
+ * without any lock. A single writer thread drains the rings into the log file, stdout and syslog.
+ * When a ring is full, the record is dropped unless blocking on overflow is configured. Error and
+ * fatal records are never dropped, and fatal records are flushed before returning.
+ */
+class AsyncLogSink : public el::LogDispatchCallback {
+public:
+    struct sSettings {
+        bool to_file = false;
+        std::string file_path;
+        size_t rollover_size = 0;
+        void (*rollover_handler)(const char *, std::size_t) = nullptr;
+        size_t queue_size                                 = LOGGING_DEFAULT_ASYNC_QUEUE_SIZE;
+        bool block_on_overflow                            = false;
+        bool binary_enabled                               = false;
+        std::string binary_file_path;
+    };
+
+    // Sink of the binary records, if binary logging is enabled
+    static std::atomic<AsyncLogSink *> s_binary_sink;
+
+    ~AsyncLogSink()
+    {
+        auto self = this;
+        s_binary_sink.compare_exchange_strong(self, nullptr);
+        stop();
+    }
+
+    /**
+     * @brief Start the writer thread, or apply new settings if already running.
+     */
+    void start(const sSettings &settings)
+    {
+        {
+            std::lock_guard<std::mutex> io_lock(m_io_mutex);
+
+            if (m_file.is_open() &&
+                (!settings.to_file || settings.file_path != m_settings.file_path)) {
+                m_file.close();
+            }
+            if (m_binary_file.is_open() &&
+                (!settings.binary_enabled ||
+                 settings.binary_file_path != m_settings.binary_file_path)) {
+                m_binary_file.close();
+            }
+            m_settings = settings;
+            if (m_settings.to_file && !m_file.is_open()) {
+                open_file(std::ios::app);
+            }
+            if (m_settings.binary_enabled && !m_binary_file.is_open()) {
+                open_binary_file(std::ios::app);
+            }
+        }
+
+        m_to_file           = settings.to_file;
+        m_queue_size        = std::max(settings.queue_size, LOGGING_MIN_ASYNC_QUEUE_SIZE);
+        m_block_on_overflow = settings.block_on_overflow;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable()) {
+            m_running = true;
+            m_thread  = std::thread(&AsyncLogSink::run, this);
+        }
+    }
+
+    /**
+     * @brief Write the queued records and stop the writer thread.
+     */
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+        m_cv.notify_all();
+
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+
+        std::lock_guard<std::mutex> io_lock(m_io_mutex);
+        if (m_file.is_open()) {
+            m_file.close();
+        }
+        if (m_binary_file.is_open()) {
+            m_binary_file.close();
+        }
+    }
+
+    /**
+     * @brief Queue a binary record, see beerocks::log::write_binary().
+     */
+    bool push_binary(const uint8_t *data, size_t len, bool block)
+    {
+        if (!m_running) {
+            return false;
+        }
+
+        LogRing::sRecordHeader header = {};
+        header.flags                  = LogRing::FLAG_BINARY;
+        header.line_len               = len;
+        return push(header, reinterpret_cast<const char *>(data), nullptr, block);
+    }
+
+    /**
+     * @brief Wait until the records queued so far are written.
+     */
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+
+        auto request = ++m_flush_requested;
+        m_cv.notify_all();
+        m_flushed_cv.wait(lock, [&] { return m_flushed >= request || !m_running; });
+    }
+
+protected:
+    void handle(const el::LogDispatchData *data) override
+    {
+
+        //////////////////////////////
+        // DO NOT USE LOGGING HERE! //
+        //////////////////////////////
+
+        if (!m_running) {
+            return;
+        }
+
+        auto message = data->logMessage();
+        auto logger  = message->logger();
+        auto level   = message->level();
+        bool normal  = (data->dispatchAction() == el::base::DispatchAction::NormalLog);
+
+        LogRing::sRecordHeader header = {};
+        if (normal && m_to_file) {
+            header.flags |= LogRing::FLAG_TO_FILE;
+        }
+        if (normal && logger->typedConfigurations()->toStandardOutput(level)) {
+            header.flags |= LogRing::FLAG_TO_STDOUT;
+        }
+
+        std::string line;
+        if (header.flags) {
+            line = logger->logBuilder()->build(message, normal);
+        }
+
+        std::string syslog_line;
+#if defined(ELPP_SYSLOG)
+        if (!normal) {
+            header.flags |= LogRing::FLAG_TO_SYSLOG;
+            syslog_line = logger->logBuilder()->build(message, false);
+        } else if (logger->typedConfigurations()->toSyslog(level)) {
+            // Formatted with the syslog logger, as done by the default dispatcher
+            header.flags |= LogRing::FLAG_TO_SYSLOG;
+            el::LogMessage syslog_message(level, message->file(), message->line(),
+                                          message->func(), message->verboseLevel(),
+                                          el::Loggers::getLogger(el::base::consts::kSysLogLoggerId),
+                                          message->message());
+            syslog_line = syslog_message.logger()->logBuilder()->build(&syslog_message, false);
+        }
+        header.syslog_priority = get_syslog_priority(level);
+#endif
+
+        if (!header.flags) {
+            return;
+        }
+
+        // Truncate the records which could never fit in the ring
+        auto max_len = get_ring()->size() / 4;
+        if (line.size() > max_len) {
+            line.resize(max_len);
+        }
+        if (syslog_line.size() > max_len) {
+            syslog_line.resize(max_len);
+        }
+        header.line_len        = line.size();
+        header.syslog_line_len = syslog_line.size();
+
+        if (!push(header, line.data(), syslog_line.data(),
+                  level == el::Level::Error || level == el::Level::Fatal)) {
+            return;
+        }
+
+        if (level == el::Level::Fatal) {
+            flush();
+        }
+    }
+
+private:
+    static constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(50);
+
+    static uint8_t get_syslog_priority(el::Level level)
+    {
+        switch (level) {
+        case el::Level::Fatal:
+            return LOG_EMERG;
+        case el::Level::Error:
+            return LOG_ERR;
+        case el::Level::Warning:
+            return LOG_WARNING;
+        case el::Level::Info:
+            return LOG_INFO;
+        case el::Level::Debug:
+            return LOG_DEBUG;
+        default:
+            return LOG_NOTICE;
+        }
+    }
+
+    /**
+     * @brief Push a record to the ring of the calling thread.
+     *
+     * @param block Wait for room in the ring even if the overflow policy is to drop records.
+     * @return false if the record was dropped.
+     */
+    bool push(const LogRing::sRecordHeader &header, const char *line, const char *syslog_line,
+              bool block)
+    {
+        auto ring = get_ring();
+
+        block = block || m_block_on_overflow;
+        while (!ring->push(header, line, syslog_line)) {
+            if (!block || !m_running) {
+                m_dropped++;
+                return false;
+            }
+            m_cv.notify_one();
+            std::this_thread::yield();
+        }
+
+        if (ring->half_full()) {
+            m_cv.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get the ring of the calling thread, registered on first use.
+     */
+    LogRing *get_ring()
+    {
+        // Shared with the writer thread, which writes the remaining records once the owning
+        // thread exited
+        static thread_local std::shared_ptr<LogRing> ring;
+        if (!ring) {
+            ring = std::make_shared<LogRing>(m_queue_size);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_rings.push_back(ring);
+        }
+        return ring.get();
+    }
+
+    void open_file(std::ios::openmode mode)
+    {
+        m_file.open(m_settings.file_path, std::ios::out | mode);
+        if (!m_file.is_open()) {
+            std::cerr << "failed opening log file " << m_settings.file_path << std::endl;
+            return;
+        }
+        m_file.seekp(0, std::ios::end);
+        m_file_size = m_file.tellp();
+    }
+
+    void open_binary_file(std::ios::openmode mode)
+    {
+        m_binary_file.open(m_settings.binary_file_path, std::ios::out | std::ios::binary | mode);
+        if (!m_binary_file.is_open()) {
+            std::cerr << "failed opening binary log file " << m_settings.binary_file_path
+                      << std::endl;
+            return;
+        }
+        m_binary_file.seekp(0, std::ios::end);
+        m_binary_file_size = m_binary_file.tellp();
+        if (!m_binary_file_size) {
+            m_binary_file.write(beerocks::log::BINARY_MAGIC,
+                                sizeof(beerocks::log::BINARY_MAGIC) - 1);
+            m_binary_file.put(beerocks::log::BINARY_VERSION);
+            m_binary_file_size = m_binary_file.tellp();
+        }
+
+        // The formats are written again to the new file
+        m_binary_formats_written.clear();
+    }
+
+    /**
+     * @brief Write the format record of a call site, if not written to the file yet.
+     */
+    void write_binary_format(uint32_t id)
+    {
+        if (id < m_binary_formats_written.size() && m_binary_formats_written[id]) {
+            return;
+        }
+
+        auto site = beerocks::log::get_binary_site(id);
+        if (!site) {
+            return;
+        }
+
+        beerocks::log::binary_record record;
+        record.put_raw('F');
+        record.put_raw(id);
+        record.put_raw(uint8_t(site->severity));
+        record.put_raw(uint32_t(site->line));
+        record.put_string(site->file, std::strlen(site->file));
+        record.put_string(site->format, std::strlen(site->format));
+        m_binary_file.write(reinterpret_cast<const char *>(record.data()), record.size());
+        m_binary_file_size += record.size();
+
+        if (id >= m_binary_formats_written.size()) {
+            m_binary_formats_written.resize(id + 1);
+        }
+        m_binary_formats_written[id] = true;
+    }
+
+    void write_binary_record(const std::string &record)
+    {
+        if (!m_binary_file.is_open()) {
+            return;
+        }
+
+        // Event record: uint16_t length, 'E', uint32_t call site id
+        if (record.size() >= sizeof(uint16_t) + 1 + sizeof(uint32_t) &&
+            record[sizeof(uint16_t)] == 'E') {
+            uint32_t id;
+            std::memcpy(&id, &record[sizeof(uint16_t) + 1], sizeof(id));
+            write_binary_format(id);
+        }
+
+        m_binary_file.write(record.data(), record.size());
+        m_binary_file_size += record.size();
+
+        if (m_settings.rollover_size && m_binary_file_size >= m_settings.rollover_size) {
+            m_binary_file.close();
+            if (m_settings.rollover_handler) {
+                m_settings.rollover_handler(m_settings.binary_file_path.c_str(),
+                                            m_binary_file_size);
+            }
+            open_binary_file(std::ios::trunc);
+        }
+    }
+
+    void write_record(const LogRing::sRecordHeader &header, const std::string &line,
+                      const std::string &syslog_line)
+    {
+        if (header.flags & LogRing::FLAG_BINARY) {
+            write_binary_record(line);
+            return;
+        }
+
+        if ((header.flags & LogRing::FLAG_TO_FILE) && m_file.is_open()) {
+            m_file.write(line.data(), line.size());
+            m_file_size += line.size();
+
+            if (m_settings.rollover_size && m_file_size >= m_settings.rollover_size) {
+                m_file.close();
+                if (m_settings.rollover_handler) {
+                    m_settings.rollover_handler(m_settings.file_path.c_str(), m_file_size);
+                }
+                open_file(std::ios::trunc);
+            }
+        }
+        if (header.flags & LogRing::FLAG_TO_STDOUT) {
+            std::cout.write(line.data(), line.size());
+        }
+        if (header.flags & LogRing::FLAG_TO_SYSLOG) {
+            syslog(header.syslog_priority, "%s", syslog_line.c_str());
+        }
+    }
+
+    /**
+     * @brief Writer thread.
+     *
+     * The rings are only listed under m_mutex, they are drained and written with the I/O lock
+     * alone, so registering the ring of a new thread or requesting a flush never waits for the
+     * file writes, flushes and rollovers.
+     */
+    void run()
+    {
+        std::string line_buf;
+        std::string syslog_line_buf;
+        std::vector<std::shared_ptr<LogRing>> rings;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait_for(lock, DRAIN_INTERVAL,
+                          [&] { return !m_running || m_flush_requested != m_flushed; });
+            auto flush_requested = m_flush_requested;
+            bool running         = m_running;
+            rings                = m_rings;
+            lock.unlock();
+
+            {
+                std::lock_guard<std::mutex> io_lock(m_io_mutex);
+
+                for (auto &ring : rings) {
+                    ring->pop_all(line_buf, syslog_line_buf,
+                                  [&](const LogRing::sRecordHeader &header,
+                                      const std::string &line, const std::string &syslog_line) {
+                                      write_record(header, line, syslog_line);
+                                  });
+                }
+
+                auto dropped = m_dropped.exchange(0);
+                if (dropped && m_file.is_open()) {
+                    m_file << "WARNING " << dropped << " log messages dropped (queue full)\n";
+                }
+
+                if (m_file.is_open()) {
+                    m_file.flush();
+                }
+                if (m_binary_file.is_open()) {
+                    m_binary_file.flush();
+                }
+                std::cout.flush();
+            }
+            rings.clear();
+
+            lock.lock();
+
+            // Forget the rings of the threads which exited, once written
+            m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                         [](const std::shared_ptr<LogRing> &ring) {
+                                             return ring.use_count() == 1 && ring->empty();
+                                         }),
+                          m_rings.end());
+
+            m_flushed = flush_requested;
+            m_flushed_cv.notify_all();
+
+            if (!running) {
+                break;
+            }
+        }
+    }
+
+    // Settings read by the logging threads
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_to_file{false};
+    std::atomic<size_t> m_queue_size{LOGGING_DEFAULT_ASYNC_QUEUE_SIZE};
+    std::atomic<bool> m_block_on_overflow{false};
+    std::atomic<uint32_t> m_dropped{0};
+
+    // Protected by the mutex
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_flushed_cv;
+    std::thread m_thread;
+    std::vector<std::shared_ptr<LogRing>> m_rings;
+    uint64_t m_flush_requested = 0;
+    uint64_t m_flushed         = 0;
+
+    // Protected by the I/O mutex
+    std::mutex m_io_mutex;
+    sSettings m_settings;
+    std::ofstream m_file;
+    size_t m_file_size = 0;
+    std::ofstream m_binary_file;
+    size_t m_binary_file_size = 0;
+    std::vector<bool> m_binary_formats_written; // By call site id, for the current binary file
+};
+
+constexpr std::chrono::milliseconds AsyncLogSink::DRAIN_INTERVAL;
+std::atomic<AsyncLogSink *> AsyncLogSink::s_binary_sink{nullptr};
+
+//====================================================================================
+// beerocks::log
+//====================================================================================
+namespace beerocks {
+namespace log {
+
+// All the levels are enabled until the log settings are applied
+std::atomic<uint32_t> enabled_levels{UINT32_MAX};
+
+/**
+ * Registry of the binary logging call sites, the id of a site is its index + 1.
+ * Never destroyed, as the writer thread may still look up the sites during the static
+ * destruction.
+ */
+struct sBinarySites {
+    std::mutex mutex;
+    std::vector<const binary_site *> sites;
+};
+
+static sBinarySites &binary_sites()
+{
+    static auto registry = new sBinarySites;
+    return *registry;
+}
+
+bool binary_enabled() { return AsyncLogSink::s_binary_sink != nullptr; }
+
+uint32_t register_binary_site(binary_site &site)
+{
+    auto &registry = binary_sites();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Registered meanwhile by another thread
+    auto id = site.id.load(std::memory_order_relaxed);
+    if (!id) {
+        registry.sites.push_back(&site);
+        id = registry.sites.size();
+        site.id.store(id, std::memory_order_release);
+    }
+    return id;
+}
+
+static const binary_site *get_binary_site(uint32_t id)
+{
+    auto &registry = binary_sites();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return (id && id <= registry.sites.size()) ? registry.sites[id - 1] : nullptr;
+}
+
+bool write_binary(const uint8_t *data, size_t len, bool block)
+{
+    auto sink = AsyncLogSink::s_binary_sink.load();
+    return sink && sink->push_binary(data, len, block);
+}
+
+} // namespace log
+} // namespace beerocks
+
 static std::string log_level_to_string(const beerocks::eLogLevel &log_level)
 {
     std::string log_level_str;
@@ -345,6 +1004,20 @@ logging::logging(const beerocks::config_file::SConfigLog &settings, std::string
     } else {
         m_settings_map.insert({"log_syslog_enabled", "false"});
     }
+    m_settings_map.insert(
+        {"log_async_enabled", settings.async_enabled.empty() ? "false" : settings.async_enabled});
+    if (!settings.async_queue_size.empty()) {
+        m_settings_map.insert({"log_async_queue_size", settings.async_queue_size});
+    }
+    if (!settings.async_overflow.empty()) {
+        m_settings_map.insert({"log_async_overflow", settings.async_overflow});
+    }
+    if (!settings.binary_enabled.empty()) {
+        m_settings_map.insert({"log_binary_enabled", settings.binary_enabled});
+    }
+    if (!settings.cmdu_trace_records.empty()) {
+        m_settings_map.insert({"log_cmdu_trace_records", settings.cmdu_trace_records});
+    }
 
     eval_settings();
 }
@@ -425,6 +1098,20 @@ bool logging::get_stdout_enabled() { return m_stdout_enabled; }
 
 bool logging::get_syslog_enabled() { return m_syslog_enabled; }
 
+bool logging::get_async_enabled() { return m_async_enabled; }
+
+uint32_t logging::get_cmdu_trace_records() { return m_cmdu_trace_records; }
+
+bool logging::start_cmdu_trace()
+{
+    if (!m_cmdu_trace_records) {
+        return false;
+    }
+
+    // The segment is left behind on exit, for post mortem analysis, and replaced on restart
+    return mapf::cmdu_trace::open(m_module_name, m_cmdu_trace_records);
+}
+
 void logging::set_log_level_state(const eLogLevel &log_level, const bool &new_state)
 {
     m_levels.set_log_level_state(log_level, new_state);
@@ -465,7 +1152,8 @@ void logging::apply_settings()
     // Only configure file settings if log files are actually enabled
     // This to prevent easylogging from creating an empty file even if
     // the "ToFile" setting is set to "false"
-    if (m_log_files_enabled) {
+    // With async logging the file is written by the AsyncLogSink instead
+    if (m_log_files_enabled && !m_async_enabled) {
         defaultConf.setGlobally(el::ConfigurationType::ToFile,
                                 string_utils::bool_str(m_log_files_enabled));
         defaultConf.setGlobally(el::ConfigurationType::Filename, get_log_filepath());
@@ -509,6 +1197,28 @@ void logging::apply_settings()
     el::Loggers::reconfigureLogger("default", defaultConf);
     el::Loggers::reconfigureLogger("syslog", syslogConf);
 
+    // Checked by LOG() before evaluating its arguments
+    uint32_t enabled_levels = 0;
+    if (m_levels.fatal_enabled()) {
+        enabled_levels |= static_cast<uint32_t>(el::Level::Fatal);
+    }
+    if (m_levels.error_enabled()) {
+        enabled_levels |= static_cast<uint32_t>(el::Level::Error);
+    }
+    if (m_levels.warning_enabled()) {
+        enabled_levels |= static_cast<uint32_t>(el::Level::Warning);
+    }
+    if (m_levels.info_enabled()) {
+        enabled_levels |= static_cast<uint32_t>(el::Level::Info);
+    }
+    if (m_levels.debug_enabled()) {
+        enabled_levels |= static_cast<uint32_t>(el::Level::Debug);
+    }
+    if (m_levels.trace_enabled()) {
+        enabled_levels |= static_cast<uint32_t>(el::Level::Trace);
+    }
+    beerocks::log::enabled_levels = enabled_levels;
+
     el::Loggers::addFlag(el::LoggingFlag::ImmediateFlush);
     el::Loggers::addFlag(el::LoggingFlag::LogDetailedCrashReason);
     el::Loggers::addFlag(el::LoggingFlag::DisableApplicationAbortOnFatalLog);
@@ -528,9 +1238,49 @@ void logging::apply_settings()
         return;
     }
 
+    // Switch between the default (synchronous) dispatcher and the async sink, the new one is
+    // enabled first so no record is lost
+    auto default_dispatch = el::Helpers::logDispatchCallback<el::base::DefaultLogDispatchCallback>(
+        "DefaultLogDispatchCallback");
+    auto async_sink = el::Helpers::logDispatchCallback<AsyncLogSink>("AsyncLogSink");
+    std::string logFilePath;
+    if (m_async_enabled) {
+        if (!async_sink) {
+            el::Helpers::installLogDispatchCallback<AsyncLogSink>("AsyncLogSink");
+            async_sink = el::Helpers::logDispatchCallback<AsyncLogSink>("AsyncLogSink");
+        }
+
+        AsyncLogSink::sSettings settings;
+        settings.to_file           = m_log_files_enabled;
+        settings.file_path         = resolve_log_filepath();
+        settings.rollover_size     = get_log_max_size();
+        settings.rollover_handler  = handle_logging_rollover;
+        settings.queue_size        = m_async_queue_size;
+        settings.block_on_overflow = m_async_block_on_overflow;
+        settings.binary_enabled    = m_log_files_enabled && m_binary_enabled;
+        settings.binary_file_path  = get_log_files_path() + "/" + m_module_name + ".blog";
+        async_sink->start(settings);
+        async_sink->setEnabled(true);
+        AsyncLogSink::s_binary_sink = settings.binary_enabled ? async_sink : nullptr;
+
+        if (default_dispatch) {
+            default_dispatch->setEnabled(false);
+        }
+        logFilePath = settings.file_path;
+    } else {
+        if (default_dispatch) {
+            default_dispatch->setEnabled(true);
+        }
+        if (async_sink) {
+            AsyncLogSink::s_binary_sink = nullptr;
+            async_sink->setEnabled(false);
+            async_sink->stop();
+        }
+        logFilePath = typedConfigurations->filename(el::Level::Info);
+    }
+
     // Create symbolic links to the current log file
     if (m_log_files_enabled) {
-        auto logFilePath = typedConfigurations->filename(el::Level::Info);
         auto logFileName = logFilePath.substr(logFilePath.find_last_of("/") + 1);
         auto symLinkName = get_log_files_path() + "/" + m_module_name + ".log";
         unlink(symLinkName.c_str());
@@ -539,8 +1289,8 @@ void logging::apply_settings()
         }
     }
 
-    // Enable roll monitor
-    if (m_log_files_auto_roll) {
+    // Enable roll monitor, the async sink rolls the log file by itself
+    if (m_log_files_auto_roll && !m_async_enabled) {
         auto roll_monitor = el::Helpers::logDispatchCallback<RollMonitor>("RollMonitor");
         if (roll_monitor) {
             roll_monitor->enable(true);
@@ -616,6 +1366,34 @@ void logging::set_log_path(std::string log_path)
     }
 }
 
+std::string logging::resolve_log_filepath()
+{
+    // Same as the easylogging file name resolution, for the log file written by the async sink
+    static const std::string datetime_specifier("%datetime");
+
+    auto file_path = get_log_filepath();
+    auto pos       = file_path.find(datetime_specifier);
+    if (pos == std::string::npos) {
+        return file_path;
+    }
+
+    auto len = datetime_specifier.size();
+    std::string format("%Y-%M-%d_%H-%m");
+    if (pos + len < file_path.size() && file_path[pos + len] == '{') {
+        auto end = file_path.find('}', pos + len);
+        if (end != std::string::npos) {
+            format = file_path.substr(pos + len + 1, end - pos - len - 1);
+            len    = end + 1 - pos;
+        }
+    }
+
+    el::base::SubsecondPrecision precision(3);
+    auto now = el::base::utils::DateTime::getDateTime(format.c_str(), &precision);
+    std::replace(now.begin(), now.end(), '/', '-');
+
+    return file_path.replace(pos, len, now);
+}
+
 void logging::eval_settings()
 {
     // log files
@@ -707,4 +1485,33 @@ void logging::eval_settings()
     } else {
         m_syslog_enabled = "false"; // If no module specific setting, accept a global, then default
     }
+
+    // async logging
+    setting = m_settings_map.find("log_async_enabled");
+    if (setting != m_settings_map.end()) {
+        m_async_enabled = string_utils::trimmed_substr(setting->second) == "true";
+    }
+
+    setting            = m_settings_map.find("log_async_queue_size");
+    m_async_queue_size = LOGGING_DEFAULT_ASYNC_QUEUE_SIZE;
+    if (setting != m_settings_map.end()) {
+        m_async_queue_size = strtoul(setting->second.c_str(), nullptr, 10);
+    }
+
+    // Policy when the queue of a thread is full: "drop" (default) or "block"
+    setting = m_settings_map.find("log_async_overflow");
+    if (setting != m_settings_map.end()) {
+        m_async_block_on_overflow = string_utils::trimmed_substr(setting->second) == "block";
+    }
+
+    // binary logging, written by the async sink
+    setting = m_settings_map.find("log_binary_enabled");
+    if (setting != m_settings_map.end()) {
+        m_binary_enabled = string_utils::trimmed_substr(setting->second) == "true";
+    }
+
+    setting = m_settings_map.find("log_cmdu_trace_records");
+    if (setting != m_settings_map.end()) {
+        m_cmdu_trace_records = strtoul(setting->second.c_str(), nullptr, 10);
+    }
 }
@@ -0,0 +1,321 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <bcl/beerocks_metrics.h>
+
+#include <bcl/beerocks_log.h>
+
+#include <tlvf/ieee_1905_1/eMessageType.h>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace beerocks::metrics;
+
+//////////////////////////////////////////////////////////////////////////////
+/////////////////////////// Local Module Functions ///////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static void write_escaped(std::ostream &os, const std::string &str, bool quotes)
+{
+    for (auto c : str) {
+        if (c == '\\') {
+            os << "\\\\";
+        } else if (c == '\n') {
+            os << "\\n";
+        } else if (c == '"' && quotes) {
+            os << "\\\"";
+        } else {
+            os << c;
+        }
+    }
+}
+
+static std::string format_labels(const labels_t &labels)
+{
+    std::stringstream ss;
+    for (const auto &label : labels) {
+        if (ss.tellp() > 0) {
+            ss << ',';
+        }
+        ss << label.first << "=\"";
+        write_escaped(ss, label.second, true);
+        ss << '"';
+    }
+    return ss.str();
+}
+
+static void write_sample(std::ostream &os, const std::string &name, const std::string &labels,
+                         const std::string &extra_label = std::string())
+{
+    os << name;
+    if (!labels.empty() || !extra_label.empty()) {
+        os << '{' << labels;
+        if (!labels.empty() && !extra_label.empty()) {
+            os << ',';
+        }
+        os << extra_label << '}';
+    }
+    os << ' ';
+}
+
+static labels_t cmdu_labels(uint16_t message_type, const std::string &action,
+                            const std::string &action_op)
+{
+    std::stringstream type;
+    type << "0x" << std::hex << std::setw(4) << std::setfill('0') << message_type;
+    return {{"message_type", type.str()}, {"action", action}, {"action_op", action_op}};
+}
+
+static std::string format_seconds(uint64_t usec)
+{
+    std::stringstream ss;
+    ss.precision(15);
+    ss << double(usec) / 1000000.0;
+    return ss.str();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/////////////////////////////// Implementation ///////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+size_t counter::shard_index()
+{
+    static std::atomic<size_t> s_next_shard{0};
+    static thread_local size_t t_shard =
+        s_next_shard.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+    return t_shard;
+}
+
+uint64_t counter::value() const
+{
+    uint64_t sum = 0;
+    for (const auto &shard : m_shards) {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+size_t histogram::bucket_index(uint64_t usec)
+{
+    if (usec < SUB_BUCKETS) {
+        return usec;
+    }
+
+    // The SUB_BUCKETS_BITS bits following the most significant bit select the sub bucket
+    size_t msb   = 63 - __builtin_clzll(usec);
+    size_t shift = msb - SUB_BUCKETS_BITS;
+    size_t index = ((msb - SUB_BUCKETS_BITS + 1) << SUB_BUCKETS_BITS) +
+                   ((usec >> shift) - SUB_BUCKETS);
+
+    return (index < NUM_BUCKETS) ? index : NUM_BUCKETS - 1;
+}
+
+uint64_t histogram::bucket_upper_bound(size_t index)
+{
+    if (index < SUB_BUCKETS) {
+        return index + 1;
+    }
+
+    size_t shift = (index >> SUB_BUCKETS_BITS) - 1;
+    size_t sub   = index & (SUB_BUCKETS - 1);
+    return uint64_t(SUB_BUCKETS + sub + 1) << shift;
+}
+
+void histogram::snapshot(sSnapshot &snapshot) const
+{
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+        snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count = m_count.load(std::memory_order_relaxed);
+    snapshot.sum   = m_sum.load(std::memory_order_relaxed);
+}
+
+uint64_t histogram::sSnapshot::quantile(double quantile) const
+{
+    uint64_t total = 0;
+    for (auto bucket : buckets) {
+        total += bucket;
+    }
+    if (!total) {
+        return 0;
+    }
+
+    auto rank       = uint64_t(quantile * total);
+    uint64_t so_far = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+        so_far += buckets[i];
+        if (so_far > rank) {
+            return bucket_upper_bound(i);
+        }
+    }
+    return bucket_upper_bound(NUM_BUCKETS - 1);
+}
+
+registry &registry::instance()
+{
+    static registry s_registry;
+    return s_registry;
+}
+
+registry::sFamily *registry::get_family(const std::string &name, const std::string &help,
+                                        eType type)
+{
+    auto it = m_families.find(name);
+    if (it == m_families.end()) {
+        auto &family = m_families[name];
+        family.type  = type;
+        family.help  = help;
+        return &family;
+    }
+
+    if (it->second.type != type) {
+        LOG(ERROR) << "metric " << name << " is already registered with another type";
+        return nullptr;
+    }
+    return &it->second;
+}
+
+counter &registry::get_counter(const std::string &name, const std::string &help,
+                               const labels_t &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto family = get_family(name, help, eType::COUNTER);
+    if (!family) {
+        static counter s_detached;
+        return s_detached;
+    }
+
+    auto &metric = family->counters[format_labels(labels)];
+    if (!metric) {
+        metric = std::unique_ptr<counter>(new counter());
+    }
+    return *metric;
+}
+
+gauge &registry::get_gauge(const std::string &name, const std::string &help,
+                           const labels_t &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto family = get_family(name, help, eType::GAUGE);
+    if (!family) {
+        static gauge s_detached;
+        return s_detached;
+    }
+
+    auto &metric = family->gauges[format_labels(labels)];
+    if (!metric) {
+        metric = std::unique_ptr<gauge>(new gauge());
+    }
+    return *metric;
+}
+
+histogram &registry::get_histogram(const std::string &name, const std::string &help,
+                                   const labels_t &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto family = get_family(name, help, eType::HISTOGRAM);
+    if (!family) {
+        static histogram s_detached;
+        return s_detached;
+    }
+
+    auto &metric = family->histograms[format_labels(labels)];
+    if (!metric) {
+        metric = std::unique_ptr<histogram>(new histogram());
+    }
+    return *metric;
+}
+
+void registry::write_prometheus(std::ostream &os) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    histogram::sSnapshot snapshot;
+    for (const auto &it : m_families) {
+        const auto &name   = it.first;
+        const auto &family = it.second;
+
+        os << "# HELP " << name << ' ';
+        write_escaped(os, family.help, false);
+        os << "\n# TYPE " << name << ' ';
+
+        switch (family.type) {
+        case eType::COUNTER: {
+            os << "counter\n";
+            for (const auto &metric : family.counters) {
+                write_sample(os, name, metric.first);
+                os << metric.second->value() << '\n';
+            }
+        } break;
+        case eType::GAUGE: {
+            os << "gauge\n";
+            for (const auto &metric : family.gauges) {
+                write_sample(os, name, metric.first);
+                os << metric.second->value() << '\n';
+            }
+        } break;
+        case eType::HISTOGRAM: {
+            os << "histogram\n";
+            for (const auto &metric : family.histograms) {
+                metric.second->snapshot(snapshot);
+
+                // The last bucket also holds the values above its bound, it is only counted in +Inf
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < histogram::NUM_BUCKETS - 1; i++) {
+                    if (!snapshot.buckets[i]) {
+                        continue;
+                    }
+                    cumulative += snapshot.buckets[i];
+                    write_sample(os, name + "_bucket", metric.first,
+                                 "le=\"" + format_seconds(histogram::bucket_upper_bound(i)) + '"');
+                    os << cumulative << '\n';
+                }
+                cumulative += snapshot.buckets[histogram::NUM_BUCKETS - 1];
+                write_sample(os, name + "_bucket", metric.first, "le=\"+Inf\"");
+                os << cumulative << '\n';
+
+                // Keep the count consistent with the buckets read before it
+                write_sample(os, name + "_sum", metric.first);
+                os << format_seconds(snapshot.sum) << '\n';
+                write_sample(os, name + "_count", metric.first);
+                os << cumulative << '\n';
+            }
+        } break;
+        }
+    }
+}
+
+std::string registry::to_prometheus() const
+{
+    std::stringstream ss;
+    write_prometheus(ss);
+    return ss.str();
+}
+
+histogram &beerocks::metrics::cmdu_handle_time(histogram_map<> &handle_time,
+                                               uint16_t message_type)
+{
+    return handle_time.get(message_type, [&]() {
+        return cmdu_labels(message_type, std::string(), std::string());
+    });
+}
+
+histogram &beerocks::metrics::cmdu_handle_time(histogram_map<> &handle_time, uint8_t action,
+                                               uint8_t action_op)
+{
+    // Vendor specific messages are keyed above the 16 bits 1905.1 message types
+    uint32_t key = (1 << 16) | (action << 8) | action_op;
+    return handle_time.get(key, [&]() {
+        return cmdu_labels(uint16_t(ieee1905_1::eMessageType::VENDOR_SPECIFIC_MESSAGE),
+                           std::to_string(action), std::to_string(action_op));
+    });
+}
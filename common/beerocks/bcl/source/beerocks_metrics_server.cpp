@@ -0,0 +1,143 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <bcl/beerocks_metrics_server.h>
+
+#include <bcl/beerocks_log.h>
+#include <bcl/beerocks_metrics.h>
+#include <bcl/beerocks_string_utils.h>
+
+using namespace beerocks;
+
+metrics_server::metrics_server(int port) : m_port(port) { thread_name = "metrics_server"; }
+
+metrics_server::~metrics_server() { stop(); }
+
+std::unique_ptr<metrics_server> metrics_server::start_from_config(const std::string &port,
+                                                                  int port_offset)
+{
+    // The metrics server is optional, disabled unless metrics_port is set
+    if (port.empty() || string_utils::stoi(port) <= 0) {
+        return nullptr;
+    }
+
+    auto server = std::unique_ptr<metrics_server>(
+        new metrics_server(string_utils::stoi(port) + port_offset));
+    if (!server->start()) {
+        LOG(ERROR) << "Failed starting the metrics server";
+        return nullptr;
+    }
+
+    return server;
+}
+
+bool metrics_server::init()
+{
+    m_server_socket.reset();
+
+    // Only reachable from the device itself
+    auto server_socket = std::unique_ptr<SocketServer>(
+        new SocketServer(m_port, 1, SocketServer::SocketModeBlocking, "127.0.0.1"));
+    if (!server_socket->getError().empty() || !server_socket->isOpen()) {
+        LOG(ERROR) << "Failed creating the metrics server on port " << m_port << ": "
+                   << server_socket->getError();
+        return false;
+    }
+    m_select.addSocket(server_socket.get());
+
+    timeval timeout = {0, SELECT_TIMEOUT_MSC * 1000};
+    m_select.setTimeout(&timeout);
+
+    m_server_socket = std::move(server_socket);
+
+    LOG(INFO) << "Metrics available on http://127.0.0.1:" << m_port << "/metrics";
+    return true;
+}
+
+bool metrics_server::work()
+{
+    // Wakes up periodically to check whether the thread should stop
+    int ret = m_select.selectSocket();
+    if (ret < 0) {
+        if (errno == EINTR) {
+            return true;
+        }
+        LOG(ERROR) << "select error: " << strerror(errno);
+        return false;
+    }
+
+    if (ret == 0 || !m_select.readReady(m_server_socket.get())) {
+        return true;
+    }
+
+    auto sd = std::unique_ptr<Socket>(m_server_socket->acceptConnections());
+    if (!sd) {
+        LOG(ERROR) << "acceptConnections failed: " << m_server_socket->getError();
+        return true;
+    }
+
+    handle_request(sd.get());
+    return true;
+}
+
+void metrics_server::handle_request(Socket *sd)
+{
+    sd->setReadTimeout(READ_TIMEOUT_MSC);
+
+    // Only the request line is needed, the headers are ignored
+    std::string request;
+    uint8_t buffer[MAX_REQUEST_SIZE];
+    while (request.find('\n') == std::string::npos && request.size() < MAX_REQUEST_SIZE) {
+        auto remaining = sizeof(buffer) - request.size();
+        auto len       = sd->readBytes(buffer, remaining, true, remaining);
+        if (len <= 0) {
+            return;
+        }
+        request.append(reinterpret_cast<char *>(buffer), len);
+    }
+
+    auto request_line = request.substr(0, request.find_first_of("\r\n"));
+    if (request_line.compare(0, 4, "GET ") != 0) {
+        send_response(sd, "405 Method Not Allowed", "Only GET is supported\n");
+        return;
+    }
+
+    auto path = request_line.substr(4, request_line.find(' ', 4) - 4);
+    if (path != "/metrics" && path != "/") {
+        send_response(sd, "404 Not Found", "Metrics are available on /metrics\n");
+        return;
+    }
+
+    send_response(sd, "200 OK", metrics::registry::instance().to_prometheus());
+}
+
+bool metrics_server::send_response(Socket *sd, const std::string &status, const std::string &body)
+{
+    auto response = "HTTP/1.0 " + status +
+                    "\r\n"
+                    "Content-Type: text/plain; version=0.0.4\r\n"
+                    "Content-Length: " +
+                    std::to_string(body.size()) +
+                    "\r\n"
+                    "Connection: close\r\n"
+                    "\r\n" +
+                    body;
+
+    size_t sent = 0;
+    while (sent < response.size()) {
+        auto len = sd->writeBytes(reinterpret_cast<const uint8_t *>(response.data()) + sent,
+                                  response.size() - sent);
+        if (len <= 0) {
+            LOG(ERROR) << "Failed sending the metrics response: " << strerror(errno);
+            return false;
+        }
+        sent += len;
+    }
+
+    return true;
+}
@@ -17,7 +17,7 @@
 #include <sys/utsname.h>
 #include <unistd.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 using namespace beerocks;
 
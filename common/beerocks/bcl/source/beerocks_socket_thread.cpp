@@ -7,22 +7,52 @@
  */
 
 #include <bcl/beerocks_backport.h>
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_socket_thread.h>
-#include <easylogging++.h>
 
 #include <bcl/beerocks_utils.h>
 
+#include <mapf/common/cmdu_trace.h>
+
 #include <tlvf/CmduMessageRx.h>
 #include <tlvf/ieee_1905_1/eTlvType.h>
+#include <tlvf/ieee_1905_1/tlvVendorSpecific.h>
 
 using namespace beerocks;
 
 #define DEFAULT_MAX_SOCKET_CONNECTIONS 10
+
 #define TX_BUFFER_UDS (tx_buffer + sizeof(beerocks::message::sUdsHeader))
 #define TX_BUFFER_UDS_SIZE (sizeof(tx_buffer) - sizeof(beerocks::message::sUdsHeader))
 #define CERT_TX_BUFFER_UDS (cert_tx_buffer + sizeof(beerocks::message::sUdsHeader))
 #define CERT_TX_BUFFER_UDS_SIZE (sizeof(cert_tx_buffer) - sizeof(beerocks::message::sUdsHeader))
 
+//////////////////////////////////////////////////////////////////////////////
+/////////////////////////// Local Module Functions ///////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The beerocks header (cACTION_HEADER) starts with the magic (4 bytes) and the version (1 byte),
+// followed by the action and the action op
+#define BEEROCKS_HEADER_ACTION_OFFSET 5
+#define BEEROCKS_HEADER_ACTION_OP_OFFSET 6
+
+static void get_beerocks_action(ieee1905_1::CmduMessageRx &cmdu_rx, uint8_t &action,
+                                uint8_t &action_op)
+{
+    auto tlv = cmdu_rx.getClass<ieee1905_1::tlvVendorSpecific>();
+    if (!tlv || tlv->vendor_oui() != ieee1905_1::tlvVendorSpecific::eVendorOUI::OUI_INTEL ||
+        tlv->payload_length() <= BEEROCKS_HEADER_ACTION_OP_OFFSET) {
+        return;
+    }
+
+    action    = tlv->payload()[BEEROCKS_HEADER_ACTION_OFFSET];
+    action_op = tlv->payload()[BEEROCKS_HEADER_ACTION_OP_OFFSET];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/////////////////////////////// Implementation ///////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
 socket_thread::socket_thread(const std::string &unix_socket_path_)
     : thread_base(), cmdu_tx(TX_BUFFER_UDS, TX_BUFFER_UDS_SIZE),
       cert_cmdu_tx(CERT_TX_BUFFER_UDS, CERT_TX_BUFFER_UDS_SIZE),
@@ -43,6 +73,14 @@ void socket_thread::set_server_max_connections(int connections)
 
 bool socket_thread::init()
 {
+    auto &registry     = metrics::registry::instance();
+    m_ready_events     = &registry.get_gauge("beerocks_transport_ready_events",
+                                             "Sockets ready on the last wake up of the thread",
+                                             {{"thread", thread_name}});
+    m_rx_pending_bytes = &registry.get_gauge(
+        "beerocks_transport_rx_pending_bytes",
+        "Bytes left in a socket of a thread after a message was read", {{"thread", thread_name}});
+
     if (server_socket) {
         remove_socket(server_socket.get());
         server_socket->closeSocket();
@@ -161,6 +199,10 @@ bool socket_thread::handle_cmdu_message_uds(Socket *sd)
         return false;
     }
 
+    if (m_rx_pending_bytes) {
+        m_rx_pending_bytes->set(sd->getBytesReady());
+    }
+
     if (!verify_cmdu(uds_header)) {
         THREAD_LOG(ERROR) << "unable to verify cmdu!";
         return false;
@@ -172,13 +214,41 @@ bool socket_thread::handle_cmdu_message_uds(Socket *sd)
         return false;
     }
 
-    if (!handle_cmdu(sd, cmdu_rx)) {
+    if (!handle_cmdu_traced(sd, uds_header)) {
         return false;
     }
 
     return true;
 }
 
+bool socket_thread::handle_cmdu_traced(Socket *sd, message::sUdsHeader *uds_header)
+{
+    auto message_type = uint16_t(cmdu_rx.getMessageType());
+    auto mid          = cmdu_rx.getMessageId();
+
+    // CMDUs received from the bus start a trace, unless the transport traced them already
+    if (!sd && !uds_header->trace_id) {
+        uds_header->trace_id = mapf::cmdu_trace::trace_id(message_type, mid);
+    }
+
+    if (!mapf::cmdu_trace::enabled()) {
+        return handle_cmdu(sd, cmdu_rx);
+    }
+
+    uint8_t action    = 0;
+    uint8_t action_op = 0;
+    if (cmdu_rx.getMessageType() == ieee1905_1::eMessageType::VENDOR_SPECIFIC_MESSAGE) {
+        get_beerocks_action(cmdu_rx, action, action_op);
+    }
+
+    mapf::cmdu_trace::record(sd ? mapf::cmdu_trace::eHop::UDS_RX : mapf::cmdu_trace::eHop::BUS_RX,
+                             uds_header->trace_id, message_type, mid, action, action_op);
+
+    mapf::cmdu_trace::handle_scope scope(uds_header->trace_id, message_type, mid, action,
+                                         action_op);
+    return handle_cmdu(sd, cmdu_rx);
+}
+
 // FIXME - WLANRTSYS-6360 - should be moved to transport
 bool socket_thread::verify_cmdu(message::sUdsHeader *uds_header)
 {
@@ -263,6 +333,10 @@ bool socket_thread::work()
 
     after_select(bool(sel_ret == 0));
 
+    if (m_ready_events) {
+        m_ready_events->set(sel_ret);
+    }
+
     if (sel_ret == 0) {
         return true;
     }
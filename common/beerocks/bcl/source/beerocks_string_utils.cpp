@@ -8,7 +8,7 @@
 
 #include <bcl/beerocks_string_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 #include <iomanip>
 
@@ -26,7 +26,7 @@
 #include <tlvf/wfa_map/tlvTransmitPowerLimit.h>
 
 #include <algorithm>
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 #include <iomanip>
 
 #define SELECT_TIMEOUT_MSC 5000
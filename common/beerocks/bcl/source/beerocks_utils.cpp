@@ -6,9 +6,9 @@
  * See LICENSE file for more details.
  */
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_utils.h>
-#include <easylogging++.h>
 #include <iomanip>
 
 using namespace beerocks;
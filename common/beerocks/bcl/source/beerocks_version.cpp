@@ -11,7 +11,7 @@
 
 #include <cstdio>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 using namespace beerocks;
 
@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <bcl/beerocks_worker_pool.h>
+
+#include <bcl/beerocks_log.h>
+
+using namespace beerocks;
+
+worker_pool::~worker_pool() { stop(); }
+
+bool worker_pool::start(size_t workers_num, const std::string &name)
+{
+    stop();
+
+    for (size_t i = 0; i < workers_num; i++) {
+        auto new_worker = std::unique_ptr<worker>(new worker(*this));
+        if (!new_worker->start(name + "_" + std::to_string(i))) {
+            LOG(ERROR) << "failed to start " << name << "_" << i;
+            stop();
+            return false;
+        }
+        m_workers.push_back(std::move(new_worker));
+    }
+    return true;
+}
+
+void worker_pool::stop()
+{
+    if (m_workers.empty()) {
+        return;
+    }
+
+    for (auto &w : m_workers) {
+        w->stop(false);
+    }
+    // An empty job per worker releases the workers blocked on the queue
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        m_jobs.push(job_t());
+    }
+    for (auto &w : m_workers) {
+        w->join();
+    }
+    m_workers.clear();
+    m_jobs.clear();
+    m_pending_jobs = 0;
+}
+
+bool worker_pool::enqueue(const job_t &job)
+{
+    if (m_workers.empty() || !job) {
+        return false;
+    }
+    if (m_pending_jobs >= m_max_pending_jobs) {
+        LOG(DEBUG) << "pending jobs limit reached (" << m_max_pending_jobs << ")";
+        return false;
+    }
+
+    m_pending_jobs++;
+    m_jobs.push(job);
+    return true;
+}
+
+bool worker_pool::worker::work()
+{
+    auto job = m_pool.m_jobs.pop();
+    if (!job) {
+        return true;
+    }
+
+    job();
+    m_pool.m_pending_jobs--;
+    return true;
+}
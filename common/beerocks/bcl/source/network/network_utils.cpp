@@ -32,12 +32,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 using namespace beerocks::net;
 
 #define NL_BUFSIZE 8192
-#define MAC_ADDR_CHAR_SIZE 17
 
 struct route_info {
     struct in_addr dstAddr;
@@ -68,6 +67,21 @@ static int read_iface_flags(const std::string &strIface, struct ifreq &if_req)
     return 0;
 }
 
+// Value of a hex digit, or -1 if the character is not a hex digit
+static inline int hex_digit_value(char c)
+{
+    uint8_t digit = uint8_t(c - '0');
+    if (digit < 10) {
+        return digit;
+    }
+    // Lower case the letters
+    uint8_t letter = uint8_t((c | 0x20) - 'a');
+    if (letter < 6) {
+        return letter + 10;
+    }
+    return -1;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////////// Local Module Constants ///////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -96,16 +110,9 @@ std::string network_utils::mac_to_string(const uint64_t mac)
 // Converts a mac address in a human-readable format
 std::string network_utils::mac_to_string(const uint8_t *mac_address)
 {
-    std::string mac_addr_string;
-
-    mac_addr_string = string_utils::int_to_hex_string((uint32_t)mac_address[0], 2) + ":" +
-                      string_utils::int_to_hex_string((uint32_t)mac_address[1], 2) + ":" +
-                      string_utils::int_to_hex_string((uint32_t)mac_address[2], 2) + ":" +
-                      string_utils::int_to_hex_string((uint32_t)mac_address[3], 2) + ":" +
-                      string_utils::int_to_hex_string((uint32_t)mac_address[4], 2) + ":" +
-                      string_utils::int_to_hex_string((uint32_t)mac_address[5], 2);
-
-    return mac_addr_string;
+    char buf[MAC_ADDR_STRING_LEN + 1];
+    mac_to_string(mac_address, buf);
+    return std::string(buf, MAC_ADDR_STRING_LEN);
 }
 
 std::string network_utils::mac_to_string(const sMacAddr &mac)
@@ -113,6 +120,21 @@ std::string network_utils::mac_to_string(const sMacAddr &mac)
     return mac_to_string((const uint8_t *)mac.oct);
 }
 
+void network_utils::mac_to_string(const uint8_t *mac_address, char (&buf)[MAC_ADDR_STRING_LEN + 1])
+{
+    static const char hex_digits[] = "0123456789abcdef";
+
+    char *p = buf;
+    for (int i = 0; i < MAC_ADDR_LEN; i++) {
+        *p++ = hex_digits[mac_address[i] >> 4];
+        *p++ = hex_digits[mac_address[i] & 0x0f];
+        *p++ = ':';
+    }
+
+    // Overwrite the last separator
+    buf[MAC_ADDR_STRING_LEN] = '\0';
+}
+
 sMacAddr network_utils::mac_from_string(const std::string &mac)
 {
     sMacAddr ret;
@@ -124,29 +146,51 @@ sMacAddr network_utils::mac_from_string(const std::string &mac)
 
 void network_utils::mac_from_string(uint8_t *buf, const std::string &mac)
 {
-    if (mac.empty()) {
-        memset(buf, 0, MAC_ADDR_LEN);
-    } else {
-        std::stringstream mac_ss(mac);
-        std::string token;
+    sMacAddr addr;
+    if (parse_mac(mac.c_str(), addr)) {
+        memcpy(buf, addr.oct, MAC_ADDR_LEN);
+        return;
+    }
 
-        for (int i = 0; i < MAC_ADDR_LEN; i++) {
-            std::getline(mac_ss, token, ':');
-            buf[i] = std::stoul(token, nullptr, 16);
+    // Not in the "xx:xx:xx:xx:xx:xx" format (e.g. empty or single digit octets),
+    // missing octets are zero
+    memset(buf, 0, MAC_ADDR_LEN);
+    const char *str = mac.c_str();
+    for (int i = 0; i < MAC_ADDR_LEN && *str; i++) {
+        char *end;
+        buf[i] = uint8_t(strtoul(str, &end, 16));
+        if (*end != ':') {
+            break;
         }
+        str = end + 1;
     }
 }
 
-bool network_utils::is_valid_mac(std::string mac)
+bool network_utils::parse_mac(const char *str, sMacAddr &mac)
 {
-    if (mac.size() != MAC_ADDR_CHAR_SIZE) {
-        return false;
+    sMacAddr addr;
+    for (int i = 0; i < MAC_ADDR_LEN; i++, str += 3) {
+        // Stops at the null terminator, before reading past it
+        int high = hex_digit_value(str[0]);
+        int low  = (high < 0) ? -1 : hex_digit_value(str[1]);
+        if (low < 0) {
+            return false;
+        }
+        char separator = (i < MAC_ADDR_LEN - 1) ? ':' : '\0';
+        if (str[2] != separator) {
+            return false;
+        }
+        addr.oct[i] = uint8_t((high << 4) | low);
     }
-    std::transform(mac.begin(), mac.end(), mac.begin(), ::tolower);
-    uint8_t str[20];
-    mac_from_string(str, mac);
-    auto mac_out = mac_to_string(str);
-    return (mac == mac_out);
+
+    mac = addr;
+    return true;
+}
+
+bool network_utils::is_valid_mac(std::string mac)
+{
+    sMacAddr addr;
+    return parse_mac(mac.c_str(), addr);
 }
 
 std::string network_utils::ipv4_to_string(const sIpv4Addr &ip)
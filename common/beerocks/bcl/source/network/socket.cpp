@@ -27,7 +27,7 @@ typedef int socklen_t;
 #define ioctlsocket ioctl
 #endif
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 int Socket::m_ref = 0;
 
@@ -268,7 +268,7 @@ SocketServer::SocketServer(const std::string &uds_path, int connections, SocketM
 #endif
 }
 
-SocketServer::SocketServer(int port, int connections, SocketMode mode)
+SocketServer::SocketServer(int port, int connections, SocketMode mode, const std::string &bind_ip)
 {
     sockaddr_in addr;
 
@@ -281,7 +281,7 @@ SocketServer::SocketServer(int port, int connections, SocketMode mode)
 
     memset(&addr, 0, sizeof(addr));
     addr.sin_family      = AF_INET; // windows --> PF_INET;
-    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_addr.s_addr = bind_ip.empty() ? INADDR_ANY : inet_addr(bind_ip.c_str());
     addr.sin_port        = htons(port);
 
 #ifdef IS_WINDOWS
@@ -12,8 +12,10 @@
 
 #include <tlvf/wfa_map/tlvChannelPreference.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 using namespace son;
@@ -68,7 +70,7 @@ static bool has_operating_class_channel(const sOperatingClass &oper_class,
 wireless_utils::sPhyUlParams
 wireless_utils::estimate_ul_params(int ul_rssi, uint16_t sta_phy_tx_rate_100kb,
                                    const beerocks::message::sRadioCapabilities *sta_capabilities,
-                                   beerocks::eWiFiBandwidth ap_bw, bool is_5ghz)
+                                   beerocks::eWiFiBandwidth ap_bw, bool is_5ghz, bool verbose)
 {
     int ul_rssi_lut = ul_rssi * 10;
     int estimated_ul_rssi_lut;
@@ -91,21 +93,22 @@ wireless_utils::estimate_ul_params(int ul_rssi, uint16_t sta_phy_tx_rate_100kb,
 
     max_bw = (max_bw > beerocks::BANDWIDTH_160 ? beerocks::BANDWIDTH_160 : max_bw);
 
-    LOG(DEBUG) << "UL RSSI:" << ul_rssi << " | sta_phy_tx_rate:" << sta_phy_tx_rate_100kb / 10
-               << " Mbps | AP BW:"
-               << beerocks::utils::convert_bandwidth_to_int((beerocks::eWiFiBandwidth)ap_bw)
-               << " | is_5ghz:" << is_5ghz << " | ant_num:" << int(sta_capabilities->ant_num)
-               << " | max_ant_mode:" << max_ant_mode << " | max MCS:" << max_mcs << " | max BW:"
-               << beerocks::utils::convert_bandwidth_to_int((beerocks::eWiFiBandwidth)max_bw);
+    LOG_IF(verbose, DEBUG)
+        << "UL RSSI:" << ul_rssi << " | sta_phy_tx_rate:" << sta_phy_tx_rate_100kb / 10
+        << " Mbps | AP BW:"
+        << beerocks::utils::convert_bandwidth_to_int((beerocks::eWiFiBandwidth)ap_bw)
+        << " | is_5ghz:" << is_5ghz << " | ant_num:" << int(sta_capabilities->ant_num)
+        << " | max_ant_mode:" << max_ant_mode << " | max MCS:" << max_mcs << " | max BW:"
+        << beerocks::utils::convert_bandwidth_to_int((beerocks::eWiFiBandwidth)max_bw);
 
     if (ul_rssi == beerocks::RSSI_INVALID) {
-        LOG(DEBUG) << "Can not estimate UL parameters (invalid RSSI)";
+        LOG_IF(verbose, DEBUG) << "Can not estimate UL parameters (invalid RSSI)";
         return estimation;
     }
 
     // If station phyrate value is below table's minimum, return minimal estimation
     if (sta_phy_tx_rate_100kb < phy_rate_table[0][0].bw_values[0].gi_long_rate) {
-        LOG(DEBUG) << "Can not estimate UL parameters (STA phyrate is too low)";
+        LOG_IF(verbose, DEBUG) << "Can not estimate UL parameters (STA phyrate is too low)";
         estimation.tx_power =
             is_5ghz ? phy_rate_table[0][0].tx_power_5 : phy_rate_table[0][0].tx_power_2_4;
         estimation.rssi   = int(ceil(phy_rate_table[0][0].bw_values[0].rssi / 10.0));
@@ -117,10 +120,11 @@ wireless_utils::estimate_ul_params(int ul_rssi, uint16_t sta_phy_tx_rate_100kb,
     // If station phyrate value is above table's maximum, return maximal estimation
     if (sta_phy_tx_rate_100kb >
         phy_rate_table[max_ant_mode][max_mcs].bw_values[max_bw].gi_short_rate) {
-        LOG(DEBUG) << "STA phy rate (" << sta_phy_tx_rate_100kb / 10
-                   << " Mbps) is above maximum possible in current MCS/NSS/BW mode ("
-                   << phy_rate_table[max_ant_mode][max_mcs].bw_values[max_bw].gi_short_rate / 10
-                   << " Mbps)";
+        LOG_IF(verbose, DEBUG)
+            << "STA phy rate (" << sta_phy_tx_rate_100kb / 10
+            << " Mbps) is above maximum possible in current MCS/NSS/BW mode ("
+            << phy_rate_table[max_ant_mode][max_mcs].bw_values[max_bw].gi_short_rate / 10
+            << " Mbps)";
 
         estimation.status   = ESTIMATION_SUCCESS;
         estimation.tx_power = is_5ghz ? phy_rate_table[max_ant_mode][max_mcs].tx_power_5
@@ -128,8 +132,8 @@ wireless_utils::estimate_ul_params(int ul_rssi, uint16_t sta_phy_tx_rate_100kb,
         estimation.rssi =
             int(ceil(phy_rate_table[max_ant_mode][max_mcs].bw_values[max_bw].rssi / 10.0));
 
-        LOG(DEBUG) << "Return maximal estimation values | tx_power:" << estimation.tx_power
-                   << " | RSSI:" << estimation.rssi;
+        LOG_IF(verbose, DEBUG) << "Return maximal estimation values | tx_power:"
+                               << estimation.tx_power << " | RSSI:" << estimation.rssi;
 
         return estimation;
     }
@@ -194,13 +198,14 @@ wireless_utils::estimate_ul_params(int ul_rssi, uint16_t sta_phy_tx_rate_100kb,
 
     estimation.status = ESTIMATION_SUCCESS;
 
-    LOG(DEBUG) << "Successful estimation | tx_power:" << estimation.tx_power
-               << " | RSSI:" << estimation.rssi;
+    LOG_IF(verbose, DEBUG) << "Successful estimation | tx_power:" << estimation.tx_power
+                           << " | RSSI:" << estimation.rssi;
 
     return estimation;
 }
 
-int wireless_utils::estimate_dl_rssi(int ul_rssi, int tx_power, const sPhyApParams &ap_params)
+int wireless_utils::estimate_dl_rssi(int ul_rssi, int tx_power, const sPhyApParams &ap_params,
+                                     bool verbose)
 {
     int eirp_sta   = tx_power;
     int eirp_ap    = ap_params.ant_gain + ap_params.conducted_power;
@@ -222,17 +227,17 @@ int wireless_utils::estimate_dl_rssi(int ul_rssi, int tx_power, const sPhyApPara
 
     dl_rssi = eirp_ap - pathloss;
 
-    LOG(DEBUG) << " eirp_sta:" << eirp_sta << " | UL RSSI:" << int(ul_rssi)
-               << " | ant_factor:" << ant_factor << " | ant_gain:" << ap_params.ant_gain
-               << " | eirp_ap:" << eirp_ap << " | pathloss:" << int(pathloss)
-               << " | Returns estimated DL RSSI:" << int(dl_rssi);
+    LOG_IF(verbose, DEBUG) << " eirp_sta:" << eirp_sta << " | UL RSSI:" << int(ul_rssi)
+                           << " | ant_factor:" << ant_factor << " | ant_gain:" << ap_params.ant_gain
+                           << " | eirp_ap:" << eirp_ap << " | pathloss:" << int(pathloss)
+                           << " | Returns estimated DL RSSI:" << int(dl_rssi);
 
     return dl_rssi;
 }
 
 double wireless_utils::estimate_ap_tx_phy_rate(
     int estimated_dl_rssi, const beerocks::message::sRadioCapabilities *sta_capabilities,
-    beerocks::eWiFiBandwidth ap_bw, bool is_5ghz)
+    beerocks::eWiFiBandwidth ap_bw, bool is_5ghz, bool verbose)
 {
     int estimated_dl_rssi_lut = estimated_dl_rssi * 10;
     int dl_rssi_lut;
@@ -277,9 +282,10 @@ double wireless_utils::estimate_ap_tx_phy_rate(
         estimated_phy_rate = 1e+5 * double(phy_rate_table[0][0].bw_values[0].gi_short_rate);
     }
 
-    LOG(DEBUG) << "estimated DL RSSI:" << int(estimated_dl_rssi)
-               << " | AP BW:" << beerocks::utils::convert_bandwidth_to_int(ap_bw)
-               << " | Return estimated PHY RATE:" << int(estimated_phy_rate / 1e+6) << " Mbps";
+    LOG_IF(verbose, DEBUG) << "estimated DL RSSI:" << int(estimated_dl_rssi)
+                           << " | AP BW:" << beerocks::utils::convert_bandwidth_to_int(ap_bw)
+                           << " | Return estimated PHY RATE:" << int(estimated_phy_rate / 1e+6)
+                           << " Mbps";
 
     return estimated_phy_rate;
 }
@@ -310,6 +316,43 @@ double wireless_utils::get_load_max_bit_rate_mbps(double phy_rate_100kb)
     }
 }
 
+// Linear value of every dB level of the int8_t range, indexed by (db - INT8_MIN)
+static const std::array<float, 256> &db_to_watt_table()
+{
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> values;
+        for (int db = INT8_MIN; db <= INT8_MAX; db++) {
+            values[db - INT8_MIN] = std::pow(10, float(db) / float(10));
+        }
+        return values;
+    }();
+    return table;
+}
+
+float wireless_utils::db_to_watt(int8_t db) { return db_to_watt_table()[db - INT8_MIN]; }
+
+int8_t wireless_utils::watt_to_db(float watt)
+{
+    auto &table = db_to_watt_table();
+
+    // First level not lower than the given value
+    auto it = std::lower_bound(table.begin(), table.end(), watt);
+    if (it == table.begin()) {
+        return INT8_MIN;
+    }
+    if (it == table.end()) {
+        return INT8_MAX;
+    }
+
+    // Pick the nearer of the two neighbouring levels in the dB domain: the value is below the
+    // midpoint when it is below the geometric mean of the two levels
+    auto lower = it - 1;
+    if (double(watt) * double(watt) < double(*lower) * double(*it)) {
+        it = lower;
+    }
+    return int8_t(int(it - table.begin()) + INT8_MIN);
+}
+
 bool wireless_utils::get_mcs_from_rate(const uint16_t rate, const beerocks::eWiFiAntMode ant_mode,
                                        const beerocks::eWiFiBandwidth bw, uint8_t &mcs,
                                        uint8_t &short_gi)
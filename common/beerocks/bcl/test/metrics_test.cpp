@@ -0,0 +1,156 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <bcl/beerocks_metrics.h>
+#include <mapf/common/logger.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace beerocks::metrics;
+
+static bool check(int &errors, bool check, std::string message)
+{
+    if (check) {
+        MAPF_INFO(" OK  ") << message;
+    } else {
+        MAPF_ERR("FAIL ") << message;
+        errors++;
+    }
+    return check;
+}
+
+static std::vector<std::string> split_lines(const std::string &text)
+{
+    std::vector<std::string> lines;
+    std::stringstream ss(text);
+    std::string line;
+    while (std::getline(ss, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static bool has_line(const std::vector<std::string> &lines, const std::string &expected)
+{
+    for (const auto &line : lines) {
+        if (line == expected) {
+            return true;
+        }
+    }
+    MAPF_ERR("missing line: " << expected);
+    return false;
+}
+
+// Every value falls in the bucket whose bounds surround it, with a relative error below
+// 1 / SUB_BUCKETS
+static void test_bucket_bounds(int &errors)
+{
+    int mismatches    = 0;
+    size_t last_index = 0;
+    for (uint64_t usec = 0; usec < (1 << 20); usec++) {
+        size_t index   = histogram::bucket_index(usec);
+        uint64_t upper = histogram::bucket_upper_bound(index);
+        uint64_t lower = index ? histogram::bucket_upper_bound(index - 1) : 0;
+        // The first buckets hold a single value each
+        bool too_wide =
+            usec >= histogram::SUB_BUCKETS && (upper - lower) * histogram::SUB_BUCKETS > upper;
+        if (index < last_index || usec < lower || usec >= upper || too_wide) {
+            MAPF_ERR(usec << " usec: bucket " << index << " [" << lower << ", " << upper << ")");
+            mismatches++;
+        }
+        last_index = index;
+    }
+    check(errors, mismatches == 0, "bucket_index within the bucket bounds, 0..2^20 usec");
+
+    mismatches = 0;
+    for (size_t index = 1; index < histogram::NUM_BUCKETS; index++) {
+        uint64_t lower = histogram::bucket_upper_bound(index - 1);
+        if (histogram::bucket_index(lower) != index ||
+            histogram::bucket_index(histogram::bucket_upper_bound(index) - 1) != index) {
+            MAPF_ERR("bucket " << index << " does not hold its bounds");
+            mismatches++;
+        }
+    }
+    check(errors, mismatches == 0, "bucket_upper_bound consistent with bucket_index");
+
+    check(errors, histogram::bucket_index(UINT64_MAX) == histogram::NUM_BUCKETS - 1,
+          "values above the last bucket are counted in it");
+}
+
+static void test_prometheus_output(int &errors)
+{
+    auto &registry = registry::instance();
+
+    auto &events = registry.get_counter("beerocks_test_events_total", "Test events",
+                                        {{"kind", "a\"b"}});
+    events.inc();
+    events.inc(2);
+    check(errors, &registry.get_counter("beerocks_test_events_total", "", {{"kind", "a\"b"}}) ==
+                      &events,
+          "get_counter returns the registered counter");
+
+    registry.get_gauge("beerocks_test_depth", "Test depth\nsecond line").set(-5);
+
+    auto &latency = registry.get_histogram("beerocks_test_latency_seconds", "Test latency");
+    latency.observe(1);
+    latency.observe(1);
+    latency.observe(1000000);
+
+    auto lines = split_lines(registry.to_prometheus());
+
+    check(errors,
+          has_line(lines, "# HELP beerocks_test_events_total Test events") &&
+              has_line(lines, "# TYPE beerocks_test_events_total counter") &&
+              has_line(lines, "beerocks_test_events_total{kind=\"a\\\"b\"} 3"),
+          "counter output");
+
+    check(errors,
+          has_line(lines, "# HELP beerocks_test_depth Test depth\\nsecond line") &&
+              has_line(lines, "# TYPE beerocks_test_depth gauge") &&
+              has_line(lines, "beerocks_test_depth -5"),
+          "gauge output");
+
+    // Only the non empty buckets are written, with cumulative counts
+    std::stringstream one_sec_bound;
+    one_sec_bound.precision(15);
+    one_sec_bound << double(histogram::bucket_upper_bound(histogram::bucket_index(1000000))) /
+                         1000000.0;
+    check(errors,
+          has_line(lines, "# TYPE beerocks_test_latency_seconds histogram") &&
+              has_line(lines, "beerocks_test_latency_seconds_bucket{le=\"2e-06\"} 2") &&
+              has_line(lines, "beerocks_test_latency_seconds_bucket{le=\"" +
+                                  one_sec_bound.str() + "\"} 3") &&
+              has_line(lines, "beerocks_test_latency_seconds_bucket{le=\"+Inf\"} 3") &&
+              has_line(lines, "beerocks_test_latency_seconds_sum 1.000002") &&
+              has_line(lines, "beerocks_test_latency_seconds_count 3"),
+          "histogram output");
+
+    int bucket_lines = 0;
+    for (const auto &line : lines) {
+        if (line.compare(0, 37, "beerocks_test_latency_seconds_bucket{") == 0) {
+            bucket_lines++;
+        }
+    }
+    check(errors, bucket_lines == 3, "empty histogram buckets are omitted");
+}
+
+int main()
+{
+    mapf::Logger::Instance().LoggerInit("metrics_test");
+    int errors = 0;
+
+    MAPF_INFO("Start metrics test");
+
+    test_bucket_bounds(errors);
+    test_prometheus_output(errors);
+
+    return errors;
+}
@@ -0,0 +1,191 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <bcl/beerocks_string_utils.h>
+#include <bcl/network/network_utils.h>
+#include <mapf/common/logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+using namespace beerocks;
+using namespace beerocks::net;
+
+static bool check(int &errors, bool check, std::string message)
+{
+    if (check) {
+        MAPF_INFO(" OK  ") << message;
+    } else {
+        MAPF_ERR("FAIL ") << message;
+        errors++;
+    }
+    return check;
+}
+
+// Reference implementations, as they were before the allocation free parser
+
+static std::string ref_mac_to_string(const uint8_t *mac_address)
+{
+    return string_utils::int_to_hex_string((uint32_t)mac_address[0], 2) + ":" +
+           string_utils::int_to_hex_string((uint32_t)mac_address[1], 2) + ":" +
+           string_utils::int_to_hex_string((uint32_t)mac_address[2], 2) + ":" +
+           string_utils::int_to_hex_string((uint32_t)mac_address[3], 2) + ":" +
+           string_utils::int_to_hex_string((uint32_t)mac_address[4], 2) + ":" +
+           string_utils::int_to_hex_string((uint32_t)mac_address[5], 2);
+}
+
+// Throws on malformed input, as std::stoul does
+static void ref_mac_from_string(uint8_t *buf, const std::string &mac)
+{
+    if (mac.empty()) {
+        memset(buf, 0, MAC_ADDR_LEN);
+    } else {
+        std::stringstream mac_ss(mac);
+        std::string token;
+
+        for (int i = 0; i < MAC_ADDR_LEN; i++) {
+            std::getline(mac_ss, token, ':');
+            buf[i] = std::stoul(token, nullptr, 16);
+        }
+    }
+}
+
+static bool ref_is_valid_mac(std::string mac)
+{
+    if (mac.size() != MAC_ADDR_STRING_LEN) {
+        return false;
+    }
+    std::transform(mac.begin(), mac.end(), mac.begin(), ::tolower);
+    uint8_t str[20];
+    try {
+        ref_mac_from_string(str, mac);
+    } catch (const std::exception &) {
+        return false;
+    }
+    return (mac == ref_mac_to_string(str));
+}
+
+static void test_mac_to_string(int &errors)
+{
+    const uint8_t macs[][MAC_ADDR_LEN] = {{0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+                                          {0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+                                          {0x00, 0x1a, 0x2b, 0x3c, 0x4d, 0x5e},
+                                          {0xa0, 0x09, 0xf1, 0x80, 0x7f, 0x01}};
+
+    for (auto &mac : macs) {
+        char buf[MAC_ADDR_STRING_LEN + 1];
+        network_utils::mac_to_string(mac, buf);
+        auto expected = ref_mac_to_string(mac);
+        check(errors, expected == buf, "mac_to_string(buf) " + expected);
+        check(errors, expected == network_utils::mac_to_string(mac), "mac_to_string " + expected);
+
+        std::stringstream ss;
+        sMacAddr addr;
+        std::copy_n(mac, MAC_ADDR_LEN, addr.oct);
+        ss << addr;
+        check(errors, ss.str() == expected, "operator<< " + expected);
+    }
+}
+
+static void test_mac_from_string(int &errors)
+{
+    const char *inputs[] = {
+        // Strict format, parsed by parse_mac()
+        "00:00:00:00:00:00", "ff:ff:ff:ff:ff:ff", "00:1a:2b:3c:4d:5e", "00:1A:2B:3C:4D:5E",
+        "a0:09:F1:80:7f:01",
+        // Lenient formats, parsed by the strtoul fallback
+        "", "0:1:2:3:4:5", "a:b:c:d:e:f", "00:11:22:33:44:55:66", "0x1:0x2:3:4:5:6",
+        // Malformed, the reference parser throws
+        "zz:11:22:33:44:55", "00-11-22-33-44-55"};
+
+    for (auto input : inputs) {
+        sMacAddr parsed = network_utils::mac_from_string(input);
+
+        sMacAddr strict;
+        bool is_strict = network_utils::parse_mac(input, strict);
+        check(errors, is_strict == ref_is_valid_mac(input),
+              std::string("parse_mac/is_valid_mac parity \"") + input + "\"");
+        check(errors, network_utils::is_valid_mac(input) == ref_is_valid_mac(input),
+              std::string("is_valid_mac parity \"") + input + "\"");
+        if (is_strict) {
+            check(errors, strict == parsed,
+                  std::string("parse_mac and mac_from_string agree \"") + input + "\"");
+        }
+
+        uint8_t expected[MAC_ADDR_LEN];
+        try {
+            ref_mac_from_string(expected, input);
+        } catch (const std::exception &) {
+            // Used to throw, now parsed leniently without throwing
+            continue;
+        }
+        check(errors, std::equal(expected, expected + MAC_ADDR_LEN, parsed.oct),
+              std::string("mac_from_string parity \"") + input + "\"");
+    }
+
+    // Missing octets are zero, the reference parser repeated the last octet
+    check(errors,
+          network_utils::mac_from_string("00:11:22") ==
+              network_utils::mac_from_string("00:11:22:00:00:00"),
+          "missing octets are zero");
+
+    // The output is left untouched on failure
+    sMacAddr mac = network_utils::mac_from_string("01:02:03:04:05:06");
+    check(errors, !network_utils::parse_mac("01:02:03:04:05", mac) &&
+                      mac == network_utils::mac_from_string("01:02:03:04:05:06"),
+          "parse_mac keeps the output on failure");
+    check(errors, !network_utils::parse_mac("01:02:03:04:05:0", mac), "truncated last octet");
+    check(errors, !network_utils::parse_mac("01:02:03:04:05:06 ", mac), "trailing characters");
+}
+
+// Not a pass/fail check, prints the cost of a round trip with the old and the new code
+static void benchmark(int iterations)
+{
+    const std::string input = "a0:09:f1:80:7f:01";
+    uint8_t mac[MAC_ADDR_LEN];
+    size_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        ref_mac_from_string(mac, input);
+        sink += ref_mac_to_string(mac).size();
+    }
+    auto ref_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sMacAddr addr;
+        network_utils::parse_mac(input.c_str(), addr);
+        char buf[MAC_ADDR_STRING_LEN + 1];
+        network_utils::mac_to_string(addr.oct, buf);
+        sink += buf[0];
+    }
+    auto new_time = std::chrono::steady_clock::now() - start;
+
+    using ns = std::chrono::nanoseconds;
+    MAPF_INFO("mac parse + format round trip: "
+              << std::chrono::duration_cast<ns>(ref_time).count() / iterations << " ns before, "
+              << std::chrono::duration_cast<ns>(new_time).count() / iterations << " ns now ("
+              << sink << ")");
+}
+
+int main()
+{
+    mapf::Logger::Instance().LoggerInit("network_utils_test");
+    int errors = 0;
+
+    MAPF_INFO("Start network_utils test");
+
+    test_mac_to_string(errors);
+    test_mac_from_string(errors);
+    benchmark(100000);
+
+    return errors;
+}
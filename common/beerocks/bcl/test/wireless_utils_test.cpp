@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <bcl/son/son_wireless_utils.h>
+#include <mapf/common/logger.h>
+
+#include <cmath>
+#include <string>
+
+using namespace son;
+
+static bool check(int &errors, bool check, std::string message)
+{
+    if (check) {
+        MAPF_INFO(" OK  ") << message;
+    } else {
+        MAPF_ERR("FAIL ") << message;
+        errors++;
+    }
+    return check;
+}
+
+// Reference conversion, without the lookup table
+static int ref_watt_to_db(float watt) { return int(std::lround(10 * std::log10(watt))); }
+
+// The monitor averages the linear values of the station samples of a measurement window
+static void test_averaged_samples(int &errors)
+{
+    int mismatches = 0;
+    for (int db = -100; db <= -20; db++) {
+        for (int samples = 1; samples <= 8; samples++) {
+            float sum = 0;
+            for (int i = 0; i < samples; i++) {
+                sum += wireless_utils::db_to_watt(db);
+            }
+            float avg = sum / float(samples);
+
+            int result = wireless_utils::watt_to_db(avg);
+            if (result != db || result != ref_watt_to_db(avg)) {
+                MAPF_ERR(samples << " samples at " << db << " dB: " << result
+                                 << " dB, reference " << ref_watt_to_db(avg) << " dB");
+                mismatches++;
+            }
+        }
+    }
+    check(errors, mismatches == 0, "watt_to_db of averaged samples, -100..-20 dB, 1-8 samples");
+}
+
+static void test_between_levels(int &errors)
+{
+    int mismatches = 0;
+    // Steps of 0.1 dB offset by 0.05 dB, never on a midpoint between two levels
+    for (int step = -1000; step < -200; step++) {
+        float watt = std::pow(10.0f, (float(step) + 0.5f) / 100.0f);
+        int result = wireless_utils::watt_to_db(watt);
+        if (result != ref_watt_to_db(watt)) {
+            MAPF_ERR(10 * std::log10(watt) << " dB: " << result << " dB, reference "
+                                           << ref_watt_to_db(watt) << " dB");
+            mismatches++;
+        }
+    }
+    check(errors, mismatches == 0, "watt_to_db between levels, -100..-20 dB");
+}
+
+static void test_limits(int &errors)
+{
+    check(errors, wireless_utils::db_to_watt(0) == 1.0f, "db_to_watt(0)");
+    check(errors, wireless_utils::watt_to_db(1.0f) == 0, "watt_to_db(1)");
+    check(errors, wireless_utils::watt_to_db(0.0f) == INT8_MIN, "watt_to_db(0) is clamped");
+    check(errors, wireless_utils::watt_to_db(1e20f) == INT8_MAX, "watt_to_db(1e20) is clamped");
+}
+
+int main()
+{
+    mapf::Logger::Instance().LoggerInit("wireless_utils_test");
+    int errors = 0;
+
+    MAPF_INFO("Start wireless_utils test");
+
+    test_averaged_samples(errors);
+    test_between_levels(errors);
+    test_limits(errors);
+
+    return errors;
+}
@@ -6,9 +6,9 @@
  * See LICENSE file for more details.
  */
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
 #include <btl/btl.h>
-#include <easylogging++.h>
 
 using namespace beerocks::btl;
 using namespace beerocks::net;
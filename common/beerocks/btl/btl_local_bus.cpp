@@ -6,9 +6,10 @@
  * See LICENSE file for more details.
  */
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
 #include <btl/btl.h>
-#include <easylogging++.h>
+#include <mapf/common/cmdu_trace.h>
 #include <mapf/local_bus.h>
 #include <mapf/transport/ieee1905_transport.h>
 
@@ -205,7 +206,8 @@ bool transport_socket_thread::handle_cmdu_message_bus()
                 uds_header->src_bridge_mac);
     std::copy_n((uint8_t *)cmdu_rx_msg->metadata()->dst, sizeof(mapf::CmduRxMessage::Metadata::dst),
                 uds_header->dst_bridge_mac);
-    uds_header->length = cmdu_rx_msg->metadata()->length;
+    uds_header->length   = cmdu_rx_msg->metadata()->length;
+    uds_header->trace_id = cmdu_rx_msg->metadata()->trace_id;
 
     if (!verify_cmdu(uds_header)) {
         THREAD_LOG(ERROR) << "Failed verifying cmdu header";
@@ -218,7 +220,7 @@ bool transport_socket_thread::handle_cmdu_message_bus()
         return false;
     }
 
-    if (!handle_cmdu(nullptr, cmdu_rx)) {
+    if (!handle_cmdu_traced(nullptr, uds_header)) {
         return false;
     }
 
@@ -237,8 +239,12 @@ bool transport_socket_thread::bus_send(ieee1905_1::CmduMessage &cmdu, const std:
     msg.metadata()->length            = length;
     msg.metadata()->msg_type          = static_cast<uint16_t>(cmdu.getMessageType());
     msg.metadata()->preset_message_id = cmdu.getMessageId() ? 1 : 0;
+    msg.metadata()->trace_id          = mapf::cmdu_trace::current_trace_id();
 
     std::copy_n((uint8_t *)cmdu.getMessageBuff(), msg.metadata()->length, (uint8_t *)msg.data());
+
+    mapf::cmdu_trace::record(mapf::cmdu_trace::eHop::BUS_TX, msg.metadata()->trace_id,
+                             msg.metadata()->msg_type, cmdu.getMessageId());
     return bus->publisher().Send(msg);
 }
 
@@ -265,6 +271,10 @@ bool transport_socket_thread::work()
 
     after_select(num_events == 0);
 
+    if (m_ready_events) {
+        m_ready_events->set(num_events);
+    }
+
     if (num_events == 0) {
         //THREAD_LOG(DEBUG) << "poll timeout";
         return true;
@@ -302,7 +312,11 @@ bool transport_socket_thread::work()
         return true;
 
     // read from UDS
+    // Events of the sockets which are polled but not in the vector (add_socket() with
+    // add_to_vector=false) are handled by the derived class in after_select()
+    int prev_num_events;
     do {
+        prev_num_events = num_events;
         for (unsigned int i = 0; i < sockets.size() && num_events > 0; i++) {
             if (read_ready(sockets.at(i))) {
                 num_events--;
@@ -320,7 +334,7 @@ bool transport_socket_thread::work()
                 }
             }
         }
-    } while (num_events);
+    } while (num_events && num_events != prev_num_events);
 
     return true;
 }
@@ -7,9 +7,10 @@
  */
 
 #include <bcl/beerocks_backport.h>
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
 #include <btl/btl.h>
-#include <easylogging++.h>
+#include <mapf/common/cmdu_trace.h>
 
 using namespace beerocks::btl;
 using namespace beerocks::net;
@@ -115,9 +116,12 @@ bool transport_socket_thread::bus_send(ieee1905_1::CmduMessage &cmdu, const std:
         THREAD_LOG(ERROR) << "uds_header=nullptr";
         return false;
     }
-    uds_header->length = length;
+    uds_header->length   = length;
+    uds_header->trace_id = mapf::cmdu_trace::current_trace_id();
     net::network_utils::mac_from_string(uds_header->src_bridge_mac, src_mac);
     net::network_utils::mac_from_string(uds_header->dst_bridge_mac, dst_mac);
+    mapf::cmdu_trace::record(mapf::cmdu_trace::eHop::BUS_TX, uds_header->trace_id,
+                             uint16_t(cmdu.getMessageType()), cmdu.getMessageId());
     return message_com::send_data(bus, cmdu.getMessageBuff() - sizeof(message::sUdsHeader),
                                   uds_header->length + sizeof(message::sUdsHeader));
 }
@@ -8,7 +8,9 @@
 
 #include <bwl/base_wlan_hal.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
+
+#include <algorithm>
 
 #include <errno.h>
 #include <sys/eventfd.h>
@@ -25,13 +27,22 @@ base_wlan_hal::base_wlan_hal(HALType type, std::string iface_name, IfaceType ifa
     m_radio_info.iface_name = iface_name;
     m_radio_info.iface_type = iface_type;
 
-    // Create an eventfd for internal events
-    if ((m_fd_int_events = eventfd(0, EFD_SEMAPHORE)) < 0) {
+    // Create an eventfd for internal events.
+    // Not a semaphore, a single read returns the number of queued events.
+    if ((m_fd_int_events = eventfd(0, 0)) < 0) {
         LOG(FATAL) << "Failed creating eventfd: " << strerror(errno);
     }
 
     // Initialize complex containers of the radio_info structure
     m_radio_info.supported_channels.resize(128 /* TODO: Get real value */);
+
+    auto &registry      = beerocks::metrics::registry::instance();
+    m_event_queue_depth = &registry.get_gauge("beerocks_bwl_event_queue_depth",
+                                              "Number of HAL events handled in the last batch",
+                                              {{"iface", iface_name}});
+    m_events_dropped    = &registry.get_counter("beerocks_bwl_events_dropped_total",
+                                                "Number of HAL events dropped on a full queue",
+                                                {{"iface", iface_name}});
 }
 
 base_wlan_hal::~base_wlan_hal()
@@ -45,12 +56,14 @@ base_wlan_hal::~base_wlan_hal()
 
 bool base_wlan_hal::event_queue_push(int event, std::shared_ptr<void> data)
 {
-    // Create a new shared pointer of the event and the payload
-    auto event_ptr = std::make_shared<hal_event_t>(hal_event_t(event, data));
-
     // Push the event into the queue
-    // push with block (default true) can't return false
-    m_queue_events.push(event_ptr);
+    if (!m_queue_events.push(hal_event_t(event, std::move(data)))) {
+        LOG(ERROR) << "Events queue is full, dropping event " << event;
+        if (m_events_dropped) {
+            m_events_dropped->inc();
+        }
+        return false;
+    }
 
     // Increment the eventfd counter by 1
     uint64_t counter = 1;
@@ -64,30 +77,79 @@ bool base_wlan_hal::event_queue_push(int event, std::shared_ptr<void> data)
 
 bool base_wlan_hal::process_int_events()
 {
-    // Read the counter value of the eventfd
+    // Read (and reset) the counter value of the eventfd
     uint64_t counter = 0;
     if (read(m_fd_int_events, &counter, sizeof(counter)) < 0) {
         LOG(ERROR) << "Failed reading eventfd counter: " << strerror(errno);
         return false;
     }
 
-    // Pop an event from the queue
-    auto event = m_queue_events.pop(false);
+    if (!counter) {
+        LOG(WARNING) << "process_int_events() called but the eventfd counter = " << counter;
+        return false;
+    }
 
-    if (!event || !counter) {
-        LOG(WARNING) << "process_int_events() called by the event queue pointer is " << event
-                     << " and/or eventfd counter = " << counter;
+    // Pop all the queued events.
+    // The queue may already be empty, if the events were pushed after the eventfd counter
+    // was read but before the previous call popped them.
+    m_events_batch.clear();
+    if (!m_queue_events.pop_all(m_events_batch)) {
+        return true;
+    }
 
-        return false;
+    if (m_event_queue_depth) {
+        m_event_queue_depth->set(m_events_batch.size());
     }
 
-    // Call the callback for handling the event
+    // Call the callback for handling the events
     if (!m_int_event_cb) {
         LOG(ERROR) << "Event callback not registered!";
         return false;
     }
 
-    return m_int_event_cb(event);
+    bool ret = true;
+    for (auto &event : m_events_batch) {
+        if (!m_int_event_cb(event)) {
+            ret = false;
+        }
+    }
+
+    // Release the payloads
+    m_events_batch.clear();
+
+    return ret;
+}
+
+beerocks::metrics::histogram &base_wlan_hal::hal_call_time(const std::string &call)
+{
+    // Compare the command name in place, without building a temporary string
+    auto len = std::min(call.find(' '), call.size());
+    for (auto &call_time : m_hal_call_time) {
+        if (call_time.first.size() == len && call.compare(0, len, call_time.first) == 0) {
+            return *call_time.second;
+        }
+    }
+
+    auto name       = call.substr(0, len);
+    auto &histogram = register_hal_call_time(name);
+    m_hal_call_time.emplace_back(name, &histogram);
+    return histogram;
+}
+
+beerocks::metrics::histogram &base_wlan_hal::register_hal_call_time(const std::string &name)
+{
+    return beerocks::metrics::registry::instance().get_histogram(
+        "beerocks_bwl_hal_call_seconds", "Time spent in a call to the driver or control interface",
+        {{"iface", m_iface_name}, {"call", name}});
+}
+
+std::shared_ptr<void> base_wlan_hal::event_payload_alloc(size_t size)
+{
+    auto buffer = m_event_payload_pool.get();
+    buffer->assign(size, 0);
+
+    // Share the ownership of the buffer, without allocating a new control block
+    return std::shared_ptr<void>(buffer, buffer->data());
 }
 
 } // namespace bwl
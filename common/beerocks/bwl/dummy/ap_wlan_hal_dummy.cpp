@@ -9,13 +9,13 @@
 #include "ap_wlan_hal_dummy.h"
 
 #include <bcl/beerocks_defines.h>
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_os_utils.h>
 #include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/beerocks_version.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 #include <math.h>
 
 //////////////////////////////////////////////////////////////////////////////
@@ -13,7 +13,7 @@
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 #include <limits.h>
 #include <sys/inotify.h>
 
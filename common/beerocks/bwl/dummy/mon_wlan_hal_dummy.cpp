@@ -11,7 +11,7 @@
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 #include <cmath>
 
@@ -105,6 +105,18 @@ bool mon_wlan_hal_dummy::update_stations_stats(const std::string vap_iface_name,
     return true;
 }
 
+bool mon_wlan_hal_dummy::update_vap_stations_stats(const std::string &vap_iface_name,
+                                                   sta_stats_map_t &sta_stats)
+{
+    bool ret = true;
+    for (auto &sta : sta_stats) {
+        if (!update_stations_stats(vap_iface_name, sta.first, *sta.second)) {
+            ret = false;
+        }
+    }
+    return ret;
+}
+
 bool mon_wlan_hal_dummy::sta_channel_load_11k_request(const SStaChannelLoadRequest11k &req)
 {
     LOG(TRACE) << __func__;
@@ -39,6 +39,8 @@ public:
     virtual bool update_vap_stats(const std::string vap_iface_name, SVapStats &vap_stats) override;
     virtual bool update_stations_stats(const std::string vap_iface_name, const std::string sta_mac,
                                        SStaStats &sta_stats) override;
+    virtual bool update_vap_stations_stats(const std::string &vap_iface_name,
+                                           sta_stats_map_t &sta_stats) override;
     virtual bool sta_channel_load_11k_request(const SStaChannelLoadRequest11k &req) override;
     virtual bool sta_beacon_11k_request(const SBeaconRequest11k &req, int &dialog_token) override;
     virtual bool sta_statistics_11k_request(const SStatisticsRequest11k &req) override;
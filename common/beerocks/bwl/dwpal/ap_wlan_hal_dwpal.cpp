@@ -9,13 +9,13 @@
 #include "ap_wlan_hal_dwpal.h"
 
 #include <bcl/beerocks_defines.h>
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_os_utils.h>
 #include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/beerocks_version.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 #include <math.h>
 
 #ifdef USE_LIBSAFEC
@@ -40,13 +40,6 @@ namespace dwpal {
 #define WLAN_FC_STYPE_PROBE_REQ 4
 #define WLAN_FC_STYPE_AUTH 11
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 // Temporary storage for parsed ACS report
 struct DWPAL_acs_report_get {
     int Ch;
@@ -318,11 +311,11 @@ static void parse_rrm_capabilities(int *RRM_CAPS, beerocks::message::sRadioCapab
     sta_caps.fmt_range_report      = ((RRM_CAPS[4] & WLAN_RRM_CAPS_FTM_RANGE_REPORT) != 0);
 }
 
-static std::shared_ptr<char> generate_client_assoc_event(const std::string &event, int vap_id,
-                                                         bool radio_5G)
+std::shared_ptr<void> ap_wlan_hal_dwpal::generate_client_assoc_event(const std::string &event,
+                                                                     int vap_id, bool radio_5G)
 {
     // TODO: Change to HAL objects
-    auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
+    auto msg_buff = event_payload_alloc(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
     auto msg = reinterpret_cast<sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION *>(msg_buff.get());
 
     if (!msg) {
@@ -330,8 +323,6 @@ static std::shared_ptr<char> generate_client_assoc_event(const std::string &even
         return nullptr;
     }
 
-    // Initialize the message
-    memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
     memset((char *)&msg->params.capabilities, 0, sizeof(msg->params.capabilities));
 
     char client_mac[MAC_ADDR_SIZE] = {0};
@@ -1803,13 +1794,11 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
+            event_payload_alloc(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
         memset((char *)&msg->params.capabilities, 0, sizeof(msg->params.capabilities));
 
         char VAP[SSID_MAX_SIZE]        = {0};
@@ -1921,14 +1910,11 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
     case Event::STA_Disconnected: {
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
+            event_payload_alloc(sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
-
         char VAP[SSID_MAX_SIZE]        = {0};
         char MACAddress[MAC_ADDR_SIZE] = {0};
         size_t numOfValidArgs[6]       = {0};
@@ -1971,14 +1957,11 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
     case Event::STA_Unassoc_RSSI: {
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
+            event_payload_alloc(sizeof(sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
         auto msg = reinterpret_cast<sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE));
-
         char MACAddress[MAC_ADDR_SIZE] = {0};
         char rssi[24]                  = {0};
         uint64_t rx_packets            = 0;
@@ -2103,14 +2086,11 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
         if (message_type == WLAN_FC_STYPE_PROBE_REQ) {
 
-            auto msg_buff =
-                ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_STEERING_EVENT_PROBE_REQ_NOTIFICATION));
+            auto msg_buff = event_payload_alloc(
+                sizeof(sACTION_APMANAGER_STEERING_EVENT_PROBE_REQ_NOTIFICATION));
             auto msg = reinterpret_cast<sACTION_APMANAGER_STEERING_EVENT_PROBE_REQ_NOTIFICATION *>(
                 msg_buff.get());
             LOG_IF(!msg, FATAL) << "Memory allocation failed!";
-            // Initialize the message
-            memset(msg_buff.get(), 0,
-                   sizeof(sACTION_APMANAGER_STEERING_EVENT_PROBE_REQ_NOTIFICATION));
 
             size_t numOfValidArgs[6] = {0};
 
@@ -2176,14 +2156,11 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
         } else if (message_type == WLAN_FC_STYPE_AUTH) {
 
-            auto msg_buff =
-                ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_STEERING_EVENT_AUTH_FAIL_NOTIFICATION));
+            auto msg_buff = event_payload_alloc(
+                sizeof(sACTION_APMANAGER_STEERING_EVENT_AUTH_FAIL_NOTIFICATION));
             auto msg = reinterpret_cast<sACTION_APMANAGER_STEERING_EVENT_AUTH_FAIL_NOTIFICATION *>(
                 msg_buff.get());
             LOG_IF(!msg, FATAL) << "Memory allocation failed!";
-            // Initialize the message
-            memset(msg_buff.get(), 0,
-                   sizeof(sACTION_APMANAGER_STEERING_EVENT_AUTH_FAIL_NOTIFICATION));
 
             size_t numOfValidArgs[7] = {0};
 
@@ -2267,13 +2244,10 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
     case Event::BSS_TM_Response: {
         // TODO: Change to HAL objects
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
+        auto msg_buff = event_payload_alloc(sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
         auto msg = reinterpret_cast<sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
-
         char MACAddress[MAC_ADDR_SIZE]                      = {0};
         int status_code                                     = 0;
         char vap_name[beerocks::message::IFACE_NAME_LENGTH] = {0};
@@ -2329,12 +2303,10 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION));
+            event_payload_alloc(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION));
         auto msg = reinterpret_cast<sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
-        // Initialize the message
-        memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_HOSTAP_DFS_CAC_COMPLETED_NOTIFICATION));
 
         uint8_t chan_width            = 0;
         size_t numOfValidArgs[6]      = {0};
@@ -2381,16 +2353,12 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
     case Event::DFS_NOP_Finished: {
         // TODO: Change to HAL objects
-        auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION));
+        auto msg_buff = event_payload_alloc(
+            sizeof(sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION));
         auto msg = reinterpret_cast<sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION *>(
             msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(msg_buff.get(), 0,
-               sizeof(sACTION_APMANAGER_HOSTAP_DFS_CHANNEL_AVAILABLE_NOTIFICATION));
-
         uint8_t chan_width            = 0;
         size_t numOfValidArgs[5]      = {0};
         FieldsToParse fieldsToParse[] = {
@@ -2433,7 +2401,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
     }
 
     case Event::AP_Disabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
+        auto msg_buff = event_payload_alloc(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
         auto msg      = reinterpret_cast<sHOSTAP_DISABLED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
@@ -2460,7 +2428,7 @@ bool ap_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std:
 
     } break;
     case Event::AP_Enabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_ENABLED_NOTIFICATION));
+        auto msg_buff = event_payload_alloc(sizeof(sHOSTAP_ENABLED_NOTIFICATION));
         auto msg      = reinterpret_cast<sHOSTAP_ENABLED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
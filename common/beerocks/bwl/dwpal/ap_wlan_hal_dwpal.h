@@ -86,6 +86,10 @@ protected:
     }
 
 private:
+    // Parse a STA connected event or a STA query reply into a client associated notification
+    std::shared_ptr<void> generate_client_assoc_event(const std::string &event, int vap_id,
+                                                      bool radio_5G);
+
     // Unassociated measurement state variables
     std::chrono::steady_clock::time_point m_unassoc_measure_start;
     int m_unassoc_measure_window_size = 0;
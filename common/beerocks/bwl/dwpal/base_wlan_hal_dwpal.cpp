@@ -13,7 +13,7 @@
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 extern "C" {
 #include <dwpal.h>
@@ -473,6 +473,8 @@ bool base_wlan_hal_dwpal::dwpal_send_cmd(const std::string &cmd, int vap_id)
         return false;
     }
 
+    beerocks::metrics::scoped_timer timer(hal_call_time(cmd));
+
     do {
         //LOG(DEBUG) << "Send dwpal cmd: " << cmd.c_str();
         result = dwpal_hostap_cmd_send(m_dwpal_ctx[ctx_index], cmd.c_str(), NULL, buffer,
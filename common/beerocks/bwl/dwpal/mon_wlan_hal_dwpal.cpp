@@ -12,7 +12,7 @@
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 #include <net/if.h>
 
 #include <cmath>
@@ -50,13 +50,6 @@ enum ie_type : uint8_t {
 #define WLAN_CAPABILITY_PRIVACY (1 << 4)
 #define GET_OP_CLASS(channel) ((channel < 14) ? 4 : 5)
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////////// Local Module Functions ///////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -107,6 +100,133 @@ static void calc_curr_traffic(const uint64_t val, uint64_t &total, uint32_t &cur
     total = val;
 }
 
+// GET_STA_MEASUREMENTS reply fields required to update the station statistics
+enum sta_measurements_field : uint16_t {
+    STA_MEAS_BYTES_SENT          = 1 << 0,
+    STA_MEAS_BYTES_RECEIVED      = 1 << 1,
+    STA_MEAS_PACKETS_SENT        = 1 << 2,
+    STA_MEAS_PACKETS_RECEIVED    = 1 << 3,
+    STA_MEAS_RETRANS_COUNT       = 1 << 4,
+    STA_MEAS_RSSI                = 1 << 5,
+    STA_MEAS_SNR                 = 1 << 6,
+    STA_MEAS_ACTIVE              = 1 << 7,
+    STA_MEAS_DOWNLINK_RATE       = 1 << 8,
+    STA_MEAS_UPLINK_RATE         = 1 << 9,
+    STA_MEAS_ALL_REQUIRED_FIELDS = (1 << 10) - 1,
+};
+
+// Accumulate a space separated list of dB values, in watt
+static void accumulate_watt(const char *value, const char *value_end, int min_db, float &acc_watt,
+                            uint8_t &samples_cnt)
+{
+    while (value < value_end) {
+        char *next;
+        long db = strtol(value, &next, 10);
+        if (next == value) {
+            break;
+        }
+        if (db > min_db) {
+            acc_watt += std::pow(10, float(db) / float(10));
+            samples_cnt++;
+        }
+        value = next;
+    }
+}
+
+/**
+ * @brief Parse a GET_STA_MEASUREMENTS reply into the station statistics.
+ *
+ * The reply is made of "Name=Value" lines, with space separated values for arrays.
+ * Values are converted in place while scanning the reply, without intermediate strings.
+ *
+ * @param [in] reply Reply buffer.
+ * @param [in] reply_len Length of the reply.
+ * @param [in,out] sta_stats Station statistics to update.
+ * @return true on success, false if a required field is missing.
+ */
+static bool parse_sta_measurements(const char *reply, size_t reply_len, SStaStats &sta_stats)
+{
+    uint64_t bytes_sent = 0, bytes_received = 0, packets_sent = 0, packets_received = 0,
+             downlink_rate = 0, uplink_rate = 0;
+    uint32_t retrans_count = 0;
+    float rssi_watt = 0, snr_watt = 0;
+    uint8_t rssi_samples_cnt = 0, snr_samples_cnt = 0;
+    uint16_t found_fields = 0;
+
+    const char *end = reply + reply_len;
+    for (const char *line = reply; line < end;) {
+        auto line_end = static_cast<const char *>(memchr(line, '\n', end - line));
+        if (!line_end) {
+            line_end = end;
+        }
+
+        auto separator = static_cast<const char *>(memchr(line, '=', line_end - line));
+        if (separator) {
+            size_t name_len   = separator - line;
+            const char *value = separator + 1;
+            auto name_is      = [&](const char *name) {
+                return strlen(name) == name_len && !strncmp(line, name, name_len);
+            };
+
+            if (name_is("BytesSent")) {
+                bytes_sent = strtoull(value, nullptr, 10);
+                found_fields |= STA_MEAS_BYTES_SENT;
+            } else if (name_is("BytesReceived")) {
+                bytes_received = strtoull(value, nullptr, 10);
+                found_fields |= STA_MEAS_BYTES_RECEIVED;
+            } else if (name_is("PacketsSent")) {
+                packets_sent = strtoull(value, nullptr, 10);
+                found_fields |= STA_MEAS_PACKETS_SENT;
+            } else if (name_is("PacketsReceived")) {
+                packets_received = strtoull(value, nullptr, 10);
+                found_fields |= STA_MEAS_PACKETS_RECEIVED;
+            } else if (name_is("RetransCount")) {
+                retrans_count = strtoul(value, nullptr, 10);
+                found_fields |= STA_MEAS_RETRANS_COUNT;
+            } else if (name_is("ShortTermRSSIAverage")) {
+                accumulate_watt(value, line_end, beerocks::RSSI_MIN, rssi_watt, rssi_samples_cnt);
+                found_fields |= STA_MEAS_RSSI;
+            } else if (name_is("SNR")) {
+                accumulate_watt(value, line_end, beerocks::SNR_MIN, snr_watt, snr_samples_cnt);
+                found_fields |= STA_MEAS_SNR;
+            } else if (name_is("Active")) {
+                found_fields |= STA_MEAS_ACTIVE;
+            } else if (name_is("LastDataDownlinkRate")) {
+                downlink_rate = strtoull(value, nullptr, 10);
+                found_fields |= STA_MEAS_DOWNLINK_RATE;
+            } else if (name_is("LastDataUplinkRate")) {
+                uplink_rate = strtoull(value, nullptr, 10);
+                found_fields |= STA_MEAS_UPLINK_RATE;
+            }
+        }
+
+        line = line_end + 1;
+    }
+
+    if ((found_fields & STA_MEAS_ALL_REQUIRED_FIELDS) != STA_MEAS_ALL_REQUIRED_FIELDS) {
+        LOG(ERROR) << "Missing station measurements, found fields mask: 0x" << std::hex
+                   << found_fields << std::dec;
+        return false;
+    }
+
+    sta_stats.retrans_count = retrans_count;
+
+    // Save the average RSSI and SNR in watt
+    sta_stats.rx_rssi_watt += rssi_watt;
+    sta_stats.rx_rssi_watt_samples_cnt += rssi_samples_cnt;
+    sta_stats.rx_snr_watt += snr_watt;
+    sta_stats.rx_snr_watt_samples_cnt += snr_samples_cnt;
+
+    sta_stats.tx_phy_rate_100kb = (downlink_rate / 100);
+    sta_stats.rx_phy_rate_100kb = (uplink_rate / 100);
+    calc_curr_traffic(bytes_sent, sta_stats.tx_bytes_cnt, sta_stats.tx_bytes);
+    calc_curr_traffic(bytes_received, sta_stats.rx_bytes_cnt, sta_stats.rx_bytes);
+    calc_curr_traffic(packets_sent, sta_stats.tx_packets_cnt, sta_stats.tx_packets);
+    calc_curr_traffic(packets_received, sta_stats.rx_packets_cnt, sta_stats.rx_packets);
+
+    return true;
+}
+
 /**
  * @brief get channel pool frquencies for channel scan parameters.
  *
@@ -596,84 +716,41 @@ bool mon_wlan_hal_dwpal::update_stations_stats(const std::string vap_iface_name,
         return false;
     }
 
-    size_t numOfValidArgs[10] = {0}, replyLen = strnlen(reply, HOSTAPD_TO_DWPAL_MSG_LENGTH);
-    uint64_t BytesSent = 0, BytesReceived = 0, PacketsSent = 0, PacketsReceived = 0,
-             LastDataDownlinkRate = 0, LastDataUplinkRate = 0, Active = 0;
-    char ShortTermRSSIAverage[32][HOSTAPD_TO_DWPAL_VALUE_STRING_LENGTH] = {'\0'};
-    char SNR[32][HOSTAPD_TO_DWPAL_VALUE_STRING_LENGTH]                  = {'\0'};
-    FieldsToParse fieldsToParse[]                                       = {
-        {(void *)&BytesSent, &numOfValidArgs[0], DWPAL_LONG_LONG_INT_PARAM, "BytesSent=", 0},
-        {(void *)&BytesReceived, &numOfValidArgs[1], DWPAL_LONG_LONG_INT_PARAM,
-         "BytesReceived=", 0},
-        {(void *)&PacketsSent, &numOfValidArgs[2], DWPAL_LONG_LONG_INT_PARAM, "PacketsSent=", 0},
-        {(void *)&PacketsReceived, &numOfValidArgs[3], DWPAL_LONG_LONG_INT_PARAM,
-         "PacketsReceived=", 0},
-        {(void *)&sta_stats.retrans_count, &numOfValidArgs[4], DWPAL_INT_PARAM, "RetransCount=", 0},
-        {(void *)ShortTermRSSIAverage, &numOfValidArgs[5], DWPAL_STR_ARRAY_PARAM,
-         "ShortTermRSSIAverage=", sizeof(ShortTermRSSIAverage)},
-        {(void *)SNR, &numOfValidArgs[6], DWPAL_STR_ARRAY_PARAM, "SNR=", sizeof(SNR)},
-        {(void *)&Active, &numOfValidArgs[7], DWPAL_LONG_LONG_INT_PARAM, "Active=", 0},
-        {(void *)&LastDataDownlinkRate, &numOfValidArgs[8], DWPAL_LONG_LONG_INT_PARAM,
-         "LastDataDownlinkRate=", 0},
-        {(void *)&LastDataUplinkRate, &numOfValidArgs[9], DWPAL_LONG_LONG_INT_PARAM,
-         "LastDataUplinkRate=", 0},
-
-        /* Must be at the end */
-        {NULL, NULL, DWPAL_NUM_OF_PARSING_TYPES, NULL, 0}};
-
-    if (dwpal_string_to_struct_parse(reply, replyLen, fieldsToParse, sizeof(SStaStats)) ==
-        DWPAL_FAILURE) {
-        LOG(ERROR) << "DWPAL parse error ==> Abort";
+    if (!parse_sta_measurements(reply, strnlen(reply, HOSTAPD_TO_DWPAL_MSG_LENGTH), sta_stats)) {
+        LOG(ERROR) << "Failed parsing the measurements of station " << sta_mac;
         return false;
     }
 
-    /* TEMP: Traces... */
-    // LOG(DEBUG) << "GET_STA_MEASUREMENTS reply= \n" << reply;
-    // LOG(DEBUG) << "numOfValidArgs[0]= " << numOfValidArgs[0] << " BytesSent= " << BytesSent;
-    // LOG(DEBUG) << "numOfValidArgs[1]= " << numOfValidArgs[1] << " BytesReceived= " << BytesReceived;
-    // LOG(DEBUG) << "numOfValidArgs[2]= " << numOfValidArgs[2] << " PacketsSent= " << PacketsSent;
-    // LOG(DEBUG) << "numOfValidArgs[3]= " << numOfValidArgs[3] << " PacketsReceived= " << PacketsReceived;
-    // LOG(DEBUG) << "numOfValidArgs[4]= " << numOfValidArgs[4] << " RetransCount= " << sta_stats.retrans_count;
-    // LOG(DEBUG) << "numOfValidArgs[5]= " << numOfValidArgs[5] << " ShortTermRSSIAverage= " << ShortTermRSSIAverage;
-    // LOG(DEBUG) << "numOfValidArgs[6]= " << numOfValidArgs[6] << " SNR= " << SNR;
-    // LOG(DEBUG) << "numOfValidArgs[0]= " << numOfValidArgs[7] << " Active= " << Active;
-    // LOG(DEBUG) << "numOfValidArgs[7]= " << numOfValidArgs[8] << " LastDataDownlinkRate= " << LastDataDownlinkRate;
-    // LOG(DEBUG) << "numOfValidArgs[8]= " << numOfValidArgs[9] << " LastDataUplinkRate= " << LastDataUplinkRate;
-    /* End of TEMP: Traces... */
+    return true;
+}
 
-    for (uint8_t i = 0; i < (sizeof(numOfValidArgs) / sizeof(size_t)); i++) {
-        if (numOfValidArgs[i] == 0) {
-            LOG(ERROR) << "Failed reading parsed parameter " << (int)i << " ==> Abort";
-            return false;
-        }
-    }
+bool mon_wlan_hal_dwpal::update_vap_stations_stats(const std::string &vap_iface_name,
+                                                   sta_stats_map_t &sta_stats)
+{
+    // hostapd reports the measurements of a single station per command, so the
+    // commands of all the stations are sent back to back on the same buffers
+    // and each reply is parsed straight into the station stats.
+    std::string cmd = "GET_STA_MEASUREMENTS " + vap_iface_name + " ";
+    auto prefix_len = cmd.length();
+
+    for (auto &sta : sta_stats) {
+        char *reply = nullptr;
 
-    //save avarage RSSI in watt
-    for (uint8_t i = 0; i < numOfValidArgs[5]; i++) {
-        float s_float = float(beerocks::string_utils::stoi(std::string(ShortTermRSSIAverage[i])));
-        if (s_float > beerocks::RSSI_MIN) {
-            sta_stats.rx_rssi_watt += std::pow(10, s_float / float(10));
-            sta_stats.rx_rssi_watt_samples_cnt++;
+        cmd.resize(prefix_len);
+        cmd += sta.first;
+
+        if (!dwpal_send_cmd(cmd, &reply)) {
+            LOG(ERROR) << __func__ << " failed";
+            return false;
         }
-    }
 
-    //save avarage SNR in watt
-    for (uint8_t i = 0; i < numOfValidArgs[6]; i++) {
-        float s_float = float(beerocks::string_utils::stoi(std::string(SNR[i])));
-        if (s_float > beerocks::SNR_MIN) {
-            sta_stats.rx_snr_watt += std::pow(10, s_float / float(10));
-            sta_stats.rx_snr_watt_samples_cnt++;
+        // A station which has just disconnected has no measurements, skip it
+        if (!parse_sta_measurements(reply, strnlen(reply, HOSTAPD_TO_DWPAL_MSG_LENGTH),
+                                    *sta.second)) {
+            LOG(WARNING) << "No measurements for station " << sta.first;
         }
     }
 
-    // TODO: Update RSSI externally!
-    sta_stats.tx_phy_rate_100kb = (LastDataDownlinkRate / 100);
-    sta_stats.rx_phy_rate_100kb = (LastDataUplinkRate / 100);
-    calc_curr_traffic(BytesSent, sta_stats.tx_bytes_cnt, sta_stats.tx_bytes);
-    calc_curr_traffic(BytesReceived, sta_stats.rx_bytes_cnt, sta_stats.rx_bytes);
-    calc_curr_traffic(PacketsSent, sta_stats.tx_packets_cnt, sta_stats.tx_packets);
-    calc_curr_traffic(PacketsReceived, sta_stats.rx_packets_cnt, sta_stats.rx_packets);
-
     return true;
 }
 
@@ -889,7 +966,7 @@ bool mon_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
     case Event::RRM_Beacon_Response: {
         LOG(DEBUG) << "RRM-BEACON-REP-RECEIVED buffer= \n" << buffer;
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SBeaconResponse11k));
+        auto resp_buff = event_payload_alloc(sizeof(SBeaconResponse11k));
         auto resp      = reinterpret_cast<SBeaconResponse11k *>(resp_buff.get());
 
         if (!resp) {
@@ -897,9 +974,6 @@ bool mon_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
             return false;
         }
 
-        // Initialize the message
-        memset(resp_buff.get(), 0, sizeof(SBeaconResponse11k));
-
         size_t numOfValidArgs[11]      = {0};
         char MACAddress[MAC_ADDR_SIZE] = {0}, bssid[MAC_ADDR_SIZE] = {0};
         FieldsToParse fieldsToParse[] = {
@@ -957,7 +1031,7 @@ bool mon_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
     }
 
     case Event::AP_Enabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_ENABLED_NOTIFICATION));
+        auto msg_buff = event_payload_alloc(sizeof(sHOSTAP_ENABLED_NOTIFICATION));
         if (!msg_buff) {
             LOG(FATAL) << "Memory allocation failed!";
             return false;
@@ -999,7 +1073,7 @@ bool mon_wlan_hal_dwpal::process_dwpal_event(char *buffer, int bufLen, const std
     }
 
     case Event::AP_Disabled: {
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
+        auto msg_buff = event_payload_alloc(sizeof(sHOSTAP_DISABLED_NOTIFICATION));
         if (!msg_buff) {
             LOG(FATAL) << "Memory allocation failed!";
             return false;
@@ -1106,7 +1180,8 @@ bool mon_wlan_hal_dwpal::process_dwpal_nl_event(struct nl_msg *msg)
         if (m_nl_seq == nlh->nlmsg_seq) {
             LOG(DEBUG) << "DWPAL NL event channel scan results dump, seq = " << int(nlh->nlmsg_seq);
 
-            auto results = std::make_shared<sCHANNEL_SCAN_RESULTS_NOTIFICATION>();
+            auto results = m_scan_results_pool.get();
+            *results     = {};
 
             if (!get_scan_results_from_nl_msg(results->channel_scan_results, msg)) {
                 LOG(ERROR) << "read NL msg to monitor msg failed!";
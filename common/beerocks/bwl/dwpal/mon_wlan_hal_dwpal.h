@@ -36,6 +36,8 @@ public:
     virtual bool update_vap_stats(const std::string vap_iface_name, SVapStats &vap_stats) override;
     virtual bool update_stations_stats(const std::string vap_iface_name, const std::string sta_mac,
                                        SStaStats &sta_stats) override;
+    virtual bool update_vap_stations_stats(const std::string &vap_iface_name,
+                                           sta_stats_map_t &sta_stats) override;
     virtual bool sta_channel_load_11k_request(const SStaChannelLoadRequest11k &req) override;
     virtual bool sta_beacon_11k_request(const SBeaconRequest11k &req, int &dialog_token) override;
     virtual bool sta_statistics_11k_request(const SStatisticsRequest11k &req) override;
@@ -113,6 +115,9 @@ private:
     std::shared_ptr<char> m_temp_dwpal_value;
     uint32_t m_nl_seq                                = 0;
     unsigned char m_nl_buffer[NL_MAX_REPLY_BUFFSIZE] = {'\0'};
+
+    // A scan results dump generates one event per neighbor BSS
+    beerocks::shared_object_pool<sCHANNEL_SCAN_RESULTS_NOTIFICATION> m_scan_results_pool{64};
 };
 
 } // namespace dwpal
@@ -11,7 +11,7 @@
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 namespace bwl {
 namespace dummy {
@@ -12,12 +12,15 @@
 #include "base_802_11_defs.h"
 #include "base_wlan_hal_types.h"
 
-#include <bcl/beerocks_thread_safe_queue.h>
+#include <bcl/beerocks_metrics.h>
+#include <bcl/beerocks_shared_object_pool.h>
+#include <bcl/beerocks_spsc_queue.h>
 #include <bcl/son/son_wireless_utils.h>
 
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace bwl {
 
@@ -30,8 +33,7 @@ class base_wlan_hal {
 public:
     // Pair of event ID and payload pointer
     typedef std::pair<int, std::shared_ptr<void>> hal_event_t;
-    typedef std::shared_ptr<hal_event_t> hal_event_ptr_t;
-    typedef std::function<bool(hal_event_ptr_t)> hal_event_cb_t;
+    typedef std::function<bool(const hal_event_t &)> hal_event_cb_t;
 
     // Public methods
 public:
@@ -105,6 +107,8 @@ public:
      * Process internal events (queued by the underlying hardware/middleware).
      * This method should be called if the file descriptor returned by
      * get_int_events_fd() generated an event.
+     * All the queued events are processed at once, the callback is invoked
+     * for each of them.
      *
      * @return true on success or false on error.
      */
@@ -192,6 +196,37 @@ protected:
      */
     bool event_queue_push(int event, std::shared_ptr<void> data = {});
 
+    /*!
+     * Allocate a zeroed event payload buffer.
+     * Buffers are taken from a pool, and return to it once the event
+     * consumer releases them.
+     *
+     * @param [in] size Payload size.
+     *
+     * @return Pointer to the payload buffer.
+     */
+    std::shared_ptr<void> event_payload_alloc(size_t size);
+
+    /*!
+     * Latency histogram of the calls to the hostapd/wpa_supplicant control interface, by the
+     * command name (the first word of the command).
+     *
+     * @param [in] call Command or message sent.
+     *
+     * @return Histogram of the command, to be timed with a metrics::scoped_timer.
+     */
+    beerocks::metrics::histogram &hal_call_time(const std::string &call);
+
+    /*!
+     * Register the latency histogram of a call to the driver or the control interface.
+     * Looked up once per command, the HALs keep the returned histogram.
+     *
+     * @param [in] name Name of the call.
+     *
+     * @return Histogram of the call.
+     */
+    beerocks::metrics::histogram &register_hal_call_time(const std::string &name);
+
     /*!
      * set a parameter in the interface
      *
@@ -231,7 +266,24 @@ private:
 
     hal_event_cb_t m_int_event_cb = nullptr;
 
-    beerocks::thread_safe_queue<hal_event_ptr_t> m_queue_events;
+    static const size_t EVENT_QUEUE_SIZE        = 1024;
+    static const size_t EVENT_PAYLOAD_POOL_SIZE = 64;
+
+    beerocks::spsc_queue<hal_event_t> m_queue_events{EVENT_QUEUE_SIZE};
+
+    // Events popped from the queue, reused between process_int_events() calls
+    std::vector<hal_event_t> m_events_batch;
+
+    beerocks::shared_object_pool<std::vector<uint8_t>> m_event_payload_pool{
+        EVENT_PAYLOAD_POOL_SIZE};
+
+    // Registered by the constructor, not by the default one used for virtual inheritance
+    beerocks::metrics::gauge *m_event_queue_depth = nullptr;
+    beerocks::metrics::counter *m_events_dropped  = nullptr;
+
+    // Latency histograms of the control interface commands, by name. A HAL only sends a few
+    // different commands, which are compared in place by hal_call_time().
+    std::vector<std::pair<std::string, beerocks::metrics::histogram *>> m_hal_call_time;
 };
 
 } // namespace bwl
@@ -11,6 +11,7 @@
 
 #include "base_wlan_hal.h"
 #include "mon_wlan_hal_types.h"
+#include <unordered_map>
 #include <vector>
 
 namespace bwl {
@@ -42,6 +43,9 @@ public:
         Channel_Scan_Finished
     };
 
+    // Statistics of the stations of a VAP, key = station mac
+    typedef std::unordered_map<std::string, SStaStats *> sta_stats_map_t;
+
     // Public methods:
 public:
     virtual ~mon_wlan_hal() = default;
@@ -51,6 +55,18 @@ public:
     virtual bool update_stations_stats(const std::string vap_iface_name, const std::string sta_mac,
                                        SStaStats &sta_stats)                              = 0;
 
+    /**
+     * @brief Update the statistics of several stations of a VAP at once.
+     *
+     * Stations which are not reported by the driver are left untouched.
+     *
+     * @param [in] vap_iface_name VAP interface name.
+     * @param [in,out] sta_stats Statistics of the stations to update.
+     * @return true on success, false otherwise.
+     */
+    virtual bool update_vap_stations_stats(const std::string &vap_iface_name,
+                                           sta_stats_map_t &sta_stats) = 0;
+
     virtual bool sta_channel_load_11k_request(const SStaChannelLoadRequest11k &req)      = 0;
     virtual bool sta_beacon_11k_request(const SBeaconRequest11k &req, int &dialog_token) = 0;
     virtual bool sta_statistics_11k_request(const SStatisticsRequest11k &req)            = 0;
@@ -14,7 +14,7 @@
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 #include <cmath>
 
@@ -35,13 +35,6 @@ namespace nl80211 {
 #define BUFFER_SIZE 4096
 #define CSA_EVENT_FILTERING_TIMEOUT_MS 1000
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 // Temporary storage for station capabilities
 struct SRadioCapabilitiesStrings {
     std::string supported_rates;
@@ -59,36 +52,24 @@ struct SRadioCapabilitiesStrings {
 /////////////////////////// Local Module Functions ///////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-static ap_wlan_hal::Event nl80211_to_bwl_event(const std::string &opcode)
-{
-    if (opcode == "AP-ENABLED") {
-        return ap_wlan_hal::Event::AP_Enabled;
-    } else if (opcode == "AP-DISABLED") {
-        return ap_wlan_hal::Event::AP_Disabled;
-    } else if (opcode == "AP-STA-CONNECTED") {
-        return ap_wlan_hal::Event::STA_Connected;
-    } else if (opcode == "AP-STA-DISCONNECTED") {
-        return ap_wlan_hal::Event::STA_Disconnected;
-    } else if (opcode == "INTERFACE-ENABLED") {
-        return ap_wlan_hal::Event::Interface_Enabled;
-    } else if (opcode == "INTERFACE-DISABLED") {
-        return ap_wlan_hal::Event::Interface_Disabled;
-    } else if (opcode == "ACS-STARTED") {
-        return ap_wlan_hal::Event::ACS_Started;
-    } else if (opcode == "ACS-COMPLETED") {
-        return ap_wlan_hal::Event::ACS_Completed;
-    } else if (opcode == "ACS-FAILED") {
-        return ap_wlan_hal::Event::ACS_Failed;
-    } else if (opcode == "AP-CSA-FINISHED") {
-        return ap_wlan_hal::Event::CSA_Finished;
-    } else if (opcode == "CTRL-EVENT-CHANNEL-SWITCH") {
-        return ap_wlan_hal::Event::CTRL_Channel_Switch;
-    } else if (opcode == "BSS-TM-RESP") {
-        return ap_wlan_hal::Event::BSS_TM_Response;
-    } else if (opcode == "DFS-CAC-COMPLETED") {
-        return ap_wlan_hal::Event::DFS_CAC_Completed;
-    } else if (opcode == "DFS-NOP-FINISHED") {
-        return ap_wlan_hal::Event::DFS_NOP_Finished;
+static ap_wlan_hal::Event nl80211_to_bwl_event(const char *opcode)
+{
+    switch (opcode_hash(opcode)) {
+        NL80211_OPCODE_CASE(opcode, "AP-ENABLED", ap_wlan_hal::Event::AP_Enabled);
+        NL80211_OPCODE_CASE(opcode, "AP-DISABLED", ap_wlan_hal::Event::AP_Disabled);
+        NL80211_OPCODE_CASE(opcode, "AP-STA-CONNECTED", ap_wlan_hal::Event::STA_Connected);
+        NL80211_OPCODE_CASE(opcode, "AP-STA-DISCONNECTED", ap_wlan_hal::Event::STA_Disconnected);
+        NL80211_OPCODE_CASE(opcode, "INTERFACE-ENABLED", ap_wlan_hal::Event::Interface_Enabled);
+        NL80211_OPCODE_CASE(opcode, "INTERFACE-DISABLED", ap_wlan_hal::Event::Interface_Disabled);
+        NL80211_OPCODE_CASE(opcode, "ACS-STARTED", ap_wlan_hal::Event::ACS_Started);
+        NL80211_OPCODE_CASE(opcode, "ACS-COMPLETED", ap_wlan_hal::Event::ACS_Completed);
+        NL80211_OPCODE_CASE(opcode, "ACS-FAILED", ap_wlan_hal::Event::ACS_Failed);
+        NL80211_OPCODE_CASE(opcode, "AP-CSA-FINISHED", ap_wlan_hal::Event::CSA_Finished);
+        NL80211_OPCODE_CASE(opcode, "CTRL-EVENT-CHANNEL-SWITCH",
+                            ap_wlan_hal::Event::CTRL_Channel_Switch);
+        NL80211_OPCODE_CASE(opcode, "BSS-TM-RESP", ap_wlan_hal::Event::BSS_TM_Response);
+        NL80211_OPCODE_CASE(opcode, "DFS-CAC-COMPLETED", ap_wlan_hal::Event::DFS_CAC_Completed);
+        NL80211_OPCODE_CASE(opcode, "DFS-NOP-FINISHED", ap_wlan_hal::Event::DFS_NOP_Finished);
     }
 
     return ap_wlan_hal::Event::Invalid;
@@ -596,12 +577,11 @@ bool ap_wlan_hal_nl80211::generate_connected_clients_events()
 
 std::string ap_wlan_hal_nl80211::get_radio_driver_version() { return "nl80211"; }
 
-bool ap_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj)
+bool ap_wlan_hal_nl80211::process_nl80211_event(const parsed_event_t &parsed_obj)
 {
     // Filter out empty events
-    std::string opcode;
-    if (!(parsed_obj.find("_opcode") != parsed_obj.end() &&
-          !(opcode = parsed_obj["_opcode"]).empty())) {
+    auto opcode = parsed_obj.opcode;
+    if (!opcode[0]) {
         return true;
     }
 
@@ -616,16 +596,13 @@ bool ap_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj)
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
+            event_payload_alloc(sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_CLIENT_ASSOCIATED_NOTIFICATION));
-
         msg->params.vap_id = 0;
-        msg->params.mac    = beerocks::net::network_utils::mac_from_string(parsed_obj["_mac"]);
+        msg->params.mac    = parsed_obj.mac_addr;
 
         // Add the message to the queue
         event_queue_push(Event::STA_Connected, msg_buff);
@@ -637,17 +614,14 @@ bool ap_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj)
 
         // TODO: Change to HAL objects
         auto msg_buff =
-            ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
+            event_payload_alloc(sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
         auto msg =
             reinterpret_cast<sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_CLIENT_DISCONNECTED_NOTIFICATION));
-
         // Store the MAC address of the disconnected STA
         msg->params.vap_id = 0;
-        msg->params.mac    = beerocks::net::network_utils::mac_from_string(parsed_obj["_mac"]);
+        msg->params.mac    = parsed_obj.mac_addr;
 
         // Add the message to the queue
         event_queue_push(Event::STA_Disconnected, msg_buff);
@@ -658,16 +632,13 @@ bool ap_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj)
     case Event::BSS_TM_Response: {
 
         // TODO: Change to HAL objects
-        auto msg_buff = ALLOC_SMART_BUFFER(sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
+        auto msg_buff = event_payload_alloc(sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
         auto msg = reinterpret_cast<sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE *>(msg_buff.get());
         LOG_IF(!msg, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(msg_buff.get(), 0, sizeof(sACTION_APMANAGER_CLIENT_BSS_STEER_RESPONSE));
-
         // Client params
-        msg->params.mac         = beerocks::net::network_utils::mac_from_string(parsed_obj["_mac"]);
-        msg->params.status_code = beerocks::string_utils::stoi(parsed_obj["status_code"]);
+        msg->params.mac         = parsed_obj.mac_addr;
+        msg->params.status_code = beerocks::string_utils::stoi(parsed_obj.get("status_code"));
 
         // Add the message to the queue
         event_queue_push(Event::BSS_TM_Response, msg_buff);
@@ -675,17 +646,17 @@ bool ap_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj)
     } break;
 
     case Event::CTRL_Channel_Switch: {
-        std::string bandwidth = parsed_obj["ch_width"];
+        std::string bandwidth = parsed_obj.get("ch_width");
         if (bandwidth.empty()) {
             LOG(ERROR) << "Invalid bandwidth";
             return false;
         }
-        m_radio_info.channel =
-            beerocks::utils::wifi_freq_to_channel(beerocks::string_utils::stoi(parsed_obj["freq"]));
+        m_radio_info.channel = beerocks::utils::wifi_freq_to_channel(
+            beerocks::string_utils::stoi(parsed_obj.get("freq")));
         m_radio_info.bandwidth          = wpa_bw_to_beerocks_bw(bandwidth);
-        m_radio_info.channel_ext_above  = beerocks::string_utils::stoi(parsed_obj["ch_offset"]);
-        m_radio_info.vht_center_freq    = beerocks::string_utils::stoi(parsed_obj["cf1"]);
-        m_radio_info.is_dfs_channel     = beerocks::string_utils::stoi(parsed_obj["dfs"]);
+        m_radio_info.channel_ext_above  = beerocks::string_utils::stoi(parsed_obj.get("ch_offset"));
+        m_radio_info.vht_center_freq    = beerocks::string_utils::stoi(parsed_obj.get("cf1"));
+        m_radio_info.is_dfs_channel     = beerocks::string_utils::stoi(parsed_obj.get("dfs"));
         m_radio_info.last_csa_sw_reason = ChanSwReason::Unknown;
         if (son::wireless_utils::which_freq(m_radio_info.channel) == beerocks::eFreqType::FREQ_5G) {
             m_radio_info.is_5ghz = true;
@@ -13,7 +13,7 @@
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 extern "C" {
 #include <wpa_ctrl.h>
@@ -21,11 +21,13 @@ extern "C" {
 
 #include <linux/nl80211.h>
 #include <net/if.h>
+#include <netlink/errno.h>
 #include <netlink/genl/ctrl.h>
 #include <netlink/genl/family.h>
 #include <netlink/genl/genl.h>
 #include <netlink/msg.h>
 #include <netlink/netlink.h>
+#include <poll.h>
 
 namespace bwl {
 namespace nl80211 {
@@ -38,6 +40,11 @@ namespace nl80211 {
 #define AP_ENABELED_TIMEOUT_SEC 15
 #define AP_ENABELED_FIXED_DFS_TIMEOUT_SEC 660
 
+// Room for the replies of several outstanding nl80211 requests
+#define NL80211_SOCK_RX_BUFFER_SIZE (64 * 1024)
+#define NL80211_SOCK_TX_BUFFER_SIZE 8192
+#define NL80211_REPLY_TIMEOUT_MS 3000
+
 //////////////////////////////////////////////////////////////////////////////
 ////////////////////////// Local Module Functions ////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -123,39 +130,58 @@ static void listed_map_obj_parser(std::stringstream &ss_in, std::list<char> deli
     }
 }
 
-static void map_event_obj_parser(std::string event_str,
-                                 base_wlan_hal_nl80211::parsed_obj_map_t &map_obj)
+// Split an event in place, by null terminating its tokens in the buffer
+static void tokenize_event(char *buffer, base_wlan_hal_nl80211::parsed_event_t &event)
 {
     // eliminate event log level from the begining of the event string : "<3>"
-    auto idx_start = event_str.find_first_of(">");
-    if (idx_start != std::string::npos) {
-        idx_start++;
+    auto token = strchr(buffer, '>');
+    if (token) {
+        token++;
     } else {
-        LOG(WARNING) << "empty event! event_string: " << event_str;
+        LOG(WARNING) << "empty event! event_string: " << buffer;
+        token = buffer;
     }
 
-    // Parse all the args
-    std::stringstream ss(event_str.c_str() + idx_start);
-    std::string str_storage;
     bool opcode = false;
     bool mac    = false;
-    int arg     = 0;
-
-    while (std::getline(ss, str_storage, ' ')) {
-        auto idx = str_storage.find_first_of('=', idx_start);
-        if (idx == std::string::npos) {
-            if (!opcode) {
-                map_obj["_opcode"] = str_storage;
-                opcode             = true;
-            } else if (!mac && beerocks::net::network_utils::is_valid_mac(str_storage)) {
-                map_obj["_mac"] = str_storage;
-                mac             = true;
+
+    while (*token) {
+        // Skip the separators
+        if (*token == ' ' || *token == '\n') {
+            token++;
+            continue;
+        }
+
+        auto token_end = token + strcspn(token, " \n");
+        bool last      = (*token_end == '\0');
+        *token_end     = '\0';
+
+        auto separator = strchr(token, '=');
+        if (separator) {
+            if (event.params_cnt < base_wlan_hal_nl80211::parsed_event_t::MAX_PARAMS) {
+                *separator                            = '\0';
+                event.params[event.params_cnt].key   = token;
+                event.params[event.params_cnt].value = separator + 1;
+                event.params_cnt++;
             } else {
-                map_obj["_arg" + std::to_string(arg++)] = str_storage;
+                LOG(WARNING) << "Too many event parameters, dropping " << token;
             }
+        } else if (!opcode) {
+            event.opcode = token;
+            opcode       = true;
+        } else if (!mac && beerocks::net::network_utils::parse_mac(token, event.mac_addr)) {
+            event.mac = token;
+            mac       = true;
+        } else if (event.args_cnt < base_wlan_hal_nl80211::parsed_event_t::MAX_ARGS) {
+            event.args[event.args_cnt++] = token;
         } else {
-            map_obj[str_storage.substr(0, idx)] = str_storage.substr(idx + 1, std::string::npos);
+            LOG(WARNING) << "Too many event arguments, dropping " << token;
         }
+
+        if (last) {
+            break;
+        }
+        token = token_end + 1;
     }
 }
 
@@ -233,6 +259,16 @@ base_wlan_hal_nl80211::base_wlan_hal_nl80211(HALType type, std::string iface_nam
 
 base_wlan_hal_nl80211::~base_wlan_hal_nl80211() { base_wlan_hal_nl80211::detach(); }
 
+const char *base_wlan_hal_nl80211::parsed_event_t::get(const char *key) const
+{
+    for (int i = 0; i < params_cnt; i++) {
+        if (!strcmp(params[i].key, key)) {
+            return params[i].value;
+        }
+    }
+    return "";
+}
+
 bool base_wlan_hal_nl80211::fsm_setup()
 {
     config()
@@ -287,9 +323,6 @@ bool base_wlan_hal_nl80211::fsm_setup()
                         return false;
                     }
 
-                    // Increase the socket's internal buffer size
-                    nl_socket_set_buffer_size(m_nl80211_sock.get(), 8192, 8192);
-
                     // Connect the socket
                     if (genl_connect(m_nl80211_sock.get()) != 0) {
                         LOG(ERROR) << "Failed connecting netlink socket!";
@@ -297,9 +330,14 @@ bool base_wlan_hal_nl80211::fsm_setup()
                         return false;
                     }
 
+                    // Increase the socket's internal buffer size
+                    nl_socket_set_buffer_size(m_nl80211_sock.get(), NL80211_SOCK_RX_BUFFER_SIZE,
+                                              NL80211_SOCK_TX_BUFFER_SIZE);
+
                     // Resolve the generic nl80211 id
                     if ((m_nl80211_id = genl_ctrl_resolve(m_nl80211_sock.get(), "nl80211")) < 0) {
                         LOG(ERROR) << "nl80211 not found!";
+                        m_nl80211_sock.reset();
                         return false;
                     }
 
@@ -307,9 +345,20 @@ bool base_wlan_hal_nl80211::fsm_setup()
                     if ((m_iface_index = if_nametoindex(get_iface_name().c_str())) == 0) {
                         LOG(ERROR) << "Failed reading the index of interface " << get_iface_name()
                                    << ": " << strerror(errno);
+                        m_nl80211_sock.reset();
+                        return false;
+                    }
 
+                    // Replies are received when available, never block on the socket.
+                    // Set last, genl_ctrl_resolve() expects a blocking socket.
+                    if (nl_socket_set_nonblocking(m_nl80211_sock.get()) < 0 ||
+                        !nl80211_cb_setup()) {
+                        LOG(ERROR) << "Failed setting up netlink socket!";
+                        m_nl80211_sock.reset();
                         return false;
                     }
+
+                    m_fd_nl_events = nl_socket_get_fd(m_nl80211_sock.get());
                 }
 
                 // Open a control interface to wpa_supplicant/hostapd.
@@ -442,8 +491,12 @@ bool base_wlan_hal_nl80211::fsm_setup()
 
             // Release the nl80211 socket
             if (m_nl80211_sock) {
+                abort_nl80211_requests();
+                m_nl80211_cb.reset();
+                m_nl80211_msg.reset();
                 m_nl80211_sock.reset();
-                m_nl80211_id = 0;
+                m_nl80211_id   = 0;
+                m_fd_nl_events = -1;
             }
 
             // Close the events control interface
@@ -542,6 +595,8 @@ bool base_wlan_hal_nl80211::wpa_ctrl_send_msg(const std::string &cmd)
         return false;
     }
 
+    beerocks::metrics::scoped_timer timer(hal_call_time(cmd));
+
     auto buffer = m_wpa_ctrl_buffer.get();
 
     auto buff_size_copy = m_wpa_ctrl_buffer_size;
@@ -622,8 +677,15 @@ bool base_wlan_hal_nl80211::wpa_ctrl_send_msg(const std::string &cmd, char **rep
 
 bool base_wlan_hal_nl80211::process_nl_events()
 {
-    LOG(ERROR) << __func__ << "not implemented";
-    return false;
+    if (!m_nl80211_sock) {
+        LOG(ERROR) << "netlink socket is not connected!";
+        return false;
+    }
+
+    // Complete the outstanding requests with the received replies.
+    // A receive failure only fails the outstanding requests, the socket remains usable.
+    receive_nl80211_replies();
+    return true;
 }
 
 bool base_wlan_hal_nl80211::refresh_radio_info()
@@ -795,32 +857,43 @@ bool base_wlan_hal_nl80211::process_ext_events()
         return false;
     }
 
-    auto buffer         = m_wpa_ctrl_buffer.get();
-    auto buff_size_copy = m_wpa_ctrl_buffer_size;
+    auto buffer = m_wpa_ctrl_buffer.get();
+    bool ret    = true;
 
-    if (wpa_ctrl_recv(m_wpa_ctrl_event, buffer, &buff_size_copy) < 0) {
-        LOG(ERROR) << "wpa_ctrl_recv() failed!";
-        return false;
-    }
+    // Drain all the pending events
+    do {
+        // Leave room for the null terminator
+        auto buff_size_copy = m_wpa_ctrl_buffer_size - 1;
+
+        if (wpa_ctrl_recv(m_wpa_ctrl_event, buffer, &buff_size_copy) < 0) {
+            LOG(ERROR) << "wpa_ctrl_recv() failed!";
+            return false;
+        }
+
+        // the wpa_ctrl does not put null termintaor at the and of the string
+        buffer[buff_size_copy] = 0;
 
-    // the wpa_ctrl does not put null termintaor at the and of the string
-    buffer[buff_size_copy] = 0;
+        LOG(DEBUG) << "event received:" << buffer;
 
-    LOG(DEBUG) << "event received:" << buffer;
+        parsed_event_t event;
+        tokenize_event(buffer, event);
 
-    parsed_obj_map_t event_obj;
-    map_event_obj_parser(buffer, event_obj);
+        // Process the event
+        if (!process_nl80211_event(event)) {
+            LOG(ERROR) << "Failed processing NL80211 event: " << event.opcode;
+            ret = false;
+        }
 
-    // parsed_obj_debug(event_obj);
+        status = wpa_ctrl_pending(m_wpa_ctrl_event);
+    } while (status > 0);
 
-    // Process the event
-    if (!process_nl80211_event(event_obj)) {
-        // LOG(ERROR) << "Failed processing NL80211 event: " << event_obj[WAV_EVENT_KEYLESS_PARAM_OPCODE];
-        LOG(ERROR) << "Failed processing NL80211 event: " << event_obj["_opcode"];
+    if (status < 0) {
+        LOG(ERROR) << "Invalid WPA Control socket status: " << status << " --> detaching!";
+        detach();
         return false;
     }
 
-    return true;
+    return ret;
 }
 
 std::string base_wlan_hal_nl80211::get_radio_mac()
@@ -857,97 +930,257 @@ void base_wlan_hal_nl80211::send_ctrl_iface_cmd(std::string cmd)
 
 bool base_wlan_hal_nl80211::send_nl80211_msg(uint8_t command, int flags,
                                              std::function<bool(struct nl_msg *msg)> msg_create,
-                                             std::function<bool(struct nl_msg *msg)> msg_handle)
+                                             std::function<bool(struct nl_msg *msg)> msg_handle,
+                                             int iface_index)
 {
-    // Netlink Message
-    std::shared_ptr<nl_msg> nl_message =
-        std::shared_ptr<struct nl_msg>(nlmsg_alloc(), [](struct nl_msg *obj) {
-            if (obj) {
-                nlmsg_free(obj);
-            }
-        });
-    LOG_IF(!nl_message, FATAL) << "Failed creating netlink message!";
+    bool done    = false;
+    bool success = false;
+
+    auto &call_time = m_nl80211_call_time[command];
+    if (!call_time) {
+        call_time = &register_hal_call_time("nl80211_cmd_" + std::to_string(command));
+    }
+    beerocks::metrics::scoped_timer timer(*call_time);
+
+    if (!send_nl80211_msg_async(command, flags, msg_create, msg_handle,
+                                [&](bool result) {
+                                    done    = true;
+                                    success = result;
+                                },
+                                iface_index)) {
+        return false;
+    }
+
+    // Replies of other outstanding requests are processed as well while waiting
+    if (!wait_nl80211_replies([&]() { return done; })) {
+        return false;
+    }
+
+    return success;
+}
+
+bool base_wlan_hal_nl80211::send_nl80211_msg_async(
+    uint8_t command, int flags, std::function<bool(struct nl_msg *msg)> msg_create,
+    std::function<bool(struct nl_msg *msg)> msg_handle, std::function<void(bool success)> msg_done,
+    int iface_index)
+{
+    if (!m_nl80211_sock || !m_nl80211_msg) {
+        LOG(ERROR) << "netlink socket is not connected!";
+        return false;
+    }
+
+    // The kernel rejects a dump request while another dump is running on the socket
+    bool dump = ((flags & NLM_F_DUMP) == NLM_F_DUMP);
+    if (dump && !wait_nl80211_replies([&]() { return !m_nl80211_dump_pending; })) {
+        return false;
+    }
+
+    if (!iface_index) {
+        iface_index = m_iface_index;
+    }
+
+    // Reuse the message buffer, the header is rewritten by genlmsg_put()
+    auto nl_message                  = m_nl80211_msg.get();
+    nlmsg_hdr(nl_message)->nlmsg_len = NLMSG_HDRLEN;
+
+    // Initialize the netlink message
+    if (!genlmsg_put(nl_message, NL_AUTO_PORT, NL_AUTO_SEQ, m_nl80211_id, 0, flags, command, 0) ||
+        nla_put_u32(nl_message, NL80211_ATTR_IFINDEX, iface_index) != 0) {
+        LOG(ERROR) << "Failed initializing the netlink message!";
+        return false;
+    }
+
+    // Call the user's message create function
+    if (!msg_create(nl_message)) {
+        LOG(ERROR) << "User's netlink create function failed!";
+        return false;
+    }
 
-    // Netlink Callback
-    std::shared_ptr<nl_cb> nl_callback =
+    // Assign the sequence number matching the replies to the request
+    nl_complete_msg(m_nl80211_sock.get(), nl_message);
+    uint32_t seq = nlmsg_hdr(nl_message)->nlmsg_seq;
+
+    // Send the netlink message
+    int err = nl_send(m_nl80211_sock.get(), nl_message);
+    if (err < 0) {
+        LOG(ERROR) << "nl_send failed: " << nl_geterror(err);
+        return false;
+    }
+
+    auto &request      = m_nl80211_requests[seq];
+    request.msg_handle = msg_handle;
+    request.msg_done   = msg_done;
+    request.dump       = dump;
+
+    if (dump) {
+        m_nl80211_dump_pending = true;
+    }
+
+    return true;
+}
+
+bool base_wlan_hal_nl80211::nl80211_cb_setup()
+{
+    m_nl80211_msg = std::shared_ptr<struct nl_msg>(nlmsg_alloc(), [](struct nl_msg *obj) {
+        if (obj) {
+            nlmsg_free(obj);
+        }
+    });
+    if (!m_nl80211_msg) {
+        LOG(ERROR) << "Failed creating netlink message!";
+        return false;
+    }
+
+    m_nl80211_cb =
         std::shared_ptr<struct nl_cb>(nl_cb_alloc(NL_CB_DEFAULT), [](struct nl_cb *obj) {
             if (obj) {
                 nl_cb_put(obj);
             }
         });
-    LOG_IF(!nl_callback, FATAL) << "Failed creating netlink callback!";
-
-    // Create standard callbacks
-    int err               = 1;
-    static auto nl_err_cb = [](struct sockaddr_nl *nla, struct nlmsgerr *err, void *arg) -> int {
-        int *ret = (int *)arg;
-        *ret     = err->error;
-        return NL_STOP;
+    if (!m_nl80211_cb) {
+        LOG(ERROR) << "Failed creating netlink callback!";
+        return false;
+    }
+
+    // Several requests may be outstanding, the replies are matched by sequence number instead
+    // of expecting the sequence number of the last request
+    auto nl_seq_check_cb = [](struct nl_msg *msg, void *arg) -> int { return NL_OK; };
+
+    auto nl_err_cb = [](struct sockaddr_nl *nla, struct nlmsgerr *err, void *arg) -> int {
+        auto hal = static_cast<base_wlan_hal_nl80211 *>(arg);
+        hal->complete_nl80211_request(err->msg.nlmsg_seq, err->error);
+        return NL_SKIP;
     };
 
-    static auto nl_finish_cb = [](struct nl_msg *msg, void *arg) -> int {
-        int *ret = (int *)arg;
-        *ret     = 0;
+    // End of a dump
+    auto nl_finish_cb = [](struct nl_msg *msg, void *arg) -> int {
+        auto hal = static_cast<base_wlan_hal_nl80211 *>(arg);
+        hal->complete_nl80211_request(nlmsg_hdr(msg)->nlmsg_seq, 0);
         return NL_SKIP;
     };
 
-    static auto nl_ack_cb = [](struct nl_msg *msg, void *arg) -> int {
-        int *ret = (int *)arg;
-        *ret     = 0;
-        return NL_STOP;
+    // End of any other request
+    auto nl_ack_cb = [](struct nl_msg *msg, void *arg) -> int {
+        auto hal = static_cast<base_wlan_hal_nl80211 *>(arg);
+        hal->complete_nl80211_request(nlmsg_hdr(msg)->nlmsg_seq, 0);
+        return NL_SKIP;
     };
 
-    // Passing a lambda with capture is not supported for standard C function
-    // pointers. As a workaround, we create a static (but thread local) wrapper
-    // function that calls the capturing lambda function.
-    static __thread std::function<int(struct nl_msg * msg, void *arg)> nl_handler_cb_wrapper;
-    nl_handler_cb_wrapper = [&](struct nl_msg *msg, void *arg) -> int {
-        if (!msg_handle(msg)) {
+    auto nl_handler_cb = [](struct nl_msg *msg, void *arg) -> int {
+        auto hal = static_cast<base_wlan_hal_nl80211 *>(arg);
+        auto seq = nlmsg_hdr(msg)->nlmsg_seq;
+        auto it  = hal->m_nl80211_requests.find(seq);
+        if (it == hal->m_nl80211_requests.end()) {
+            LOG(DEBUG) << "Dropping netlink reply of unknown request " << seq;
+            return NL_SKIP;
+        }
+        if (it->second.msg_handle && !it->second.msg_handle(msg)) {
             LOG(ERROR) << "User's netlink handler function failed!";
         }
         return NL_SKIP;
     };
-    auto nl_handler_cb = [](struct nl_msg *msg, void *arg) -> int {
-        return nl_handler_cb_wrapper(msg, arg);
-    };
 
-    // Initialize the netlink message
-    if (!genlmsg_put(nl_message.get(), 0, 0, m_nl80211_id, 0, flags, command, 0) ||
-        nla_put_u32(nl_message.get(), NL80211_ATTR_IFINDEX, m_iface_index) != 0) {
-        LOG(ERROR) << "Failed initializing the netlink message!";
-        return false;
+    // Set the callbacks
+    nl_cb_set(m_nl80211_cb.get(), NL_CB_SEQ_CHECK, NL_CB_CUSTOM, nl_seq_check_cb, nullptr);
+    nl_cb_err(m_nl80211_cb.get(), NL_CB_CUSTOM, nl_err_cb, this);                  // error
+    nl_cb_set(m_nl80211_cb.get(), NL_CB_FINISH, NL_CB_CUSTOM, nl_finish_cb, this); // finish
+    nl_cb_set(m_nl80211_cb.get(), NL_CB_ACK, NL_CB_CUSTOM, nl_ack_cb, this);       // ack
+    nl_cb_set(m_nl80211_cb.get(), NL_CB_VALID, NL_CB_CUSTOM, nl_handler_cb,
+              this); // response handler
+
+    return true;
+}
+
+bool base_wlan_hal_nl80211::receive_nl80211_replies()
+{
+    // Does not block, the socket is non-blocking
+    int err = nl_recvmsgs(m_nl80211_sock.get(), m_nl80211_cb.get());
+    if (err == -NLE_AGAIN) {
+        // Spurious wakeup, no data yet. The requests are still outstanding.
+        return true;
     }
+    if (err < 0) {
+        LOG(ERROR) << "Failed receiving netlink replies: " << nl_geterror(err);
 
-    // Call the user's message create function
-    if (!msg_create(nl_message.get())) {
-        LOG(ERROR) << "User's netlink create function failed!";
+        // Replies may have been lost (e.g. receive buffer overrun)
+        abort_nl80211_requests();
         return false;
     }
 
-    // Set the callbacks
-    nl_cb_err(nl_callback.get(), NL_CB_CUSTOM, nl_err_cb, &err);                  // error
-    nl_cb_set(nl_callback.get(), NL_CB_FINISH, NL_CB_CUSTOM, nl_finish_cb, &err); // finish
-    nl_cb_set(nl_callback.get(), NL_CB_ACK, NL_CB_CUSTOM, nl_ack_cb, &err);       // ack
-    nl_cb_set(nl_callback.get(), NL_CB_VALID, NL_CB_CUSTOM, nl_handler_cb,
-              nullptr); // response handler
+    return true;
+}
 
-    // Send the netlink message
-    err = nl_send_auto_complete(m_nl80211_sock.get(), nl_message.get());
-    if (err < 0) {
-        LOG(ERROR) << "nl_send_auto_complete failed: " << err;
-        return false;
-    }
+bool base_wlan_hal_nl80211::wait_nl80211_replies(const std::function<bool()> &done)
+{
+    auto timeout =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(NL80211_REPLY_TIMEOUT_MS);
+
+    struct pollfd fds = {};
+    fds.fd            = nl_socket_get_fd(m_nl80211_sock.get());
+    fds.events        = POLLIN;
+
+    while (!done()) {
+        auto remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                timeout - std::chrono::steady_clock::now())
+                                .count();
+        if (remaining_ms <= 0) {
+            LOG(ERROR) << "Timeout waiting for netlink replies!";
+            abort_nl80211_requests();
+            return false;
+        }
 
-    // Process the response
-    // TODO: Probably should be changed to select/epoll...
-    //       The file descriptor can be extracted by calling the
-    //       nl_socket_get_fd() function.
-    while (err > 0) {
-        nl_recvmsgs(m_nl80211_sock.get(), nl_callback.get());
+        int ret = poll(&fds, 1, remaining_ms);
+        if (ret < 0 && errno != EINTR) {
+            LOG(ERROR) << "Failed polling netlink socket: " << strerror(errno);
+            abort_nl80211_requests();
+            return false;
+        }
+
+        if (ret > 0 && !receive_nl80211_replies()) {
+            return false;
+        }
     }
 
     return true;
 }
 
+void base_wlan_hal_nl80211::complete_nl80211_request(uint32_t seq, int error)
+{
+    auto it = m_nl80211_requests.find(seq);
+    if (it == m_nl80211_requests.end()) {
+        return;
+    }
+
+    // Remove the request first, the done function may send a new request
+    auto request = std::move(it->second);
+    m_nl80211_requests.erase(it);
+
+    if (request.dump) {
+        m_nl80211_dump_pending = false;
+    }
+
+    if (error < 0) {
+        LOG(ERROR) << "netlink request " << seq << " failed: " << strerror(-error);
+    }
+
+    if (request.msg_done) {
+        request.msg_done(error == 0);
+    }
+}
+
+void base_wlan_hal_nl80211::abort_nl80211_requests()
+{
+    // Late replies of the aborted requests are dropped
+    auto requests = std::move(m_nl80211_requests);
+    m_nl80211_requests.clear();
+    m_nl80211_dump_pending = false;
+
+    for (auto &request : requests) {
+        if (request.second.msg_done) {
+            request.second.msg_done(false);
+        }
+    }
+}
+
 } // namespace nl80211
 } // namespace bwl
@@ -13,7 +13,10 @@
 
 #include <bcl/beerocks_state_machine.h>
 
+#include <array>
 #include <chrono>
+#include <cstring>
+#include <functional>
 #include <list>
 #include <memory>
 #include <unordered_map>
@@ -22,6 +25,7 @@
 struct wpa_ctrl;
 struct nl_sock;
 struct nl_msg;
+struct nl_cb;
 
 namespace bwl {
 namespace nl80211 {
@@ -29,6 +33,26 @@ namespace nl80211 {
 enum class nl80211_fsm_state { Delay, Init, GetRadioInfo, Attach, Operational, Detach };
 enum class nl80211_fsm_event { Attach, Detach };
 
+/**
+ * @brief FNV-1a hash of an event opcode.
+ *
+ * Being constexpr, it can be used as the case labels of a switch dispatching on the opcode
+ * of an event. The compiler rejects duplicate case labels, so the hash is known to be
+ * collision free over the handled opcodes. Use NL80211_OPCODE_CASE() to also reject
+ * unknown opcodes colliding with a handled one.
+ */
+constexpr uint32_t opcode_hash(const char *opcode, uint32_t hash = 2166136261u)
+{
+    return *opcode ? opcode_hash(opcode + 1, (hash ^ uint8_t(*opcode)) * 16777619u) : hash;
+}
+
+#define NL80211_OPCODE_CASE(opcode, opcode_str, ret)                                              \
+    case opcode_hash(opcode_str):                                                                  \
+        if (!strcmp(opcode, opcode_str)) {                                                         \
+            return ret;                                                                            \
+        }                                                                                          \
+        break
+
 /*!
  * Base class for the wav abstraction layer.
  * Read more about virtual inheritance: https://en.wikipedia.org/wiki/Virtual_inheritance
@@ -42,6 +66,32 @@ public:
     typedef std::unordered_map<std::string, std::string> parsed_obj_map_t;
     typedef std::list<parsed_obj_map_t> parsed_obj_listed_map_t;
 
+    /**
+     * Tokens of a hostapd/wpa_supplicant event: "<level>OPCODE [MAC] [ARG]... [KEY=VALUE]...".
+     * The tokens point into the event buffer, and are only valid while the event is processed.
+     * Missing tokens are returned as empty strings.
+     */
+    struct parsed_event_t {
+        static const int MAX_ARGS   = 8;
+        static const int MAX_PARAMS = 32;
+
+        const char *opcode = "";
+        const char *mac    = "";
+        sMacAddr mac_addr  = {};
+
+        const char *args[MAX_ARGS];
+        int args_cnt = 0;
+
+        struct {
+            const char *key;
+            const char *value;
+        } params[MAX_PARAMS];
+        int params_cnt = 0;
+
+        const char *arg(int idx) const { return (idx < args_cnt) ? args[idx] : ""; }
+        const char *get(const char *key) const;
+    };
+
     // Public methods
 public:
     virtual ~base_wlan_hal_nl80211();
@@ -61,7 +111,7 @@ protected:
                           int wpa_ctrl_buffer_size, hal_conf_t hal_conf = {});
 
     // Process hostapd/wpa_supplicant event
-    virtual bool process_nl80211_event(parsed_obj_map_t &event) = 0;
+    virtual bool process_nl80211_event(const parsed_event_t &event) = 0;
 
     bool set(const std::string &param, const std::string &value,
              int vap_id = beerocks::IFACE_RADIO_ID);
@@ -75,14 +125,40 @@ protected:
     virtual void send_ctrl_iface_cmd(std::string cmd); // HACK for development, to be removed
 
     // Send NL80211 message
+    // The message is addressed to the radio interface, unless another interface index is given.
+    // With NLM_F_DUMP, msg_handle is called once per returned object.
     bool send_nl80211_msg(uint8_t command, int flags,
                           std::function<bool(struct nl_msg *msg)> msg_create,
-                          std::function<bool(struct nl_msg *msg)> msg_handle);
+                          std::function<bool(struct nl_msg *msg)> msg_handle,
+                          int iface_index = 0);
+
+    // Send NL80211 message without waiting for the reply
+    // Several requests may be outstanding at once, their replies are matched by sequence number.
+    // msg_handle is called for every reply message, then msg_done once the request completed.
+    // Replies are received by process_nl_events(), when the socket returned by
+    // get_nl_events_fd() is readable, or while waiting in send_nl80211_msg().
+    bool send_nl80211_msg_async(uint8_t command, int flags,
+                                std::function<bool(struct nl_msg *msg)> msg_create,
+                                std::function<bool(struct nl_msg *msg)> msg_handle,
+                                std::function<void(bool success)> msg_done, int iface_index = 0);
 
     // Private data-members:
 private:
     bool fsm_setup();
 
+    // Outstanding NL80211 request
+    struct nl80211_request_t {
+        std::function<bool(struct nl_msg *msg)> msg_handle;
+        std::function<void(bool success)> msg_done;
+        bool dump = false;
+    };
+
+    bool nl80211_cb_setup();
+    bool receive_nl80211_replies();
+    bool wait_nl80211_replies(const std::function<bool()> &done);
+    void complete_nl80211_request(uint32_t seq, int error);
+    void abort_nl80211_requests();
+
     // FSM State and Timeout
     nl80211_fsm_state m_last_attach_state = nl80211_fsm_state::Detach;
     std::chrono::steady_clock::time_point m_state_timeout;
@@ -96,6 +172,19 @@ private:
     int m_nl80211_id  = 0;
     int m_iface_index = 0;
 
+    // Callbacks and message buffer, reused by all the requests
+    std::shared_ptr<struct nl_cb> m_nl80211_cb;
+    std::shared_ptr<struct nl_msg> m_nl80211_msg;
+
+    // Outstanding requests by sequence number
+    std::unordered_map<uint32_t, nl80211_request_t> m_nl80211_requests;
+
+    // Only one dump may run on a netlink socket at a time
+    bool m_nl80211_dump_pending = false;
+
+    // Latency histograms of the NL80211 commands, registered on first use
+    std::array<beerocks::metrics::histogram *, UINT8_MAX + 1> m_nl80211_call_time = {};
+
     // WPA Control Interface Communication Buffer
     std::shared_ptr<char> m_wpa_ctrl_buffer;
     size_t m_wpa_ctrl_buffer_size = 0;
@@ -10,10 +10,12 @@
 
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
+#include <bcl/son/son_wireless_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
-#include <cmath>
+#include <algorithm>
+#include <net/if.h>
 
 extern "C" {
 #include <wpa_ctrl.h>
@@ -36,29 +38,21 @@ namespace nl80211 {
 #define GET_OP_CLASS(channel) ((channel < 14) ? 4 : 5)
 #define BUFFER_SIZE 4096
 
-// Allocate a char array wrapped in a shared_ptr
-#define ALLOC_SMART_BUFFER(size)                                                                   \
-    std::shared_ptr<char>(new char[size], [](char *obj) {                                          \
-        if (obj)                                                                                   \
-            delete[] obj;                                                                          \
-    })
-
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////////// Local Module Functions ///////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-static mon_wlan_hal::Event wav_to_bwl_event(const std::string &opcode)
+static mon_wlan_hal::Event wav_to_bwl_event(const char *opcode)
 {
-    if (opcode == "BEACON-REQ-TX-STATUS") {
-        return mon_wlan_hal::Event::RRM_Beacon_Request_Status;
-    } else if (opcode == "BEACON-RESP-RX") {
-        return mon_wlan_hal::Event::RRM_Beacon_Response;
+    switch (opcode_hash(opcode)) {
+        NL80211_OPCODE_CASE(opcode, "BEACON-REQ-TX-STATUS",
+                            mon_wlan_hal::Event::RRM_Beacon_Request_Status);
+        NL80211_OPCODE_CASE(opcode, "BEACON-RESP-RX", mon_wlan_hal::Event::RRM_Beacon_Response);
+        // NL80211_OPCODE_CASE(opcode, "RRM-STA-STATISTICS-RECEIVED",
+        //                     mon_wlan_hal::Event::RRM_STA_Statistics_Response);
+        // NL80211_OPCODE_CASE(opcode, "RRM-LINK-MEASUREMENT-RECEIVED",
+        //                     mon_wlan_hal::Event::RRM_Link_Measurement_Response);
     }
-    // } else if (opcode == "RRM-STA-STATISTICS-RECEIVED") {
-    //     return mon_wlan_hal::Event::RRM_STA_Statistics_Response;
-    // } else if (opcode == "RRM-LINK-MEASUREMENT-RECEIVED") {
-    //     return mon_wlan_hal::Event::RRM_Link_Measurement_Response;
-    // }
 
     return mon_wlan_hal::Event::Invalid;
 }
@@ -80,6 +74,135 @@ static void calc_curr_traffic(std::string buff, uint64_t &total, uint32_t &curr)
 
 #endif
 
+// NL80211 station info attributes policies, built once and shared by all the
+// station statistics requests
+static struct sta_info_policies {
+    struct nla_policy stats[NL80211_STA_INFO_MAX + 1];
+    struct nla_policy rate[NL80211_RATE_INFO_MAX + 1];
+
+    sta_info_policies() : stats(), rate()
+    {
+        stats[NL80211_STA_INFO_INACTIVE_TIME] = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_RX_BYTES]      = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_TX_BYTES]      = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_RX_PACKETS]    = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_TX_PACKETS]    = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_SIGNAL]        = {NLA_U8, 0, 0};
+        stats[NL80211_STA_INFO_T_OFFSET]      = {NLA_U64, 0, 0};
+        stats[NL80211_STA_INFO_TX_BITRATE]    = {NLA_NESTED, 0, 0};
+        stats[NL80211_STA_INFO_RX_BITRATE]    = {NLA_NESTED, 0, 0};
+        stats[NL80211_STA_INFO_LLID]          = {NLA_U16, 0, 0};
+        stats[NL80211_STA_INFO_PLID]          = {NLA_U16, 0, 0};
+        stats[NL80211_STA_INFO_PLINK_STATE]   = {NLA_U8, 0, 0};
+        stats[NL80211_STA_INFO_TX_RETRIES]    = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_TX_FAILED]     = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_STA_FLAGS] = {NLA_UNSPEC, sizeof(struct nl80211_sta_flag_update), 0};
+        stats[NL80211_STA_INFO_LOCAL_PM]  = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_PEER_PM]   = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_NONPEER_PM]       = {NLA_U32, 0, 0};
+        stats[NL80211_STA_INFO_CHAIN_SIGNAL]     = {NLA_NESTED, 0, 0};
+        stats[NL80211_STA_INFO_CHAIN_SIGNAL_AVG] = {NLA_NESTED, 0, 0};
+
+        rate[NL80211_RATE_INFO_BITRATE]      = {NLA_U16, 0, 0};
+        rate[NL80211_RATE_INFO_BITRATE32]    = {NLA_U32, 0, 0};
+        rate[NL80211_RATE_INFO_MCS]          = {NLA_U8, 0, 0};
+        rate[NL80211_RATE_INFO_40_MHZ_WIDTH] = {NLA_FLAG, 0, 0};
+        rate[NL80211_RATE_INFO_SHORT_GI]     = {NLA_FLAG, 0, 0};
+    }
+} s_sta_info_policies;
+
+static int parse_bitrate(struct nlattr *bitrate_attr)
+{
+    struct nlattr *rinfo[NL80211_RATE_INFO_MAX + 1];
+    if (nla_parse_nested(rinfo, NL80211_RATE_INFO_MAX, bitrate_attr, s_sta_info_policies.rate)) {
+        LOG(ERROR) << "Failed to parse nested rate attributes!";
+        return 0;
+    }
+
+    int rate = 0;
+    if (rinfo[NL80211_RATE_INFO_BITRATE32])
+        rate = nla_get_u32(rinfo[NL80211_RATE_INFO_BITRATE32]);
+    else if (rinfo[NL80211_RATE_INFO_BITRATE])
+        rate = nla_get_u16(rinfo[NL80211_RATE_INFO_BITRATE]);
+
+    return rate;
+}
+
+static void calc_curr_traffic(uint64_t val, uint64_t &total, uint32_t &curr)
+{
+    if (val >= total) {
+        curr = val - total;
+    } else {
+        curr = val;
+    }
+    total = val;
+}
+
+// Update the statistics of a station from the NL80211_ATTR_STA_INFO attribute
+// of a NL80211_CMD_GET_STATION response
+static bool parse_sta_info(struct nlattr *sta_info_attr, SStaStats &sta_stats)
+{
+    struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+
+    // Parse nested station stats
+    if (nla_parse_nested(sinfo, NL80211_STA_INFO_MAX, sta_info_attr, s_sta_info_policies.stats)) {
+        LOG(ERROR) << "failed to parse nested attributes!";
+        return false;
+    }
+
+    // RX RSSI
+    if (sinfo[NL80211_STA_INFO_SIGNAL]) {
+        int8_t signal          = int8_t(nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL]));
+        sta_stats.rx_rssi_watt = son::wireless_utils::db_to_watt(signal);
+        sta_stats.rx_rssi_watt_samples_cnt++;
+    }
+
+    // RX SNR is not supported
+    sta_stats.rx_snr_watt             = 0;
+    sta_stats.rx_snr_watt_samples_cnt = 0;
+
+    // TX Phy Rate
+    if (sinfo[NL80211_STA_INFO_TX_BITRATE]) {
+        sta_stats.tx_phy_rate_100kb = parse_bitrate(sinfo[NL80211_STA_INFO_TX_BITRATE]) / 100;
+    }
+
+    // RX Phy Rate
+    if (sinfo[NL80211_STA_INFO_RX_BITRATE]) {
+        sta_stats.rx_phy_rate_100kb = parse_bitrate(sinfo[NL80211_STA_INFO_RX_BITRATE]) / 100;
+    }
+
+    // TX Bytes
+    if (sinfo[NL80211_STA_INFO_TX_BYTES]) {
+        calc_curr_traffic(nla_get_u32(sinfo[NL80211_STA_INFO_TX_BYTES]), sta_stats.tx_bytes_cnt,
+                          sta_stats.tx_bytes);
+    }
+
+    // RX Bytes
+    if (sinfo[NL80211_STA_INFO_RX_BYTES]) {
+        calc_curr_traffic(nla_get_u32(sinfo[NL80211_STA_INFO_RX_BYTES]), sta_stats.rx_bytes_cnt,
+                          sta_stats.rx_bytes);
+    }
+
+    // TX Packets
+    if (sinfo[NL80211_STA_INFO_TX_PACKETS]) {
+        calc_curr_traffic(nla_get_u32(sinfo[NL80211_STA_INFO_TX_PACKETS]),
+                          sta_stats.tx_packets_cnt, sta_stats.tx_packets);
+    }
+
+    // RX Packets
+    if (sinfo[NL80211_STA_INFO_RX_PACKETS]) {
+        calc_curr_traffic(nla_get_u32(sinfo[NL80211_STA_INFO_RX_PACKETS]),
+                          sta_stats.rx_packets_cnt, sta_stats.rx_packets);
+    }
+
+    // TX Retries
+    if (sinfo[NL80211_STA_INFO_TX_RETRIES]) {
+        sta_stats.retrans_count = nla_get_u32(sinfo[NL80211_STA_INFO_TX_RETRIES]);
+    }
+
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////////////// Implementation ///////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -144,36 +267,6 @@ bool mon_wlan_hal_nl80211::update_vap_stats(const std::string vap_iface_name, SV
 bool mon_wlan_hal_nl80211::update_stations_stats(const std::string vap_iface_name,
                                                  const std::string sta_mac, SStaStats &sta_stats)
 {
-    static struct nla_policy stats_policy[NL80211_STA_INFO_MAX + 1];
-    stats_policy[NL80211_STA_INFO_INACTIVE_TIME] = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_RX_BYTES]      = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_TX_BYTES]      = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_RX_PACKETS]    = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_TX_PACKETS]    = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_SIGNAL]        = {NLA_U8, 0, 0};
-    stats_policy[NL80211_STA_INFO_T_OFFSET]      = {NLA_U64, 0, 0};
-    stats_policy[NL80211_STA_INFO_TX_BITRATE]    = {NLA_NESTED, 0, 0};
-    stats_policy[NL80211_STA_INFO_RX_BITRATE]    = {NLA_NESTED, 0, 0};
-    stats_policy[NL80211_STA_INFO_LLID]          = {NLA_U16, 0, 0};
-    stats_policy[NL80211_STA_INFO_PLID]          = {NLA_U16, 0, 0};
-    stats_policy[NL80211_STA_INFO_PLINK_STATE]   = {NLA_U8, 0, 0};
-    stats_policy[NL80211_STA_INFO_TX_RETRIES]    = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_TX_FAILED]     = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_STA_FLAGS]  = {NLA_UNSPEC, sizeof(struct nl80211_sta_flag_update),
-                                                0};
-    stats_policy[NL80211_STA_INFO_LOCAL_PM]   = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_PEER_PM]    = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_NONPEER_PM] = {NLA_U32, 0, 0};
-    stats_policy[NL80211_STA_INFO_CHAIN_SIGNAL]     = {NLA_NESTED, 0, 0};
-    stats_policy[NL80211_STA_INFO_CHAIN_SIGNAL_AVG] = {NLA_NESTED, 0, 0};
-
-    static struct nla_policy rate_policy[NL80211_RATE_INFO_MAX + 1];
-    rate_policy[NL80211_RATE_INFO_BITRATE]      = {NLA_U16, 0, 0};
-    rate_policy[NL80211_RATE_INFO_BITRATE32]    = {NLA_U32, 0, 0};
-    rate_policy[NL80211_RATE_INFO_MCS]          = {NLA_U8, 0, 0};
-    rate_policy[NL80211_RATE_INFO_40_MHZ_WIDTH] = {NLA_FLAG, 0, 0};
-    rate_policy[NL80211_RATE_INFO_SHORT_GI]     = {NLA_FLAG, 0, 0};
-
     auto ret = send_nl80211_msg(
         NL80211_CMD_GET_STATION, 0,
         // Create the message
@@ -186,8 +279,6 @@ bool mon_wlan_hal_nl80211::update_stations_stats(const std::string vap_iface_nam
         [&](struct nl_msg *msg) -> bool {
             struct nlattr *tb[NL80211_ATTR_MAX + 1];
             struct genlmsghdr *gnlh = (struct genlmsghdr *)nlmsg_data(nlmsg_hdr(msg));
-            struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
-            struct nlattr *rinfo[NL80211_RATE_INFO_MAX + 1];
 
             // Parse the netlink message
             nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
@@ -198,96 +289,64 @@ bool mon_wlan_hal_nl80211::update_stations_stats(const std::string vap_iface_nam
                 return false;
             }
 
-            // Parse nested station stats
-            if (nla_parse_nested(sinfo, NL80211_STA_INFO_MAX, tb[NL80211_ATTR_STA_INFO],
-                                 stats_policy)) {
-                LOG(ERROR) << "failed to parse nested attributes!";
-                return false;
-            }
+            return parse_sta_info(tb[NL80211_ATTR_STA_INFO], sta_stats);
+        });
 
-            // RX RSSI
-            if (sinfo[NL80211_STA_INFO_SIGNAL]) {
-                int8_t signal          = int8_t(nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL]));
-                sta_stats.rx_rssi_watt = pow(10, (signal / 10.0));
-                sta_stats.rx_rssi_watt_samples_cnt++;
-            }
+    if (!ret) {
+        LOG(ERROR) << "Failed updating stats for station: " << sta_mac;
+        return false;
+    }
 
-            // RX SNR is not supported
-            sta_stats.rx_snr_watt             = 0;
-            sta_stats.rx_snr_watt_samples_cnt = 0;
-
-            // Bitrate parsing helper function
-            auto parse_bitrate_func = [&](struct nlattr *bitrate_attr) -> int {
-                if (nla_parse_nested(rinfo, NL80211_RATE_INFO_MAX, bitrate_attr, rate_policy)) {
-                    LOG(ERROR) << "Failed to parse nested rate attributes!";
-                    return 0;
-                }
-
-                int rate = 0;
-                if (rinfo[NL80211_RATE_INFO_BITRATE32])
-                    rate = nla_get_u32(rinfo[NL80211_RATE_INFO_BITRATE32]);
-                else if (rinfo[NL80211_RATE_INFO_BITRATE])
-                    rate = nla_get_u16(rinfo[NL80211_RATE_INFO_BITRATE]);
-
-                return rate;
-            };
-
-            // TX Phy Rate
-            if (sinfo[NL80211_STA_INFO_TX_BITRATE]) {
-                sta_stats.tx_phy_rate_100kb =
-                    parse_bitrate_func(sinfo[NL80211_STA_INFO_TX_BITRATE]) / 100;
-            }
+    return true;
+}
 
-            // RX Phy Rate
-            if (sinfo[NL80211_STA_INFO_RX_BITRATE]) {
-                sta_stats.rx_phy_rate_100kb =
-                    parse_bitrate_func(sinfo[NL80211_STA_INFO_RX_BITRATE]) / 100;
-            }
+bool mon_wlan_hal_nl80211::update_vap_stations_stats(const std::string &vap_iface_name,
+                                                     sta_stats_map_t &sta_stats)
+{
+    if (sta_stats.empty()) {
+        return true;
+    }
 
-            // Traffic values calculations helper function
-            auto calc_curr_traffic = [](uint64_t val, uint64_t &total, uint32_t &curr) {
-                if (val >= total) {
-                    curr = val - total;
-                } else {
-                    curr = val;
-                }
-                total = val;
-            };
-
-            // TX Bytes
-            if (sinfo[NL80211_STA_INFO_TX_BYTES]) {
-                calc_curr_traffic(nla_get_u32(sinfo[NL80211_STA_INFO_TX_BYTES]),
-                                  sta_stats.tx_bytes_cnt, sta_stats.tx_bytes);
-            }
+    int vap_iface_index = if_nametoindex(vap_iface_name.c_str());
+    if (!vap_iface_index) {
+        LOG(ERROR) << "Failed to get the index of interface " << vap_iface_name;
+        return false;
+    }
 
-            // RX Bytes
-            if (sinfo[NL80211_STA_INFO_RX_BYTES]) {
-                calc_curr_traffic(nla_get_u32(sinfo[NL80211_STA_INFO_RX_BYTES]),
-                                  sta_stats.rx_bytes_cnt, sta_stats.rx_bytes);
-            }
+    // Dump the statistics of all the stations of the VAP in a single request,
+    // the response handler is called once per station.
+    auto ret = send_nl80211_msg(
+        NL80211_CMD_GET_STATION, NLM_F_DUMP,
+        // Create the message
+        [&](struct nl_msg *msg) -> bool { return true; },
+        // Handle the reponse
+        [&](struct nl_msg *msg) -> bool {
+            struct nlattr *tb[NL80211_ATTR_MAX + 1];
+            struct genlmsghdr *gnlh = (struct genlmsghdr *)nlmsg_data(nlmsg_hdr(msg));
 
-            // TX Packets
-            if (sinfo[NL80211_STA_INFO_TX_PACKETS]) {
-                calc_curr_traffic(nla_get_u32(sinfo[NL80211_STA_INFO_TX_PACKETS]),
-                                  sta_stats.tx_packets_cnt, sta_stats.tx_packets);
-            }
+            // Parse the netlink message
+            nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+                      NULL);
 
-            // RX Packets
-            if (sinfo[NL80211_STA_INFO_RX_PACKETS]) {
-                calc_curr_traffic(nla_get_u32(sinfo[NL80211_STA_INFO_RX_PACKETS]),
-                                  sta_stats.rx_packets_cnt, sta_stats.rx_packets);
+            if (!tb[NL80211_ATTR_MAC] || !tb[NL80211_ATTR_STA_INFO]) {
+                LOG(ERROR) << "sta mac or stats missing!";
+                return false;
             }
 
-            // TX Retries
-            if (sinfo[NL80211_STA_INFO_TX_RETRIES]) {
-                sta_stats.retrans_count = nla_get_u32(sinfo[NL80211_STA_INFO_TX_RETRIES]);
+            // Skip stations the caller is not interested in
+            auto sta_mac = beerocks::net::network_utils::mac_to_string(
+                (const uint8_t *)nla_data(tb[NL80211_ATTR_MAC]));
+            auto sta_it = sta_stats.find(sta_mac);
+            if (sta_it == sta_stats.end()) {
+                return true;
             }
 
-            return true;
-        });
+            return parse_sta_info(tb[NL80211_ATTR_STA_INFO], *sta_it->second);
+        },
+        vap_iface_index);
 
     if (!ret) {
-        LOG(ERROR) << "Failed updating stats for station: " << sta_mac;
+        LOG(ERROR) << "Failed updating stations stats of " << vap_iface_name;
         return false;
     }
 
@@ -392,12 +451,11 @@ bool mon_wlan_hal_nl80211::channel_scan_trigger(int dwell_time_msec,
     return false;
 }
 
-bool mon_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj)
+bool mon_wlan_hal_nl80211::process_nl80211_event(const parsed_event_t &parsed_obj)
 {
     // Filter out empty events
-    std::string opcode;
-    if (!(parsed_obj.find("_opcode") != parsed_obj.end() &&
-          !(opcode = parsed_obj["_opcode"]).empty())) {
+    auto opcode = parsed_obj.opcode;
+    if (!opcode[0]) {
         return true;
     }
 
@@ -409,19 +467,16 @@ bool mon_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj)
     case Event::RRM_Beacon_Request_Status: {
 
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SBeaconRequestStatus11k));
+        auto resp_buff = event_payload_alloc(sizeof(SBeaconRequestStatus11k));
         auto resp      = reinterpret_cast<SBeaconRequestStatus11k *>(resp_buff.get());
         LOG_IF(!resp, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(resp_buff.get(), 0, sizeof(SBeaconRequestStatus11k));
-
         // STA Mac Address
-        beerocks::net::network_utils::mac_from_string(resp->sta_mac.oct, parsed_obj["_mac"]);
+        std::copy_n(parsed_obj.mac_addr.oct, sizeof(resp->sta_mac.oct), resp->sta_mac.oct);
 
         // Dialog token and ACK
-        resp->dialog_token = beerocks::string_utils::stoi(parsed_obj["_arg0"]);
-        resp->ack          = beerocks::string_utils::stoi(parsed_obj["ack"]);
+        resp->dialog_token = beerocks::string_utils::stoi(parsed_obj.arg(0));
+        resp->ack          = beerocks::string_utils::stoi(parsed_obj.get("ack"));
 
         // Add the message to the queue
         event_queue_push(event, resp_buff);
@@ -431,22 +486,19 @@ bool mon_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj)
     case Event::RRM_Beacon_Response: {
 
         // Allocate response object
-        auto resp_buff = ALLOC_SMART_BUFFER(sizeof(SBeaconResponse11k));
+        auto resp_buff = event_payload_alloc(sizeof(SBeaconResponse11k));
         auto resp      = reinterpret_cast<SBeaconResponse11k *>(resp_buff.get());
         LOG_IF(!resp, FATAL) << "Memory allocation failed!";
 
-        // Initialize the message
-        memset(resp_buff.get(), 0, sizeof(SBeaconResponse11k));
-
         // STA Mac Address
-        beerocks::net::network_utils::mac_from_string(resp->sta_mac.oct, parsed_obj["_mac"]);
+        std::copy_n(parsed_obj.mac_addr.oct, sizeof(resp->sta_mac.oct), resp->sta_mac.oct);
 
         // Dialog token and rep_mode
-        resp->dialog_token = beerocks::string_utils::stoi(parsed_obj["_arg0"]);
-        resp->rep_mode     = beerocks::string_utils::stoi(parsed_obj["_arg1"]);
+        resp->dialog_token = beerocks::string_utils::stoi(parsed_obj.arg(0));
+        resp->rep_mode     = beerocks::string_utils::stoi(parsed_obj.arg(1));
 
         // Parse the report
-        auto report = parsed_obj["_arg2"];
+        std::string report = parsed_obj.arg(2);
         if (report.length() < 52) {
             LOG(WARNING) << "Invalid 11k report length!";
             break;
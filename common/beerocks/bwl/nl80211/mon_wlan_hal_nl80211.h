@@ -35,6 +35,8 @@ public:
     virtual bool update_vap_stats(const std::string vap_iface_name, SVapStats &vap_stats) override;
     virtual bool update_stations_stats(const std::string vap_iface_name, const std::string sta_mac,
                                        SStaStats &sta_stats) override;
+    virtual bool update_vap_stations_stats(const std::string &vap_iface_name,
+                                           sta_stats_map_t &sta_stats) override;
 
     virtual bool sta_channel_load_11k_request(const SStaChannelLoadRequest11k &req) override;
     virtual bool sta_beacon_11k_request(const SBeaconRequest11k &req, int &dialog_token) override;
@@ -44,7 +46,7 @@ public:
                                       const std::vector<unsigned int> &channel_pool) override;
     // Protected methods:
 protected:
-    virtual bool process_nl80211_event(parsed_obj_map_t &parsed_obj) override;
+    virtual bool process_nl80211_event(const parsed_event_t &parsed_obj) override;
 
     // Overload for Monitor events
     bool event_queue_push(mon_wlan_hal::Event event, std::shared_ptr<void> data = {})
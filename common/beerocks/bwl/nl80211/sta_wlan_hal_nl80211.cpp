@@ -11,7 +11,7 @@
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 namespace bwl {
 namespace nl80211 {
@@ -63,7 +63,7 @@ std::string sta_wlan_hal_nl80211::get_ssid() { return m_active_ssid; }
 
 std::string sta_wlan_hal_nl80211::get_bssid() { return m_active_bssid; }
 
-bool sta_wlan_hal_nl80211::process_nl80211_event(parsed_obj_map_t &parsed_obj) { return true; }
+bool sta_wlan_hal_nl80211::process_nl80211_event(const parsed_event_t &parsed_obj) { return true; }
 
 bool sta_wlan_hal_nl80211::update_status() { return false; }
 
@@ -60,7 +60,7 @@ public:
     std::string get_bssid() override;
 
 protected:
-    virtual bool process_nl80211_event(parsed_obj_map_t &parsed_obj) override;
+    virtual bool process_nl80211_event(const parsed_event_t &parsed_obj) override;
 
     // Overload for Monitor events
     bool event_queue_push(sta_wlan_hal::Event event, std::shared_ptr<void> data = {})
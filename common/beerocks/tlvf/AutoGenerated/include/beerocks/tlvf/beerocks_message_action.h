@@ -50,6 +50,7 @@ enum eActionOp_CONTROL: uint8_t {
     ACTION_CONTROL_ARP_QUERY_REQUEST = 0xa,
     ACTION_CONTROL_ARP_QUERY_RESPONSE = 0xb,
     ACTION_CONTROL_PLATFORM_OPERATIONAL_NOTIFICATION = 0xc,
+    ACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION = 0xd,
     ACTION_CONTROL_BACKHAUL_ROAM_REQUEST = 0x1e,
     ACTION_CONTROL_BACKHAUL_DL_RSSI_REPORT_NOTIFICATION = 0x1f,
     ACTION_CONTROL_BACKHAUL_RESET = 0x20,
@@ -83,6 +84,8 @@ enum eActionOp_CONTROL: uint8_t {
     ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION = 0x6a,
     ACTION_CONTROL_CLIENT_NO_RESPONSE_NOTIFICATION = 0x6b,
     ACTION_CONTROL_CLIENT_NEW_IP_ADDRESS_NOTIFICATION = 0x6c,
+    ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST = 0x6d,
+    ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION = 0x6e,
     ACTION_CONTROL_CLIENT_DISCONNECT_REQUEST = 0x6f,
     ACTION_CONTROL_CLIENT_DISCONNECT_RESPONSE = 0x70,
     ACTION_CONTROL_CLIENT_DHCP_COMPLETE_NOTIFICATION = 0x73,
@@ -111,7 +114,8 @@ enum eActionOp_CONTROL: uint8_t {
     ACTION_CONTROL_CHANNEL_SCAN_RESULTS_NOTIFICATION = 0x8f,
     ACTION_CONTROL_CHANNEL_SCAN_ABORT_NOTIFICATION = 0x90,
     ACTION_CONTROL_CHANNEL_SCAN_FINISHED_NOTIFICATION = 0x91,
-    ACTION_CONTROL_ENUM_END = 0x92,
+    ACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION = 0x92,
+    ACTION_CONTROL_ENUM_END = 0x93,
 };
 
 enum eActionOp_BACKHAUL: uint8_t {
@@ -246,6 +250,7 @@ enum eActionOp_MONITOR: uint8_t {
     ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_CMD_RESPONSE = 0x25,
     ACTION_MONITOR_CLIENT_NO_ACTIVITY_NOTIFICATION = 0x26,
     ACTION_MONITOR_CLIENT_NEW_IP_ADDRESS_NOTIFICATION = 0x27,
+    ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION = 0x28,
     ACTION_MONITOR_HOSTAP_STATS_MEASUREMENT_REQUEST = 0x32,
     ACTION_MONITOR_HOSTAP_STATS_MEASUREMENT_RESPONSE = 0x33,
     ACTION_MONITOR_HOSTAP_LOAD_MEASUREMENT_NOTIFICATION = 0x34,
@@ -259,6 +264,7 @@ enum eActionOp_MONITOR: uint8_t {
     ACTION_MONITOR_CHANNEL_SCAN_RESULTS_NOTIFICATION = 0x41,
     ACTION_MONITOR_CHANNEL_SCAN_ABORT_NOTIFICATION = 0x42,
     ACTION_MONITOR_CHANNEL_SCAN_FINISHED_NOTIFICATION = 0x43,
+    ACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION = 0x44,
     ACTION_MONITOR_STEERING_CLIENT_SET_GROUP_REQUEST = 0x50,
     ACTION_MONITOR_STEERING_CLIENT_SET_GROUP_RESPONSE = 0x51,
     ACTION_MONITOR_STEERING_CLIENT_SET_REQUEST = 0x52,
@@ -320,6 +326,7 @@ enum eActionOp_BML: uint8_t {
     ACTION_BML_NW_MAP_UPDATE = 0x1e,
     ACTION_BML_STATS_UPDATE = 0x1f,
     ACTION_BML_EVENTS_UPDATE = 0x20,
+    ACTION_BML_STATS_DELTA_UPDATE = 0x21,
     ACTION_BML_SET_LEGACY_CLIENT_ROAMING_REQUEST = 0x38,
     ACTION_BML_SET_LEGACY_CLIENT_ROAMING_RESPONSE = 0x39,
     ACTION_BML_GET_LEGACY_CLIENT_ROAMING_REQUEST = 0x3a,
@@ -402,7 +409,9 @@ enum eActionOp_BML: uint8_t {
     ACTION_BML_CHANNEL_SCAN_GET_RESULTS_RESPONSE = 0xd3,
     ACTION_BML_CHANNEL_SCAN_DUMP_RESULTS_REQUEST = 0xd4,
     ACTION_BML_CHANNEL_SCAN_DUMP_RESULTS_RESPONSE = 0xd5,
-    ACTION_BML_ENUM_END = 0xd6,
+    ACTION_BML_METRICS_REQUEST = 0xd6,
+    ACTION_BML_METRICS_RESPONSE = 0xd7,
+    ACTION_BML_ENUM_END = 0xd8,
 };
 
 
@@ -177,6 +177,39 @@ class cACTION_BML_STATS_UPDATE : public BaseClass
         int m_lock_order_counter__ = 0;
 };
 
+class cACTION_BML_STATS_DELTA_UPDATE : public BaseClass
+{
+    public:
+        cACTION_BML_STATS_DELTA_UPDATE(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_BML_STATS_DELTA_UPDATE(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_BML_STATS_DELTA_UPDATE();
+
+        static eActionOp_BML get_action_op(){
+            return (eActionOp_BML)(ACTION_BML_STATS_DELTA_UPDATE);
+        }
+        uint8_t& full();
+        uint32_t& num_of_records();
+        uint32_t& buffer_size();
+        std::string buffer_str();
+        char* buffer(size_t length = 0);
+        bool set_buffer(const std::string& str);
+        bool set_buffer(const char buffer[], size_t size);
+        bool alloc_buffer(size_t count = 1);
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_BML* m_action_op = nullptr;
+        uint8_t* m_full = nullptr;
+        uint32_t* m_num_of_records = nullptr;
+        uint32_t* m_buffer_size = nullptr;
+        char* m_buffer = nullptr;
+        size_t m_buffer_idx__ = 0;
+        int m_lock_order_counter__ = 0;
+};
+
 class cACTION_BML_EVENTS_UPDATE : public BaseClass
 {
     public:
@@ -406,6 +439,12 @@ class cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST : public BaseClass
         static eActionOp_BML get_action_op(){
             return (eActionOp_BML)(ACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST);
         }
+        uint8_t& delta();
+        uint8_t& node_types();
+        uint8_t& metrics();
+        uint8_t& macs_size();
+        std::tuple<bool, sMacAddr&> macs(size_t idx);
+        bool alloc_macs(size_t count = 1);
         void class_swap() override;
         bool finalize() override;
         static size_t get_initial_size();
@@ -413,6 +452,13 @@ class cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST : public BaseClass
     private:
         bool init();
         eActionOp_BML* m_action_op = nullptr;
+        uint8_t* m_delta = nullptr;
+        uint8_t* m_node_types = nullptr;
+        uint8_t* m_metrics = nullptr;
+        uint8_t* m_macs_size = nullptr;
+        sMacAddr* m_macs = nullptr;
+        size_t m_macs_idx__ = 0;
+        int m_lock_order_counter__ = 0;
 };
 
 class cACTION_BML_REGISTER_TO_STATS_UPDATES_RESPONSE : public BaseClass
@@ -2041,6 +2087,57 @@ class cACTION_BML_CHANNEL_SCAN_DUMP_RESULTS_RESPONSE : public BaseClass
         eActionOp_BML* m_action_op = nullptr;
 };
 
+class cACTION_BML_METRICS_REQUEST : public BaseClass
+{
+    public:
+        cACTION_BML_METRICS_REQUEST(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_BML_METRICS_REQUEST(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_BML_METRICS_REQUEST();
+
+        static eActionOp_BML get_action_op(){
+            return (eActionOp_BML)(ACTION_BML_METRICS_REQUEST);
+        }
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_BML* m_action_op = nullptr;
+};
+
+class cACTION_BML_METRICS_RESPONSE : public BaseClass
+{
+    public:
+        cACTION_BML_METRICS_RESPONSE(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_BML_METRICS_RESPONSE(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_BML_METRICS_RESPONSE();
+
+        static eActionOp_BML get_action_op(){
+            return (eActionOp_BML)(ACTION_BML_METRICS_RESPONSE);
+        }
+        //0 - More chunks follow, 1 - Last chunk of the metrics
+        uint8_t& last();
+        uint32_t& buffer_size();
+        std::string buffer_str();
+        char* buffer(size_t length = 0);
+        bool set_buffer(const std::string& str);
+        bool set_buffer(const char buffer[], size_t size);
+        bool alloc_buffer(size_t count = 1);
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_BML* m_action_op = nullptr;
+        uint8_t* m_last = nullptr;
+        uint32_t* m_buffer_size = nullptr;
+        char* m_buffer = nullptr;
+        size_t m_buffer_idx__ = 0;
+        int m_lock_order_counter__ = 0;
+};
+
 }; // close namespace: beerocks_message
 
 #endif //_BEEROCKS/TLVF_BEEROCKS_MESSAGE_BML_H_
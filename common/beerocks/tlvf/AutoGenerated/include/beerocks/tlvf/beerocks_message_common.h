@@ -342,6 +342,18 @@ typedef struct sNodeRssiMeasurementRequest {
     }
 } __attribute__((packed)) sNodeRssiMeasurementRequest;
 
+typedef struct sNodeRssiMeasurementBatchEntry {
+    uint16_t request_id;
+    sNodeRssiMeasurementRequest params;
+    void struct_swap(){
+        tlvf_swap(16, reinterpret_cast<uint8_t*>(&request_id));
+        params.struct_swap();
+    }
+    void struct_init(){
+        params.struct_init();
+    }
+} __attribute__((packed)) sNodeRssiMeasurementBatchEntry;
+
 typedef struct sNodeRssiMeasurement {
     beerocks::net::sScanResult result;
     uint16_t rx_phy_rate_100kb;
@@ -340,6 +340,27 @@ class cACTION_CONTROL_PLATFORM_OPERATIONAL_NOTIFICATION : public BaseClass
         uint8_t* m_operational = nullptr;
 };
 
+class cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION : public BaseClass
+{
+    public:
+        cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION();
+
+        static eActionOp_CONTROL get_action_op(){
+            return (eActionOp_CONTROL)(ACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION);
+        }
+        uint32_t& features();
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_CONTROL* m_action_op = nullptr;
+        uint32_t* m_features = nullptr;
+};
+
 class cACTION_CONTROL_BACKHAUL_DL_RSSI_REPORT_NOTIFICATION : public BaseClass
 {
     public:
@@ -958,6 +979,32 @@ class cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST : public BaseClass
         sNodeRssiMeasurementRequest* m_params = nullptr;
 };
 
+class cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST : public BaseClass
+{
+    public:
+        cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST();
+
+        static eActionOp_CONTROL get_action_op(){
+            return (eActionOp_CONTROL)(ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST);
+        }
+        uint8_t& requests_size();
+        std::tuple<bool, sNodeRssiMeasurementBatchEntry&> requests(size_t idx);
+        bool alloc_requests(size_t count = 1);
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_CONTROL* m_action_op = nullptr;
+        uint8_t* m_requests_size = nullptr;
+        sNodeRssiMeasurementBatchEntry* m_requests = nullptr;
+        size_t m_requests_idx__ = 0;
+        int m_lock_order_counter__ = 0;
+};
+
 class cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE : public BaseClass
 {
     public:
@@ -1042,6 +1089,32 @@ class cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION : public BaseClass
         sNodeRssiMeasurement* m_params = nullptr;
 };
 
+class cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION : public BaseClass
+{
+    public:
+        cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION();
+
+        static eActionOp_CONTROL get_action_op(){
+            return (eActionOp_CONTROL)(ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION);
+        }
+        uint8_t& measurements_size();
+        std::tuple<bool, sNodeRssiMeasurement&> measurements(size_t idx);
+        bool alloc_measurements(size_t count = 1);
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_CONTROL* m_action_op = nullptr;
+        uint8_t* m_measurements_size = nullptr;
+        sNodeRssiMeasurement* m_measurements = nullptr;
+        size_t m_measurements_idx__ = 0;
+        int m_lock_order_counter__ = 0;
+};
+
 class cACTION_CONTROL_CLIENT_NO_ACTIVITY_NOTIFICATION : public BaseClass
 {
     public:
@@ -1631,6 +1704,32 @@ class cACTION_CONTROL_CHANNEL_SCAN_RESULTS_NOTIFICATION : public BaseClass
         uint8_t* m_is_dump = nullptr;
 };
 
+class cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION : public BaseClass
+{
+    public:
+        cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION();
+
+        static eActionOp_CONTROL get_action_op(){
+            return (eActionOp_CONTROL)(ACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION);
+        }
+        uint8_t& results_size();
+        std::tuple<bool, sChannelScanResults&> results(size_t idx);
+        bool alloc_results(size_t count = 1);
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_CONTROL* m_action_op = nullptr;
+        uint8_t* m_results_size = nullptr;
+        sChannelScanResults* m_results = nullptr;
+        size_t m_results_idx__ = 0;
+        int m_lock_order_counter__ = 0;
+};
+
 class cACTION_CONTROL_CHANNEL_SCAN_ABORT_NOTIFICATION : public BaseClass
 {
     public:
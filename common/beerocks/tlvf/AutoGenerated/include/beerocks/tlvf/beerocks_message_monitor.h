@@ -297,6 +297,32 @@ class cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION : public BaseClass
         sNodeRssiMeasurement* m_params = nullptr;
 };
 
+class cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION : public BaseClass
+{
+    public:
+        cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION();
+
+        static eActionOp_MONITOR get_action_op(){
+            return (eActionOp_MONITOR)(ACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION);
+        }
+        uint8_t& measurements_size();
+        std::tuple<bool, sNodeRssiMeasurement&> measurements(size_t idx);
+        bool alloc_measurements(size_t count = 1);
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_MONITOR* m_action_op = nullptr;
+        uint8_t* m_measurements_size = nullptr;
+        sNodeRssiMeasurement* m_measurements = nullptr;
+        size_t m_measurements_idx__ = 0;
+        int m_lock_order_counter__ = 0;
+};
+
 class cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE : public BaseClass
 {
     public:
@@ -918,6 +944,32 @@ class cACTION_MONITOR_CHANNEL_SCAN_RESULTS_NOTIFICATION : public BaseClass
         uint8_t* m_is_dump = nullptr;
 };
 
+class cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION : public BaseClass
+{
+    public:
+        cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse = false);
+        explicit cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse = false);
+        ~cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION();
+
+        static eActionOp_MONITOR get_action_op(){
+            return (eActionOp_MONITOR)(ACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION);
+        }
+        uint8_t& results_size();
+        std::tuple<bool, sChannelScanResults&> results(size_t idx);
+        bool alloc_results(size_t count = 1);
+        void class_swap() override;
+        bool finalize() override;
+        static size_t get_initial_size();
+
+    private:
+        bool init();
+        eActionOp_MONITOR* m_action_op = nullptr;
+        uint8_t* m_results_size = nullptr;
+        sChannelScanResults* m_results = nullptr;
+        size_t m_results_idx__ = 0;
+        int m_lock_order_counter__ = 0;
+};
+
 class cACTION_MONITOR_CHANNEL_SCAN_ABORT_NOTIFICATION : public BaseClass
 {
     public:
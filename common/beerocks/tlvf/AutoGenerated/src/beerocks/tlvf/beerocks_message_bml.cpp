@@ -606,6 +606,155 @@ bool cACTION_BML_STATS_UPDATE::init()
     return true;
 }
 
+cACTION_BML_STATS_DELTA_UPDATE::cACTION_BML_STATS_DELTA_UPDATE(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_BML_STATS_DELTA_UPDATE::cACTION_BML_STATS_DELTA_UPDATE(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_BML_STATS_DELTA_UPDATE::~cACTION_BML_STATS_DELTA_UPDATE() {
+}
+uint8_t& cACTION_BML_STATS_DELTA_UPDATE::full() {
+    return (uint8_t&)(*m_full);
+}
+
+uint32_t& cACTION_BML_STATS_DELTA_UPDATE::num_of_records() {
+    return (uint32_t&)(*m_num_of_records);
+}
+
+uint32_t& cACTION_BML_STATS_DELTA_UPDATE::buffer_size() {
+    return (uint32_t&)(*m_buffer_size);
+}
+
+std::string cACTION_BML_STATS_DELTA_UPDATE::buffer_str() {
+    char *buffer_ = buffer();
+    if (!buffer_) { return std::string(); }
+    return std::string(buffer_, m_buffer_idx__);
+}
+
+char* cACTION_BML_STATS_DELTA_UPDATE::buffer(size_t length) {
+    if( (m_buffer_idx__ == 0) || (m_buffer_idx__ < length) ) {
+        TLVF_LOG(ERROR) << "buffer length is smaller than requested length";
+        return nullptr;
+    }
+    return ((char*)m_buffer);
+}
+
+bool cACTION_BML_STATS_DELTA_UPDATE::set_buffer(const std::string& str) { return set_buffer(str.c_str(), str.size()); }
+bool cACTION_BML_STATS_DELTA_UPDATE::set_buffer(const char str[], size_t size) {
+    if (str == nullptr) {
+        TLVF_LOG(WARNING) << "set_buffer received a null pointer.";
+        return false;
+    }
+    if (!alloc_buffer(size)) { return false; }
+    std::copy(str, str + size, m_buffer);
+    return true;
+}
+bool cACTION_BML_STATS_DELTA_UPDATE::alloc_buffer(size_t count) {
+    if (m_lock_order_counter__ > 0) {;
+        TLVF_LOG(ERROR) << "Out of order allocation for variable length list buffer, abort!";
+        return false;
+    }
+    size_t len = sizeof(char) * count;
+    if(getBuffRemainingBytes() < len )  {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer - can't allocate";
+        return false;
+    }
+    m_lock_order_counter__ = 0;
+    uint8_t *src = (uint8_t *)&m_buffer[*m_buffer_size];
+    uint8_t *dst = src + len;
+    if (!m_parse__) {
+        size_t move_length = getBuffRemainingBytes(src) - len;
+        std::copy_n(src, move_length, dst);
+    }
+    m_buffer_idx__ += count;
+    *m_buffer_size += count;
+    if (!buffPtrIncrementSafe(len)) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << len << ") Failed!";
+        return false;
+    }
+    return true;
+}
+
+void cACTION_BML_STATS_DELTA_UPDATE::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_BML), reinterpret_cast<uint8_t*>(m_action_op));
+    tlvf_swap(32, reinterpret_cast<uint8_t*>(m_num_of_records));
+    tlvf_swap(32, reinterpret_cast<uint8_t*>(m_buffer_size));
+}
+
+bool cACTION_BML_STATS_DELTA_UPDATE::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_BML_STATS_DELTA_UPDATE::get_initial_size()
+{
+    size_t class_size = 0;
+    class_size += sizeof(uint8_t); // full
+    class_size += sizeof(uint32_t); // num_of_records
+    class_size += sizeof(uint32_t); // buffer_size
+    return class_size;
+}
+
+bool cACTION_BML_STATS_DELTA_UPDATE::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    m_full = (uint8_t*)m_buff_ptr__;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_num_of_records = (uint32_t*)m_buff_ptr__;
+    if (!buffPtrIncrementSafe(sizeof(uint32_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint32_t) << ") Failed!";
+        return false;
+    }
+    m_buffer_size = (uint32_t*)m_buff_ptr__;
+    if (!m_parse__) *m_buffer_size = 0;
+    if (!buffPtrIncrementSafe(sizeof(uint32_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint32_t) << ") Failed!";
+        return false;
+    }
+    m_buffer = (char*)m_buff_ptr__;
+    uint32_t buffer_size = *m_buffer_size;
+    if (m_parse__) {  tlvf_swap(32, reinterpret_cast<uint8_t*>(&buffer_size)); }
+    m_buffer_idx__ = buffer_size;
+    if (!buffPtrIncrementSafe(sizeof(char) * (buffer_size))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(char) * (buffer_size) << ") Failed!";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
 cACTION_BML_EVENTS_UPDATE::cACTION_BML_EVENTS_UPDATE(uint8_t* buff, size_t buff_len, bool parse) :
     BaseClass(buff, buff_len, parse) {
     m_init_succeeded = init();
@@ -1324,9 +1473,66 @@ BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
 }
 cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::~cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST() {
 }
+uint8_t& cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::delta() {
+    return (uint8_t&)(*m_delta);
+}
+
+uint8_t& cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::node_types() {
+    return (uint8_t&)(*m_node_types);
+}
+
+uint8_t& cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::metrics() {
+    return (uint8_t&)(*m_metrics);
+}
+
+uint8_t& cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::macs_size() {
+    return (uint8_t&)(*m_macs_size);
+}
+
+std::tuple<bool, sMacAddr&> cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::macs(size_t idx) {
+    bool ret_success = ( (m_macs_idx__ > 0) && (m_macs_idx__ > idx) );
+    size_t ret_idx = ret_success ? idx : 0;
+    if (!ret_success) {
+        TLVF_LOG(ERROR) << "Requested index is greater than the number of available entries";
+    }
+    return std::forward_as_tuple(ret_success, m_macs[ret_idx]);
+}
+
+bool cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::alloc_macs(size_t count) {
+    if (m_lock_order_counter__ > 0) {;
+        TLVF_LOG(ERROR) << "Out of order allocation for variable length list macs, abort!";
+        return false;
+    }
+    size_t len = sizeof(sMacAddr) * count;
+    if(getBuffRemainingBytes() < len )  {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer - can't allocate";
+        return false;
+    }
+    m_lock_order_counter__ = 0;
+    uint8_t *src = (uint8_t *)&m_macs[*m_macs_size];
+    uint8_t *dst = src + len;
+    if (!m_parse__) {
+        size_t move_length = getBuffRemainingBytes(src) - len;
+        std::copy_n(src, move_length, dst);
+    }
+    m_macs_idx__ += count;
+    *m_macs_size += count;
+    if (!buffPtrIncrementSafe(len)) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << len << ") Failed!";
+        return false;
+    }
+    if (!m_parse__) { 
+        for (size_t i = m_macs_idx__ - count; i < m_macs_idx__; i++) { m_macs[i].struct_init(); }
+    }
+    return true;
+}
+
 void cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::class_swap()
 {
     tlvf_swap(8*sizeof(eActionOp_BML), reinterpret_cast<uint8_t*>(m_action_op));
+    for (size_t i = 0; i < (size_t)*m_macs_size; i++){
+        m_macs[i].struct_swap();
+    }
 }
 
 bool cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::finalize()
@@ -1359,6 +1565,10 @@ bool cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::finalize()
 size_t cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::get_initial_size()
 {
     size_t class_size = 0;
+    class_size += sizeof(uint8_t); // delta
+    class_size += sizeof(uint8_t); // node_types
+    class_size += sizeof(uint8_t); // metrics
+    class_size += sizeof(uint8_t); // macs_size
     return class_size;
 }
 
@@ -1368,6 +1578,34 @@ bool cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST::init()
         TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
         return false;
     }
+    m_delta = (uint8_t*)m_buff_ptr__;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_node_types = (uint8_t*)m_buff_ptr__;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_metrics = (uint8_t*)m_buff_ptr__;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_macs_size = (uint8_t*)m_buff_ptr__;
+    if (!m_parse__) *m_macs_size = 0;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_macs = (sMacAddr*)m_buff_ptr__;
+    uint8_t macs_size = *m_macs_size;
+    m_macs_idx__ = macs_size;
+    if (!buffPtrIncrementSafe(sizeof(sMacAddr) * (macs_size))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(sMacAddr) * (macs_size) << ") Failed!";
+        return false;
+    }
     if (m_parse__) { class_swap(); }
     return true;
 }
@@ -6814,4 +7052,200 @@ bool cACTION_BML_CHANNEL_SCAN_DUMP_RESULTS_RESPONSE::init()
     return true;
 }
 
+cACTION_BML_METRICS_REQUEST::cACTION_BML_METRICS_REQUEST(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_BML_METRICS_REQUEST::cACTION_BML_METRICS_REQUEST(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_BML_METRICS_REQUEST::~cACTION_BML_METRICS_REQUEST() {
+}
+void cACTION_BML_METRICS_REQUEST::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_BML), reinterpret_cast<uint8_t*>(m_action_op));
+}
+
+bool cACTION_BML_METRICS_REQUEST::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_BML_METRICS_REQUEST::get_initial_size()
+{
+    size_t class_size = 0;
+    return class_size;
+}
+
+bool cACTION_BML_METRICS_REQUEST::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
+cACTION_BML_METRICS_RESPONSE::cACTION_BML_METRICS_RESPONSE(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_BML_METRICS_RESPONSE::cACTION_BML_METRICS_RESPONSE(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_BML_METRICS_RESPONSE::~cACTION_BML_METRICS_RESPONSE() {
+}
+uint8_t& cACTION_BML_METRICS_RESPONSE::last() {
+    return (uint8_t&)(*m_last);
+}
+
+uint32_t& cACTION_BML_METRICS_RESPONSE::buffer_size() {
+    return (uint32_t&)(*m_buffer_size);
+}
+
+std::string cACTION_BML_METRICS_RESPONSE::buffer_str() {
+    char *buffer_ = buffer();
+    if (!buffer_) { return std::string(); }
+    return std::string(buffer_, m_buffer_idx__);
+}
+
+char* cACTION_BML_METRICS_RESPONSE::buffer(size_t length) {
+    if( (m_buffer_idx__ == 0) || (m_buffer_idx__ < length) ) {
+        TLVF_LOG(ERROR) << "buffer length is smaller than requested length";
+        return nullptr;
+    }
+    return ((char*)m_buffer);
+}
+
+bool cACTION_BML_METRICS_RESPONSE::set_buffer(const std::string& str) { return set_buffer(str.c_str(), str.size()); }
+bool cACTION_BML_METRICS_RESPONSE::set_buffer(const char str[], size_t size) {
+    if (str == nullptr) {
+        TLVF_LOG(WARNING) << "set_buffer received a null pointer.";
+        return false;
+    }
+    if (!alloc_buffer(size)) { return false; }
+    std::copy(str, str + size, m_buffer);
+    return true;
+}
+bool cACTION_BML_METRICS_RESPONSE::alloc_buffer(size_t count) {
+    if (m_lock_order_counter__ > 0) {;
+        TLVF_LOG(ERROR) << "Out of order allocation for variable length list buffer, abort!";
+        return false;
+    }
+    size_t len = sizeof(char) * count;
+    if(getBuffRemainingBytes() < len )  {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer - can't allocate";
+        return false;
+    }
+    m_lock_order_counter__ = 0;
+    uint8_t *src = (uint8_t *)&m_buffer[*m_buffer_size];
+    uint8_t *dst = src + len;
+    if (!m_parse__) {
+        size_t move_length = getBuffRemainingBytes(src) - len;
+        std::copy_n(src, move_length, dst);
+    }
+    m_buffer_idx__ += count;
+    *m_buffer_size += count;
+    if (!buffPtrIncrementSafe(len)) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << len << ") Failed!";
+        return false;
+    }
+    return true;
+}
+
+void cACTION_BML_METRICS_RESPONSE::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_BML), reinterpret_cast<uint8_t*>(m_action_op));
+    tlvf_swap(32, reinterpret_cast<uint8_t*>(m_buffer_size));
+}
+
+bool cACTION_BML_METRICS_RESPONSE::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_BML_METRICS_RESPONSE::get_initial_size()
+{
+    size_t class_size = 0;
+    class_size += sizeof(uint8_t); // last
+    class_size += sizeof(uint32_t); // buffer_size
+    return class_size;
+}
+
+bool cACTION_BML_METRICS_RESPONSE::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    m_last = (uint8_t*)m_buff_ptr__;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_buffer_size = (uint32_t*)m_buff_ptr__;
+    if (!m_parse__) *m_buffer_size = 0;
+    if (!buffPtrIncrementSafe(sizeof(uint32_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint32_t) << ") Failed!";
+        return false;
+    }
+    m_buffer = (char*)m_buff_ptr__;
+    uint32_t buffer_size = *m_buffer_size;
+    if (m_parse__) {  tlvf_swap(32, reinterpret_cast<uint8_t*>(&buffer_size)); }
+    m_buffer_idx__ = buffer_size;
+    if (!buffPtrIncrementSafe(sizeof(char) * (buffer_size))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(char) * (buffer_size) << ") Failed!";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
 
@@ -1231,6 +1231,75 @@ bool cACTION_CONTROL_PLATFORM_OPERATIONAL_NOTIFICATION::init()
     return true;
 }
 
+cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION::cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION::cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION::~cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION() {
+}
+uint32_t& cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION::features() {
+    return (uint32_t&)(*m_features);
+}
+
+void cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_CONTROL), reinterpret_cast<uint8_t*>(m_action_op));
+    tlvf_swap(32, reinterpret_cast<uint8_t*>(m_features));
+}
+
+bool cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION::get_initial_size()
+{
+    size_t class_size = 0;
+    class_size += sizeof(uint32_t); // features
+    return class_size;
+}
+
+bool cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    m_features = (uint32_t*)m_buff_ptr__;
+    if (!buffPtrIncrementSafe(sizeof(uint32_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint32_t) << ") Failed!";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
 cACTION_CONTROL_BACKHAUL_DL_RSSI_REPORT_NOTIFICATION::cACTION_CONTROL_BACKHAUL_DL_RSSI_REPORT_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
     BaseClass(buff, buff_len, parse) {
     m_init_succeeded = init();
@@ -3319,6 +3388,123 @@ bool cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST::init()
     return true;
 }
 
+cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::~cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST() {
+}
+uint8_t& cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::requests_size() {
+    return (uint8_t&)(*m_requests_size);
+}
+
+std::tuple<bool, sNodeRssiMeasurementBatchEntry&> cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::requests(size_t idx) {
+    bool ret_success = ( (m_requests_idx__ > 0) && (m_requests_idx__ > idx) );
+    size_t ret_idx = ret_success ? idx : 0;
+    if (!ret_success) {
+        TLVF_LOG(ERROR) << "Requested index is greater than the number of available entries";
+    }
+    return std::forward_as_tuple(ret_success, m_requests[ret_idx]);
+}
+
+bool cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::alloc_requests(size_t count) {
+    if (m_lock_order_counter__ > 0) {;
+        TLVF_LOG(ERROR) << "Out of order allocation for variable length list requests, abort!";
+        return false;
+    }
+    size_t len = sizeof(sNodeRssiMeasurementBatchEntry) * count;
+    if(getBuffRemainingBytes() < len )  {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer - can't allocate";
+        return false;
+    }
+    m_lock_order_counter__ = 0;
+    uint8_t *src = (uint8_t *)&m_requests[*m_requests_size];
+    uint8_t *dst = src + len;
+    if (!m_parse__) {
+        size_t move_length = getBuffRemainingBytes(src) - len;
+        std::copy_n(src, move_length, dst);
+    }
+    m_requests_idx__ += count;
+    *m_requests_size += count;
+    if (!buffPtrIncrementSafe(len)) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << len << ") Failed!";
+        return false;
+    }
+    if (!m_parse__) { 
+        for (size_t i = m_requests_idx__ - count; i < m_requests_idx__; i++) { m_requests[i].struct_init(); }
+    }
+    return true;
+}
+
+void cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_CONTROL), reinterpret_cast<uint8_t*>(m_action_op));
+    for (size_t i = 0; i < (size_t)*m_requests_size; i++){
+        m_requests[i].struct_swap();
+    }
+}
+
+bool cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::get_initial_size()
+{
+    size_t class_size = 0;
+    class_size += sizeof(uint8_t); // requests_size
+    return class_size;
+}
+
+bool cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    m_requests_size = (uint8_t*)m_buff_ptr__;
+    if (!m_parse__) *m_requests_size = 0;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_requests = (sNodeRssiMeasurementBatchEntry*)m_buff_ptr__;
+    uint8_t requests_size = *m_requests_size;
+    m_requests_idx__ = requests_size;
+    if (!buffPtrIncrementSafe(sizeof(sNodeRssiMeasurementBatchEntry) * (requests_size))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(sNodeRssiMeasurementBatchEntry) * (requests_size) << ") Failed!";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
 cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE(uint8_t* buff, size_t buff_len, bool parse) :
     BaseClass(buff, buff_len, parse) {
     m_init_succeeded = init();
@@ -3599,6 +3785,123 @@ bool cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION::init()
     return true;
 }
 
+cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::~cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION() {
+}
+uint8_t& cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::measurements_size() {
+    return (uint8_t&)(*m_measurements_size);
+}
+
+std::tuple<bool, sNodeRssiMeasurement&> cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::measurements(size_t idx) {
+    bool ret_success = ( (m_measurements_idx__ > 0) && (m_measurements_idx__ > idx) );
+    size_t ret_idx = ret_success ? idx : 0;
+    if (!ret_success) {
+        TLVF_LOG(ERROR) << "Requested index is greater than the number of available entries";
+    }
+    return std::forward_as_tuple(ret_success, m_measurements[ret_idx]);
+}
+
+bool cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::alloc_measurements(size_t count) {
+    if (m_lock_order_counter__ > 0) {;
+        TLVF_LOG(ERROR) << "Out of order allocation for variable length list measurements, abort!";
+        return false;
+    }
+    size_t len = sizeof(sNodeRssiMeasurement) * count;
+    if(getBuffRemainingBytes() < len )  {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer - can't allocate";
+        return false;
+    }
+    m_lock_order_counter__ = 0;
+    uint8_t *src = (uint8_t *)&m_measurements[*m_measurements_size];
+    uint8_t *dst = src + len;
+    if (!m_parse__) {
+        size_t move_length = getBuffRemainingBytes(src) - len;
+        std::copy_n(src, move_length, dst);
+    }
+    m_measurements_idx__ += count;
+    *m_measurements_size += count;
+    if (!buffPtrIncrementSafe(len)) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << len << ") Failed!";
+        return false;
+    }
+    if (!m_parse__) { 
+        for (size_t i = m_measurements_idx__ - count; i < m_measurements_idx__; i++) { m_measurements[i].struct_init(); }
+    }
+    return true;
+}
+
+void cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_CONTROL), reinterpret_cast<uint8_t*>(m_action_op));
+    for (size_t i = 0; i < (size_t)*m_measurements_size; i++){
+        m_measurements[i].struct_swap();
+    }
+}
+
+bool cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::get_initial_size()
+{
+    size_t class_size = 0;
+    class_size += sizeof(uint8_t); // measurements_size
+    return class_size;
+}
+
+bool cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    m_measurements_size = (uint8_t*)m_buff_ptr__;
+    if (!m_parse__) *m_measurements_size = 0;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_measurements = (sNodeRssiMeasurement*)m_buff_ptr__;
+    uint8_t measurements_size = *m_measurements_size;
+    m_measurements_idx__ = measurements_size;
+    if (!buffPtrIncrementSafe(sizeof(sNodeRssiMeasurement) * (measurements_size))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(sNodeRssiMeasurement) * (measurements_size) << ") Failed!";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
 cACTION_CONTROL_CLIENT_NO_ACTIVITY_NOTIFICATION::cACTION_CONTROL_CLIENT_NO_ACTIVITY_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
     BaseClass(buff, buff_len, parse) {
     m_init_succeeded = init();
@@ -5600,6 +5903,123 @@ bool cACTION_CONTROL_CHANNEL_SCAN_RESULTS_NOTIFICATION::init()
     return true;
 }
 
+cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::~cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION() {
+}
+uint8_t& cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::results_size() {
+    return (uint8_t&)(*m_results_size);
+}
+
+std::tuple<bool, sChannelScanResults&> cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::results(size_t idx) {
+    bool ret_success = ( (m_results_idx__ > 0) && (m_results_idx__ > idx) );
+    size_t ret_idx = ret_success ? idx : 0;
+    if (!ret_success) {
+        TLVF_LOG(ERROR) << "Requested index is greater than the number of available entries";
+    }
+    return std::forward_as_tuple(ret_success, m_results[ret_idx]);
+}
+
+bool cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::alloc_results(size_t count) {
+    if (m_lock_order_counter__ > 0) {;
+        TLVF_LOG(ERROR) << "Out of order allocation for variable length list results, abort!";
+        return false;
+    }
+    size_t len = sizeof(sChannelScanResults) * count;
+    if(getBuffRemainingBytes() < len )  {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer - can't allocate";
+        return false;
+    }
+    m_lock_order_counter__ = 0;
+    uint8_t *src = (uint8_t *)&m_results[*m_results_size];
+    uint8_t *dst = src + len;
+    if (!m_parse__) {
+        size_t move_length = getBuffRemainingBytes(src) - len;
+        std::copy_n(src, move_length, dst);
+    }
+    m_results_idx__ += count;
+    *m_results_size += count;
+    if (!buffPtrIncrementSafe(len)) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << len << ") Failed!";
+        return false;
+    }
+    if (!m_parse__) { 
+        for (size_t i = m_results_idx__ - count; i < m_results_idx__; i++) { m_results[i].struct_init(); }
+    }
+    return true;
+}
+
+void cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_CONTROL), reinterpret_cast<uint8_t*>(m_action_op));
+    for (size_t i = 0; i < (size_t)*m_results_size; i++){
+        m_results[i].struct_swap();
+    }
+}
+
+bool cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::get_initial_size()
+{
+    size_t class_size = 0;
+    class_size += sizeof(uint8_t); // results_size
+    return class_size;
+}
+
+bool cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    m_results_size = (uint8_t*)m_buff_ptr__;
+    if (!m_parse__) *m_results_size = 0;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_results = (sChannelScanResults*)m_buff_ptr__;
+    uint8_t results_size = *m_results_size;
+    m_results_idx__ = results_size;
+    if (!buffPtrIncrementSafe(sizeof(sChannelScanResults) * (results_size))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(sChannelScanResults) * (results_size) << ") Failed!";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
 cACTION_CONTROL_CHANNEL_SCAN_ABORT_NOTIFICATION::cACTION_CONTROL_CHANNEL_SCAN_ABORT_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
     BaseClass(buff, buff_len, parse) {
     m_init_succeeded = init();
@@ -906,6 +906,123 @@ bool cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION::init()
     return true;
 }
 
+cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::~cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION() {
+}
+uint8_t& cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::measurements_size() {
+    return (uint8_t&)(*m_measurements_size);
+}
+
+std::tuple<bool, sNodeRssiMeasurement&> cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::measurements(size_t idx) {
+    bool ret_success = ( (m_measurements_idx__ > 0) && (m_measurements_idx__ > idx) );
+    size_t ret_idx = ret_success ? idx : 0;
+    if (!ret_success) {
+        TLVF_LOG(ERROR) << "Requested index is greater than the number of available entries";
+    }
+    return std::forward_as_tuple(ret_success, m_measurements[ret_idx]);
+}
+
+bool cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::alloc_measurements(size_t count) {
+    if (m_lock_order_counter__ > 0) {;
+        TLVF_LOG(ERROR) << "Out of order allocation for variable length list measurements, abort!";
+        return false;
+    }
+    size_t len = sizeof(sNodeRssiMeasurement) * count;
+    if(getBuffRemainingBytes() < len )  {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer - can't allocate";
+        return false;
+    }
+    m_lock_order_counter__ = 0;
+    uint8_t *src = (uint8_t *)&m_measurements[*m_measurements_size];
+    uint8_t *dst = src + len;
+    if (!m_parse__) {
+        size_t move_length = getBuffRemainingBytes(src) - len;
+        std::copy_n(src, move_length, dst);
+    }
+    m_measurements_idx__ += count;
+    *m_measurements_size += count;
+    if (!buffPtrIncrementSafe(len)) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << len << ") Failed!";
+        return false;
+    }
+    if (!m_parse__) { 
+        for (size_t i = m_measurements_idx__ - count; i < m_measurements_idx__; i++) { m_measurements[i].struct_init(); }
+    }
+    return true;
+}
+
+void cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_MONITOR), reinterpret_cast<uint8_t*>(m_action_op));
+    for (size_t i = 0; i < (size_t)*m_measurements_size; i++){
+        m_measurements[i].struct_swap();
+    }
+}
+
+bool cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::get_initial_size()
+{
+    size_t class_size = 0;
+    class_size += sizeof(uint8_t); // measurements_size
+    return class_size;
+}
+
+bool cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    m_measurements_size = (uint8_t*)m_buff_ptr__;
+    if (!m_parse__) *m_measurements_size = 0;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_measurements = (sNodeRssiMeasurement*)m_buff_ptr__;
+    uint8_t measurements_size = *m_measurements_size;
+    m_measurements_idx__ = measurements_size;
+    if (!buffPtrIncrementSafe(sizeof(sNodeRssiMeasurement) * (measurements_size))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(sNodeRssiMeasurement) * (measurements_size) << ") Failed!";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
 cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE::cACTION_MONITOR_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE(uint8_t* buff, size_t buff_len, bool parse) :
     BaseClass(buff, buff_len, parse) {
     m_init_succeeded = init();
@@ -3010,6 +3127,123 @@ bool cACTION_MONITOR_CHANNEL_SCAN_RESULTS_NOTIFICATION::init()
     return true;
 }
 
+cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
+    BaseClass(buff, buff_len, parse) {
+    m_init_succeeded = init();
+}
+cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION(std::shared_ptr<BaseClass> base, bool parse) :
+BaseClass(base->getBuffPtr(), base->getBuffRemainingBytes(), parse){
+    m_init_succeeded = init();
+}
+cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::~cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION() {
+}
+uint8_t& cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::results_size() {
+    return (uint8_t&)(*m_results_size);
+}
+
+std::tuple<bool, sChannelScanResults&> cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::results(size_t idx) {
+    bool ret_success = ( (m_results_idx__ > 0) && (m_results_idx__ > idx) );
+    size_t ret_idx = ret_success ? idx : 0;
+    if (!ret_success) {
+        TLVF_LOG(ERROR) << "Requested index is greater than the number of available entries";
+    }
+    return std::forward_as_tuple(ret_success, m_results[ret_idx]);
+}
+
+bool cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::alloc_results(size_t count) {
+    if (m_lock_order_counter__ > 0) {;
+        TLVF_LOG(ERROR) << "Out of order allocation for variable length list results, abort!";
+        return false;
+    }
+    size_t len = sizeof(sChannelScanResults) * count;
+    if(getBuffRemainingBytes() < len )  {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer - can't allocate";
+        return false;
+    }
+    m_lock_order_counter__ = 0;
+    uint8_t *src = (uint8_t *)&m_results[*m_results_size];
+    uint8_t *dst = src + len;
+    if (!m_parse__) {
+        size_t move_length = getBuffRemainingBytes(src) - len;
+        std::copy_n(src, move_length, dst);
+    }
+    m_results_idx__ += count;
+    *m_results_size += count;
+    if (!buffPtrIncrementSafe(len)) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << len << ") Failed!";
+        return false;
+    }
+    if (!m_parse__) { 
+        for (size_t i = m_results_idx__ - count; i < m_results_idx__; i++) { m_results[i].struct_init(); }
+    }
+    return true;
+}
+
+void cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::class_swap()
+{
+    tlvf_swap(8*sizeof(eActionOp_MONITOR), reinterpret_cast<uint8_t*>(m_action_op));
+    for (size_t i = 0; i < (size_t)*m_results_size; i++){
+        m_results[i].struct_swap();
+    }
+}
+
+bool cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::finalize()
+{
+    if (m_parse__) {
+        TLVF_LOG(DEBUG) << "finalize() called but m_parse__ is set";
+        return true;
+    }
+    if (m_finalized__) {
+        TLVF_LOG(DEBUG) << "finalize() called for already finalized class";
+        return true;
+    }
+    if (!isPostInitSucceeded()) {
+        TLVF_LOG(ERROR) << "post init check failed";
+        return false;
+    }
+    if (m_inner__) {
+        if (!m_inner__->finalize()) {
+            TLVF_LOG(ERROR) << "m_inner__->finalize() failed";
+            return false;
+        }
+        auto tailroom = m_inner__->getMessageBuffLength() - m_inner__->getMessageLength();
+        m_buff_ptr__ -= tailroom;
+    }
+    class_swap();
+    m_finalized__ = true;
+    return true;
+}
+
+size_t cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::get_initial_size()
+{
+    size_t class_size = 0;
+    class_size += sizeof(uint8_t); // results_size
+    return class_size;
+}
+
+bool cACTION_MONITOR_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION::init()
+{
+    if (getBuffRemainingBytes() < get_initial_size()) {
+        TLVF_LOG(ERROR) << "Not enough available space on buffer. Class init failed";
+        return false;
+    }
+    m_results_size = (uint8_t*)m_buff_ptr__;
+    if (!m_parse__) *m_results_size = 0;
+    if (!buffPtrIncrementSafe(sizeof(uint8_t))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(uint8_t) << ") Failed!";
+        return false;
+    }
+    m_results = (sChannelScanResults*)m_buff_ptr__;
+    uint8_t results_size = *m_results_size;
+    m_results_idx__ = results_size;
+    if (!buffPtrIncrementSafe(sizeof(sChannelScanResults) * (results_size))) {
+        LOG(ERROR) << "buffPtrIncrementSafe(" << std::dec << sizeof(sChannelScanResults) * (results_size) << ") Failed!";
+        return false;
+    }
+    if (m_parse__) { class_swap(); }
+    return true;
+}
+
 cACTION_MONITOR_CHANNEL_SCAN_ABORT_NOTIFICATION::cACTION_MONITOR_CHANNEL_SCAN_ABORT_NOTIFICATION(uint8_t* buff, size_t buff_len, bool parse) :
     BaseClass(buff, buff_len, parse) {
     m_init_succeeded = init();
@@ -11,6 +11,7 @@
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 #include <easylogging++.h>
+#include <mapf/common/cmdu_trace.h>
 
 using namespace beerocks;
 
@@ -169,7 +170,11 @@ bool message_com::send_cmdu(Socket *sd, ieee1905_1::CmduMessageTx &cmdu_tx,
         memset(uds_header->dst_bridge_mac, 0, sizeof(message::sUdsHeader::dst_bridge_mac));
     }
 
-    uds_header->length = cmdu_tx.getMessageLength();
+    uds_header->length   = cmdu_tx.getMessageLength();
+    uds_header->trace_id = mapf::cmdu_trace::current_trace_id();
+
+    mapf::cmdu_trace::record(mapf::cmdu_trace::eHop::UDS_TX, uds_header->trace_id,
+                             uint16_t(cmdu_tx.getMessageType()), cmdu_tx.getMessageId());
 
     return send_data(sd, cmdu_tx.getMessageBuff() - sizeof(message::sUdsHeader),
                      uds_header->length + sizeof(message::sUdsHeader));
@@ -178,6 +183,13 @@ bool message_com::send_cmdu(Socket *sd, ieee1905_1::CmduMessageTx &cmdu_tx,
 bool message_com::forward_cmdu_to_uds(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx,
                                       uint16_t length)
 {
+    // The forwarded UDS header keeps the trace id of the received CMDU
+    auto uds_header = get_uds_header(cmdu_rx);
+    if (uds_header) {
+        mapf::cmdu_trace::record(mapf::cmdu_trace::eHop::UDS_TX, uds_header->trace_id,
+                                 uint16_t(cmdu_rx.getMessageType()), cmdu_rx.getMessageId());
+    }
+
     return message_com::send_data(sd, cmdu_rx.getMessageBuff() - sizeof(message::sUdsHeader),
                                   length + sizeof(message::sUdsHeader));
 }
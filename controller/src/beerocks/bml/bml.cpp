@@ -9,8 +9,12 @@
 #include "bml.h"
 #include "internal/bml_internal.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
+
+#include <mapf/common/cmdu_trace.h>
+
+#include <fstream>
 
 using namespace beerocks::net;
 
@@ -161,6 +165,15 @@ int bml_nw_map_query(BML_CTX ctx)
     return (pBML->nw_map_query());
 }
 
+int bml_nw_map_query_snapshot(BML_CTX ctx, unsigned int *generation)
+{
+    if (!ctx)
+        return (-BML_RET_INVALID_ARGS);
+    bml_internal *pBML = (bml_internal *)ctx;
+
+    return (pBML->nw_map_query_snapshot(generation));
+}
+
 int bml_stat_register_cb(BML_CTX ctx, BML_STATS_UPDATE_CB cb)
 {
     if (!ctx)
@@ -170,6 +183,16 @@ int bml_stat_register_cb(BML_CTX ctx, BML_STATS_UPDATE_CB cb)
     return pBML->register_stats_cb(cb);
 }
 
+int bml_stat_register_filtered_cb(BML_CTX ctx, BML_STATS_UPDATE_CB cb,
+                                  const struct BML_STATS_FILTER *filter)
+{
+    if (!ctx || (cb && !filter))
+        return (-BML_RET_INVALID_ARGS);
+    bml_internal *pBML = (bml_internal *)ctx;
+
+    return pBML->register_stats_cb(cb, filter);
+}
+
 int bml_event_register_cb(BML_CTX ctx, BML_EVENT_CB cb)
 {
     if (!ctx)
@@ -478,6 +501,53 @@ int bml_get_master_slave_versions(BML_CTX ctx, char *master_version, char *slave
     return (pBML->get_master_slave_versions(master_version, slave_version));
 }
 
+int bml_get_metrics(BML_CTX ctx, char *buffer, unsigned int *buffer_size)
+{
+    // Validate input parameters
+    if (!ctx || !buffer || !buffer_size || !*buffer_size) {
+        return (-BML_RET_INVALID_ARGS);
+    }
+
+    std::string metrics;
+    auto pBML = static_cast<bml_internal *>(ctx);
+    int iRet  = pBML->get_metrics(metrics);
+    if (iRet != BML_RET_OK) {
+        return iRet;
+    }
+
+    if (metrics.size() >= *buffer_size) {
+        *buffer_size = metrics.size() + 1;
+        return (-BML_RET_INVALID_ARGS);
+    }
+
+    beerocks::string_utils::copy_string(buffer, metrics.c_str(), *buffer_size);
+    *buffer_size = metrics.size();
+    return BML_RET_OK;
+}
+
+int bml_cmdu_trace_dump(const char *file_path)
+{
+    // Validate input parameters
+    if (!file_path) {
+        return (-BML_RET_INVALID_ARGS);
+    }
+
+    std::ofstream file(file_path);
+    if (!file) {
+        LOG(ERROR) << "Failed opening " << file_path;
+        return (-BML_RET_OP_FAILED);
+    }
+
+    auto events = mapf::cmdu_trace::write_chrome_json(file);
+    file.close();
+    if (!file) {
+        LOG(ERROR) << "Failed writing " << file_path;
+        return (-BML_RET_OP_FAILED);
+    }
+
+    return events ? BML_RET_OK : (-BML_RET_NO_DATA);
+}
+
 int bml_set_local_log_context(void *log_ctx) { return (bml_internal::set_log_context(log_ctx)); }
 
 const char *bml_get_bml_version() { return (BEEROCKS_VERSION); }
@@ -639,3 +709,39 @@ int bml_start_dcs_single_scan(BML_CTX ctx, const char *radio_mac, int dwell_time
     return pBML->start_dcs_single_scan(network_utils::mac_from_string(std::string(radio_mac)),
                                        dwell_time, channel_pool, channel_pool_size);
 }
+
+int bml_get_dcs_scan_results_async(BML_CTX ctx, const char *radio_mac,
+                                   unsigned int max_results_size, bool is_single_scan,
+                                   BML_DCS_SCAN_RESULTS_CB cb, void *user_data)
+{
+    // Validate intput params;
+    if (!ctx || !radio_mac || !cb) {
+        return (-BML_RET_INVALID_ARGS);
+    }
+
+    auto pBML = static_cast<bml_internal *>(ctx);
+    return pBML->get_dcs_scan_results_async(
+        network_utils::mac_from_string(std::string(radio_mac)), max_results_size, is_single_scan,
+        [ctx, cb, user_data](int request_id, int result,
+                             const std::vector<BML_NEIGHBOR_AP> &results, uint8_t result_status) {
+            cb(ctx, request_id, result, results.data(), results.size(), result_status, user_data);
+        });
+}
+
+int bml_start_dcs_single_scan_async(BML_CTX ctx, const char *radio_mac, int dwell_time_ms,
+                                    int channel_pool_size, unsigned int *channel_pool,
+                                    BML_REQUEST_CB cb, void *user_data)
+{
+    // Validate intput params;
+    if (!ctx || !radio_mac || !cb) {
+        return (-BML_RET_INVALID_ARGS);
+    }
+
+    auto pBML = static_cast<bml_internal *>(ctx);
+    return pBML->start_dcs_single_scan_async(
+        network_utils::mac_from_string(std::string(radio_mac)), dwell_time_ms, channel_pool,
+        channel_pool_size,
+        [ctx, cb, user_data](int request_id, int result) {
+            cb(ctx, request_id, result, user_data);
+        });
+}
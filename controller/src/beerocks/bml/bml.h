@@ -109,6 +109,23 @@ int bml_nw_map_register_update_cb(BML_CTX ctx, BML_NW_MAP_QUERY_CB cb);
  */
 int bml_nw_map_query(BML_CTX ctx);
 
+/**
+ * Read the latest network map from the topology snapshot, which the controller publishes in
+ * shared memory when the load_topology_snapshot feature is enabled.
+ * Unlike bml_nw_map_query(), the controller is not queried: the callback registered using the
+ * bml_nw_map_register_query_cb() function is called from the calling thread, before this
+ * function returns. It is never called concurrently with a response to bml_nw_map_query().
+ *
+ * @param [in] ctx BML Context.
+ * @param [in,out] generation Generation of the network map last read by the caller, the
+ * callback is not called if it did not change since. Updated with the generation of the
+ * current network map. May be NULL to always call the callback.
+ *
+ * @return BML_RET_OK on success, -BML_RET_OP_NOT_SUPPORTED if no snapshot is published
+ * (use bml_nw_map_query() instead).
+ */
+int bml_nw_map_query_snapshot(BML_CTX ctx, unsigned int *generation);
+
 /**
  * Registers a callback function to periodic statistics update from 
  * the beerocks platform.
@@ -122,6 +139,26 @@ int bml_nw_map_query(BML_CTX ctx);
  */
 int bml_stat_register_cb(BML_CTX ctx, BML_STATS_UPDATE_CB cb);
 
+/**
+ * Registers a callback function to periodic statistics update from
+ * the beerocks platform, for the nodes and metrics matching a filter.
+ *
+ * Only the metrics which changed since the previous update are sent by
+ * the controller, the callback always receives complete statistics.
+ * With BML_STATS_FILTER_FLAG_CHANGES_ONLY, only the nodes with changed
+ * metrics are passed to the callback.
+ *
+ * The function can be called with NULL callback to unregister the callback.
+ *
+ * @param [in] ctx BML Context.
+ * @param [in] cb Pointer to the statistics update callback.
+ * @param [in] filter Subscription filter.
+ *
+ * @return BML_RET_OK on success.
+ */
+int bml_stat_register_filtered_cb(BML_CTX ctx, BML_STATS_UPDATE_CB cb,
+                                  const struct BML_STATS_FILTER *filter);
+
 /**
  * Registers a callback function to events from 
  * the beerocks platform.
@@ -427,6 +464,34 @@ int bml_set_log_level(BML_CTX ctx, const char *module_name, const char *log_leve
  */
 int bml_get_master_slave_versions(BML_CTX ctx, char *master_version, char *slave_version);
 
+/**
+ * Returns the runtime metrics of the controller (message handling, task and HAL call
+ * latencies, queue depths), in the Prometheus text format.
+ *
+ * @param [in] ctx BML Context.
+ * @param [out] buffer Null terminated metrics.
+ * @param [in,out] buffer_size Size of the buffer, set to the length of the metrics.
+ *
+ * @return BML_RET_OK on success, -BML_RET_INVALID_ARGS if the buffer is too small for the
+ * metrics (buffer_size is set to the required size).
+ */
+int bml_get_metrics(BML_CTX ctx, char *buffer, unsigned int *buffer_size);
+
+/**
+ * Writes the CMDU traces of all the prplMesh processes of the device (transport, agent and
+ * controller) into a file, in the Chrome trace event JSON format (loaded by Perfetto and
+ * chrome://tracing).
+ *
+ * The traces are read from shared memory, without a connection to the controller, and include
+ * those of processes which are no longer running.
+ *
+ * @param [in] file_path Path of the output file.
+ *
+ * @return BML_RET_OK on success, -BML_RET_NO_DATA if no CMDU trace is found,
+ * -BML_RET_OP_FAILED if the file can not be written.
+ */
+int bml_cmdu_trace_dump(const char *file_path);
+
 /**
  * Use provided easylogging context.
  *
@@ -619,6 +684,42 @@ int bml_get_dcs_scan_results(BML_CTX ctx, const char *radio_mac,
 int bml_start_dcs_single_scan(BML_CTX ctx, const char *radio_mac, int dwell_time_ms,
                               int channel_pool_size, unsigned int *channel_pool);
 
+/**
+ * get DCS scan results, without blocking.
+ * Any number of requests may be outstanding, the callback is called from the BML thread once
+ * all the results were received, or the request failed.
+ *
+ * @param [in] ctx                  BML Context.
+ * @param [in] radio_mac            radio MAC of selected radio
+ * @param [in] max_results_size     Max requested results.
+ * @param [in] is_single_scan       Flag indicating if the params belong to a single scan or not
+ * @param [in] cb                   Completion callback.
+ * @param [in] user_data            Passed to the callback.
+ *
+ * @return Request id (positive) on success, negative BML_RET error otherwise.
+ */
+int bml_get_dcs_scan_results_async(BML_CTX ctx, const char *radio_mac,
+                                   unsigned int max_results_size, bool is_single_scan,
+                                   BML_DCS_SCAN_RESULTS_CB cb, void *user_data);
+
+/**
+ * Start a single DCS scan with parameters, without blocking.
+ * The callback is called from the BML thread with the result of the request.
+ *
+ * @param [in] ctx                  BML Context.
+ * @param [in] radio_mac            radio MAC of selected radio
+ * @param [in] dwell_time_ms        Set the dwell time in miliseconds.
+ * @param [in] channel_pool_size    Set the DCS channel pool size.
+ * @param [in] channel_pool         Set the channel pool for the DCS.
+ * @param [in] cb                   Completion callback.
+ * @param [in] user_data            Passed to the callback.
+ *
+ * @return Request id (positive) on success, negative BML_RET error otherwise.
+ */
+int bml_start_dcs_single_scan_async(BML_CTX ctx, const char *radio_mac, int dwell_time_ms,
+                                    int channel_pool_size, unsigned int *channel_pool,
+                                    BML_REQUEST_CB cb, void *user_data);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
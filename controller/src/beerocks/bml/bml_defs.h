@@ -96,6 +96,16 @@ extern "C" {
 #define BML_STAT_TYPE_VAP 2    /* VAP Statistics */
 #define BML_STAT_TYPE_CLIENT 3 /* Client/STA Statistics */
 
+/* BML Statistic Metric Sets (use with BML_STATS_FILTER) */
+#define BML_STATS_METRICS_TRAFFIC 0x01 /* Bytes and packets sent/received */
+#define BML_STATS_METRICS_ERRORS 0x02  /* Errors, retransmissions */
+#define BML_STATS_METRICS_LINK 0x04    /* Radio noise and load, client signal strength and rates */
+#define BML_STATS_METRICS_ALL 0x07     /* All the metrics */
+
+/* BML Statistic Filter Definitions */
+#define BML_STATS_FILTER_MAX_MACS 32         /* Maximal number of nodes in a filter */
+#define BML_STATS_FILTER_FLAG_CHANGES_ONLY 1 /* Report only the nodes with changed metrics */
+
 /* BML Event Types */
 #define BML_EVENT_TYPE_BSS_TM_REQ 1                      /* BSS TM Request (11v) */
 #define BML_EVENT_TYPE_BEACON_MEASUREMENT 2              /* Beacon Measurement Request (11k) */
@@ -379,6 +389,34 @@ struct BML_STATS {
     /* TBD */
 };
 
+/**
+ * Statistics subscription filter (use with bml_stat_register_filtered_cb()).
+ */
+struct BML_STATS_FILTER {
+
+    /**
+     * Bitmask of (1 << BML_STAT_TYPE_XXX) of the reported nodes, 0 for all the types.
+     */
+    uint32_t node_types;
+
+    /**
+     * Bitmask of BML_STATS_METRICS_XXX of the reported metrics, 0 for all the metrics.
+     * Metrics which are not reported are set to 0.
+     */
+    uint32_t metrics;
+
+    /**
+     * BML_STATS_FILTER_FLAG_XXX flags.
+     */
+    uint32_t flags;
+
+    /**
+     * MAC addresses of the reported nodes, all the nodes if num_of_macs is 0.
+     */
+    uint32_t num_of_macs;
+    uint8_t macs[BML_STATS_FILTER_MAX_MACS][BML_MAC_ADDR_LEN];
+};
+
 /**
  * Beerocks event structure.
  */
@@ -619,6 +657,24 @@ typedef void (*BML_STATS_UPDATE_CB)(const struct BML_STATS_ITER *);
  */
 typedef void (*BML_EVENT_CB)(const struct BML_EVENT *);
 
+/**
+ * Completion callback of an asynchronous request.
+ * Called from the BML thread with the id returned when the request was sent, and the
+ * result of the request: BML_RET_OK on success, or a negative BML_RET error
+ * (-BML_RET_TIMEOUT if no response was received in time).
+ */
+typedef void (*BML_REQUEST_CB)(BML_CTX ctx, int request_id, int result, void *user_data);
+
+/**
+ * Completion callback of an asynchronous DCS scan results request.
+ * Called from the BML thread, the results are only valid during the call.
+ * The result is BML_RET_OK or a negative BML_RET error, as for BML_REQUEST_CB.
+ */
+typedef void (*BML_DCS_SCAN_RESULTS_CB)(BML_CTX ctx, int request_id, int result,
+                                        const struct BML_NEIGHBOR_AP *results,
+                                        unsigned int results_size, uint8_t result_status,
+                                        void *user_data);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
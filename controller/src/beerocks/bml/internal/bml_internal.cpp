@@ -10,14 +10,22 @@
 #include "bml_defs.h"
 #include "bml_iter_node.h"
 #include "bml_iter_stat.h"
+#include "bml_stats_delta.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_message_structs.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message_bml.h>
 
+#include <algorithm>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace beerocks;
 using namespace net;
 
@@ -93,6 +101,29 @@ static void translate_channel_scan_results(const beerocks_message::sChannelScanR
     res_out.ap_ChannelUtilization        = res_in.channel_utilization;
 }
 
+/**
+ * @brief Translate the error code of a channel scan operation to a BML return code.
+ *
+ * @param op_error_code eChannelScanOpErrCode returned by the controller.
+ * @return BML_RET_OK on success, negative BML_RET error otherwise.
+ */
+static int channel_scan_op_result(int op_error_code)
+{
+    switch (eChannelScanOpErrCode(op_error_code)) {
+    case eChannelScanOpErrCode::CHANNEL_SCAN_OP_SUCCESS:
+        return BML_RET_OK;
+    case eChannelScanOpErrCode::CHANNEL_SCAN_OP_INVALID_PARAMS_ENABLE:
+    case eChannelScanOpErrCode::CHANNEL_SCAN_OP_INVALID_PARAMS_DWELLTIME:
+    case eChannelScanOpErrCode::CHANNEL_SCAN_OP_INVALID_PARAMS_SCANTIME:
+    case eChannelScanOpErrCode::CHANNEL_SCAN_OP_INVALID_PARAMS_CHANNELPOOL:
+        return (-BML_RET_INVALID_ARGS);
+    case eChannelScanOpErrCode::CHANNEL_SCAN_OP_ERROR:
+    case eChannelScanOpErrCode::CHANNEL_SCAN_OP_SCAN_IN_PROGRESS:
+    default:
+        return (-BML_RET_OP_FAILED);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////////////// Implementation ///////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -109,7 +140,7 @@ bml_internal::bml_internal()
 #endif
 }
 
-bml_internal::~bml_internal() {}
+bml_internal::~bml_internal() { close_topology_snapshot(); }
 
 int bml_internal::send_bml_cmdu(int &result, uint8_t action_op)
 {
@@ -168,6 +199,94 @@ int bml_internal::send_bml_cmdu(int &result, uint8_t action_op)
     return (iRet);
 }
 
+int bml_internal::send_async_request(uint8_t response_action_op, int timeout_ms,
+                                     const async_build_t &build,
+                                     const async_handler_t &handler)
+{
+    // Command supported only on local master
+    if (!is_local_master()) {
+        LOG(ERROR) << "Command supported only on local master!";
+        return (-BML_RET_OP_NOT_SUPPORTED);
+    }
+
+    // If the socket is not valid, attempt to re-establish the connection
+    if (!m_sockMaster && !connect_to_master()) {
+        return (-BML_RET_CONNECT_FAIL);
+    }
+
+    // Register the request before sending it, the response may arrive before send returns.
+    // Message id 0 is used by the synchronous requests.
+    std::unique_lock<std::mutex> lock(m_mtxAsyncRequests);
+    uint16_t id;
+    do {
+        id = ++m_async_request_id;
+    } while (id == 0 || m_async_requests.count(id) != 0);
+
+    auto &request              = m_async_requests[id];
+    request.response_action_op = response_action_op;
+    request.timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    request.handler = handler;
+    lock.unlock();
+
+    // Built in a buffer of its own, the cmdu_tx member is not guarded and may be in use by
+    // another caller thread
+    uint8_t tx_buffer[beerocks::message::MESSAGE_BUFFER_LENGTH];
+    ieee1905_1::CmduMessageTx request_tx(tx_buffer, sizeof(tx_buffer));
+    if (!build(request_tx, id) || !message_com::send_cmdu(m_sockMaster, request_tx)) {
+        LOG(ERROR) << "Failed sending message!";
+        lock.lock();
+        m_async_requests.erase(id);
+        return (-BML_RET_OP_FAILED);
+    }
+
+    return id;
+}
+
+bool bml_internal::handle_async_response(std::shared_ptr<beerocks_header> beerocks_header)
+{
+    uint16_t id = beerocks_header->id();
+
+    std::unique_lock<std::mutex> lock(m_mtxAsyncRequests);
+    auto it = m_async_requests.find(id);
+    if (it == m_async_requests.end() ||
+        it->second.response_action_op != beerocks_header->action_op()) {
+        return false;
+    }
+    // The handler may send new requests, call it without holding the lock
+    auto handler = it->second.handler;
+    lock.unlock();
+
+    if (handler(id, beerocks_header)) {
+        lock.lock();
+        m_async_requests.erase(id);
+    }
+
+    return true;
+}
+
+void bml_internal::expire_async_requests(bool all)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    std::vector<std::pair<uint16_t, async_handler_t>> expired;
+    std::unique_lock<std::mutex> lock(m_mtxAsyncRequests);
+    for (auto it = m_async_requests.begin(); it != m_async_requests.end();) {
+        if (all || it->second.timeout <= now) {
+            LOG(WARNING) << "Request " << it->first << " failed, waiting for action_op "
+                         << int(it->second.response_action_op);
+            expired.emplace_back(it->first, std::move(it->second.handler));
+            it = m_async_requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    lock.unlock();
+
+    for (auto &request : expired) {
+        request.second(request.first, nullptr);
+    }
+}
+
 bool bml_internal::init()
 {
     on_thread_stop();
@@ -432,6 +551,77 @@ bool bml_internal::handle_stats_update(int elements_num, void *data_buffer)
     return (true);
 }
 
+bool bml_internal::handle_stats_delta_update(bool full, int records_num,
+                                             const uint8_t *data_buffer, size_t buffer_size,
+                                             bool last)
+{
+    // First update of the subscription
+    if (full) {
+        m_stats_samples.clear();
+        m_stats_updated.clear();
+    }
+
+    // Apply the records on top of the previous statistics of the nodes
+    size_t pos = 0;
+    for (int i = 0; i < records_num; i++) {
+        bml_stats_delta::sRecordHeader header;
+        if (buffer_size - pos < sizeof(header)) {
+            LOG(ERROR) << "Truncated statistics record";
+            return false;
+        }
+        std::copy_n(data_buffer + pos, sizeof(header), reinterpret_cast<uint8_t *>(&header));
+
+        sMacAddr mac;
+        std::copy_n(header.mac, BML_MAC_ADDR_LEN, mac.oct);
+
+        if (header.flags & bml_stats_delta::RECORD_FLAG_REMOVED) {
+            m_stats_samples.erase(mac);
+            pos += sizeof(header);
+            continue;
+        }
+
+        int len = bml_stats_delta::decode(data_buffer + pos, buffer_size - pos, header,
+                                          m_stats_samples[mac]);
+        if (len < 0) {
+            LOG(ERROR) << "Invalid statistics record of " << mac;
+            m_stats_samples.erase(mac);
+            return false;
+        }
+        pos += len;
+        m_stats_updated.push_back(mac);
+    }
+
+    // An update may be split over several messages
+    if (!last) {
+        return true;
+    }
+
+    m_stats_buffer.clear();
+    int nodes_num  = 0;
+    auto add_stats = [&](const BML_STATS &stats) {
+        auto data = reinterpret_cast<const uint8_t *>(&stats);
+        m_stats_buffer.insert(m_stats_buffer.end(), data,
+                              data + bml_stats_delta::get_stats_len(stats.type));
+        nodes_num++;
+    };
+
+    if (m_stats_filter_flags & BML_STATS_FILTER_FLAG_CHANGES_ONLY) {
+        for (auto &mac : m_stats_updated) {
+            auto it = m_stats_samples.find(mac);
+            if (it != m_stats_samples.end()) {
+                add_stats(it->second);
+            }
+        }
+    } else {
+        for (auto &sample : m_stats_samples) {
+            add_stats(sample.second);
+        }
+    }
+    m_stats_updated.clear();
+
+    return handle_stats_update(nodes_num, m_stats_buffer.data());
+}
+
 bool bml_internal::handle_event_update(uint8_t *data_buffer)
 {
     // Exit gracefully is no callback function has been registered
@@ -485,8 +675,12 @@ bool bml_internal::handle_event_update(uint8_t *data_buffer)
     return (true);
 }
 
+void bml_internal::after_select(bool timeout) { expire_async_requests(false); }
+
 void bml_internal::on_thread_stop()
 {
+    expire_async_requests(true);
+
     if (m_sockPlatform) {
         remove_socket(m_sockPlatform);
         delete m_sockPlatform;
@@ -506,6 +700,9 @@ bool bml_internal::socket_disconnected(Socket *sd)
 
     // Attempt reconnecting to the master
     if (sd == m_sockMaster) {
+        // Responses of the outstanding requests are lost
+        expire_async_requests(true);
+
         LOG(INFO) << "Master socket disconnected. Reconnecting...";
         connect_to_master();
     } else if (sd == m_sockPlatform) {
@@ -543,6 +740,11 @@ int bml_internal::process_cmdu_header(std::shared_ptr<beerocks_header> beerocks_
 
     // BML messages
     if (beerocks_header->action() == beerocks_message::ACTION_BML) {
+        // Responses of asynchronous requests, the synchronous requests use message id 0
+        if (beerocks_header->id() != 0 && handle_async_response(beerocks_header)) {
+            return BML_RET_OK;
+        }
+
         //uint32_t num_of_nodes;
         // Process BML messages
         switch (beerocks_header->action_op()) {
@@ -565,6 +767,7 @@ int bml_internal::process_cmdu_header(std::shared_ptr<beerocks_header> beerocks_
             char *firstNode       = (num_of_nodes > 0) ? response->buffer(0) : nullptr;
 
             // Process the message
+            std::lock_guard<std::mutex> lock(m_mtxNwMapQuery);
             handle_nw_map_query_update(num_of_nodes, (int)beerocks_header->actionhdr()->last(),
                                        firstNode, true);
 
@@ -589,6 +792,19 @@ int bml_internal::process_cmdu_header(std::shared_ptr<beerocks_header> beerocks_
             // Process the message
             handle_stats_update(num_of_nodes, firstNode);
         } break;
+        // filtered statistics update
+        case beerocks_message::ACTION_BML_STATS_DELTA_UPDATE: {
+            auto response =
+                beerocks_header->addClass<beerocks_message::cACTION_BML_STATS_DELTA_UPDATE>();
+            if (!response) {
+                LOG(ERROR) << "addClass cACTION_BML_STATS_DELTA_UPDATE failed";
+                break;
+            }
+            auto buffer_size = response->buffer_size();
+            auto buffer      = (buffer_size > 0) ? (uint8_t *)response->buffer(0) : nullptr;
+            handle_stats_delta_update(response->full(), response->num_of_records(), buffer,
+                                      buffer_size, beerocks_header->actionhdr()->last());
+        } break;
         // event update
         case beerocks_message::ACTION_BML_EVENTS_UPDATE: {
             auto response =
@@ -993,50 +1209,9 @@ int bml_internal::process_cmdu_header(std::shared_ptr<beerocks_header> beerocks_
                 return BML_RET_OP_FAILED;
             }
 
-            //Signal any waiting threads
-            if (m_prmChannelScanResultsGet) {
-
-                if (m_scan_results && m_scan_results_maxsize && m_scan_results_status) {
-                    uint8_t op_error_code  = response->op_error_code();
-                    *m_scan_results_status = response->result_status();
-                    auto scan_results_size = response->results_size();
-                    uint8_t last           = response->last();
-
-                    LOG(DEBUG) << "Received response ["
-                               << "opt code: " << int(op_error_code)
-                               << ", status: " << int(*m_scan_results_status)
-                               << ", size: " << int(scan_results_size) << "].";
-
-                    if (scan_results_size > 0) {
-                        LOG(TRACE) << "currently " << m_scan_results->size() << " cached results, "
-                                   << "adding " << int(scan_results_size) << ".";
-
-                        // Get results from CMDU
-                        auto results = &std::get<1>(response->results(0));
-
-                        // Cap results if no more room is avaliable
-                        scan_results_size =
-                            (m_scan_results->size() + scan_results_size > *m_scan_results_maxsize)
-                                ? *m_scan_results_maxsize - m_scan_results->size()
-                                : scan_results_size;
-
-                        // Insert results
-                        m_scan_results->insert(m_scan_results->end(), results,
-                                               results + scan_results_size);
-                        LOG(TRACE) << "added " << int(scan_results_size) << " results, "
-                                   << "to a total of " << m_scan_results->size() << ".";
-                    }
-                    if (!last) {
-                        LOG(TRACE) << "Waiting for more results.";
-                    } else {
-                        LOG(TRACE) << "Done receiving results, resolving promise.";
-                        m_prmChannelScanResultsGet->set_value(op_error_code);
-                    }
-                }
-            } else {
-                LOG(WARNING) << "Received ACTION_BML_CHANNEL_SCAN_GET_RESULTS_RESPONSE response, "
-                             << "but no one is waiting...";
-            }
+            // Results are only expected by asynchronous requests
+            LOG(WARNING) << "Received ACTION_BML_CHANNEL_SCAN_GET_RESULTS_RESPONSE response, "
+                         << "but no one is waiting...";
         } break;
         case beerocks_message::ACTION_BML_CHANNEL_SCAN_START_SCAN_RESPONSE: {
             LOG(DEBUG) << "ACTION_BML_CHANNEL_SCAN_START_SCAN_RESPONSE received";
@@ -1575,85 +1750,192 @@ int bml_internal::get_dcs_scan_results(const sMacAddr &mac, BML_NEIGHBOR_AP *res
         return (-BML_RET_INVALID_DATA);
     }
 
-    // If the socket is not valid, attempt to re-establish the connection
-    if (!m_sockMaster) {
-        int iRet = connect_to_master();
-        if (iRet != BML_RET_OK) {
-            return iRet;
-        }
+    // Shared with the callback, which may outlive this call on timeout
+    struct sState {
+        beerocks::promise<int> prmResults;
+        std::vector<BML_NEIGHBOR_AP> results;
+        uint8_t result_status = 0;
+    };
+    auto state = std::make_shared<sState>();
+
+    int iRet = send_dcs_scan_results_request(
+        mac, max_results_size, is_single_scan,
+        [state](int request_id, int result, const std::vector<BML_NEIGHBOR_AP> &results,
+                uint8_t result_status) {
+            state->results       = results;
+            state->result_status = result_status;
+            state->prmResults.set_value(result);
+        });
+    if (iRet < 0) {
+        return iRet;
     }
 
-    // Initialize the promise for receiving the response
-    beerocks::promise<int> prmChannelScanResultsGet;
-    m_prmChannelScanResultsGet    = &prmChannelScanResultsGet;
-    int iOpTimeout                = DELAYED_RESPONSE_TIMEOUT; // Default timeout
-    auto scan_results             = std::list<beerocks_message::sChannelScanResults>();
-    uint32_t scan_results_maxsize = uint32_t(max_results_size);
+    // The request times out on the BML thread, the extra delay covers the expiry check interval
+    if (!state->prmResults.wait_for(DELAYED_RESPONSE_TIMEOUT + RESPONSE_TIMEOUT)) {
+        LOG(WARNING) << "Timeout while waiting for results get response...";
+        return (-BML_RET_TIMEOUT);
+    }
 
-    m_scan_results         = &scan_results;
-    m_scan_results_maxsize = &scan_results_maxsize;
-    m_scan_results_status  = &result_status;
+    // eChannelScanOpErrCode of the operation, or a negative BML_RET error
+    iRet          = state->prmResults.get_value();
+    result_status = state->result_status;
+    if (iRet != int(eChannelScanOpErrCode::CHANNEL_SCAN_OP_SUCCESS)) {
+        LOG(ERROR) << "Results get failed!";
+        return iRet;
+    }
 
-    auto request = message_com::create_vs_message<
-        beerocks_message::cACTION_BML_CHANNEL_SCAN_GET_RESULTS_REQUEST>(cmdu_tx);
+    //output_results_size will be set to the number of actual returning results
+    results_size = state->results.size();
+    std::copy(state->results.begin(), state->results.end(), results);
 
-    if (!request) {
-        LOG(ERROR) << "Failed building cACTION_BML_CHANNEL_SCAN_GET_RESULTS_REQUEST message!";
-        return (-BML_RET_OP_FAILED);
-    }
+    return BML_RET_OK;
+}
 
-    request->radio_mac() = mac;
-    request->scan_mode() = (is_single_scan) ? 1 : 0;
-    // Build and send the message
-    if (!message_com::send_cmdu(m_sockMaster, cmdu_tx)) {
-        LOG(ERROR) << "Failed sending param get message!";
-        m_prmChannelScanResultsGet = nullptr;
-        m_scan_results             = nullptr;
-        m_scan_results_maxsize     = nullptr;
-        m_scan_results_status      = nullptr;
-        return (-BML_RET_OP_FAILED);
+int bml_internal::get_dcs_scan_results_async(const sMacAddr &mac,
+                                             const unsigned int max_results_size,
+                                             bool is_single_scan, dcs_scan_results_cb_t callback)
+{
+    if (max_results_size == 0 || !callback) {
+        LOG(ERROR) << "Function is called, but no data is being requested!";
+        return (-BML_RET_INVALID_DATA);
     }
-    LOG(DEBUG) << "ACTION_BML_CHANNEL_SCAN_GET_RESULTS_REQUEST sent";
 
-    int iRet = BML_RET_OK;
+    return send_dcs_scan_results_request(
+        mac, max_results_size, is_single_scan,
+        [callback](int request_id, int result, const std::vector<BML_NEIGHBOR_AP> &results,
+                   uint8_t result_status) {
+            callback(request_id, result < 0 ? result : channel_scan_op_result(result), results,
+                     result_status);
+        });
+}
 
-    if (!m_prmChannelScanResultsGet->wait_for(iOpTimeout)) {
-        LOG(WARNING) << "Timeout while waiting for results get response...";
-        iRet = -BML_RET_TIMEOUT;
-    }
+int bml_internal::send_dcs_scan_results_request(const sMacAddr &mac,
+                                                const unsigned int max_results_size,
+                                                bool is_single_scan,
+                                                dcs_scan_results_cb_t callback)
+{
+    // Results accumulated over the responses, until the last one
+    auto results = std::make_shared<std::vector<BML_NEIGHBOR_AP>>();
 
-    // Clear the scan results members
-    m_scan_results         = nullptr;
-    m_scan_results_maxsize = nullptr;
-    m_scan_results_status  = nullptr;
+    auto build = [&](ieee1905_1::CmduMessageTx &request_tx, uint16_t id) {
+        auto request = message_com::create_vs_message<
+            beerocks_message::cACTION_BML_CHANNEL_SCAN_GET_RESULTS_REQUEST>(request_tx, id);
+        if (!request) {
+            LOG(ERROR) << "Failed building cACTION_BML_CHANNEL_SCAN_GET_RESULTS_REQUEST message!";
+            return false;
+        }
 
-    // Clear the promise holder
-    m_prmChannelScanResultsGet = nullptr;
+        request->radio_mac() = mac;
+        request->scan_mode() = (is_single_scan) ? 1 : 0;
+        return true;
+    };
 
-    if (iRet != BML_RET_OK) {
-        LOG(ERROR) << "Results get failed!";
-        return (iRet);
-    }
+    auto handler = [results, max_results_size,
+                    callback](uint16_t id, std::shared_ptr<beerocks_header> beerocks_header) {
+        if (!beerocks_header) {
+            callback(id, -BML_RET_TIMEOUT, *results, 0);
+            return true;
+        }
 
-    iRet = prmChannelScanResultsGet.get_value();
-    LOG(DEBUG) << "Promise resolved, recived results info: ["
-               << "total count: " << scan_results.size() << ", "
-               << "results status: " << int(result_status) << ", "
-               << "results opt code: " << int(iRet) << "].";
-    if (iRet != int(eChannelScanOpErrCode::CHANNEL_SCAN_OP_SUCCESS)) {
-        LOG(ERROR) << "Results returned with error code:" << iRet << ". Aborting!";
-        return iRet;
+        auto response =
+            beerocks_header
+                ->addClass<beerocks_message::cACTION_BML_CHANNEL_SCAN_GET_RESULTS_RESPONSE>();
+        if (!response) {
+            LOG(ERROR) << "addClass cACTION_BML_CHANNEL_SCAN_GET_RESULTS_RESPONSE failed";
+            callback(id, -BML_RET_OP_FAILED, *results, 0);
+            return true;
+        }
+
+        LOG(DEBUG) << "Received response ["
+                   << "opt code: " << int(response->op_error_code())
+                   << ", status: " << int(response->result_status())
+                   << ", size: " << int(response->results_size()) << "].";
+
+        // Cap results if no more room is avaliable
+        for (size_t i = 0; i < response->results_size() && results->size() < max_results_size;
+             i++) {
+            BML_NEIGHBOR_AP result;
+            translate_channel_scan_results(std::get<1>(response->results(i)), result);
+            results->push_back(result);
+        }
+
+        if (!response->last()) {
+            LOG(TRACE) << "Waiting for more results.";
+            return false;
+        }
+
+        int op_error_code = response->op_error_code();
+        if (op_error_code != int(eChannelScanOpErrCode::CHANNEL_SCAN_OP_SUCCESS)) {
+            LOG(ERROR) << "Results returned with error code:" << op_error_code;
+        }
+        callback(id, op_error_code, *results, response->result_status());
+        return true;
+    };
+
+    int id = send_async_request(beerocks_message::ACTION_BML_CHANNEL_SCAN_GET_RESULTS_RESPONSE,
+                                DELAYED_RESPONSE_TIMEOUT, build, handler);
+    if (id > 0) {
+        LOG(DEBUG) << "ACTION_BML_CHANNEL_SCAN_GET_RESULTS_REQUEST sent, id=" << id;
     }
+    return id;
+}
 
-    //output_results_size will be set to the number of actual returning results
-    results_size = 0;
-    for (auto &res : scan_results) {
-        auto &out = results[results_size];
-        translate_channel_scan_results(res, out);
-        results_size += 1;
+int bml_internal::start_dcs_single_scan_async(
+    const sMacAddr &mac, int dwell_time_ms, unsigned int *channel_pool, int channel_pool_size,
+    std::function<void(int request_id, int result)> callback)
+{
+    if (!callback) {
+        LOG(ERROR) << "Invalid callback!";
+        return (-BML_RET_INVALID_DATA);
     }
 
-    return BML_RET_OK;
+    auto build = [&](ieee1905_1::CmduMessageTx &request_tx, uint16_t id) {
+        auto request = message_com::create_vs_message<
+            beerocks_message::cACTION_BML_CHANNEL_SCAN_START_SCAN_REQUEST>(request_tx, id);
+        if (!request) {
+            LOG(ERROR) << "Failed building cACTION_BML_CHANNEL_SCAN_START_SCAN_REQUEST message!";
+            return false;
+        }
+
+        request->scan_params().radio_mac         = mac;
+        request->scan_params().dwell_time_ms     = dwell_time_ms;
+        request->scan_params().channel_pool_size = channel_pool_size;
+        if (channel_pool && channel_pool_size > 0 &&
+            channel_pool_size <= BML_CHANNEL_SCAN_MAX_CHANNEL_POOL_SIZE) {
+            std::copy_n(channel_pool, channel_pool_size, request->scan_params().channel_pool);
+        }
+        return true;
+    };
+
+    auto handler = [callback](uint16_t id, std::shared_ptr<beerocks_header> beerocks_header) {
+        if (!beerocks_header) {
+            callback(id, -BML_RET_TIMEOUT);
+            return true;
+        }
+
+        auto response =
+            beerocks_header
+                ->addClass<beerocks_message::cACTION_BML_CHANNEL_SCAN_START_SCAN_RESPONSE>();
+        if (!response) {
+            LOG(ERROR) << "addClass cACTION_BML_CHANNEL_SCAN_START_SCAN_RESPONSE failed";
+            callback(id, -BML_RET_OP_FAILED);
+            return true;
+        }
+
+        int op_error_code = response->op_error_code();
+        if (op_error_code != int(eChannelScanOpErrCode::CHANNEL_SCAN_OP_SUCCESS)) {
+            LOG(ERROR) << "Start scan returned error code:" << op_error_code;
+        }
+        callback(id, channel_scan_op_result(op_error_code));
+        return true;
+    };
+
+    int id = send_async_request(beerocks_message::ACTION_BML_CHANNEL_SCAN_START_SCAN_RESPONSE,
+                                RESPONSE_TIMEOUT, build, handler);
+    if (id > 0) {
+        LOG(DEBUG) << "ACTION_BML_CHANNEL_SCAN_START_SCAN_REQUEST sent, id=" << id;
+    }
+    return id;
 }
 
 int bml_internal::start_dcs_single_scan(const sMacAddr &mac, int dwell_time_ms,
@@ -1845,7 +2127,138 @@ int bml_internal::nw_map_query()
     return (BML_RET_OK);
 }
 
-int bml_internal::register_stats_cb(BML_STATS_UPDATE_CB pCB)
+bool bml_internal::open_topology_snapshot()
+{
+    using namespace bml_topology_snapshot;
+
+    m_topology_snapshot_fd = shm_open(SHM_NAME, O_RDONLY, 0);
+    if (m_topology_snapshot_fd < 0) {
+        // Not published by the controller
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(m_topology_snapshot_fd, &st) < 0 || size_t(st.st_size) < sizeof(sHeader)) {
+        LOG(ERROR) << "Invalid topology snapshot " << SHM_NAME;
+        close_topology_snapshot();
+        return false;
+    }
+
+    auto addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, m_topology_snapshot_fd, 0);
+    if (addr == MAP_FAILED) {
+        LOG(ERROR) << "Failed mapping " << SHM_NAME << ": " << strerror(errno);
+        close_topology_snapshot();
+        return false;
+    }
+    m_topology_snapshot      = static_cast<const sHeader *>(addr);
+    m_topology_snapshot_size = st.st_size;
+
+    if (m_topology_snapshot->magic != MAGIC || m_topology_snapshot->version != VERSION ||
+        m_topology_snapshot->header_len != sizeof(sHeader) ||
+        m_topology_snapshot->size > m_topology_snapshot_size) {
+        LOG(ERROR) << "Unsupported topology snapshot, version " << m_topology_snapshot->version;
+        close_topology_snapshot();
+        return false;
+    }
+
+    return true;
+}
+
+void bml_internal::close_topology_snapshot()
+{
+    if (m_topology_snapshot) {
+        munmap(const_cast<bml_topology_snapshot::sHeader *>(m_topology_snapshot),
+               m_topology_snapshot_size);
+        m_topology_snapshot      = nullptr;
+        m_topology_snapshot_size = 0;
+    }
+
+    if (m_topology_snapshot_fd >= 0) {
+        close(m_topology_snapshot_fd);
+        m_topology_snapshot_fd = -1;
+    }
+}
+
+int bml_internal::nw_map_query_snapshot(uint32_t *generation)
+{
+    using namespace bml_topology_snapshot;
+
+    // The BML thread may deliver a network map response at the same time
+    std::lock_guard<std::mutex> lock(m_mtxNwMapQuery);
+
+    if (!m_cbNetMapQuery) {
+        LOG(WARNING) << "Network map callback function was NOT registered...";
+        return (-BML_RET_OP_NOT_SUPPORTED);
+    }
+
+    // The segment is removed when the controller stops, a restarted controller creates a new one
+    struct stat st;
+    if (m_topology_snapshot && (fstat(m_topology_snapshot_fd, &st) < 0 || st.st_nlink == 0)) {
+        close_topology_snapshot();
+    }
+
+    if (!m_topology_snapshot && !open_topology_snapshot()) {
+        return (-BML_RET_OP_NOT_SUPPORTED);
+    }
+
+    auto data = reinterpret_cast<const uint8_t *>(m_topology_snapshot) + sizeof(sHeader);
+    uint32_t snapshot_generation = 0;
+    uint32_t num_of_nodes        = 0;
+    uint32_t data_len            = 0;
+    bool changed                 = false;
+
+    // Sequence lock: retry while the controller is updating the snapshot
+    int retries = 0;
+    for (; retries < MAX_READ_RETRIES; retries++) {
+        auto sequence = m_topology_snapshot->sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            sched_yield();
+            continue;
+        }
+
+        snapshot_generation = m_topology_snapshot->generation;
+        num_of_nodes        = m_topology_snapshot->num_of_nodes;
+        data_len            = m_topology_snapshot->data_len;
+        changed             = (!generation || *generation != snapshot_generation);
+
+        // Torn values are caught by the sequence check below
+        if (changed && data_len <= m_topology_snapshot_size - sizeof(sHeader)) {
+            m_topology_snapshot_buffer.assign(data, data + data_len);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_topology_snapshot->sequence.load(std::memory_order_relaxed) == sequence) {
+            break;
+        }
+    }
+
+    if (retries == MAX_READ_RETRIES) {
+        LOG(WARNING) << "Timeout while reading the topology snapshot";
+        return (-BML_RET_TIMEOUT);
+    }
+
+    if (snapshot_generation == 0) {
+        // Not published yet
+        return (-BML_RET_OP_NOT_SUPPORTED);
+    }
+
+    if (data_len > m_topology_snapshot_size - sizeof(sHeader)) {
+        LOG(ERROR) << "Invalid topology snapshot length " << data_len;
+        return (-BML_RET_INVALID_DATA);
+    }
+
+    if (generation) {
+        *generation = snapshot_generation;
+    }
+
+    if (changed) {
+        handle_nw_map_query_update(num_of_nodes, 1, m_topology_snapshot_buffer.data(), true);
+    }
+
+    return (BML_RET_OK);
+}
+
+int bml_internal::register_stats_cb(BML_STATS_UPDATE_CB pCB, const BML_STATS_FILTER *filter)
 {
     // Command supported only on local master
     if (!is_local_master()) {
@@ -1865,7 +2278,13 @@ int bml_internal::register_stats_cb(BML_STATS_UPDATE_CB pCB)
         return (-BML_RET_OP_NOT_SUPPORTED);
     }
 
-    m_cbStatsUpdate = pCB;
+    if (filter && filter->num_of_macs > BML_STATS_FILTER_MAX_MACS) {
+        LOG(ERROR) << "Too many nodes in the statistics filter: " << filter->num_of_macs;
+        return (-BML_RET_INVALID_ARGS);
+    }
+
+    m_cbStatsUpdate      = pCB;
+    m_stats_filter_flags = filter ? filter->flags : 0;
 
     //CMDU message
     if (m_cbStatsUpdate) {
@@ -1876,6 +2295,20 @@ int bml_internal::register_stats_cb(BML_STATS_UPDATE_CB pCB)
             LOG(ERROR) << "Failed building REGISTER_TO_STATS_UPDATES_REQUEST message!";
             return (-BML_RET_OP_FAILED);
         }
+
+        // Without a filter, the full statistics of all the nodes are sent on every update
+        request->delta() = (filter != nullptr);
+        if (filter) {
+            request->node_types() = filter->node_types;
+            request->metrics()    = filter->metrics;
+            if (filter->num_of_macs && !request->alloc_macs(filter->num_of_macs)) {
+                LOG(ERROR) << "Failed allocating the statistics filter nodes!";
+                return (-BML_RET_OP_FAILED);
+            }
+            for (uint32_t i = 0; i < filter->num_of_macs; i++) {
+                std::copy_n(filter->macs[i], BML_MAC_ADDR_LEN, std::get<1>(request->macs(i)).oct);
+            }
+        }
     } else {
         auto request = message_com::create_vs_message<
             beerocks_message::cACTION_BML_UNREGISTER_FROM_STATS_UPDATES_REQUEST>(cmdu_tx);
@@ -2854,6 +3287,92 @@ int bml_internal::get_master_slave_versions(char *master_version, char *slave_ve
     return (iRet);
 }
 
+int bml_internal::get_metrics(std::string &metrics)
+{
+    // Shared with the callback, which may outlive this call on timeout
+    struct sState {
+        beerocks::promise<int> prmMetrics;
+        std::string metrics;
+    };
+    auto state = std::make_shared<sState>();
+
+    int iRet = get_metrics_async([state](int request_id, int result, const std::string &metrics) {
+        state->metrics = metrics;
+        state->prmMetrics.set_value(result);
+    });
+    if (iRet < 0) {
+        return iRet;
+    }
+
+    // The request times out on the BML thread, the extra delay covers the expiry check interval
+    if (!state->prmMetrics.wait_for(2 * RESPONSE_TIMEOUT)) {
+        LOG(WARNING) << "Timeout while waiting for metrics response...";
+        return (-BML_RET_TIMEOUT);
+    }
+
+    iRet = state->prmMetrics.get_value();
+    if (iRet != BML_RET_OK) {
+        LOG(ERROR) << "Metrics get failed!";
+        return iRet;
+    }
+
+    metrics = std::move(state->metrics);
+    return BML_RET_OK;
+}
+
+int bml_internal::get_metrics_async(
+    std::function<void(int request_id, int result, const std::string &metrics)> callback)
+{
+    if (!callback) {
+        LOG(ERROR) << "Invalid callback!";
+        return (-BML_RET_INVALID_DATA);
+    }
+
+    auto build = [&](ieee1905_1::CmduMessageTx &request_tx, uint16_t id) {
+        auto request =
+            message_com::create_vs_message<beerocks_message::cACTION_BML_METRICS_REQUEST>(
+                request_tx, id);
+        if (!request) {
+            LOG(ERROR) << "Failed building cACTION_BML_METRICS_REQUEST message!";
+            return false;
+        }
+        return true;
+    };
+
+    // Metrics accumulated over the responses, until the last one
+    auto metrics = std::make_shared<std::string>();
+
+    auto handler = [metrics, callback](uint16_t id,
+                                       std::shared_ptr<beerocks_header> beerocks_header) {
+        if (!beerocks_header) {
+            callback(id, -BML_RET_TIMEOUT, *metrics);
+            return true;
+        }
+
+        auto response = beerocks_header->addClass<beerocks_message::cACTION_BML_METRICS_RESPONSE>();
+        if (!response) {
+            LOG(ERROR) << "addClass cACTION_BML_METRICS_RESPONSE failed";
+            callback(id, -BML_RET_OP_FAILED, *metrics);
+            return true;
+        }
+
+        metrics->append(response->buffer_str());
+        if (!response->last()) {
+            return false;
+        }
+
+        callback(id, BML_RET_OK, *metrics);
+        return true;
+    };
+
+    int id = send_async_request(beerocks_message::ACTION_BML_METRICS_RESPONSE, RESPONSE_TIMEOUT,
+                                build, handler);
+    if (id > 0) {
+        LOG(DEBUG) << "ACTION_BML_METRICS_REQUEST sent, id=" << id;
+    }
+    return id;
+}
+
 int bml_internal::set_log_context(void *log_ctx)
 {
     if (!log_ctx) {
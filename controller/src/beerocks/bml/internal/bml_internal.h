@@ -19,10 +19,15 @@
 #include <beerocks/tlvf/beerocks_message_platform.h>
 
 #include "bml_defs.h"
+#include "bml_topology_snapshot.h"
 
+#include <chrono>
+#include <functional>
 #include <list>
 #include <map>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 class bml_internal : public beerocks::socket_thread {
 
@@ -45,8 +50,19 @@ public:
     // Query the beerocks master for the network map
     int nw_map_query();
 
-    // Register a callback for the statistcs results
-    int register_stats_cb(BML_STATS_UPDATE_CB pCB);
+    /**
+     * @brief Read the network map from the topology snapshot published by the controller,
+     * without querying it. The query callback is called from the calling thread, serialized
+     * with the network map responses delivered by the BML thread.
+     *
+     * @param [in,out] generation Generation of the last read snapshot, the callback is not
+     * called if it did not change. Updated with the generation read. May be nullptr.
+     * @return BML_RET_OK on success, -BML_RET_OP_NOT_SUPPORTED if no snapshot is published.
+     */
+    int nw_map_query_snapshot(uint32_t *generation);
+
+    // Register a callback for the statistcs results, optionally filtered and delta encoded
+    int register_stats_cb(BML_STATS_UPDATE_CB pCB, const BML_STATS_FILTER *filter = nullptr);
 
     // Register a callback for events
     int register_event_cb(BML_EVENT_CB pCB);
@@ -134,6 +150,26 @@ public:
     // Return master & slave version
     int get_master_slave_versions(char *master_version, char *slave_version);
 
+    /**
+    * @brief Get the runtime metrics of the controller.
+    *
+    * @param [out] metrics Metrics, in the Prometheus text format.
+    *
+    * @return BML_RET_OK on success.
+    */
+    int get_metrics(std::string &metrics);
+
+    /**
+    * @brief Get the runtime metrics of the controller, without blocking.
+    * The callback is called from the BML thread.
+    *
+    * @param [in] callback Called with the metrics, or the error of the request.
+    *
+    * @return Request id (positive) on success, negative error otherwise.
+    */
+    int get_metrics_async(
+        std::function<void(int request_id, int result, const std::string &metrics)> callback);
+
     // set global/slave restricted channel
     int set_restricted_channels(const uint8_t *restricted_channels, const std::string mac,
                                 uint8_t is_global, uint8_t size);
@@ -227,6 +263,40 @@ public:
     */
     int start_dcs_single_scan(const sMacAddr &mac, int dwell_time_ms, unsigned int *channel_pool,
                               int channel_pool_size);
+
+    typedef std::function<void(int request_id, int result,
+                               const std::vector<BML_NEIGHBOR_AP> &results, uint8_t result_status)>
+        dcs_scan_results_cb_t;
+
+    /**
+    * @brief Get DCS channel scan results, without blocking.
+    * The callback is called from the BML thread.
+    *
+    * @param [in] mac              Radio MAC of selected radio
+    * @param [in] max_results_size Max requested results
+    * @param [in] is_single_scan   Flag, if the results should be from a single scan or continuous
+    * @param [in] callback         Called with the results, or the error of the request.
+    *
+    * @return Request id (positive) on success, negative error otherwise.
+    */
+    int get_dcs_scan_results_async(const sMacAddr &mac, const unsigned int max_results_size,
+                                   bool is_single_scan, dcs_scan_results_cb_t callback);
+
+    /**
+    * @brief Start a single DCS scan with parameters, without blocking.
+    * The callback is called from the BML thread.
+    *
+    * @param [in] mac                  Radio MAC of selected radio
+    * @param [in] dwell_time_ms        Set the dwell time in milliseconds.
+    * @param [in] channel_pool         Set the channel pool for the DCS.
+    * @param [in] channel_pool_size    Set the DCS channel pool size.
+    * @param [in] callback             Called with the result of the request.
+    *
+    * @return Request id (positive) on success, negative error otherwise.
+    */
+    int start_dcs_single_scan_async(const sMacAddr &mac, int dwell_time_ms,
+                                    unsigned int *channel_pool, int channel_pool_size,
+                                    std::function<void(int request_id, int result)> callback);
     /*
  * Public static methods:
  */
@@ -250,6 +320,7 @@ protected:
     virtual bool init() override;
     virtual void on_thread_stop() override;
     virtual bool socket_disconnected(Socket *sd) override;
+    virtual void after_select(bool timeout) override;
     virtual std::string print_cmdu_types(const beerocks::message::sUdsHeader *cmdu_header) override;
     bool wake_up(uint8_t action_opcode, int value);
     bool connect_to_master();
@@ -261,14 +332,61 @@ private:
     bool initialize(const std::string &beerocks_conf_path);
     bool connect_to_platform();
 
+    bool open_topology_snapshot();
+    void close_topology_snapshot();
     bool handle_nw_map_query_update(int elements_num, int last_node, void *data_buffer,
                                     bool is_query);
     bool handle_stats_update(int elements_num, void *data_buffer);
+    bool handle_stats_delta_update(bool full, int records_num, const uint8_t *data_buffer,
+                                   size_t buffer_size, bool last);
     bool handle_event_update(uint8_t *data_buffer);
     virtual bool handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx) override;
     // Send message contained in cmdu to m_sockMaster,
     int send_bml_cmdu(int &result, uint8_t action_op);
 
+    // Handler of the responses of an asynchronous request, called with nullptr if the request
+    // failed (timeout, disconnection). Returns false while more responses are expected.
+    typedef std::function<bool(uint16_t id,
+                               std::shared_ptr<beerocks::beerocks_header> beerocks_header)>
+        async_handler_t;
+
+    // Builds a request in the given buffer, with the given message id
+    typedef std::function<bool(ieee1905_1::CmduMessageTx &request_tx, uint16_t id)>
+        async_build_t;
+
+    struct sAsyncRequest {
+        uint8_t response_action_op;
+        std::chrono::steady_clock::time_point timeout;
+        async_handler_t handler;
+    };
+
+    /**
+     * @brief Send a request without waiting for its response.
+     *
+     * Requests are correlated with their responses by message id, so any number of requests
+     * may be outstanding.
+     *
+     * @param response_action_op Action op of the response.
+     * @param timeout_ms Timeout of the response.
+     * @param build Builds the request, in a buffer owned by the call.
+     * @param handler Handler of the responses.
+     * @return Message id of the request (positive) on success, negative error otherwise.
+     */
+    int send_async_request(uint8_t response_action_op, int timeout_ms, const async_build_t &build,
+                           const async_handler_t &handler);
+
+    /**
+     * @brief Send a DCS channel scan results request, as get_dcs_scan_results_async() does.
+     *
+     * The callback gets the eChannelScanOpErrCode of the operation, or a negative BML_RET error
+     * if the request failed, the blocking get_dcs_scan_results() returns it as is.
+     */
+    int send_dcs_scan_results_request(const sMacAddr &mac, const unsigned int max_results_size,
+                                      bool is_single_scan, dcs_scan_results_cb_t callback);
+    bool handle_async_response(std::shared_ptr<beerocks::beerocks_header> beerocks_header);
+    // Fail the outstanding requests which timed out, or all of them
+    void expire_async_requests(bool all);
+
 private:
     std::string m_strBeerocksConfPath;
     beerocks::config_file::sConfigSlave m_sConfig;
@@ -293,17 +411,38 @@ private:
     beerocks::promise<int> *m_prmRdkbWlan               = nullptr;
     //Promise used to indicate the GetParams response was received
     beerocks::promise<bool> *m_prmChannelScanParamsGet = nullptr;
-    //Promise used to indicate the GetResults response was received
-    beerocks::promise<int> *m_prmChannelScanResultsGet = nullptr;
 
     std::map<uint8_t, beerocks::promise<int> *> m_prmCliResponses;
 
+    // Outstanding asynchronous requests, by message id
+    std::mutex m_mtxAsyncRequests;
+    std::unordered_map<uint16_t, sAsyncRequest> m_async_requests;
+    uint16_t m_async_request_id = 0;
+
+    // Serializes the query callback between nw_map_query_snapshot() and the BML thread,
+    // and guards the topology snapshot members below
+    std::mutex m_mtxNwMapQuery;
+
+    // Mapping of the topology snapshot, and the copy of the network map read from it
+    int m_topology_snapshot_fd                                = -1;
+    const bml_topology_snapshot::sHeader *m_topology_snapshot = nullptr;
+    size_t m_topology_snapshot_size                           = 0;
+    std::vector<uint8_t> m_topology_snapshot_buffer;
+
     // Callback functions
     BML_NW_MAP_QUERY_CB m_cbNetMapQuery  = nullptr;
     BML_NW_MAP_QUERY_CB m_cbNetMapUpdate = nullptr;
     BML_STATS_UPDATE_CB m_cbStatsUpdate  = nullptr;
     BML_EVENT_CB m_cbEvent               = nullptr;
 
+    // Filtered statistics subscription: the BML_STATS_FILTER_FLAG_XXX flags, the statistics of
+    // the reported nodes rebuilt from the delta encoded updates, the nodes updated by the
+    // current update and the buffer passed to the callback
+    uint32_t m_stats_filter_flags = 0;
+    std::unordered_map<sMacAddr, BML_STATS> m_stats_samples;
+    std::vector<sMacAddr> m_stats_updated;
+    std::vector<uint8_t> m_stats_buffer;
+
     beerocks_message::sDeviceInfo *m_device_info                 = nullptr;
     beerocks_message::sWifiCredentials *m_wifi_credentials       = nullptr;
     beerocks_message::sAdminCredentials *m_admin_credentials     = nullptr;
@@ -311,12 +450,6 @@ private:
     beerocks_message::sRestrictedChannels *m_Restricted_channels = nullptr;
     //m_scan_params is used when receiving the channel scan parameters
     beerocks_message::sChannelScanRequestParams *m_scan_params = nullptr;
-    //m_scan_results is used when receiving channel scan results
-    std::list<beerocks_message::sChannelScanResults> *m_scan_results = nullptr;
-    //m_scan_results_status is used to store the results' latest status
-    uint8_t *m_scan_results_status = nullptr;
-    //m_scan_results_maxsize is used to indicate the maximum capacity of the requested results
-    uint32_t *m_scan_results_maxsize = nullptr;
     BML_VAP_INFO *m_vaps             = nullptr;
     uint8_t *m_pvaps_list_size       = nullptr;
     uint16_t id                      = 0;
@@ -9,7 +9,7 @@
 #include "bml_iter_node.h"
 #include "bml_defs.h"
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 bml_iter_node::bml_iter_node(int elements_num, void *data_buffer)
     : bml_iter_base(elements_num, data_buffer)
@@ -0,0 +1,244 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BML_STATS_DELTA_H_
+#define _BML_STATS_DELTA_H_
+
+#include "bml_defs.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Delta encoding of the BML statistics, shared by the controller (encoder) and the BML
+ * library (decoder).
+ *
+ * Each record of an ACTION_BML_STATS_DELTA_UPDATE buffer is an sRecordHeader, followed by the
+ * values of the fields set in its bitmask, in field order. A field is only encoded if it
+ * changed since the previous sample sent to the listener, the decoder applies the record on top
+ * of its own copy of that sample.
+ */
+namespace bml_stats_delta {
+
+enum eRecordFlags : uint8_t {
+    RECORD_FLAG_REMOVED = 0x01, // The node is gone, the listener drops its sample
+};
+
+struct sRecordHeader {
+    uint8_t mac[BML_MAC_ADDR_LEN];
+    uint8_t type;
+    uint8_t flags;
+    uint16_t fields;
+} __attribute__((packed));
+
+struct sField {
+    uint16_t offset;
+    uint8_t size;
+    // BML_STATS_METRICS_XXX set of the field, 0 for metadata which is only encoded along with a
+    // changed metric (the measurement window jitters on every sample)
+    uint8_t metrics;
+};
+
+#define BML_STATS_DELTA_FIELD(_member, _metrics)                                                   \
+    {                                                                                              \
+        uint16_t(offsetof(BML_STATS, _member)), uint8_t(sizeof(BML_STATS::_member)), _metrics      \
+    }
+
+#define BML_STATS_DELTA_COMMON_FIELDS                                                              \
+    BML_STATS_DELTA_FIELD(bytes_sent, BML_STATS_METRICS_TRAFFIC),                                  \
+        BML_STATS_DELTA_FIELD(bytes_received, BML_STATS_METRICS_TRAFFIC),                          \
+        BML_STATS_DELTA_FIELD(packets_sent, BML_STATS_METRICS_TRAFFIC),                            \
+        BML_STATS_DELTA_FIELD(packets_received, BML_STATS_METRICS_TRAFFIC),                        \
+        BML_STATS_DELTA_FIELD(errors_sent, BML_STATS_METRICS_ERRORS),                              \
+        BML_STATS_DELTA_FIELD(errors_received, BML_STATS_METRICS_ERRORS),                          \
+        BML_STATS_DELTA_FIELD(retrans_count, BML_STATS_METRICS_ERRORS),                            \
+        BML_STATS_DELTA_FIELD(measurement_window_msec, 0)
+
+/**
+ * @brief Get the encoded fields of a statistics type.
+ *
+ * @param[in] type BML_STAT_TYPE_XXX type.
+ * @param[out] count Number of fields, at most 16.
+ * @return Fields of the type, nullptr for an unsupported type.
+ */
+inline const sField *get_fields(int type, size_t &count)
+{
+    static const sField radio_fields[] = {
+        BML_STATS_DELTA_COMMON_FIELDS,
+        BML_STATS_DELTA_FIELD(uType.radio.bss_load, BML_STATS_METRICS_LINK),
+        BML_STATS_DELTA_FIELD(uType.radio.noise, BML_STATS_METRICS_LINK),
+    };
+    static const sField client_fields[] = {
+        BML_STATS_DELTA_COMMON_FIELDS,
+        BML_STATS_DELTA_FIELD(uType.client.signal_strength, BML_STATS_METRICS_LINK),
+        BML_STATS_DELTA_FIELD(uType.client.last_data_downlink_rate, BML_STATS_METRICS_LINK),
+        BML_STATS_DELTA_FIELD(uType.client.last_data_uplink_rate, BML_STATS_METRICS_LINK),
+        BML_STATS_DELTA_FIELD(uType.client.retransmissions, BML_STATS_METRICS_ERRORS),
+    };
+
+    switch (type) {
+    case BML_STAT_TYPE_RADIO:
+        count = sizeof(radio_fields) / sizeof(radio_fields[0]);
+        return radio_fields;
+    case BML_STAT_TYPE_CLIENT:
+        count = sizeof(client_fields) / sizeof(client_fields[0]);
+        return client_fields;
+    default:
+        count = 0;
+        return nullptr;
+    }
+}
+
+#undef BML_STATS_DELTA_COMMON_FIELDS
+#undef BML_STATS_DELTA_FIELD
+
+/**
+ * @brief Length of the BML_STATS of a type in the BML_STATS_UPDATE_CB buffers, which only
+ * contain the union member of the type.
+ */
+inline size_t get_stats_len(int type)
+{
+    size_t len = sizeof(BML_STATS) - sizeof(BML_STATS::S_TYPE);
+    switch (type) {
+    case BML_STAT_TYPE_RADIO:
+        return len + sizeof(BML_STATS::S_TYPE::S_RADIO);
+    case BML_STAT_TYPE_VAP:
+        return len + sizeof(BML_STATS::S_TYPE::S_VAP);
+    case BML_STAT_TYPE_CLIENT:
+        return len + sizeof(BML_STATS::S_TYPE::S_CLIENT);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Encode the metrics of a node which changed since the previous sample.
+ *
+ * @param[in] stats Current statistics of the node.
+ * @param[in] prev Previous statistics sent for the node, nullptr to encode all the metrics.
+ * @param[in] metrics BML_STATS_METRICS_XXX bitmask of the encoded metrics.
+ * @param[out] buf Output buffer.
+ * @param[in] buf_size Size of the output buffer.
+ * @return Length of the record, 0 if no metric changed, -1 if the buffer is too small.
+ */
+inline int encode(const BML_STATS &stats, const BML_STATS *prev, uint8_t metrics, uint8_t *buf,
+                  size_t buf_size)
+{
+    size_t count;
+    auto fields = get_fields(stats.type, count);
+
+    auto curr_data = reinterpret_cast<const uint8_t *>(&stats);
+    auto prev_data = reinterpret_cast<const uint8_t *>(prev);
+
+    uint16_t changed    = 0;
+    bool changed_metric = false;
+    size_t len          = sizeof(sRecordHeader);
+    for (size_t i = 0; i < count; i++) {
+        auto &field = fields[i];
+        if (field.metrics && !(field.metrics & metrics)) {
+            continue;
+        }
+        if (prev && !memcmp(curr_data + field.offset, prev_data + field.offset, field.size)) {
+            continue;
+        }
+        changed |= (1 << i);
+        changed_metric |= (field.metrics != 0);
+        len += field.size;
+    }
+
+    if (!changed_metric) {
+        return 0;
+    }
+    if (len > buf_size) {
+        return -1;
+    }
+
+    sRecordHeader header;
+    memcpy(header.mac, stats.mac, sizeof(header.mac));
+    header.type   = stats.type;
+    header.flags  = 0;
+    header.fields = changed;
+    memcpy(buf, &header, sizeof(header));
+
+    auto pos = buf + sizeof(header);
+    for (size_t i = 0; i < count; i++) {
+        if (changed & (1 << i)) {
+            memcpy(pos, curr_data + fields[i].offset, fields[i].size);
+            pos += fields[i].size;
+        }
+    }
+
+    return len;
+}
+
+/**
+ * @brief Encode the removal of a node.
+ *
+ * @return Length of the record, -1 if the buffer is too small.
+ */
+inline int encode_removed(const BML_STATS &prev, uint8_t *buf, size_t buf_size)
+{
+    if (sizeof(sRecordHeader) > buf_size) {
+        return -1;
+    }
+
+    sRecordHeader header;
+    memcpy(header.mac, prev.mac, sizeof(header.mac));
+    header.type   = prev.type;
+    header.flags  = RECORD_FLAG_REMOVED;
+    header.fields = 0;
+    memcpy(buf, &header, sizeof(header));
+
+    return sizeof(header);
+}
+
+/**
+ * @brief Decode a record.
+ *
+ * @param[in] buf Record.
+ * @param[in] buf_size Size of the buffer, from the start of the record.
+ * @param[out] header Header of the record.
+ * @param[in,out] stats Previous statistics of the node, updated with the changed fields.
+ * @return Length of the record, -1 if the record is invalid.
+ */
+inline int decode(const uint8_t *buf, size_t buf_size, sRecordHeader &header, BML_STATS &stats)
+{
+    if (sizeof(header) > buf_size) {
+        return -1;
+    }
+    memcpy(&header, buf, sizeof(header));
+
+    size_t count;
+    auto fields = get_fields(header.type, count);
+    if (!fields || (header.fields >> count)) {
+        return -1;
+    }
+
+    memcpy(stats.mac, header.mac, sizeof(stats.mac));
+    stats.type = header.type;
+
+    auto data = reinterpret_cast<uint8_t *>(&stats);
+    auto pos  = buf + sizeof(header);
+    for (size_t i = 0; i < count; i++) {
+        if (!(header.fields & (1 << i))) {
+            continue;
+        }
+        if (size_t(pos - buf) + fields[i].size > buf_size) {
+            return -1;
+        }
+        memcpy(data + fields[i].offset, pos, fields[i].size);
+        pos += fields[i].size;
+    }
+
+    return pos - buf;
+}
+
+} // namespace bml_stats_delta
+
+#endif // _BML_STATS_DELTA_H_
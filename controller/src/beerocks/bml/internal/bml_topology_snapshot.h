@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BML_TOPOLOGY_SNAPSHOT_H_
+#define _BML_TOPOLOGY_SNAPSHOT_H_
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Layout of the topology snapshot shared memory segment, published by the controller (single
+ * writer) and read by the BML library (any number of readers).
+ *
+ * The segment is an sHeader followed by the network map, in the format of the
+ * ACTION_BML_NW_MAP_RESPONSE buffer: BML_NODE records, with the GW/IRE data omitted from the
+ * client records.
+ *
+ * The content is protected by a sequence lock: the writer makes the sequence odd while it
+ * updates the segment, and even once done. Readers copy the content, and retry if the sequence
+ * was odd or changed during the copy. Readers never block the writer.
+ */
+namespace bml_topology_snapshot {
+
+constexpr char SHM_NAME[]      = "/beerocks_topology";
+constexpr uint32_t MAGIC       = 0x54504c47; // "TPLG"
+constexpr uint16_t VERSION     = 1;          // Bumped on any change of the layout
+constexpr uint32_t MAX_SIZE    = 4 * 1024 * 1024;
+constexpr int MAX_READ_RETRIES = 16;
+
+struct sHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_len;
+    uint32_t size; // Size of the segment
+    std::atomic<uint32_t> sequence;
+    // Protected by the sequence
+    uint32_t generation; // Incremented when the content changes, 0 until first published
+    uint32_t num_of_nodes;
+    uint32_t data_len;
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "the sequence must have the layout of a plain integer");
+
+} // namespace bml_topology_snapshot
+
+#endif // _BML_TOPOLOGY_SNAPSHOT_H_
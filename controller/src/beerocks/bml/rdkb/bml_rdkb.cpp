@@ -10,8 +10,8 @@
 #include "../bml.h"
 #include "internal/bml_rdkb_internal.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 using namespace beerocks::net;
 
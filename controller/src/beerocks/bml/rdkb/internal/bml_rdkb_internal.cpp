@@ -8,10 +8,10 @@
 
 #include "bml_rdkb_internal.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_message_structs.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_bml.h>
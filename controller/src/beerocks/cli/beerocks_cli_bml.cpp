@@ -9,11 +9,11 @@
 #include "beerocks_cli_bml.h"
 #include "bml_utils.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <unordered_map>
 
@@ -411,6 +411,13 @@ void cli_bml::setFunctionsMapAndArray()
     insertCommandToMap("bml_get_master_slave_versions", "",
                        "prints beerocks master & slave versions",
                        static_cast<pFunction>(&cli_bml::get_master_slave_versions_caller), 0, 0);
+    insertCommandToMap("bml_get_metrics", "",
+                       "prints the controller runtime metrics (Prometheus text format)",
+                       static_cast<pFunction>(&cli_bml::get_metrics_caller), 0, 0);
+    insertCommandToMap("bml_cmdu_trace_dump", "<file>",
+                       "writes the CMDU traces of the device to 'file' (Chrome trace JSON)",
+                       static_cast<pFunction>(&cli_bml::cmdu_trace_dump_caller), 1, 1,
+                       STRING_ARG);
     insertCommandToMap(
         "bml_enable_legacy_client_roaming", "[<1 or 0>]",
         "if input was given - enable/disable legacy client roaming, prints current value",
@@ -983,6 +990,22 @@ int cli_bml::get_master_slave_versions_caller(int numOfArgs)
         return get_master_slave_versions();
 }
 
+int cli_bml::get_metrics_caller(int numOfArgs)
+{
+    if (numOfArgs != 0)
+        return -1;
+    else
+        return get_metrics();
+}
+
+int cli_bml::cmdu_trace_dump_caller(int numOfArgs)
+{
+    if (numOfArgs != 1)
+        return -1;
+    else
+        return cmdu_trace_dump(args.stringArgs[0]);
+}
+
 int cli_bml::enable_legacy_client_roaming_caller(int numOfArgs)
 {
     if (numOfArgs < 0)
@@ -1482,6 +1505,35 @@ int cli_bml::get_master_slave_versions()
     return 0;
 }
 
+int cli_bml::get_metrics()
+{
+    std::vector<char> buffer(64 * 1024);
+    auto buffer_size = static_cast<unsigned int>(buffer.size());
+    int ret          = bml_get_metrics(ctx, buffer.data(), &buffer_size);
+    if (ret == -BML_RET_INVALID_ARGS && buffer_size > buffer.size()) {
+        // The metrics grew beyond the buffer, retry with the required size
+        buffer.resize(buffer_size);
+        ret = bml_get_metrics(ctx, buffer.data(), &buffer_size);
+    }
+    if (ret == BML_RET_OK) {
+        std::cout << buffer.data();
+    }
+
+    printBmlReturnVals("bml_get_metrics", ret);
+    return 0;
+}
+
+int cli_bml::cmdu_trace_dump(const std::string &file_path)
+{
+    int ret = bml_cmdu_trace_dump(file_path.c_str());
+    if (ret == BML_RET_OK) {
+        std::cout << "CMDU traces written to " << file_path << std::endl;
+    }
+
+    printBmlReturnVals("bml_cmdu_trace_dump", ret);
+    return 0;
+}
+
 int cli_bml::enable_client_roaming(int8_t isEnable)
 {
     int result;
@@ -117,6 +117,8 @@ private:
 
     int get_bml_version_caller(int numOfArgs);
     int get_master_slave_versions_caller(int numOfArgs);
+    int get_metrics_caller(int numOfArgs);
+    int cmdu_trace_dump_caller(int numOfArgs);
 
     int enable_legacy_client_roaming_caller(int numOfArgs);
     int enable_client_roaming_caller(int numOfArgs);
@@ -164,6 +166,8 @@ private:
     int get_device_info();
     int get_bml_version();
     int get_master_slave_versions();
+    int get_metrics();
+    int cmdu_trace_dump(const std::string &file_path);
 
     int client_allow(const std::string &client_mac, const std::string &hostap_mac);
     int client_disallow(const std::string &client_mac, const std::string &hostap_mac);
@@ -13,11 +13,11 @@
 
 #include <bcl/beerocks_config_file.h>
 #include <bcl/beerocks_defines.h>
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_logging.h>
 #include <bcl/beerocks_os_utils.h>
 #include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_version.h>
-#include <easylogging++.h>
 
 #include <chrono>
 
@@ -6,8 +6,8 @@
  * See LICENSE file for more details.
  */
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 
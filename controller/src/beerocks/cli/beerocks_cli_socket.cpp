@@ -8,9 +8,9 @@
 
 #include "beerocks_cli_socket.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_cli.h>
@@ -7,11 +7,13 @@
  */
 
 #include <bcl/beerocks_config_file.h>
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_logging.h>
+#include <bcl/beerocks_metrics_server.h>
+#include <bcl/beerocks_string_utils.h>
 #include <bcl/beerocks_version.h>
 #include <bcl/network/network_utils.h>
 #include <bpl/bpl_cfg.h>
-#include <easylogging++.h>
 
 #include "db/db.h"
 #include "son_master_thread.h"
@@ -136,6 +138,7 @@ static void fill_master_config(son::db::sDbMasterConfig &master_conf,
     master_conf.load_front_measurements    = (main_master_conf.load_front_measurements == "1");
     master_conf.load_health_check          = (main_master_conf.load_health_check == "1");
     master_conf.load_monitor_on_vaps       = (main_master_conf.load_monitor_on_vaps == "1");
+    master_conf.load_topology_snapshot     = (main_master_conf.load_topology_snapshot == "1");
     master_conf.diagnostics_measurements_polling_rate_sec =
         beerocks::string_utils::stoi(main_master_conf.diagnostics_measurements_polling_rate_sec);
     master_conf.ire_rssi_report_rate_sec =
@@ -195,6 +198,10 @@ static void fill_master_config(son::db::sDbMasterConfig &master_conf,
         beerocks::string_utils::stoi(main_master_conf.roaming_sticky_client_rssi_threshold);
     master_conf.credentials_change_timeout_sec =
         beerocks::string_utils::stoi(main_master_conf.credentials_change_timeout_sec);
+    master_conf.task_worker_threads =
+        main_master_conf.task_worker_threads.empty()
+            ? 0
+            : beerocks::string_utils::stoi(main_master_conf.task_worker_threads);
     // get channel vector
     std::string s         = main_master_conf.global_restricted_channels;
     std::string delimiter = ",";
@@ -280,6 +287,7 @@ int main(int argc, char *argv[])
               << BEEROCKS_BUILD_DATE << std::endl
               << std::endl;
     beerocks::version::log_version(argc, argv);
+    logger.start_cmdu_trace();
     versionfile.open(beerocks_master_conf.temp_path + "beerocks_master_version");
     versionfile << BEEROCKS_VERSION << std::endl << BEEROCKS_REVISION;
     versionfile.close();
@@ -317,6 +325,8 @@ int main(int argc, char *argv[])
         g_running = false;
     }
 
+    auto metrics = beerocks::metrics_server::start_from_config(beerocks_master_conf.metrics_port);
+
     auto touch_time_stamp_timeout = std::chrono::steady_clock::now();
     while (g_running) {
 
@@ -337,6 +347,10 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (metrics) {
+        metrics->stop();
+    }
+
     s_pLogger = nullptr;
 
     son_master.stop();
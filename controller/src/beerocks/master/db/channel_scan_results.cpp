@@ -0,0 +1,36 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "channel_scan_results.h"
+
+using namespace son;
+
+void channel_scan_results::clear()
+{
+    for (auto &channel : m_channels) {
+        channel.second.clear();
+    }
+    m_size = 0;
+}
+
+void channel_scan_results::add(const beerocks_message::sChannelScanResults &result)
+{
+    m_channels[result.channel].push_back(result);
+    m_size++;
+}
+
+const channel_scan_results::results_t &channel_scan_results::get(uint32_t channel) const
+{
+    static const results_t empty_results;
+
+    auto it = m_channels.find(channel);
+    if (it == m_channels.end()) {
+        return empty_results;
+    }
+    return it->second;
+}
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _CHANNEL_SCAN_RESULTS_H_
+#define _CHANNEL_SCAN_RESULTS_H_
+
+#include <beerocks/tlvf/beerocks_message_common.h>
+
+#include <map>
+#include <vector>
+
+namespace son {
+
+/**
+ * Channel scan results of a radio, grouped by channel.
+ *
+ * The results of every channel are stored contiguously, in the order they were received.
+ * Clearing the results keeps the storage, so a periodic scan refills it without allocating
+ * once the number of neighbors stabilized. Readers get references to the stored results
+ * instead of copies.
+ */
+class channel_scan_results {
+public:
+    typedef std::vector<beerocks_message::sChannelScanResults> results_t;
+
+    /**
+     * @brief Remove all the results.
+     */
+    void clear();
+
+    /**
+     * @brief Add a result, to the results of its channel.
+     *
+     * @param result Scan result of a neighbor BSS.
+     */
+    void add(const beerocks_message::sChannelScanResults &result);
+
+    /**
+     * @brief Total number of results, over all the channels.
+     */
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief Get the results of a channel.
+     *
+     * @param channel Channel number.
+     * @return Results of the channel, empty if none was received.
+     */
+    const results_t &get(uint32_t channel) const;
+
+    /**
+     * @brief Get the results of all the channels, by ascending channel number.
+     * Channels may have an empty list of results.
+     */
+    const std::map<uint32_t, results_t> &channels() const { return m_channels; }
+
+private:
+    std::map<uint32_t, results_t> m_channels;
+    size_t m_size = 0;
+};
+
+} // namespace son
+
+#endif
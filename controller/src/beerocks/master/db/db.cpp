@@ -8,9 +8,9 @@
 
 #include "db.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <algorithm>
 
@@ -98,6 +98,9 @@ bool db::add_node(const sMacAddr &mac, const sMacAddr &parent_mac, beerocks::eTy
         n             = std::make_shared<node>(type, network_utils::mac_to_string(mac));
         n->parent_mac = network_utils::mac_to_string(parent_mac);
     }
+    if (type == beerocks::TYPE_CLIENT || type == beerocks::TYPE_IRE_BACKHAUL) {
+        allocate_node_metrics(n);
+    }
     n->radio_identifier = network_utils::mac_to_string(radio_identifier);
     n->hierarchy        = new_hierarchy;
     nodes[new_hierarchy].insert(std::make_pair(network_utils::mac_to_string(mac), n));
@@ -134,6 +137,8 @@ bool db::remove_node(const sMacAddr &mac)
                 last_accessed_node     = nullptr;
             }
 
+            auto n = it->second;
+
             // map may include 2 keys to same node - if so remove other key-node pair from map
             // if removed by mac
             if (network_utils::mac_to_string(mac) == node_mac) {
@@ -142,9 +147,11 @@ bool db::remove_node(const sMacAddr &mac)
                 if (!ruid_key.empty()) {
                     nodes[i].erase(ruid_key);
                 }
+                release_node_metrics(n);
                 // if removed by ruid_key
             } else if (network_utils::mac_to_string(mac) == ruid_key) {
                 nodes[i].erase(node_mac);
+                release_node_metrics(n);
             }
 
             return true;
@@ -1745,6 +1752,35 @@ std::string db::get_hostap_driver_version(std::string mac)
     return n->hostap->driver_version;
 }
 
+bool db::set_hostap_slave_features(std::string mac, uint32_t features)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist!";
+        return false;
+    } else if (n->get_type() != beerocks::TYPE_SLAVE || n->hostap == nullptr) {
+        LOG(WARNING) << __FUNCTION__ << "node " << mac << " is not a valid hostap!";
+        return false;
+    }
+
+    n->hostap->slave_features = features;
+    return true;
+}
+
+bool db::is_hostap_slave_feature_supported(std::string mac, beerocks::eSlaveFeature feature)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist!";
+        return false;
+    } else if (n->get_type() != beerocks::TYPE_SLAVE || n->hostap == nullptr) {
+        LOG(WARNING) << __FUNCTION__ << "node " << mac << " is not a valid hostap!";
+        return false;
+    }
+
+    return (n->hostap->slave_features & feature) != 0;
+}
+
 beerocks::eIfaceType db::get_node_backhaul_iface_type(std::string mac)
 {
     auto n = get_node(mac);
@@ -2343,16 +2379,14 @@ bool db::add_channel_scan_results(const sMacAddr &mac, const sChannelScanResults
         return false;
     }
 
-    (single_scan ? hostap->single_scan_results : hostap->continuous_scan_results)
-        .push_back(scan_result);
+    (single_scan ? hostap->single_scan_results : hostap->continuous_scan_results).add(scan_result);
 
     return true;
 }
 
-const std::list<sChannelScanResults> &db::get_channel_scan_results(const sMacAddr &mac,
-                                                                   bool single_scan)
+const channel_scan_results &db::get_channel_scan_results(const sMacAddr &mac, bool single_scan)
 {
-    static std::list<sChannelScanResults> dummy_return;
+    static channel_scan_results dummy_return;
 
     auto hostap = get_hostap_by_mac(mac);
     if (!hostap) {
@@ -2568,11 +2602,10 @@ bool db::set_node_cross_rx_rssi(std::string sta_mac, std::string ap_mac, int8_t
                                 int8_t rx_packets)
 {
     auto sta = get_node(sta_mac);
-    if (sta == nullptr) {
+    if (sta == nullptr || !allocate_node_metrics(sta)) {
         return false;
     }
-    sta->set_cross_rx_rssi(ap_mac, rssi, rx_packets);
-    return true;
+    return m_station_metrics.set_cross_rx_rssi(sta->metrics_index, ap_mac, rssi, rx_packets);
 }
 
 bool db::get_node_cross_rx_rssi(std::string sta_mac, std::string ap_mac, int8_t &rssi,
@@ -2584,7 +2617,7 @@ bool db::get_node_cross_rx_rssi(std::string sta_mac, std::string ap_mac, int8_t
         rx_packets = 0;
         return false;
     }
-    return sta->get_cross_rx_rssi(ap_mac, rssi, rx_packets);
+    return m_station_metrics.get_cross_rx_rssi(sta->metrics_index, ap_mac, rssi, rx_packets);
 }
 
 bool db::set_node_cross_rx_phy_rate_100kb(std::string mac, uint16_t rx_phy_rate_100kb)
@@ -2631,7 +2664,8 @@ bool db::clear_node_cross_rssi(std::string sta_mac)
     if (sta == nullptr) {
         return false;
     }
-    sta->clear_cross_rssi();
+    m_station_metrics.clear_cross_rx_rssi(sta->metrics_index);
+    sta->clear_beacon_measurements();
     return true;
 }
 
@@ -2691,25 +2725,13 @@ void db::clear_hostap_stats_info(std::string mac) { set_hostap_stats_info(mac, n
 bool db::set_node_stats_info(std::string mac, beerocks_message::sStaStatsParams *params)
 {
     auto n = get_node(mac);
-    if (!n) {
+    if (!n || !allocate_node_metrics(n)) {
         return false;
     }
     if (params == nullptr) { // clear stats
-        n->clear_node_stats_info();
+        m_station_metrics.clear_stats(n->metrics_index);
     } else {
-        auto p               = n->stats_info;
-        p->rx_packets        = params->rx_packets;
-        p->tx_packets        = params->tx_packets;
-        p->tx_bytes          = params->tx_bytes;
-        p->rx_bytes          = params->rx_bytes;
-        p->retrans_count     = params->retrans_count;
-        p->tx_phy_rate_100kb = params->tx_phy_rate_100kb;
-        p->rx_phy_rate_100kb = params->rx_phy_rate_100kb;
-        p->tx_load_percent   = params->tx_load_percent;
-        p->rx_load_percent   = params->rx_load_percent;
-        p->stats_delta_ms    = params->stats_delta_ms;
-        p->rx_rssi           = params->rx_rssi;
-        p->timestamp         = std::chrono::steady_clock::now();
+        m_station_metrics.set_stats(n->metrics_index, *params);
     }
     return true;
 }
@@ -2732,10 +2754,10 @@ int db::get_hostap_stats_measurement_duration(std::string mac)
 std::chrono::steady_clock::time_point db::get_node_stats_info_timestamp(std::string mac)
 {
     auto n = get_node(mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return std::chrono::steady_clock::time_point();
     }
-    return n->stats_info->timestamp;
+    return m_station_metrics.columns().timestamp[n->metrics_index];
 }
 
 std::chrono::steady_clock::time_point db::get_hostap_stats_info_timestamp(std::string mac)
@@ -2754,19 +2776,19 @@ std::chrono::steady_clock::time_point db::get_hostap_stats_info_timestamp(std::s
 uint32_t db::get_node_rx_bytes(std::string mac)
 {
     auto n = get_node(mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->rx_bytes;
+    return m_station_metrics.columns().rx_bytes[n->metrics_index];
 }
 
 uint32_t db::get_node_tx_bytes(std::string mac)
 {
     auto n = get_node(mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->tx_bytes;
+    return m_station_metrics.columns().tx_bytes[n->metrics_index];
 }
 
 uint32_t db::get_hostap_total_sta_rx_bytes(std::string mac)
@@ -2801,8 +2823,10 @@ double db::get_node_rx_bitrate(std::string mac)
     if (!n) {
         LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist!";
         return -1;
+    } else if (!m_station_metrics.is_valid(n->metrics_index)) {
+        return -1;
     }
-    return (1000 * 8 * double(n->stats_info->rx_bytes) / n->stats_info->stats_delta_ms) / 1e+6;
+    return m_station_metrics.get_rx_bitrate(n->metrics_index);
 }
 
 double db::get_node_tx_bitrate(std::string mac)
@@ -2811,26 +2835,28 @@ double db::get_node_tx_bitrate(std::string mac)
     if (!n) {
         LOG(WARNING) << __FUNCTION__ << " - node " << mac << " does not exist!";
         return -1;
+    } else if (!m_station_metrics.is_valid(n->metrics_index)) {
+        return -1;
     }
-    return (1000 * 8 * double(n->stats_info->tx_bytes) / n->stats_info->stats_delta_ms) / 1e+6;
+    return m_station_metrics.get_tx_bitrate(n->metrics_index);
 }
 
 uint16_t db::get_node_rx_phy_rate_100kb(std::string mac)
 {
     auto n = get_node(mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->rx_phy_rate_100kb;
+    return m_station_metrics.columns().rx_phy_rate_100kb[n->metrics_index];
 }
 
 uint16_t db::get_node_tx_phy_rate_100kb(std::string mac)
 {
     auto n = get_node(mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->tx_phy_rate_100kb;
+    return m_station_metrics.columns().tx_phy_rate_100kb[n->metrics_index];
 }
 
 int db::get_hostap_channel_load_percent(std::string mac)
@@ -2875,46 +2901,55 @@ int db::get_hostap_total_client_rx_load_percent(std::string mac)
 int db::get_node_rx_load_percent(std::string mac)
 {
     auto n = get_node(mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->rx_load_percent;
+    return m_station_metrics.columns().rx_load_percent[n->metrics_index];
 }
 
 int db::get_node_tx_load_percent(std::string mac)
 {
     auto n = get_node(mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->tx_load_percent;
+    return m_station_metrics.columns().tx_load_percent[n->metrics_index];
+}
+
+int db::get_node_metrics_index(std::string mac)
+{
+    auto n = get_node(mac);
+    if (!n) {
+        return station_metrics::INVALID_INDEX;
+    }
+    return n->metrics_index;
 }
 
 int8_t db::get_load_rx_rssi(std::string sta_mac)
 {
     auto n = get_node(sta_mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->rx_rssi;
+    return m_station_metrics.columns().rx_rssi[n->metrics_index];
 }
 
 uint16_t db::get_load_rx_phy_rate_100kb(std::string sta_mac)
 {
     auto n = get_node(sta_mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->rx_phy_rate_100kb;
+    return m_station_metrics.columns().rx_phy_rate_100kb[n->metrics_index];
 }
 
 uint16_t db::get_load_tx_phy_rate_100kb(std::string sta_mac)
 {
     auto n = get_node(sta_mac);
-    if (!n) {
+    if (!n || !m_station_metrics.is_valid(n->metrics_index)) {
         return -1;
     }
-    return n->stats_info->tx_phy_rate_100kb;
+    return m_station_metrics.columns().tx_phy_rate_100kb[n->metrics_index];
 }
 
 bool db::set_measurement_delay(std::string mac, int measurement_delay)
@@ -3319,6 +3354,14 @@ bool db::assign_rdkb_wlan_task_id(int new_task_id)
 
 int db::get_rdkb_wlan_task_id() { return rdkb_wlan_task_id; }
 
+bool db::assign_rssi_measurement_batch_task_id(int new_task_id)
+{
+    rssi_measurement_batch_task_id = new_task_id;
+    return true;
+}
+
+int db::get_rssi_measurement_batch_task_id() { return rssi_measurement_batch_task_id; }
+
 bool db::assign_dynamic_channel_selection_task_id(const sMacAddr &mac, int new_task_id)
 {
     auto n = get_node(mac);
@@ -3589,6 +3632,26 @@ int db::get_node_bw_int(std::shared_ptr<node> &n)
     return bw;
 }
 
+bool db::allocate_node_metrics(std::shared_ptr<node> &n)
+{
+    if (m_station_metrics.is_valid(n->metrics_index)) {
+        return true;
+    }
+    n->metrics_index = m_station_metrics.allocate();
+    n->metrics       = &m_station_metrics;
+    return true;
+}
+
+void db::release_node_metrics(std::shared_ptr<node> &n)
+{
+    if (!m_station_metrics.is_valid(n->metrics_index)) {
+        return;
+    }
+    m_station_metrics.release(n->metrics_index);
+    n->metrics_index = station_metrics::INVALID_INDEX;
+    n->metrics       = nullptr;
+}
+
 void db::set_vap_list(std::shared_ptr<db::vaps_list_t> vaps_list) { m_vap_list = vaps_list; }
 
 void db::clear_vap_list()
@@ -73,6 +73,7 @@ public:
         bool load_front_measurements;
         bool load_health_check;
         bool load_monitor_on_vaps;
+        bool load_topology_snapshot;
         bool certification_mode;
         int roaming_5ghz_failed_attemps_threshold;
         int roaming_24ghz_failed_attemps_threshold;
@@ -106,6 +107,7 @@ public:
         int blacklist_channel_remove_timeout;
         int failed_roaming_counter_threshold;
         int roaming_sticky_client_rssi_threshold;
+        int task_worker_threads;
 
     } sDbMasterConfig;
 
@@ -329,6 +331,9 @@ public:
     bool set_hostap_driver_version(std::string mac, std::string version);
     std::string get_hostap_driver_version(std::string mac);
 
+    bool set_hostap_slave_features(std::string mac, uint32_t features);
+    bool is_hostap_slave_feature_supported(std::string mac, beerocks::eSlaveFeature feature);
+
     bool set_hostap_iface_id(std::string mac, int8_t iface_id);
     int8_t get_hostap_iface_id(std::string mac);
 
@@ -558,10 +563,9 @@ public:
      * 
      * @param mac:         MAC address of radio
      * @param single_scan: Indicated if to use single scan or continuous
-     * @return const std::list<sChannelScanResults>& 
+     * @return Stored results, grouped by channel. Only valid until the results are modified.
      */
-    const std::list<sChannelScanResults> &get_channel_scan_results(const sMacAddr &mac,
-                                                                   bool single_scan);
+    const channel_scan_results &get_channel_scan_results(const sMacAddr &mac, bool single_scan);
 
     //
     // CLI
@@ -651,6 +655,18 @@ public:
     uint16_t get_load_rx_phy_rate_100kb(std::string sta_mac);
     uint16_t get_load_tx_phy_rate_100kb(std::string sta_mac);
 
+    /**
+     * @brief Get the slot of a station in the station metrics store.
+     *
+     * Used to scan the metrics of many stations through get_station_metrics() instead of
+     * looking up every station for every metric.
+     *
+     * @param mac Station mac address.
+     * @return Slot index, or station_metrics::INVALID_INDEX if the station has no metrics.
+     */
+    int get_node_metrics_index(std::string mac);
+    const station_metrics &get_station_metrics() const { return m_station_metrics; }
+
     bool set_measurement_delay(std::string mac, int measurement_delay);
     int get_measurement_delay(std::string mac);
 
@@ -708,6 +724,9 @@ public:
     bool assign_rdkb_wlan_task_id(int new_task_id);
     int get_rdkb_wlan_task_id();
 
+    bool assign_rssi_measurement_batch_task_id(int new_task_id);
+    int get_rssi_measurement_batch_task_id();
+
     bool assign_ire_4addr_mode_transition_task_id(std::string mac, int new_task_id);
     int get_ire_4addr_mode_transition_task_id(std::string mac);
 
@@ -839,16 +858,19 @@ private:
                                                       int state              = beerocks::STATE_ANY,
                                                       std::string parent_mac = std::string());
     int get_node_bw_int(std::shared_ptr<node> &n);
+    bool allocate_node_metrics(std::shared_ptr<node> &n);
+    void release_node_metrics(std::shared_ptr<node> &n);
 
     void rewind();
     bool get_next_node(std::shared_ptr<node> &n, int &hierarchy);
     bool get_next_node(std::shared_ptr<node> &n);
 
-    int network_optimization_task_id = -1;
-    int channel_selection_task_id    = -1;
-    int bml_task_id                  = -1;
-    int rdkb_wlan_task_id            = -1;
-    int config_update_task_id        = -1;
+    int network_optimization_task_id   = -1;
+    int channel_selection_task_id      = -1;
+    int bml_task_id                    = -1;
+    int rdkb_wlan_task_id              = -1;
+    int config_update_task_id          = -1;
+    int rssi_measurement_batch_task_id = -1;
 
     std::shared_ptr<node> last_accessed_node;
     std::string last_accessed_node_mac;
@@ -904,6 +926,8 @@ private:
 
     master_thread *m_master_thread_ctx = nullptr;
     const std::string m_local_bridge_mac;
+
+    station_metrics m_station_metrics;
 };
 
 } // namespace son
@@ -8,16 +8,18 @@
 
 #include "network_map.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_bml.h>
 #include <tlvf/ieee_1905_1/tlvEndOfMessage.h>
 
 #include <bml_defs.h>
+#include <internal/bml_stats_delta.h>
 
+#include <algorithm>
 #include <unordered_set>
 
 using namespace beerocks;
@@ -145,6 +147,54 @@ void network_map::send_bml_network_map_message(db &database, Socket *sd,
     //LOG(DEBUG) << "sending message, last=1";
 }
 
+uint32_t network_map::fill_bml_network_map(db &database, std::vector<uint8_t> &buffer)
+{
+    const std::ptrdiff_t gwIreNodeSize  = sizeof(BML_NODE);
+    const std::ptrdiff_t clientNodeSize = sizeof(BML_NODE) - sizeof(BML_NODE::N_DATA::N_GW_IRE);
+
+    uint32_t num_of_nodes = 0;
+    std::ptrdiff_t size   = 0;
+    buffer.clear();
+
+    // because of virtual nodes (vap nodes) are poiting to the radio node,
+    // we want to save the in a list in order to not count them multiple times as the same mac.
+    std::unordered_set<std::string> ap_list;
+
+    database.rewind();
+    bool last = false;
+    while (!last) {
+        std::shared_ptr<node> n;
+        last = database.get_next_node(n);
+        if (n == nullptr) {
+            continue;
+        }
+
+        // skip virtual vap nodes
+        auto n_type = n->get_type();
+        if (n_type == beerocks::TYPE_SLAVE) {
+            if (!ap_list.insert(n->mac).second) {
+                continue;
+            }
+        }
+
+        if (n->state != beerocks::STATE_CONNECTED ||
+            (n_type != beerocks::TYPE_CLIENT && n_type != beerocks::TYPE_IRE &&
+             n_type != beerocks::TYPE_GW)) {
+            continue;
+        }
+
+        std::ptrdiff_t node_len =
+            (n_type == beerocks::TYPE_CLIENT) ? clientNodeSize : gwIreNodeSize;
+        buffer.resize(size + node_len);
+        fill_bml_node_data(database, n, buffer.data() + size, node_len);
+
+        num_of_nodes++;
+        size += node_len;
+    }
+
+    return num_of_nodes;
+}
+
 std::ptrdiff_t network_map::fill_bml_node_data(db &database, std::string node_mac,
                                                uint8_t *tx_buffer, std::ptrdiff_t &buffer_size,
                                                bool force_client_disconnect)
@@ -461,6 +511,127 @@ void network_map::send_bml_nodes_statistics_message_to_listeners(
     //LOG(DEBUG) << "sending message, last=1";
 }
 
+void network_map::send_bml_nodes_statistics_delta_message(
+    db &database, ieee1905_1::CmduMessageTx &cmdu_tx, Socket *sd,
+    bml_stats_subscription &subscription, const std::set<std::string> &valid_hostaps)
+{
+    const size_t max_buffer_size =
+        cmdu_tx.getMessageBuffLength() -
+        message_com::get_vs_cmdu_size_on_buffer<beerocks_message::cACTION_BML_STATS_DELTA_UPDATE>();
+
+    // The first message of the subscription resets the samples of the listener
+    subscription.generation++;
+    bool full = (subscription.generation == 1);
+
+    std::shared_ptr<beerocks_message::cACTION_BML_STATS_DELTA_UPDATE> update;
+    auto create_update = [&]() -> bool {
+        update = message_com::create_vs_message<beerocks_message::cACTION_BML_STATS_DELTA_UPDATE>(
+            cmdu_tx);
+        if (!update) {
+            LOG(ERROR) << "Failed building ACTION_BML_STATS_DELTA_UPDATE message!";
+            return false;
+        }
+        update->full() = full;
+        full           = false;
+
+        auto beerocks_header                 = message_com::get_beerocks_header(cmdu_tx);
+        beerocks_header->actionhdr()->last() = 0;
+        return true;
+    };
+
+    // Append a record to the update, sending the update first if the record does not fit
+    uint8_t record[sizeof(bml_stats_delta::sRecordHeader) + sizeof(BML_STATS)];
+    auto add_record = [&](size_t len) -> bool {
+        size_t offset = update->buffer_size();
+        if (offset + len > max_buffer_size) {
+            message_com::send_cmdu(sd, cmdu_tx);
+            if (!create_update()) {
+                return false;
+            }
+            offset = 0;
+        }
+        if (!update->alloc_buffer(len)) {
+            LOG(ERROR) << "Failed to alloc buffer";
+            return false;
+        }
+        std::copy_n(record, len, update->buffer(0) + offset);
+        update->num_of_records()++;
+        return true;
+    };
+
+    auto add_node = [&](std::shared_ptr<node> n) -> bool {
+        auto mac = network_utils::mac_from_string(n->mac);
+        if (!subscription.macs.empty() && !subscription.macs.count(mac)) {
+            return true;
+        }
+
+        // Nodes which have not been measured yet are left untouched (type 0)
+        BML_STATS stats = {};
+        if (!fill_bml_node_statistics(database, n, reinterpret_cast<uint8_t *>(&stats),
+                                      sizeof(stats)) ||
+            !stats.type) {
+            return true;
+        }
+        if (subscription.node_types && !(subscription.node_types & (1 << stats.type))) {
+            return true;
+        }
+
+        auto &sample      = subscription.samples[mac];
+        bool new_node     = (sample.generation == 0);
+        sample.generation = subscription.generation;
+
+        int len = bml_stats_delta::encode(stats, new_node ? nullptr : &sample.stats,
+                                          subscription.metrics, record, sizeof(record));
+        if (len <= 0) {
+            // Unchanged
+            return true;
+        }
+        sample.stats = stats;
+        return add_record(len);
+    };
+
+    if (!create_update()) {
+        return;
+    }
+
+    for (auto &hostap_mac : valid_hostaps) {
+        auto n = database.get_node(hostap_mac);
+        if (!n || n->state != beerocks::STATE_CONNECTED || n->get_type() != beerocks::TYPE_SLAVE) {
+            continue;
+        }
+        if (!add_node(n)) {
+            return;
+        }
+
+        for (auto &sta_mac : database.get_node_children(hostap_mac)) {
+            auto sta = database.get_node(sta_mac);
+            if (!sta || sta->state != beerocks::STATE_CONNECTED) {
+                continue;
+            }
+            if (!add_node(sta)) {
+                return;
+            }
+        }
+    }
+
+    // Nodes which were not part of this update
+    for (auto it = subscription.samples.begin(); it != subscription.samples.end();) {
+        if (it->second.generation == subscription.generation) {
+            ++it;
+            continue;
+        }
+        int len = bml_stats_delta::encode_removed(it->second.stats, record, sizeof(record));
+        if (len < 0 || !add_record(len)) {
+            return;
+        }
+        it = subscription.samples.erase(it);
+    }
+
+    auto beerocks_header                 = message_com::get_beerocks_header(cmdu_tx);
+    beerocks_header->actionhdr()->last() = 1;
+    message_com::send_cmdu(sd, cmdu_tx);
+}
+
 void network_map::send_bml_event_to_listeners(ieee1905_1::CmduMessageTx &cmdu_tx,
                                               std::vector<Socket *> &bml_listeners)
 {
@@ -785,11 +956,15 @@ std::ptrdiff_t network_map::fill_bml_node_statistics(db &database, std::shared_p
     case beerocks::TYPE_CLIENT: {
         //LOG(DEBUG) << "fill TYPE_CLIENT";
 
+        auto &metrics = database.get_station_metrics();
+        auto idx      = n->metrics_index;
+
         // filter client which have not been measured yet
-        if (n->stats_info->rx_rssi == beerocks::RSSI_INVALID) {
+        if (!metrics.is_valid(idx) || metrics.columns().rx_rssi[idx] == beerocks::RSSI_INVALID) {
             //LOG(DEBUG) << "sta_mac=" << n->mac << ", signal_strength=INVALID!";
             return buf_size;
         }
+        auto &stats = metrics.columns();
 
         //prepearing buffer and calc size
         auto sta_stats_bulk = (BML_STATS *)tx_buffer;
@@ -799,23 +974,22 @@ std::ptrdiff_t network_map::fill_bml_node_statistics(db &database, std::shared_p
         network_utils::mac_from_string(sta_stats_bulk->mac, n->mac);
         sta_stats_bulk->type = BML_STAT_TYPE_CLIENT;
 
-        sta_stats_bulk->bytes_sent              = n->stats_info->tx_bytes;
-        sta_stats_bulk->bytes_received          = n->stats_info->rx_bytes;
-        sta_stats_bulk->packets_sent            = n->stats_info->tx_packets;
-        sta_stats_bulk->packets_received        = n->stats_info->rx_packets;
-        sta_stats_bulk->measurement_window_msec = n->stats_info->stats_delta_ms;
-        sta_stats_bulk->retrans_count           = n->stats_info->retrans_count;
+        sta_stats_bulk->bytes_sent              = stats.tx_bytes[idx];
+        sta_stats_bulk->bytes_received          = stats.rx_bytes[idx];
+        sta_stats_bulk->packets_sent            = stats.tx_packets[idx];
+        sta_stats_bulk->packets_received        = stats.rx_packets[idx];
+        sta_stats_bulk->measurement_window_msec = stats.stats_delta_ms[idx];
+        sta_stats_bulk->retrans_count           = stats.retrans_count[idx];
 
         // These COMMON params are not available for station from bwl
         sta_stats_bulk->errors_sent     = 0;
         sta_stats_bulk->errors_received = 0;
 
-        // LOG(DEBUG) << "sta_mac=" << n->mac << ", signal_strength=" << int(n->stats_info->rx_rssi);
-        sta_stats_bulk->uType.client.signal_strength = n->stats_info->rx_rssi;
+        // LOG(DEBUG) << "sta_mac=" << n->mac << ", signal_strength=" << int(stats.rx_rssi[idx]);
+        sta_stats_bulk->uType.client.signal_strength = stats.rx_rssi[idx];
         sta_stats_bulk->uType.client.last_data_downlink_rate =
-            n->stats_info->tx_phy_rate_100kb * 100000;
-        sta_stats_bulk->uType.client.last_data_uplink_rate =
-            n->stats_info->rx_phy_rate_100kb * 100000;
+            stats.tx_phy_rate_100kb[idx] * 100000;
+        sta_stats_bulk->uType.client.last_data_uplink_rate = stats.rx_phy_rate_100kb[idx] * 100000;
 
         //These CLIENT SPECIFIC params are missing in DB:
         sta_stats_bulk->uType.client.retransmissions = 0;
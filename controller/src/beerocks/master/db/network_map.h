@@ -11,12 +11,44 @@
 
 #include "db.h"
 
+#include <bml_defs.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
 namespace son {
 class network_map {
 public:
+    /**
+     * @brief Filtered statistics subscription of a BML listener, with the statistics last sent
+     * to the listener, which the next update is delta encoded against.
+     */
+    struct bml_stats_subscription {
+        struct sample_t {
+            BML_STATS stats;
+            uint32_t generation; // Last update the node was part of
+        };
+
+        uint8_t node_types = 0; // Bitmask of (1 << BML_STAT_TYPE_XXX), 0 for all the types
+        uint8_t metrics    = BML_STATS_METRICS_ALL;
+        std::unordered_set<sMacAddr> macs; // Empty for all the nodes
+
+        uint32_t generation = 0; // Number of updates sent
+        std::unordered_map<sMacAddr, sample_t> samples;
+    };
+
     static void send_bml_network_map_message(db &database, Socket *sd,
                                              ieee1905_1::CmduMessageTx &cmdu_tx, uint16_t id);
 
+    /**
+     * @brief Fill the network map, in the format of the ACTION_BML_NW_MAP_RESPONSE buffer.
+     *
+     * @param database Controller database.
+     * @param buffer Output buffer, resized to the length of the network map.
+     * @return Number of nodes.
+     */
+    static uint32_t fill_bml_network_map(db &database, std::vector<uint8_t> &buffer);
+
     static std::ptrdiff_t fill_bml_node_data(db &database, std::shared_ptr<node> n,
                                              uint8_t *tx_buffer, std::ptrdiff_t &buffer_size,
                                              bool force_client_disconnect = false);
@@ -32,6 +64,23 @@ public:
                                                    uint8_t *tx_buffer, std::ptrdiff_t buf_size);
     static std::ptrdiff_t get_bml_node_statistics_len(std::shared_ptr<node> n);
 
+    /**
+     * @brief Send the statistics of the nodes matching the subscription of a listener, delta
+     * encoded against the previous update sent to it.
+     *
+     * Only the nodes with changed metrics are sent, with the changed metrics only. Nodes which
+     * are no longer reported are sent as removed.
+     *
+     * @param database Controller database.
+     * @param cmdu_tx Message builder.
+     * @param sd Socket of the listener.
+     * @param subscription Subscription of the listener, updated with the sent statistics.
+     * @param valid_hostaps Radios with up to date statistics.
+     */
+    static void send_bml_nodes_statistics_delta_message(
+        db &database, ieee1905_1::CmduMessageTx &cmdu_tx, Socket *sd,
+        bml_stats_subscription &subscription, const std::set<std::string> &valid_hostaps);
+
     static void send_bml_event_to_listeners(ieee1905_1::CmduMessageTx &cmdu_tx,
                                             std::vector<Socket *> &bml_listeners);
 
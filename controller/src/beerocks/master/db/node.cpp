@@ -8,8 +8,8 @@
 
 #include "node.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
-#include <easylogging++.h>
 
 using namespace beerocks;
 using namespace son;
@@ -18,9 +18,7 @@ node::node(beerocks::eType type_, const std::string mac_)
     : mac(mac_), capabilities(m_sta_24ghz_capabilities) // deafult value
 {
     type = type_;
-    if ((type == beerocks::TYPE_CLIENT) || (type == beerocks::TYPE_IRE_BACKHAUL)) {
-        stats_info = std::make_shared<sta_stats_params>();
-    } else if (type == beerocks::TYPE_SLAVE) {
+    if (type == beerocks::TYPE_SLAVE) {
         hostap             = std::make_shared<radio>();
         hostap->stats_info = std::make_shared<radio::ap_stats_params>();
     }
@@ -63,45 +61,50 @@ std::ostream &operator<<(std::ostream &os, const node &n)
            << " State: " << int(n.state) << std::endl
            << " Supports5ghz: " << bool(n.supports_5ghz) << std::endl
            << " Supports24ghz: " << bool(n.supports_24ghz) << std::endl
-           << " Statistics:" << std::endl
-           << "   LastUpdate: "
-           << float((std::chrono::duration_cast<std::chrono::duration<double>>(
-                         tCurrTime - n.stats_info->timestamp))
-                        .count())
-           << "[sec]" << std::endl
-           << "   StatsDelta: " << float(n.stats_info->stats_delta_ms) / 1000.0 << "[sec]"
-           << std::endl
-           << "   RSSI (RX): " << int(n.stats_info->rx_rssi) << " [dBm] " << std::endl
-           << "   Packets (RX|TX): " << int(n.stats_info->rx_packets) << " | "
-           << int(n.stats_info->tx_packets) << std::endl
-           << "   Bytes (RX|TX): " << int(n.stats_info->rx_bytes) << " | "
-           << int(n.stats_info->tx_bytes) << std::endl
-           << "   PhyRate (RX|TX): " << int(n.stats_info->rx_phy_rate_100kb / 10.0) << " | "
-           << int(n.stats_info->tx_phy_rate_100kb / 10.0) << " [Mbps]" << std::endl
-           << "   Load (RX|TX): " << int(n.stats_info->rx_load_percent) << " | "
-           << int(n.stats_info->tx_load_percent) << " [%]" << std::endl
-           << "   RX Load: [";
-
-        for (int i = 0; i < 10; ++i) {
-            if (i < n.stats_info->rx_load_percent / 10) {
-                os << "#";
-            } else {
-                os << " ";
+           << " Statistics:" << std::endl;
+
+        if (n.metrics && n.metrics->is_valid(n.metrics_index)) {
+            auto &stats = n.metrics->columns();
+            auto idx    = n.metrics_index;
+            os << "   LastUpdate: "
+               << float((std::chrono::duration_cast<std::chrono::duration<double>>(
+                             tCurrTime - stats.timestamp[idx]))
+                            .count())
+               << "[sec]" << std::endl
+               << "   StatsDelta: " << float(stats.stats_delta_ms[idx]) / 1000.0 << "[sec]"
+               << std::endl
+               << "   RSSI (RX): " << int(stats.rx_rssi[idx]) << " [dBm] " << std::endl
+               << "   Packets (RX|TX): " << int(stats.rx_packets[idx]) << " | "
+               << int(stats.tx_packets[idx]) << std::endl
+               << "   Bytes (RX|TX): " << int(stats.rx_bytes[idx]) << " | "
+               << int(stats.tx_bytes[idx]) << std::endl
+               << "   PhyRate (RX|TX): " << int(stats.rx_phy_rate_100kb[idx] / 10.0) << " | "
+               << int(stats.tx_phy_rate_100kb[idx] / 10.0) << " [Mbps]" << std::endl
+               << "   Load (RX|TX): " << int(stats.rx_load_percent[idx]) << " | "
+               << int(stats.tx_load_percent[idx]) << " [%]" << std::endl
+               << "   RX Load: [";
+
+            for (int i = 0; i < 10; ++i) {
+                if (i < stats.rx_load_percent[idx] / 10) {
+                    os << "#";
+                } else {
+                    os << " ";
+                }
             }
-        }
 
-        os << "] | TX Load: [";
+            os << "] | TX Load: [";
 
-        for (int i = 0; i < 10; ++i) {
-            if (i < n.stats_info->tx_load_percent / 10) {
-                os << "#";
-            } else {
-                os << " ";
+            for (int i = 0; i < 10; ++i) {
+                if (i < stats.tx_load_percent[idx] / 10) {
+                    os << "#";
+                } else {
+                    os << " ";
+                }
             }
+            os << "]" << std::endl;
         }
 
-        os << "]" << std::endl
-           << "   LastSeen: "
+        os << "   LastSeen: "
            << float((std::chrono::duration_cast<std::chrono::duration<double>>(tCurrTime -
                                                                                n.last_seen))
                         .count())
@@ -240,40 +243,7 @@ void node::set_beacon_measurement(std::string ap_mac_, int8_t rcpi, uint8_t rsni
     }
 }
 
-bool node::get_cross_rx_rssi(std::string ap_mac_, int8_t &rssi, int8_t &packets)
-{
-    auto it = cross_rx_rssi.find(ap_mac_);
-    if (it == cross_rx_rssi.end()) {
-        rssi    = beerocks::RSSI_INVALID;
-        packets = -1;
-        return false;
-    }
-    rssi    = it->second->rssi;
-    packets = it->second->packets;
-    return true;
-}
-
-void node::set_cross_rx_rssi(std::string ap_mac_, int8_t rssi, int8_t packets)
-{
-    auto it = cross_rx_rssi.find(ap_mac_);
-    if (it == cross_rx_rssi.end()) {
-        std::shared_ptr<rssi_measurement> m =
-            std::make_shared<rssi_measurement>(ap_mac_, rssi, packets);
-        cross_rx_rssi.insert(std::make_pair(ap_mac_, m));
-    } else {
-        it->second->rssi      = rssi;
-        it->second->timestamp = std::chrono::steady_clock::now();
-        it->second->packets   = packets;
-    }
-}
-
-void node::clear_cross_rssi()
-{
-    cross_rx_rssi.clear();
-    beacon_measurements.clear();
-}
-
-void node::clear_node_stats_info() { stats_info = std::make_shared<sta_stats_params>(); }
+void node::clear_beacon_measurements() { beacon_measurements.clear(); }
 
 void node::clear_hostap_stats_info()
 {
@@ -10,6 +10,8 @@
 #define _NODE_H_
 
 #include "../tasks/task.h"
+#include "channel_scan_results.h"
+#include "station_metrics.h"
 #include <tlvf/common/sMacAddr.h>
 #include <tlvf/ieee_1905_1/tlvReceiverLinkMetric.h>
 #include <tlvf/ieee_1905_1/tlvTransmitterLinkMetric.h>
@@ -39,11 +41,8 @@ public:
     node(beerocks::eType type_, const std::string mac_);
     bool get_beacon_measurement(std::string ap_mac_, int8_t &rcpi, uint8_t &rsni);
     void set_beacon_measurement(std::string ap_mac_, int8_t rcpi, uint8_t rsni);
-    bool get_cross_rx_rssi(std::string ap_mac_, int8_t &rssi, int8_t &rx_packets);
-    void set_cross_rx_rssi(std::string ap_mac_, int8_t rssi, int8_t rx_packets);
 
-    void clear_cross_rssi();
-    void clear_node_stats_info();
+    void clear_beacon_measurements();
     void clear_hostap_stats_info();
 
     beerocks::eType get_type();
@@ -108,22 +107,9 @@ public:
     int measurement_delay       = 0;
     int measurement_window_size = 60;
 
-    class sta_stats_params {
-    public:
-        uint32_t rx_packets                             = 0;
-        uint32_t tx_packets                             = 0;
-        uint32_t rx_bytes                               = 0;
-        uint32_t tx_bytes                               = 0;
-        uint32_t retrans_count                          = 0;
-        uint8_t tx_load_percent                         = 0;
-        uint8_t rx_load_percent                         = 0;
-        uint16_t rx_phy_rate_100kb                      = 0;
-        uint16_t tx_phy_rate_100kb                      = 0;
-        int8_t rx_rssi                                  = beerocks::RSSI_INVALID;
-        uint16_t stats_delta_ms                         = 0;
-        std::chrono::steady_clock::time_point timestamp = std::chrono::steady_clock::now();
-    };
-    std::shared_ptr<sta_stats_params> stats_info;
+    // Slot of the station in the database station metrics store, set by the database
+    int metrics_index              = station_metrics::INVALID_INDEX;
+    const station_metrics *metrics = nullptr;
 
     uint16_t max_supported_phy_rate_100kb = 0;
 
@@ -146,6 +132,7 @@ public:
         std::string iface_name;
         beerocks::eIfaceType iface_type;
         std::string driver_version;
+        uint32_t slave_features = 0; // beerocks::eSlaveFeature bitmask
         std::vector<beerocks::message::sWifiChannel> supported_channels;
         uint8_t operating_class    = 0;
         int ant_gain               = 0;
@@ -205,8 +192,7 @@ public:
          */
         channel_scan_config continuous_scan_config; /**< continues scan configuration */
         channel_scan_status continuous_scan_status; /**< continues scan status        */
-        std::list<beerocks_message::sChannelScanResults>
-            continuous_scan_results; /**< continues scan results list  */
+        channel_scan_results continuous_scan_results; /**< continues scan results */
 
         /**
          * These members are part of the single channel scan.
@@ -214,8 +200,7 @@ public:
          */
         channel_scan_config single_scan_config; /**< single scan configuration */
         channel_scan_status single_scan_status; /**< single scan status        */
-        std::list<beerocks_message::sChannelScanResults>
-            single_scan_results; /**< single scan results list  */
+        channel_scan_results single_scan_results; /**< single scan results */
     };
     std::shared_ptr<radio> hostap;
 
@@ -266,20 +251,6 @@ public:
     friend std::ostream &operator<<(std::ostream &os, const node *node);
 
 private:
-    class rssi_measurement {
-    public:
-        rssi_measurement(std::string ap_mac_, int8_t rssi_, int8_t packets_) : ap_mac(ap_mac_)
-        {
-            rssi      = rssi_;
-            packets   = packets_;
-            timestamp = std::chrono::steady_clock::now();
-        }
-        const std::string ap_mac;
-        int8_t rssi = beerocks::RSSI_INVALID;
-        int8_t packets;
-        std::chrono::steady_clock::time_point timestamp;
-    };
-
     class beacon_measurement {
     public:
         beacon_measurement(std::string ap_mac_, int8_t rcpi_, uint8_t rsni_) : ap_mac(ap_mac_)
@@ -296,7 +267,6 @@ private:
 
     beerocks::eType type;
     std::unordered_map<std::string, std::shared_ptr<beacon_measurement>> beacon_measurements;
-    std::unordered_map<std::string, std::shared_ptr<rssi_measurement>> cross_rx_rssi;
 };
 } // namespace son
 #endif
@@ -0,0 +1,196 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "station_metrics.h"
+
+#include <bcl/beerocks_defines.h>
+#include <bcl/beerocks_log.h>
+
+#include <algorithm>
+
+using namespace son;
+
+const int station_metrics::INVALID_INDEX;
+
+int station_metrics::allocate()
+{
+    int index;
+    if (!m_free_slots.empty()) {
+        index = m_free_slots.back();
+        m_free_slots.pop_back();
+        m_in_use[index] = true;
+    } else {
+        index = int(m_in_use.size());
+        m_in_use.push_back(true);
+        m_columns.rx_packets.emplace_back();
+        m_columns.tx_packets.emplace_back();
+        m_columns.rx_bytes.emplace_back();
+        m_columns.tx_bytes.emplace_back();
+        m_columns.retrans_count.emplace_back();
+        m_columns.tx_load_percent.emplace_back();
+        m_columns.rx_load_percent.emplace_back();
+        m_columns.rx_phy_rate_100kb.emplace_back();
+        m_columns.tx_phy_rate_100kb.emplace_back();
+        m_columns.rx_rssi.emplace_back();
+        m_columns.stats_delta_ms.emplace_back();
+        m_columns.timestamp.emplace_back();
+        m_cross_rx_rssi.emplace_back();
+    }
+    reset_slot(index);
+    return index;
+}
+
+void station_metrics::release(int index)
+{
+    if (!is_valid(index)) {
+        LOG(ERROR) << "invalid station metrics index " << index;
+        return;
+    }
+    m_in_use[index] = false;
+    m_cross_rx_rssi[index].clear();
+    m_free_slots.push_back(index);
+}
+
+bool station_metrics::set_stats(int index, const beerocks_message::sStaStatsParams &params)
+{
+    if (!is_valid(index)) {
+        return false;
+    }
+    m_columns.rx_packets[index]        = params.rx_packets;
+    m_columns.tx_packets[index]        = params.tx_packets;
+    m_columns.tx_bytes[index]          = params.tx_bytes;
+    m_columns.rx_bytes[index]          = params.rx_bytes;
+    m_columns.retrans_count[index]     = params.retrans_count;
+    m_columns.tx_phy_rate_100kb[index] = params.tx_phy_rate_100kb;
+    m_columns.rx_phy_rate_100kb[index] = params.rx_phy_rate_100kb;
+    m_columns.tx_load_percent[index]   = params.tx_load_percent;
+    m_columns.rx_load_percent[index]   = params.rx_load_percent;
+    m_columns.stats_delta_ms[index]    = params.stats_delta_ms;
+    m_columns.rx_rssi[index]           = params.rx_rssi;
+    m_columns.timestamp[index]         = std::chrono::steady_clock::now();
+    return true;
+}
+
+void station_metrics::clear_stats(int index)
+{
+    if (!is_valid(index)) {
+        return;
+    }
+    reset_slot(index);
+}
+
+bool station_metrics::set_cross_rx_rssi(int index, const std::string &ap_mac, int8_t rssi,
+                                        int8_t packets)
+{
+    if (!is_valid(index)) {
+        return false;
+    }
+
+    int ap_index;
+    auto ap_it = m_ap_indexes.find(ap_mac);
+    if (ap_it != m_ap_indexes.end()) {
+        ap_index = ap_it->second;
+    } else {
+        if (m_ap_macs.size() > UINT16_MAX) {
+            LOG(ERROR) << "too many APs in the cross rx rssi matrix, dropping " << ap_mac;
+            return false;
+        }
+        ap_index             = int(m_ap_macs.size());
+        m_ap_indexes[ap_mac] = ap_index;
+        m_ap_macs.push_back(ap_mac);
+    }
+
+    auto &row = m_cross_rx_rssi[index];
+    auto it   = std::lower_bound(
+        row.begin(), row.end(), ap_index,
+        [](const sCrossRssi &entry, int ap_index_) { return entry.ap_index < ap_index_; });
+    if (it == row.end() || it->ap_index != ap_index) {
+        sCrossRssi entry = {};
+        entry.ap_index   = uint16_t(ap_index);
+        it               = row.insert(it, entry);
+    }
+    it->rssi      = rssi;
+    it->packets   = packets;
+    it->timestamp = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool station_metrics::get_cross_rx_rssi(int index, const std::string &ap_mac, int8_t &rssi,
+                                        int8_t &packets) const
+{
+    rssi    = beerocks::RSSI_INVALID;
+    packets = -1;
+
+    int ap_index = get_ap_index(ap_mac);
+    if (!is_valid(index) || ap_index == INVALID_INDEX) {
+        return false;
+    }
+
+    auto &row = m_cross_rx_rssi[index];
+    auto it   = std::lower_bound(
+        row.begin(), row.end(), ap_index,
+        [](const sCrossRssi &entry, int ap_index_) { return entry.ap_index < ap_index_; });
+    if (it == row.end() || it->ap_index != ap_index) {
+        return false;
+    }
+    rssi    = it->rssi;
+    packets = it->packets;
+    return true;
+}
+
+void station_metrics::clear_cross_rx_rssi(int index)
+{
+    if (!is_valid(index)) {
+        return;
+    }
+    m_cross_rx_rssi[index].clear();
+}
+
+const std::vector<station_metrics::sCrossRssi> &
+station_metrics::get_cross_rx_rssi_row(int index) const
+{
+    static const std::vector<sCrossRssi> empty_row;
+    if (!is_valid(index)) {
+        return empty_row;
+    }
+    return m_cross_rx_rssi[index];
+}
+
+int station_metrics::get_ap_index(const std::string &ap_mac) const
+{
+    auto it = m_ap_indexes.find(ap_mac);
+    if (it == m_ap_indexes.end()) {
+        return INVALID_INDEX;
+    }
+    return it->second;
+}
+
+const std::string &station_metrics::get_ap_mac(int ap_index) const
+{
+    static const std::string empty_mac;
+    if (ap_index < 0 || size_t(ap_index) >= m_ap_macs.size()) {
+        return empty_mac;
+    }
+    return m_ap_macs[ap_index];
+}
+
+void station_metrics::reset_slot(int index)
+{
+    m_columns.rx_packets[index]        = 0;
+    m_columns.tx_packets[index]        = 0;
+    m_columns.rx_bytes[index]          = 0;
+    m_columns.tx_bytes[index]          = 0;
+    m_columns.retrans_count[index]     = 0;
+    m_columns.tx_load_percent[index]   = 0;
+    m_columns.rx_load_percent[index]   = 0;
+    m_columns.rx_phy_rate_100kb[index] = 0;
+    m_columns.tx_phy_rate_100kb[index] = 0;
+    m_columns.rx_rssi[index]           = beerocks::RSSI_INVALID;
+    m_columns.stats_delta_ms[index]    = 0;
+    m_columns.timestamp[index]         = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,153 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _STATION_METRICS_H_
+#define _STATION_METRICS_H_
+
+#include <beerocks/tlvf/beerocks_message_common.h>
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace son {
+
+/**
+ * Per-station metrics, stored as columns indexed by a dense station index.
+ *
+ * Every station node owns one slot (see node::metrics_index) for as long as it is in the
+ * database. Freed slots are reused, so the columns stay as long as the maximal number of
+ * stations ever known at once. Scans over many stations (load balancing, BML statistics)
+ * read the columns directly instead of looking up and dereferencing every node.
+ *
+ * Cross rx rssi measurements form a sparse station x AP matrix. Every station holds a row of
+ * measurements sorted by a dense AP index, assigned when an AP is first measured.
+ */
+class station_metrics {
+public:
+    static const int INVALID_INDEX = -1;
+
+    struct sColumns {
+        std::vector<uint32_t> rx_packets;
+        std::vector<uint32_t> tx_packets;
+        std::vector<uint32_t> rx_bytes;
+        std::vector<uint32_t> tx_bytes;
+        std::vector<uint32_t> retrans_count;
+        std::vector<uint8_t> tx_load_percent;
+        std::vector<uint8_t> rx_load_percent;
+        std::vector<uint16_t> rx_phy_rate_100kb;
+        std::vector<uint16_t> tx_phy_rate_100kb;
+        std::vector<int8_t> rx_rssi;
+        std::vector<uint16_t> stats_delta_ms;
+        std::vector<std::chrono::steady_clock::time_point> timestamp;
+    };
+
+    struct sCrossRssi {
+        uint16_t ap_index;
+        int8_t rssi;
+        int8_t packets;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    /**
+     * @brief Allocate a slot for a new station, with cleared metrics.
+     *
+     * @return Index of the slot.
+     */
+    int allocate();
+
+    /**
+     * @brief Release the slot of a station which left the database.
+     *
+     * @param index Index of the slot.
+     */
+    void release(int index);
+
+    bool is_valid(int index) const
+    {
+        return index >= 0 && size_t(index) < m_in_use.size() && m_in_use[index];
+    }
+
+    /**
+     * @brief Number of slots, valid indexes are lower than this.
+     */
+    size_t size() const { return m_in_use.size(); }
+
+    const sColumns &columns() const { return m_columns; }
+
+    /**
+     * @brief Update the statistics of a station from a statistics report.
+     *
+     * @param index Index of the station slot.
+     * @param params Reported statistics.
+     * @return true on success, false if the index is invalid.
+     */
+    bool set_stats(int index, const beerocks_message::sStaStatsParams &params);
+
+    /**
+     * @brief Reset the statistics of a station to their initial values.
+     *
+     * @param index Index of the station slot.
+     */
+    void clear_stats(int index);
+
+    /**
+     * @brief Get the bitrate of a station over its last statistics window.
+     *
+     * @param index Index of a valid station slot.
+     * @return Bitrate in Mbps.
+     */
+    double get_rx_bitrate(int index) const
+    {
+        return (1000 * 8 * double(m_columns.rx_bytes[index]) / m_columns.stats_delta_ms[index]) /
+               1e+6;
+    }
+    double get_tx_bitrate(int index) const
+    {
+        return (1000 * 8 * double(m_columns.tx_bytes[index]) / m_columns.stats_delta_ms[index]) /
+               1e+6;
+    }
+
+    bool set_cross_rx_rssi(int index, const std::string &ap_mac, int8_t rssi, int8_t packets);
+    bool get_cross_rx_rssi(int index, const std::string &ap_mac, int8_t &rssi,
+                           int8_t &packets) const;
+    void clear_cross_rx_rssi(int index);
+
+    /**
+     * @brief Get all the cross rx rssi measurements of a station, sorted by AP index.
+     *
+     * @param index Index of the station slot.
+     * @return Measurements row, empty for an invalid index.
+     */
+    const std::vector<sCrossRssi> &get_cross_rx_rssi_row(int index) const;
+
+    /**
+     * @brief Get the dense index of an AP in the cross rx rssi matrix.
+     *
+     * @param ap_mac AP mac address.
+     * @return AP index, or INVALID_INDEX if the AP was never measured.
+     */
+    int get_ap_index(const std::string &ap_mac) const;
+    const std::string &get_ap_mac(int ap_index) const;
+
+private:
+    void reset_slot(int index);
+
+    sColumns m_columns;
+    std::vector<bool> m_in_use;
+    std::vector<int> m_free_slots;
+
+    std::vector<std::vector<sCrossRssi>> m_cross_rx_rssi;
+    std::unordered_map<std::string, int> m_ap_indexes;
+    std::vector<std::string> m_ap_macs;
+};
+
+} // namespace son
+
+#endif
@@ -0,0 +1,123 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "topology_snapshot.h"
+
+#include <bcl/beerocks_log.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace son;
+using namespace bml_topology_snapshot;
+
+topology_snapshot::~topology_snapshot() { close(); }
+
+bool topology_snapshot::open()
+{
+    close();
+
+    // Readers still mapping a segment of a previous controller instance detect its removal
+    shm_unlink(SHM_NAME);
+
+    // Owner only, the network map holds the MAC address of every client
+    m_fd = shm_open(SHM_NAME, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (m_fd < 0) {
+        LOG(ERROR) << "Failed creating shared memory " << SHM_NAME << ": " << strerror(errno);
+        return false;
+    }
+
+    // The pages are only allocated once written to
+    if (ftruncate(m_fd, MAX_SIZE) < 0) {
+        LOG(ERROR) << "Failed resizing shared memory " << SHM_NAME << ": " << strerror(errno);
+        close();
+        return false;
+    }
+
+    auto addr = mmap(nullptr, MAX_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED) {
+        LOG(ERROR) << "Failed mapping shared memory " << SHM_NAME << ": " << strerror(errno);
+        close();
+        return false;
+    }
+
+    m_header = new (addr) sHeader();
+
+    // Readers ignore the segment until the first snapshot is published (generation 0)
+    m_header->magic        = MAGIC;
+    m_header->version      = VERSION;
+    m_header->header_len   = sizeof(sHeader);
+    m_header->size         = MAX_SIZE;
+    m_header->generation   = 0;
+    m_header->num_of_nodes = 0;
+    m_header->data_len     = 0;
+    m_header->sequence.store(0, std::memory_order_release);
+
+    m_data.clear();
+    m_num_of_nodes = 0;
+
+    LOG(INFO) << "Topology snapshot published in " << SHM_NAME;
+    return true;
+}
+
+void topology_snapshot::close()
+{
+    if (m_header) {
+        munmap(m_header, MAX_SIZE);
+        m_header = nullptr;
+        shm_unlink(SHM_NAME);
+    }
+
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool topology_snapshot::publish(const std::vector<uint8_t> &data, uint32_t num_of_nodes)
+{
+    if (!m_header) {
+        return false;
+    }
+
+    if (data.size() > MAX_SIZE - sizeof(sHeader)) {
+        LOG(ERROR) << "Network map of " << data.size() << " bytes does not fit in " << SHM_NAME;
+        return false;
+    }
+
+    // Nothing changed, keep the generation
+    if (m_header->generation != 0 && num_of_nodes == m_num_of_nodes && data == m_data) {
+        return true;
+    }
+
+    // Odd sequence, readers retry until the update is done
+    auto sequence = m_header->sequence.load(std::memory_order_relaxed);
+    m_header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (!data.empty()) {
+        std::memcpy(reinterpret_cast<uint8_t *>(m_header) + sizeof(sHeader), data.data(),
+                    data.size());
+    }
+    m_header->num_of_nodes = num_of_nodes;
+    m_header->data_len     = data.size();
+    m_header->generation++;
+    if (m_header->generation == 0) {
+        m_header->generation = 1;
+    }
+
+    m_header->sequence.store(sequence + 2, std::memory_order_release);
+
+    m_data         = data;
+    m_num_of_nodes = num_of_nodes;
+
+    return true;
+}
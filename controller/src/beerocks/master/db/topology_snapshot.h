@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _TOPOLOGY_SNAPSHOT_H_
+#define _TOPOLOGY_SNAPSHOT_H_
+
+#include <internal/bml_topology_snapshot.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace son {
+
+/**
+ * Publisher of the topology snapshot shared memory segment, read by the BML library without
+ * querying the controller (see bml_topology_snapshot.h for the layout).
+ *
+ * The snapshot is only written when its content changed, so readers can tell from the
+ * generation whether the topology changed since their last read.
+ */
+class topology_snapshot {
+public:
+    ~topology_snapshot();
+
+    /**
+     * @brief Create the shared memory segment, replacing any stale segment.
+     *
+     * @return true on success, false otherwise.
+     */
+    bool open();
+
+    /**
+     * @brief Remove the shared memory segment, readers fall back to querying the controller.
+     */
+    void close();
+
+    bool is_open() const { return m_header != nullptr; }
+
+    /**
+     * @brief Publish the network map.
+     *
+     * @param data BML_NODE records, in the format of the ACTION_BML_NW_MAP_RESPONSE buffer.
+     * @param num_of_nodes Number of records.
+     * @return true on success, false if the network map does not fit in the segment.
+     */
+    bool publish(const std::vector<uint8_t> &data, uint32_t num_of_nodes);
+
+private:
+    int m_fd                                 = -1;
+    bml_topology_snapshot::sHeader *m_header = nullptr;
+
+    // Last published content
+    std::vector<uint8_t> m_data;
+    uint32_t m_num_of_nodes = 0;
+};
+
+} // namespace son
+
+#endif
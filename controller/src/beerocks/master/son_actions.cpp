@@ -15,10 +15,10 @@
 #include "tasks/ire_network_optimization_task.h"
 #include "tasks/optimal_path_task.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message_cli.h>
 #include <tlvf/wfa_map/tlvClientAssociationControlRequest.h>
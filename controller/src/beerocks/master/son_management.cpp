@@ -22,9 +22,11 @@
 #include <beerocks/tlvf/beerocks_message_bml.h>
 #include <beerocks/tlvf/beerocks_message_cli.h>
 
+#include <tlvf/ieee_1905_1/tlvEndOfMessage.h>
 #include <tlvf/wfa_map/tlvClientAssociationControlRequest.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
+#include <bcl/beerocks_metrics.h>
 
 using namespace beerocks;
 using namespace net;
@@ -970,8 +972,27 @@ void son_management::handle_bml_message(Socket *sd,
 
     case beerocks_message::ACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST: {
         LOG(TRACE) << "ACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST";
-        bml_task::listener_general_register_unregister_event new_event;
-        new_event.sd = sd;
+        auto request =
+            beerocks_header
+                ->addClass<beerocks_message::cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST>();
+        if (request == nullptr) {
+            LOG(ERROR) << "addClass cACTION_BML_REGISTER_TO_STATS_UPDATES_REQUEST failed";
+            break;
+        }
+
+        bml_task::stats_register_event new_event;
+        new_event.sd    = sd;
+        new_event.delta = request->delta();
+        if (new_event.delta) {
+            auto &subscription      = new_event.subscription;
+            subscription.node_types = request->node_types();
+            if (request->metrics()) {
+                subscription.metrics = request->metrics();
+            }
+            for (uint8_t i = 0; i < request->macs_size(); i++) {
+                subscription.macs.insert(std::get<1>(request->macs(i)));
+            }
+        }
         tasks.push_event(database.get_bml_task_id(), bml_task::REGISTER_TO_STATS_UPDATES,
                          &new_event);
 
@@ -1973,7 +1994,7 @@ void son_management::handle_bml_message(Socket *sd,
         }
 
         // Get results
-        auto scan_results      = database.get_channel_scan_results(radio_mac, is_single_scan);
+        auto &scan_results     = database.get_channel_scan_results(radio_mac, is_single_scan);
         auto scan_results_size = scan_results.size();
 
         LOG(DEBUG) << "scan_results received for hostap_mac= " << radio_mac << std::endl
@@ -2021,33 +2042,38 @@ void son_management::handle_bml_message(Socket *sd,
                                 beerocks_message::cACTION_BML_CHANNEL_SCAN_GET_RESULTS_RESPONSE>());
         auto response        = gen_new_results_response();
         size_t max_size      = cmdu_tx.getMessageBuffLength() - reserved_size;
-        for (auto &dump : scan_results) {
+        for (auto &channel_results : scan_results.channels()) {
+            for (auto &dump : channel_results.second) {
 
-            if (max_size < sizeof(dump)) {
+                if (max_size < sizeof(dump)) {
 
-                LOG(DEBUG) << "Reached limit on CMDU, Sending..";
-                send_results_response(response, result_status, op_error_code, false);
-                LOG(DEBUG) << "Creating new CMDU";
-                response = gen_new_results_response();
-                max_size = cmdu_tx.getMessageBuffLength() - reserved_size;
-            }
-            //LOG(DEBUG) << "Allocating space";
-            if (!response->alloc_results()) {
-                LOG(ERROR) << "Failed buffer allocation";
-                op_error_code = eChannelScanOpErrCode::CHANNEL_SCAN_OP_ERROR;
-                break;
-            }
-            max_size -= sizeof(dump);
+                    LOG(DEBUG) << "Reached limit on CMDU, Sending..";
+                    send_results_response(response, result_status, op_error_code, false);
+                    LOG(DEBUG) << "Creating new CMDU";
+                    response = gen_new_results_response();
+                    max_size = cmdu_tx.getMessageBuffLength() - reserved_size;
+                }
+                //LOG(DEBUG) << "Allocating space";
+                if (!response->alloc_results()) {
+                    LOG(ERROR) << "Failed buffer allocation";
+                    op_error_code = eChannelScanOpErrCode::CHANNEL_SCAN_OP_ERROR;
+                    break;
+                }
+                max_size -= sizeof(dump);
+
+                auto num_of_res = response->results_size();
+                if (!std::get<0>(response->results(num_of_res - 1))) {
+                    LOG(ERROR) << "Failed accessing results buffer";
+                    op_error_code = eChannelScanOpErrCode::CHANNEL_SCAN_OP_ERROR;
+                    break;
+                }
+                auto &dump_msg = std::get<1>(response->results(num_of_res - 1));
 
-            auto num_of_res = response->results_size();
-            if (!std::get<0>(response->results(num_of_res - 1))) {
-                LOG(ERROR) << "Failed accessing results buffer";
-                op_error_code = eChannelScanOpErrCode::CHANNEL_SCAN_OP_ERROR;
+                dump_msg = dump;
+            }
+            if (op_error_code != eChannelScanOpErrCode::CHANNEL_SCAN_OP_SUCCESS) {
                 break;
             }
-            auto &dump_msg = std::get<1>(response->results(num_of_res - 1));
-
-            dump_msg = dump;
         }
         LOG(DEBUG) << "Finished all results, Sending final CMDU";
         send_results_response(response, result_status, op_error_code, true);
@@ -2118,6 +2144,35 @@ void son_management::handle_bml_message(Socket *sd,
         LOG(TRACE) << "ACTION_BML_CHANNEL_SCAN_DUMP_RESULTS_REQUEST";
         break;
     }
+    case beerocks_message::ACTION_BML_METRICS_REQUEST: {
+        LOG(TRACE) << "ACTION_BML_METRICS_REQUEST";
+
+        // Metrics of the controller process, sent in as many responses as needed
+        auto metrics  = beerocks::metrics::registry::instance().to_prometheus();
+        size_t offset = 0;
+        do {
+            auto response =
+                message_com::create_vs_message<beerocks_message::cACTION_BML_METRICS_RESPONSE>(
+                    cmdu_tx, beerocks_header->id());
+            if (!response) {
+                LOG(ERROR) << "Failed building cACTION_BML_METRICS_RESPONSE message!";
+                break;
+            }
+
+            size_t chunk_size = std::min(metrics.size() - offset,
+                                         response->getBuffRemainingBytes() -
+                                             ieee1905_1::tlvEndOfMessage::get_initial_size());
+            if (!response->set_buffer(metrics.data() + offset, chunk_size)) {
+                LOG(ERROR) << "Failed setting the metrics buffer";
+                break;
+            }
+            offset += chunk_size;
+            response->last() = (offset == metrics.size());
+
+            message_com::send_cmdu(sd, cmdu_tx);
+        } while (offset < metrics.size());
+        break;
+    }
     default: {
         LOG(ERROR) << "Unsupported BML action_op:" << int(beerocks_header->action_op());
         break;
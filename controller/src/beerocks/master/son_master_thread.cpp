@@ -14,6 +14,7 @@
 #include "tasks/client_steering_task.h"
 #include "tasks/load_balancer_task.h"
 #include "tasks/optimal_path_task.h"
+#include "tasks/rssi_measurement_batch_task.h"
 #include "tasks/statistics_polling_task.h"
 #ifdef BEEROCKS_RDKB
 #include "tasks/rdkb/rdkb_wlan_task.h"
@@ -26,9 +27,9 @@
 #include "tasks/network_health_check_task.h"
 
 #include <bcl/beerocks_backport.h>
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_version.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message_1905_vs.h>
 #include <beerocks/tlvf/beerocks_message_control.h>
@@ -68,7 +69,8 @@ using namespace son;
 
 master_thread::master_thread(const std::string &master_uds_, db &database_)
     : transport_socket_thread(master_uds_), database(database_),
-      m_controller_ucc_listener(database_, cert_cmdu_tx)
+      m_controller_ucc_listener(database_, cert_cmdu_tx),
+      m_local_bridge_mac(network_utils::mac_from_string(database_.get_local_bridge_mac()))
 {
     thread_name = "master";
 
@@ -110,6 +112,14 @@ bool master_thread::init()
         LOG(ERROR) << "Failed subscribing to the Bus";
     }
 
+    if (!tasks.start_workers(database.config.task_worker_threads)) {
+        LOG(ERROR) << "Failed starting the task workers, offloaded jobs will run inline";
+    } else if (tasks.get_job_results_fd() >= 0) {
+        // Polled only, not added to the sockets vector, run_tasks() resets it
+        m_task_job_results = std::unique_ptr<Socket>(new Socket(tasks.get_job_results_fd()));
+        add_socket(m_task_job_results.get(), false);
+    }
+
 #ifndef BEEROCKS_LINUX
     auto new_statistics_polling_task =
         std::make_shared<statistics_polling_task>(database, cmdu_tx, tasks);
@@ -135,6 +145,14 @@ bool master_thread::init()
     }
     tasks.add_task(new_channel_selection_task);
 
+    auto new_rssi_measurement_batch_task =
+        std::make_shared<rssi_measurement_batch_task>(database, cmdu_tx, tasks);
+    if (!new_rssi_measurement_batch_task) {
+        LOG(FATAL) << "Failed allocating memory";
+        return false;
+    }
+    tasks.add_task(new_rssi_measurement_batch_task);
+
     if (database.settings_health_check()) {
         auto new_network_health_check_task = std::make_shared<network_health_check_task>(
             database, cmdu_tx, tasks, 0, "network_health_check_task");
@@ -168,7 +186,15 @@ bool master_thread::work()
 
 void master_thread::before_select() { database.unlock(); }
 
-void master_thread::after_select(bool timeout) { database.lock(); }
+void master_thread::after_select(bool timeout)
+{
+    database.lock();
+
+    // The job results are delivered by run_tasks(), right after the sockets are handled
+    if (m_task_job_results && read_ready(m_task_job_results.get())) {
+        clear_ready(m_task_job_results.get());
+    }
+}
 
 std::string master_thread::print_cmdu_types(const message::sUdsHeader *cmdu_header)
 {
@@ -208,26 +234,24 @@ bool master_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
         return false;
     }
 
-    std::string src_mac = network_utils::mac_to_string(uds_header->src_bridge_mac);
-    std::string dst_mac = network_utils::mac_to_string(uds_header->dst_bridge_mac);
-
-    // LOG(DEBUG) << "handle_cmdu() - received msg from " << std::string(from_bus(sd) ? "bus" : "uds") << ", src=" << src_mac
-    //            << ", dst=" << dst_mac << ", " << print_cmdu_types(uds_header); // floods the log
-
     if (from_bus(sd)) {
 
-        if (src_mac == network_utils::ZERO_MAC_STRING) {
+        // Filter on the binary addresses, only the source of accepted messages is formatted
+        static const sMacAddr multicast_mac = network_utils::mac_from_string(MULTICAST_MAC_ADDR);
+
+        if (!memcmp(uds_header->src_bridge_mac, network_utils::ZERO_MAC.oct, MAC_ADDR_LEN)) {
             LOG(ERROR) << "src_mac is zero!";
             return false;
         }
 
-        if (dst_mac == network_utils::ZERO_MAC_STRING) {
+        if (!memcmp(uds_header->dst_bridge_mac, network_utils::ZERO_MAC.oct, MAC_ADDR_LEN)) {
             LOG(ERROR) << "dst_mac is zero!";
             return false;
         }
 
         // Filter messages which are not destined to the controller
-        if (dst_mac != MULTICAST_MAC_ADDR && dst_mac != database.get_local_bridge_mac()) {
+        if (memcmp(uds_header->dst_bridge_mac, multicast_mac.oct, MAC_ADDR_LEN) &&
+            memcmp(uds_header->dst_bridge_mac, m_local_bridge_mac.oct, MAC_ADDR_LEN)) {
             return true;
         }
 
@@ -235,6 +259,8 @@ bool master_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
         // If VS message was sent by Controllers local agent to the controller, it is looped back.
     }
 
+    std::string src_mac = network_utils::mac_to_string(uds_header->src_bridge_mac);
+
     bool vendor_specific = false;
 
     if (cmdu_rx.getMessageType() == ieee1905_1::eMessageType::VENDOR_SPECIFIC_MESSAGE) {
@@ -247,6 +273,9 @@ bool master_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
             LOG(ERROR) << "Not a vendor specific message";
             return false;
         }
+        metrics::scoped_timer timer(
+            cmdu_handle_time(m_cmdu_handle_time, beerocks_header->action(),
+                             beerocks_header->action_op()));
         switch (beerocks_header->action()) {
         case beerocks_message::ACTION_CLI: {
             son_management::handle_cli_message(sd, beerocks_header, cmdu_tx, database, tasks);
@@ -263,6 +292,8 @@ bool master_thread::handle_cmdu(Socket *sd, ieee1905_1::CmduMessageRx &cmdu_rx)
         }
     } else {
         LOG(DEBUG) << "received 1905.1 cmdu message";
+        metrics::scoped_timer timer(
+            cmdu_handle_time(m_cmdu_handle_time, uint16_t(cmdu_rx.getMessageType())));
         handle_cmdu_1905_1_message(src_mac, cmdu_rx);
     }
 
@@ -1922,6 +1953,8 @@ bool master_thread::handle_intel_slave_join(
     database.set_hostap_iface_name(radio_mac, notification->hostap().iface_name);
     database.set_hostap_iface_type(radio_mac, hostap_iface_type);
     database.set_hostap_driver_version(radio_mac, notification->hostap().driver_version);
+    // Advertised by the agent after the join, older agents never send it
+    database.set_hostap_slave_features(radio_mac, 0);
 
     database.set_hostap_ant_num(radio_mac, (beerocks::eWiFiAntNum)notification->hostap().ant_num);
     database.set_hostap_ant_gain(radio_mac, notification->hostap().ant_gain);
@@ -2246,6 +2279,44 @@ bool master_thread::handle_non_intel_slave_join(
     return son_actions::send_cmdu_to_agent(src_mac, cmdu_tx, database);
 }
 
+void master_thread::handle_client_rx_rssi_measurement_notification(
+    const std::string &hostap_mac, const beerocks_message::sNodeRssiMeasurement &params)
+{
+    std::string client_mac        = network_utils::mac_to_string(params.result.mac);
+    std::string client_parent_mac = database.get_node_parent(client_mac);
+    std::string bssid             = database.get_hostap_vap_mac(hostap_mac, params.vap_id);
+    bool is_parent                = (client_parent_mac == bssid);
+
+    int rx_rssi = int(params.rx_rssi);
+
+    LOG_CLI(DEBUG, "measurement change notification: "
+                       << client_mac << " (sta) <-> (ap) " << hostap_mac << " rx_rssi=" << rx_rssi
+                       << " phy_rate_100kb (RX|TX)=" << int(params.rx_phy_rate_100kb) << " | "
+                       << int(params.tx_phy_rate_100kb));
+
+    if ((database.get_node_type(client_mac) == beerocks::TYPE_CLIENT) &&
+        (database.get_node_state(client_mac) == beerocks::STATE_CONNECTED) &&
+        (!database.get_node_handoff_flag(client_mac)) && is_parent) {
+
+        database.set_node_cross_rx_rssi(client_mac, hostap_mac, params.rx_rssi, params.rx_packets);
+        database.set_node_cross_tx_phy_rate_100kb(client_mac, params.tx_phy_rate_100kb);
+        database.set_node_cross_rx_phy_rate_100kb(client_mac, params.rx_phy_rate_100kb);
+
+        /*
+         * when a notification arrives, it means a large change in rx_rssi occurred (above the defined thershold)
+         * therefore, we need to create an optimal path task to relocate the node if needed
+         */
+        int prev_task_id = database.get_roaming_task_id(client_mac);
+        if (tasks.is_task_running(prev_task_id)) {
+            LOG(DEBUG) << "roaming task already running for " << client_mac;
+        } else {
+            auto new_task =
+                std::make_shared<optimal_path_task>(database, cmdu_tx, tasks, client_mac, 0, "");
+            tasks.add_task(new_task);
+        }
+    }
+}
+
 bool master_thread::handle_cmdu_control_message(const std::string &src_mac,
                                                 std::shared_ptr<beerocks_header> beerocks_header)
 {
@@ -2269,6 +2340,19 @@ bool master_thread::handle_cmdu_control_message(const std::string &src_mac,
     }
 
     switch (beerocks_header->action_op()) {
+    case beerocks_message::ACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION: {
+        auto notification =
+            beerocks_header
+                ->addClass<beerocks_message::cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION>();
+        if (notification == nullptr) {
+            LOG(ERROR) << "addClass cACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION failed";
+            return false;
+        }
+        LOG(DEBUG) << "received ACTION_CONTROL_SLAVE_FEATURES_NOTIFICATION from " << hostap_mac
+                   << " features=0x" << std::hex << notification->features() << std::dec;
+        database.set_hostap_slave_features(hostap_mac, notification->features());
+        break;
+    }
     case beerocks_message::ACTION_CONTROL_HOSTAP_SET_RESTRICTED_FAILSAFE_CHANNEL_RESPONSE: {
         LOG(DEBUG)
             << "received ACTION_CONTROL_HOSTAP_SET_RESTRICTED_FAILSAFE_CHANNEL_RESPONSE from "
@@ -2661,42 +2745,25 @@ bool master_thread::handle_cmdu_control_message(const std::string &src_mac,
             LOG(ERROR) << "addClass ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_NOTIFICATION failed";
             return false;
         }
-        std::string client_mac = network_utils::mac_to_string(notification->params().result.mac);
-        std::string client_parent_mac = database.get_node_parent(client_mac);
-        std::string bssid = database.get_hostap_vap_mac(hostap_mac, notification->params().vap_id);
-        bool is_parent    = (client_parent_mac == bssid);
-
-        int rx_rssi = int(notification->params().rx_rssi);
-
-        LOG_CLI(DEBUG,
-                "measurement change notification: "
-                    << client_mac << " (sta) <-> (ap) " << hostap_mac << " rx_rssi=" << rx_rssi
-                    << " phy_rate_100kb (RX|TX)=" << int(notification->params().rx_phy_rate_100kb)
-                    << " | " << int(notification->params().tx_phy_rate_100kb));
-
-        if ((database.get_node_type(client_mac) == beerocks::TYPE_CLIENT) &&
-            (database.get_node_state(client_mac) == beerocks::STATE_CONNECTED) &&
-            (!database.get_node_handoff_flag(client_mac)) && is_parent) {
-
-            database.set_node_cross_rx_rssi(client_mac, hostap_mac, notification->params().rx_rssi,
-                                            notification->params().rx_packets);
-            database.set_node_cross_tx_phy_rate_100kb(client_mac,
-                                                      notification->params().tx_phy_rate_100kb);
-            database.set_node_cross_rx_phy_rate_100kb(client_mac,
-                                                      notification->params().rx_phy_rate_100kb);
-
-            /*
-                * when a notification arrives, it means a large change in rx_rssi occurred (above the defined thershold)
-                * therefore, we need to create an optimal path task to relocate the node if needed
-                */
-            int prev_task_id = database.get_roaming_task_id(client_mac);
-            if (tasks.is_task_running(prev_task_id)) {
-                LOG(DEBUG) << "roaming task already running for " << client_mac;
-            } else {
-                auto new_task = std::make_shared<optimal_path_task>(database, cmdu_tx, tasks,
-                                                                    client_mac, 0, "");
-                tasks.add_task(new_task);
+        handle_client_rx_rssi_measurement_notification(hostap_mac, notification->params());
+        break;
+    }
+    case beerocks_message::ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION: {
+        auto notification = beerocks_header->addClass<
+            beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION>();
+        if (notification == nullptr) {
+            LOG(ERROR)
+                << "addClass ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_NOTIFICATION failed";
+            return false;
+        }
+        int measurements_size = notification->measurements_size();
+        for (int i = 0; i < measurements_size; i++) {
+            auto entry = notification->measurements(i);
+            if (!std::get<0>(entry)) {
+                LOG(ERROR) << "Failed to get rx rssi measurement entry " << i;
+                return false;
             }
+            handle_client_rx_rssi_measurement_notification(hostap_mac, std::get<1>(entry));
         }
         break;
     }
@@ -3448,6 +3515,42 @@ bool master_thread::handle_cmdu_control_message(const std::string &src_mac,
 
         break;
     }
+    case beerocks_message::ACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION: {
+        auto notification = beerocks_header->addClass<
+            beerocks_message::cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION>();
+        if (!notification) {
+            LOG(ERROR) << "addClass cACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION failed";
+            return false;
+        }
+
+        LOG(TRACE) << "ACTION_CONTROL_CHANNEL_SCAN_RESULTS_BATCH_NOTIFICATION for mac "
+                   << hostap_mac << ", " << int(notification->results_size()) << " results";
+
+        auto radio_mac = network_utils::mac_from_string(hostap_mac);
+        if (!database.get_channel_scan_in_progress(radio_mac, false) &&
+            !database.get_channel_scan_in_progress(radio_mac, true)) {
+            LOG(DEBUG) << "received scan results while no scan is in progress, ignoring."
+                       << " hostap_mac=" << hostap_mac;
+            break;
+        }
+
+        // Every result is a dump event of the dcs task
+        dynamic_channel_selection_task::sScanEvent new_event;
+        new_event.radio_mac = radio_mac;
+        auto task_id        = database.get_dynamic_channel_selection_task_id(radio_mac);
+        for (int i = 0; i < notification->results_size(); i++) {
+            auto result = notification->results(i);
+            if (!std::get<0>(result)) {
+                LOG(ERROR) << "Failed to get channel scan result " << i;
+                return false;
+            }
+            new_event.udata.scan_results = std::get<1>(result);
+            tasks.push_event(task_id,
+                             int(dynamic_channel_selection_task::eEvent::SCAN_RESULTS_DUMP),
+                             static_cast<void *>(&new_event));
+        }
+        break;
+    }
     case beerocks_message::ACTION_CONTROL_CHANNEL_SCAN_FINISHED_NOTIFICATION: {
         LOG(DEBUG) << "DCS_task, sending SCAN_FINISHED for mac " << hostap_mac;
         auto notification =
@@ -17,6 +17,7 @@
 #include <bcl/beerocks_defines.h>
 #include <bcl/beerocks_logging.h>
 #include <bcl/beerocks_message_structs.h>
+#include <bcl/beerocks_metrics.h>
 #include <bcl/beerocks_socket_thread.h>
 #include <bcl/network/network_utils.h>
 
@@ -100,6 +101,16 @@ private:
     bool handle_cmdu_1905_topology_notification(const std::string &src_mac,
                                                 ieee1905_1::CmduMessageRx &cmdu_rx);
 
+    /**
+     * @brief Update the database with an rx rssi measurement of a client, and start a roaming
+     * task if the client is connected to the measuring AP.
+     *
+     * @param hostap_mac Mac address of the radio which measured the client.
+     * @param params Measurement.
+     */
+    void handle_client_rx_rssi_measurement_notification(
+        const std::string &hostap_mac, const beerocks_message::sNodeRssiMeasurement &params);
+
     bool autoconfig_wsc_parse_radio_caps(
         std::string radio_mac, std::shared_ptr<wfa_map::tlvApRadioBasicCapabilities> radio_caps);
     // Autoconfig encryption support
@@ -114,7 +125,16 @@ private:
 
     db &database;
     task_pool tasks;
+    // Signaled by the task workers when an offloaded job is done
+    std::unique_ptr<Socket> m_task_job_results;
     beerocks::controller_ucc_listener m_controller_ucc_listener;
+
+    // Bridge MAC of the controller, compared to the destination of every received CMDU
+    sMacAddr m_local_bridge_mac;
+
+    // Handling time of the received CMDUs, by message type
+    beerocks::metrics::histogram_map<> m_cmdu_handle_time{
+        "beerocks_cmdu_handle_seconds", "Time spent handling a received CMDU, by message type"};
 };
 
 } // namespace son
@@ -11,18 +11,21 @@
 #include "../db/network_map.h"
 #include "bml_defs.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_bml.h>
 #include <tlvf/ieee_1905_1/tlvEndOfMessage.h>
 
+#include <algorithm>
 #include <climits>
 
 using namespace beerocks;
 using namespace son;
 
+#define TOPOLOGY_SNAPSHOT_REFRESH_INTERVAL_MSEC 5000
+
 bml_task::bml_task(db &database_, ieee1905_1::CmduMessageTx &cmdu_tx_, task_pool &tasks_)
     : task("bml task"), database(database_), cmdu_tx(cmdu_tx_), tasks(tasks_)
 {
@@ -36,14 +39,20 @@ void bml_task::work()
         tasks.kill_task(prev_task_id);
         database.assign_bml_task_id(id);
 
+        if (database.config.load_topology_snapshot && m_topology_snapshot.open()) {
+            m_topology_snapshot_dirty = true;
+        }
+
         state = IDLE;
         break;
     }
     case IDLE: {
-        wait_for(5000);
+        update_topology_snapshot();
+        wait_for(m_topology_snapshot.is_open() ? 1000 : 5000);
         break;
     }
     case LISTENING: {
+        update_topology_snapshot();
         wait_for(1000);
         break;
     }
@@ -52,6 +61,11 @@ void bml_task::work()
 
 void bml_task::handle_event(int event_type, void *obj)
 {
+    // Snapshot readers are not registered as listeners
+    if (event_type == CONNECTION_CHANGE) {
+        m_topology_snapshot_dirty = true;
+    }
+
     if ((event_type != REGISTER_TO_NW_MAP_UPDATES && event_type != REGISTER_TO_STATS_UPDATES &&
          event_type != REGISTER_TO_EVENTS_UPDATES) &&
         !database.is_bml_listener_exist()) {
@@ -98,6 +112,32 @@ void bml_task::handle_event(int event_type, void *obj)
                 }
                 idx++;
             }
+
+            // Subscriptions of listeners which are gone
+            for (auto it = m_stats_subscriptions.begin(); it != m_stats_subscriptions.end();) {
+                if (std::find(stats_updates_listeners.begin(), stats_updates_listeners.end(),
+                              it->first) == stats_updates_listeners.end()) {
+                    it = m_stats_subscriptions.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            // Filtered listeners get their own delta encoded update, the others share the
+            // full statistics update
+            for (auto &subscription : m_stats_subscriptions) {
+                network_map::send_bml_nodes_statistics_delta_message(
+                    database, cmdu_tx, subscription.first, subscription.second,
+                    event_obj->valid_hostaps);
+            }
+            auto is_subscribed = [&](Socket *listener) {
+                return m_stats_subscriptions.count(listener) > 0;
+            };
+            stats_updates_listeners.erase(std::remove_if(stats_updates_listeners.begin(),
+                                                         stats_updates_listeners.end(),
+                                                         is_subscribed),
+                                          stats_updates_listeners.end());
+
             if (!stats_updates_listeners.empty()) {
                 network_map::send_bml_nodes_statistics_message_to_listeners(
                     database, cmdu_tx, stats_updates_listeners, event_obj->valid_hostaps);
@@ -221,12 +261,19 @@ void bml_task::handle_event(int event_type, void *obj)
     }
     case REGISTER_TO_STATS_UPDATES: {
         if (obj) {
-            auto event_obj = (listener_general_register_unregister_event *)obj;
-            TASK_LOG(DEBUG) << "REGISTER_TO_STATS_UPDATES event was received";
+            auto event_obj = (stats_register_event *)obj;
+            TASK_LOG(DEBUG) << "REGISTER_TO_STATS_UPDATES event was received, delta="
+                            << event_obj->delta;
             database.add_bml_socket(event_obj->sd);
             if (!database.set_bml_stats_update_enable(event_obj->sd, true)) {
                 TASK_LOG(DEBUG) << "fail in changing stats_update registration";
             }
+            // A new registration restarts the subscription from a full update
+            if (event_obj->delta) {
+                m_stats_subscriptions[event_obj->sd] = event_obj->subscription;
+            } else {
+                m_stats_subscriptions.erase(event_obj->sd);
+            }
             state = LISTENING;
         }
         break;
@@ -235,6 +282,7 @@ void bml_task::handle_event(int event_type, void *obj)
         if (obj) {
             auto event_obj = (listener_general_register_unregister_event *)obj;
             TASK_LOG(DEBUG) << "UNREGISTER_TO_STATS_UPDATES event was received";
+            m_stats_subscriptions.erase(event_obj->sd);
 
             if (!database.set_bml_stats_update_enable(event_obj->sd, false)) {
                 TASK_LOG(DEBUG) << "fail in changing stats_update unregistration";
@@ -278,6 +326,28 @@ void bml_task::handle_event(int event_type, void *obj)
     }
 }
 
+void bml_task::update_topology_snapshot()
+{
+    if (!m_topology_snapshot.is_open()) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (!m_topology_snapshot_dirty && now < m_topology_snapshot_refresh) {
+        return;
+    }
+
+    m_topology_snapshot_dirty = false;
+    m_topology_snapshot_refresh =
+        now + std::chrono::milliseconds(TOPOLOGY_SNAPSHOT_REFRESH_INTERVAL_MSEC);
+
+    // The buffer is kept to avoid reallocating it on every refresh
+    auto num_of_nodes = network_map::fill_bml_network_map(database, m_topology_snapshot_buffer);
+    if (!m_topology_snapshot.publish(m_topology_snapshot_buffer, num_of_nodes)) {
+        TASK_LOG(ERROR) << "Failed publishing the topology snapshot";
+    }
+}
+
 void bml_task::update_bml_nw_map(std::string mac, bool force_client_disconnect)
 {
     int idx = 0;
@@ -10,9 +10,13 @@
 #define _BML_TASK_H_
 
 #include "../db/db.h"
+#include "../db/network_map.h"
+#include "../db/topology_snapshot.h"
 #include "task.h"
 #include "task_pool.h"
 
+#include <chrono>
+
 namespace son {
 class bml_task : public task {
 public:
@@ -20,6 +24,12 @@ public:
         Socket *sd;
     };
 
+    struct stats_register_event {
+        Socket *sd;
+        bool delta = false; // Filtered and delta encoded updates
+        network_map::bml_stats_subscription subscription;
+    };
+
     struct connection_change_event {
         std::string mac;
         bool force_client_disconnect = false;
@@ -106,6 +116,17 @@ private:
     task_pool &tasks;
 
     void update_bml_nw_map(std::string mac, bool force_client_disconnect = false);
+    void update_topology_snapshot();
+
+    // Listeners of filtered, delta encoded statistics updates
+    std::unordered_map<Socket *, network_map::bml_stats_subscription> m_stats_subscriptions;
+
+    // Network map published in shared memory, refreshed on connection changes and periodically
+    // for the changes which are not notified (e.g. signal strength)
+    topology_snapshot m_topology_snapshot;
+    bool m_topology_snapshot_dirty = false;
+    std::chrono::steady_clock::time_point m_topology_snapshot_refresh;
+    std::vector<uint8_t> m_topology_snapshot_buffer;
 };
 
 } // namespace son
@@ -11,10 +11,10 @@
 #include "bml_task.h"
 #include "ire_network_optimization_task.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 using namespace beerocks;
 using namespace net;
@@ -11,7 +11,7 @@
 #include "../son_actions.h"
 #include "bml_task.h"
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 using namespace beerocks;
 using namespace net;
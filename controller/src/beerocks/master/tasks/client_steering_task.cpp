@@ -11,9 +11,9 @@
 #include "../son_actions.h"
 #include "bml_task.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
 #include <beerocks/tlvf/beerocks_message_1905_vs.h>
-#include <easylogging++.h>
 #include <tlvf/wfa_map/tlvClientAssociationControlRequest.h>
 #include <tlvf/wfa_map/tlvSteeringRequest.h>
 
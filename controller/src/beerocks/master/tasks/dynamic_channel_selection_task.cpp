@@ -10,7 +10,7 @@
 #include "../son_actions.h"
 #include <bcl/beerocks_defines.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 #define SCAN_TRIGGERED_WAIT_TIME_MSEC 20000
 #define SCAN_RESULTS_DUMP_WAIT_TIME_MSEC 40000
@@ -10,10 +10,10 @@
 #include "../db/db_algo.h"
 #include "../son_actions.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
 #include <bcl/network/network_utils.h>
 #include <bcl/network/socket.h>
-#include <easylogging++.h>
 
 #include <climits>
 #include <cstdlib>
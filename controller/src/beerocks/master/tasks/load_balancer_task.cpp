@@ -10,8 +10,8 @@
 #include "../db/db_algo.h"
 #include "../son_actions.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 using namespace beerocks;
 using namespace son;
@@ -150,11 +150,20 @@ void load_balancer_task::work()
         float max_efficiency_ratio           = std::numeric_limits<float>::min();
         auto most_loaded_hostap_clients      = database.get_node_children(most_loaded_hostap);
 
+        // Read the clients metrics straight from the station metrics columns
+        auto &metrics = database.get_station_metrics();
+        auto &stats   = metrics.columns();
+
         for (auto client : most_loaded_hostap_clients) {
-            int client_tx_bytes           = database.get_node_tx_bytes(client);
-            int client_rx_bytes           = database.get_node_rx_bytes(client);
-            int client_airtime_percentage = database.get_node_tx_load_percent(client) +
-                                            database.get_node_rx_load_percent(client);
+            int idx = database.get_node_metrics_index(client);
+            if (!metrics.is_valid(idx)) {
+                TASK_LOG(DEBUG) << "no metrics for client " << client;
+                continue;
+            }
+            int client_tx_bytes = stats.tx_bytes[idx];
+            int client_rx_bytes = stats.rx_bytes[idx];
+            int client_airtime_percentage =
+                stats.tx_load_percent[idx] + stats.rx_load_percent[idx];
             //int client_bytes_percentage = 100 * ((client_tx_bytes / ap_rx_bytes) + (client_rx_bytes / ap_tx_bytes));
 
             int client_bytes_percentage = 0;
@@ -169,10 +178,10 @@ void load_balancer_task::work()
             float client_efficiency_ratio = 0;
             if (client_airtime_percentage > 0) {
                 //client_efficiency_ratio = (float)client_bytes_percentage / (float)client_airtime_percentage;
-                double client_tx_bitrate          = database.get_node_tx_bitrate(client);
-                double client_rx_bitrate          = database.get_node_rx_bitrate(client);
-                uint16_t client_rx_phy_rate_100kb = database.get_load_rx_phy_rate_100kb(client);
-                uint16_t client_tx_phy_rate_100kb = database.get_load_tx_phy_rate_100kb(client);
+                double client_tx_bitrate          = metrics.get_tx_bitrate(idx);
+                double client_rx_bitrate          = metrics.get_rx_bitrate(idx);
+                uint16_t client_rx_phy_rate_100kb = stats.rx_phy_rate_100kb[idx];
+                uint16_t client_tx_phy_rate_100kb = stats.tx_phy_rate_100kb[idx];
 
                 if (client_tx_bitrate > 0) {
                     client_efficiency_ratio +=
@@ -9,9 +9,10 @@
 #include "optimal_path_task.h"
 #include "../db/db_algo.h"
 #include "../son_actions.h"
+#include "rssi_measurement_batch_task.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/son/son_wireless_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 
@@ -22,6 +23,7 @@ using namespace son;
 #define MAX_REQUEST_CYCLES 2
 #define RX_RSSI_MEASUREMENT_REQUEST_TIMEOUT_MSEC 3000
 #define BEACON_MEASUREMENT_REQUEST_TIMEOUT_MSEC 6000
+#define CANDIDATES_ESTIMATION_TIMEOUT_MSEC 1000
 #define DELAY_COUNT_LIMIT 2
 #define DELTA_BURST_LIMIT 20
 #define DEC_WINDOW_LIMIT 20
@@ -745,30 +747,29 @@ void optimal_path_task::work()
         }
 
         // send req to sta hostap //
-        auto agent_mac = database.get_node_parent_ire(current_hostap);
-        auto request   = message_com::create_vs_message<
-            beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(cmdu_tx, id);
-        if (request == nullptr) {
-            LOG(ERROR)
-                << "Failed building ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST message!";
-            return;
-        }
-
-        request->params().mac  = network_utils::mac_from_string(sta_mac);
-        request->params().ipv4 = network_utils::ipv4_from_string(database.get_node_ipv4(sta_mac));
-        request->params().channel   = database.get_node_channel(current_hostap);
-        request->params().bandwidth = database.get_node_bw(current_hostap);
-        request->params().cross     = hostaps.empty() ? 0 : 1;
-        request->params().mon_ping_burst_pkt_num =
+        rssi_measurement_batch_task::rssi_measurement_request_event request;
+        request.agent_mac   = database.get_node_parent_ire(current_hostap);
+        request.radio_mac   = current_hostap;
+        request.task_id     = id;
+        request.params      = {};
+        request.params.mac  = network_utils::mac_from_string(sta_mac);
+        request.params.ipv4 = network_utils::ipv4_from_string(database.get_node_ipv4(sta_mac));
+        request.params.channel   = database.get_node_channel(current_hostap);
+        request.params.bandwidth = database.get_node_bw(current_hostap);
+        request.params.cross     = hostaps.empty() ? 0 : 1;
+        request.params.mon_ping_burst_pkt_num =
             database.get_measurement_window_size(current_hostap);
-        request->params().measurement_delay = database.get_measurement_delay(current_hostap);
+        request.params.measurement_delay = database.get_measurement_delay(current_hostap);
         //set ap associated ire timestamp
         database.set_measurement_sent_timestamp(current_hostap);
 
-        son_actions::send_cmdu_to_agent(agent_mac, cmdu_tx, database, current_hostap);
+        if (!rssi_measurement_batch_task::send_request(database, cmdu_tx, tasks, request)) {
+            LOG(ERROR) << "Failed sending rx rssi measurement request to " << current_hostap;
+            return;
+        }
         add_pending_mac(current_hostap,
                         beerocks_message::ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE);
-        if (request->params().cross) {
+        if (request.params.cross) {
             add_pending_mac(
                 current_hostap,
                 beerocks_message::ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_START_NOTIFICATION);
@@ -884,26 +885,14 @@ void optimal_path_task::work()
             }
         }
 
-        //calculate tx phy rate and find best_weighted_phy_rate
-        int roaming_hysteresis_percent_bonus = database.config.roaming_hysteresis_percent_bonus;
+        //snapshot the estimation inputs of the candidates, the estimation itself is offloaded
         son::wireless_utils::sPhyApParams hostap_params;
-        son::wireless_utils::sPhyUlParams current_ul_params;
         const beerocks::message::sRadioCapabilities *sta_capabilities;
         beerocks::message::sRadioCapabilities default_sta_cap;
-        int ul_rssi           = beerocks::RSSI_INVALID;
-        int estimated_ul_rssi = beerocks::RSSI_INVALID;
-        int estimated_dl_rssi = beerocks::RSSI_INVALID;
-        double hostap_phy_rate;
-        double best_weighted_phy_rate              = 0;
-        double best_weighted_phy_rate_below_cutoff = 0;
-        int best_ul_rssi_5g                        = beerocks::RSSI_MIN;
-        int best_ul_rssi_2g                        = beerocks::RSSI_MIN;
-        std::string best_ul_rssi_hostap_5g;
-        std::string best_ul_rssi_hostap_2g;
-        int best_ul_rssi              = beerocks::RSSI_INVALID;
-        bool current_hostap_is_5ghz   = database.is_node_5ghz(current_hostap);
-        bool all_hostaps_below_cutoff = true;
-        std::string chosen_hostap_below_cutoff;
+        int ul_rssi                 = beerocks::RSSI_INVALID;
+        int estimated_ul_rssi       = beerocks::RSSI_INVALID;
+        bool current_hostap_is_5ghz = database.is_node_5ghz(current_hostap);
+        std::vector<sCandidateEstimation> candidates;
         sticky_roaming_rssi = 0;
 
         // hostap's in this list are in order, current_hostap is first
@@ -912,7 +901,6 @@ void optimal_path_task::work()
             auto hostap_sibling = it.second;
 
             int hostap_channel    = database.get_node_channel(hostap);
-            auto skip_estimation  = false; // initialise for each HostAP candidate
             hostap_params.is_5ghz = database.is_node_5ghz(hostap);
 
             if ((hostap_params.is_5ghz && !database.get_node_5ghz_support(sta_mac)) ||
@@ -962,18 +950,8 @@ void optimal_path_task::work()
 
                 ul_rssi = rx_rssi;
 
-                // calc ul rssi for current ap
                 if (hostap == current_hostap) {
                     sticky_roaming_rssi = rx_rssi;
-                    current_ul_params   = son::wireless_utils::estimate_ul_params(
-                        ul_rssi, sta_phy_tx_rate_100kb, sta_capabilities, hostap_params.bw,
-                        hostap_params.is_5ghz);
-
-                    skip_estimation = true; // indicate estimation is done and can be skipped later
-
-                    TASK_LOG(DEBUG)
-                        << "hostap_candidate: estimated ul_tx_power=" << current_ul_params.tx_power
-                        << " ul_rssi=" << int(current_ul_params.rssi);
                 } else if (database.config.roaming_unconnected_client_rssi_compensation_db != 0) {
                     // add compensation for an AP who is not on the same IRE as the client
                     ul_rssi += database.config.roaming_unconnected_client_rssi_compensation_db;
@@ -998,11 +976,64 @@ void optimal_path_task::work()
                 estimated_ul_rssi = ul_rssi;
             }
 
-            // 1. Estimate UL parameters if not yet done
-            if (!skip_estimation) {
-                current_ul_params = son::wireless_utils::estimate_ul_params(
-                    ul_rssi, sta_phy_tx_rate_100kb, sta_capabilities, hostap_params.bw,
-                    hostap_params.is_5ghz);
+            sCandidateEstimation candidate;
+            candidate.hostap                = hostap;
+            candidate.hostap_channel        = hostap_channel;
+            candidate.ul_rssi               = ul_rssi;
+            candidate.estimated_ul_rssi     = estimated_ul_rssi;
+            candidate.sta_phy_tx_rate_100kb = sta_phy_tx_rate_100kb;
+            candidate.sta_capabilities      = *sta_capabilities;
+            candidate.hostap_params         = hostap_params;
+            candidates.push_back(candidate);
+        }
+
+        // The estimation only uses the snapshot, so it can run on a worker thread
+        candidate_estimations.clear();
+        wait_for_event(CANDIDATES_ESTIMATED);
+        set_events_timeout(CANDIDATES_ESTIMATION_TIMEOUT_MSEC);
+        tasks.offload_job(id, CANDIDATES_ESTIMATED,
+                          [candidates]() { return estimate_candidates(candidates); });
+        state = PICK_HOSTAP_CROSS;
+        break;
+    }
+    case PICK_HOSTAP_CROSS: {
+        if (!assert_original_parent()) {
+            TASK_LOG(INFO) << sta_mac << " no longer connected to " << current_hostap_vap
+                           << " aborting task";
+            finish();
+            return;
+        }
+
+        //calculate tx phy rate and find best_weighted_phy_rate
+        int roaming_hysteresis_percent_bonus = database.config.roaming_hysteresis_percent_bonus;
+        int ul_rssi                          = beerocks::RSSI_INVALID;
+        int estimated_ul_rssi                = beerocks::RSSI_INVALID;
+        int estimated_dl_rssi                = beerocks::RSSI_INVALID;
+        double hostap_phy_rate;
+        double best_weighted_phy_rate              = 0;
+        double best_weighted_phy_rate_below_cutoff = 0;
+        int best_ul_rssi_5g                        = beerocks::RSSI_MIN;
+        int best_ul_rssi_2g                        = beerocks::RSSI_MIN;
+        std::string best_ul_rssi_hostap_5g;
+        std::string best_ul_rssi_hostap_2g;
+        int best_ul_rssi              = beerocks::RSSI_INVALID;
+        bool current_hostap_is_5ghz   = database.is_node_5ghz(current_hostap);
+        bool all_hostaps_below_cutoff = true;
+        std::string chosen_hostap_below_cutoff;
+
+        // hostap's in this list are in order, current_hostap is first
+        for (const auto &candidate : candidate_estimations) {
+            const auto &hostap            = candidate.hostap;
+            const auto &hostap_params     = candidate.hostap_params;
+            const auto &current_ul_params = candidate.ul_params;
+            int hostap_channel            = candidate.hostap_channel;
+            ul_rssi                       = candidate.ul_rssi;
+            estimated_ul_rssi             = candidate.estimated_ul_rssi;
+
+            if (hostap == current_hostap) {
+                TASK_LOG(DEBUG) << "hostap_candidate: estimated ul_tx_power="
+                                << current_ul_params.tx_power
+                                << " ul_rssi=" << int(current_ul_params.rssi);
             }
 
             // Check if estimated UL phyrate is below table range and switch to
@@ -1012,13 +1043,9 @@ void optimal_path_task::work()
 
                 TASK_LOG(DEBUG) << "Stay with phyrate-estimation method";
 
-                // 2. Estimate DL RSSI
-                estimated_dl_rssi = son::wireless_utils::estimate_dl_rssi(
-                    estimated_ul_rssi, current_ul_params.tx_power, hostap_params);
-
-                // 3. Estimate AP TX PHY RATE
-                hostap_phy_rate = son::wireless_utils::estimate_ap_tx_phy_rate(
-                    estimated_dl_rssi, sta_capabilities, hostap_params.bw, hostap_params.is_5ghz);
+                // 2. Estimated DL RSSI and 3. AP TX PHY RATE
+                estimated_dl_rssi = candidate.estimated_dl_rssi;
+                hostap_phy_rate   = candidate.hostap_phy_rate;
 
                 database.set_node_cross_estimated_tx_phy_rate(sta_mac, hostap_phy_rate);
 
@@ -1214,6 +1241,62 @@ void optimal_path_task::work()
     }
 }
 
+void optimal_path_task::handle_event(int event_type, void *obj)
+{
+    if (event_type == CANDIDATES_ESTIMATED) {
+        if (!obj) {
+            TASK_LOG(ERROR) << "candidates estimation result is missing";
+            return;
+        }
+        candidate_estimations = *static_cast<std::vector<sCandidateEstimation> *>(obj);
+
+        // The estimation does not log on the worker thread
+        for (const auto &candidate : candidate_estimations) {
+            TASK_LOG(DEBUG) << "hostap " << candidate.hostap
+                            << " estimation status=" << int(candidate.ul_params.status)
+                            << " ul_tx_power=" << candidate.ul_params.tx_power
+                            << " dl_rssi=" << candidate.estimated_dl_rssi
+                            << " phy_rate=" << int(candidate.hostap_phy_rate / 1e+6) << " Mbps";
+        }
+    }
+}
+
+void optimal_path_task::handle_events_timeout(std::multiset<int> pending_events)
+{
+    for (auto event : pending_events) {
+        if (event == CANDIDATES_ESTIMATED) {
+            TASK_LOG(ERROR) << "candidates estimation for sta " << sta_mac
+                            << " timed out, aborting task";
+            finish();
+        }
+    }
+}
+
+std::shared_ptr<void>
+optimal_path_task::estimate_candidates(std::vector<sCandidateEstimation> candidates)
+{
+    for (auto &candidate : candidates) {
+        // 1. Estimate UL parameters
+        candidate.ul_params = son::wireless_utils::estimate_ul_params(
+            candidate.ul_rssi, candidate.sta_phy_tx_rate_100kb, &candidate.sta_capabilities,
+            candidate.hostap_params.bw, candidate.hostap_params.is_5ghz, false);
+        if (candidate.ul_params.status != son::wireless_utils::ESTIMATION_SUCCESS) {
+            continue;
+        }
+
+        // 2. Estimate DL RSSI
+        candidate.estimated_dl_rssi = son::wireless_utils::estimate_dl_rssi(
+            candidate.estimated_ul_rssi, candidate.ul_params.tx_power, candidate.hostap_params,
+            false);
+
+        // 3. Estimate AP TX PHY RATE
+        candidate.hostap_phy_rate = son::wireless_utils::estimate_ap_tx_phy_rate(
+            candidate.estimated_dl_rssi, &candidate.sta_capabilities, candidate.hostap_params.bw,
+            candidate.hostap_params.is_5ghz, false);
+    }
+    return std::make_shared<std::vector<sCandidateEstimation>>(std::move(candidates));
+}
+
 bool optimal_path_task::check_if_sta_can_steer_to_ap(std::string ap_mac)
 {
     bool hostap_is_5ghz = database.is_node_5ghz(ap_mac);
@@ -1243,27 +1326,31 @@ void optimal_path_task::send_rssi_measurement_request(const std::string &agent_m
                                                       std::string hostap, int id)
 {
     auto hostap_mac = database.get_node_parent(client_mac);
-    auto request    = message_com::create_vs_message<
-        beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(cmdu_tx, id);
-    if (request == nullptr) {
-        LOG(ERROR) << "Failed building ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST message!";
-        return;
-    }
-    database.get_node_parent_backhaul(hostap);
-    request->params().mac                    = network_utils::mac_from_string(client_mac);
-    request->params().ipv4                   = network_utils::ipv4_from_string("0.0.0.0");
-    request->params().cross                  = 1;
-    request->params().channel                = channel;
-    request->params().bandwidth              = database.get_node_bw(hostap_mac);
-    request->params().mon_ping_burst_pkt_num = database.get_measurement_window_size(current_hostap);
-    request->params().vht_center_frequency   = database.get_hostap_vht_center_frequency(hostap_mac);
-    TASK_LOG(DEBUG) << "vht_center_frequency = " << int(request->params().vht_center_frequency);
+
+    rssi_measurement_batch_task::rssi_measurement_request_event request;
+    request.agent_mac                     = agent_mac;
+    request.radio_mac                     = hostap;
+    request.task_id                       = id;
+    request.params                        = {};
+    request.params.mac                    = network_utils::mac_from_string(client_mac);
+    request.params.ipv4                   = network_utils::ipv4_from_string("0.0.0.0");
+    request.params.cross                  = 1;
+    request.params.channel                = channel;
+    request.params.bandwidth              = database.get_node_bw(hostap_mac);
+    request.params.mon_ping_burst_pkt_num = database.get_measurement_window_size(current_hostap);
+    request.params.vht_center_frequency   = database.get_hostap_vht_center_frequency(hostap_mac);
+    TASK_LOG(DEBUG) << "vht_center_frequency = " << int(request.params.vht_center_frequency);
     //taking measurement request time stamp
     database.set_measurement_sent_timestamp(hostap);
     //sending delay parameter to measurement request
-    request->params().measurement_delay = database.get_measurement_delay(hostap);
+    request.params.measurement_delay = database.get_measurement_delay(hostap);
 
-    son_actions::send_cmdu_to_agent(agent_mac, cmdu_tx, database, hostap);
+    // Requests of all the optimal path tasks are batched per radio, which matters when
+    // many clients are evaluated at once (e.g. after a channel switch)
+    if (!rssi_measurement_batch_task::send_request(database, cmdu_tx, tasks, request)) {
+        LOG(ERROR) << "Failed sending cross rx rssi measurement request to " << hostap;
+        return;
+    }
 
     add_pending_mac(hostap, beerocks_message::ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_RESPONSE);
     TASK_LOG(DEBUG) << "sending cross rx_rssi measurement request to " << hostap
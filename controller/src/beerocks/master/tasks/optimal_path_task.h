@@ -13,6 +13,8 @@
 #include "task.h"
 #include "task_pool.h"
 
+#include <bcl/son/son_wireless_utils.h>
+
 #define MEAS_MAX_DELAY_ALLOWED 10
 
 namespace son {
@@ -32,6 +34,8 @@ public:
 
 protected:
     virtual void work() override;
+    virtual void handle_event(int event_type, void *obj) override;
+    virtual void handle_events_timeout(std::multiset<int> pending_events) override;
     virtual void
     handle_response(std::string slave_mac,
                     std::shared_ptr<beerocks::beerocks_header> beerocks_header) override;
@@ -40,6 +44,27 @@ protected:
         override;
 
 private:
+    enum eEvent {
+        CANDIDATES_ESTIMATED = 0,
+    };
+
+    // Snapshot of the inputs and the results of the estimation of a hostap candidate
+    typedef struct {
+        std::string hostap;
+        int hostap_channel;
+        int ul_rssi;
+        int estimated_ul_rssi;
+        uint16_t sta_phy_tx_rate_100kb;
+        beerocks::message::sRadioCapabilities sta_capabilities;
+        son::wireless_utils::sPhyApParams hostap_params;
+        son::wireless_utils::sPhyUlParams ul_params = {};
+        int estimated_dl_rssi                       = beerocks::RSSI_INVALID;
+        double hostap_phy_rate                      = 0;
+    } sCandidateEstimation;
+
+    // Runs on a task worker thread, must only use its arguments
+    static std::shared_ptr<void> estimate_candidates(std::vector<sCandidateEstimation> candidates);
+
     bool check_if_sta_can_steer_to_ap(std::string ap);
     void send_rssi_measurement_request(const std::string &agent_mac, std::string client_mac,
                                        int channel, std::string hostap, int id);
@@ -87,6 +112,7 @@ private:
         FILL_POTENTIAL_AP_LIST_CROSS,
         REQUEST_CROSS_RSSI_MEASUREMENTS,
         FIND_AND_PICK_HOSTAP_CROSS,
+        PICK_HOSTAP_CROSS,
         SEND_STEER_ACTION,
         WAIT_FOR_HANDOVER,
     };
@@ -111,6 +137,7 @@ private:
     //CROSS
     std::set<std::string> hostaps;
     int calculate_measurement_delay_count = 0;
+    std::vector<sCandidateEstimation> candidate_estimations;
 };
 
 } // namespace son
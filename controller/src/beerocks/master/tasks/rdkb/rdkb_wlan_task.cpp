@@ -11,8 +11,8 @@
 #include "../../son_actions.h"
 #include "rdkb/bml_rdkb_defs.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/network/network_utils.h>
-#include <easylogging++.h>
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_bml.h>
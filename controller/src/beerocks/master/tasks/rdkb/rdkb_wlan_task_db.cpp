@@ -8,7 +8,7 @@
 
 #include "rdkb_wlan_task_db.h"
 #include <algorithm>
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 using namespace beerocks;
 using namespace son;
@@ -0,0 +1,146 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "response_tracker.h"
+
+using namespace beerocks;
+using namespace son;
+
+response_tracker::response_tracker()
+    : m_rtt("beerocks_task_response_rtt_seconds",
+            "Round trip time of the requests of the tasks, by agent"),
+      m_outstanding(metrics::registry::instance().get_gauge(
+          "beerocks_task_responses_pending", "Number of requests waiting for a response"))
+{
+}
+
+void response_tracker::add_request(int task_id, const std::string &agent_mac,
+                                   beerocks_message::eActionOp_CONTROL action_op)
+{
+    m_requests[{agent_mac, action_op, task_id}].push_back(std::chrono::steady_clock::now());
+    m_task_requests[task_id].insert({agent_mac, action_op});
+    m_outstanding.add(1);
+}
+
+bool response_tracker::response_received(int task_id, const std::string &agent_mac,
+                                         beerocks_message::eActionOp_CONTROL action_op)
+{
+    auto it = m_requests.find({agent_mac, action_op, task_id});
+    if (it == m_requests.end()) {
+        return false;
+    }
+
+    // Responses are matched to the oldest identical request
+    auto rtt = std::chrono::steady_clock::now() - it->second.front();
+    m_rtt.get(agent_mac, [&]() { return metrics::labels_t{{"agent", agent_mac}}; })
+        .observe(std::chrono::duration_cast<std::chrono::microseconds>(rtt).count());
+    it->second.erase(it->second.begin());
+    if (it->second.empty()) {
+        m_requests.erase(it);
+    }
+
+    erase_task_request(task_id, agent_mac, action_op);
+    return true;
+}
+
+void response_tracker::set_deadline(int task_id, std::chrono::steady_clock::time_point deadline)
+{
+    cancel_deadline(task_id);
+    m_task_deadlines[task_id] = m_deadline_queue.insert({deadline, task_id});
+}
+
+void response_tracker::cancel_deadline(int task_id)
+{
+    auto it = m_task_deadlines.find(task_id);
+    if (it == m_task_deadlines.end()) {
+        return;
+    }
+    m_deadline_queue.erase(it->second);
+    m_task_deadlines.erase(it);
+}
+
+size_t response_tracker::pending_count(int task_id) const
+{
+    auto it = m_task_requests.find(task_id);
+    if (it == m_task_requests.end()) {
+        return 0;
+    }
+    return it->second.size();
+}
+
+void response_tracker::clear_requests(int task_id)
+{
+    auto it = m_task_requests.find(task_id);
+    if (it == m_task_requests.end()) {
+        return;
+    }
+    for (const auto &request : it->second) {
+        m_requests.erase({request.first, request.second, task_id});
+    }
+    m_outstanding.add(-int64_t(it->second.size()));
+    m_task_requests.erase(it);
+}
+
+void response_tracker::remove_task(int task_id)
+{
+    clear_requests(task_id);
+    cancel_deadline(task_id);
+}
+
+std::map<int, response_tracker::pending_requests_t>
+response_tracker::pop_expired(std::chrono::steady_clock::time_point now)
+{
+    std::map<int, pending_requests_t> expired;
+    while (!m_deadline_queue.empty() && m_deadline_queue.begin()->first <= now) {
+        int task_id = m_deadline_queue.begin()->second;
+        m_deadline_queue.erase(m_deadline_queue.begin());
+        m_task_deadlines.erase(task_id);
+
+        auto &timed_out = expired[task_id];
+        auto it         = m_task_requests.find(task_id);
+        if (it == m_task_requests.end()) {
+            continue;
+        }
+        for (const auto &request : it->second) {
+            auto &timeouts = m_timeouts[request.first];
+            if (!timeouts) {
+                timeouts = &metrics::registry::instance().get_counter(
+                    "beerocks_task_response_timeouts_total",
+                    "Requests of the tasks which were not answered in time, by agent",
+                    {{"agent", request.first}});
+            }
+            timeouts->inc();
+            m_requests.erase({request.first, request.second, task_id});
+        }
+        m_outstanding.add(-int64_t(it->second.size()));
+        timed_out = std::move(it->second);
+        m_task_requests.erase(it);
+    }
+    return expired;
+}
+
+void response_tracker::erase_task_request(int task_id, const std::string &agent_mac,
+                                          beerocks_message::eActionOp_CONTROL action_op)
+{
+    auto it = m_task_requests.find(task_id);
+    if (it == m_task_requests.end()) {
+        return;
+    }
+
+    auto range = it->second.equal_range(agent_mac);
+    for (auto request = range.first; request != range.second; ++request) {
+        if (request->second == action_op) {
+            it->second.erase(request);
+            m_outstanding.add(-1);
+            break;
+        }
+    }
+    if (it->second.empty()) {
+        m_task_requests.erase(it);
+    }
+}
@@ -0,0 +1,111 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _RESPONSE_TRACKER_H_
+#define _RESPONSE_TRACKER_H_
+
+#include <bcl/beerocks_metrics.h>
+#include <beerocks/tlvf/beerocks_message_action.h>
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace son {
+
+/**
+ * Central table of the requests sent by the tasks for which a response is expected.
+ * Requests are keyed by (agent mac, action op, task id), the task id being the message id
+ * carried in the beerocks header of the response.
+ * Response deadlines are kept per task in an ordered queue so that expired requests can be
+ * delivered to the tasks in batches. The round trip times and the timeouts of the requests
+ * are exported per agent in the metrics registry, with the number of outstanding requests.
+ */
+class response_tracker {
+
+public:
+    typedef std::unordered_multimap<std::string, beerocks_message::eActionOp_CONTROL>
+        pending_requests_t;
+
+    response_tracker();
+    ~response_tracker() {}
+
+    void add_request(int task_id, const std::string &agent_mac,
+                     beerocks_message::eActionOp_CONTROL action_op);
+
+    /**
+     * @brief Match a received response against the pending requests.
+     *
+     * @return true if a pending request was matched and removed, false otherwise.
+     */
+    bool response_received(int task_id, const std::string &agent_mac,
+                           beerocks_message::eActionOp_CONTROL action_op);
+
+    void set_deadline(int task_id, std::chrono::steady_clock::time_point deadline);
+    void cancel_deadline(int task_id);
+    size_t pending_count(int task_id) const;
+    void clear_requests(int task_id);
+    void remove_task(int task_id);
+
+    /**
+     * @brief Remove all the tasks whose deadline expired from the deadline queue.
+     *
+     * The unanswered requests of these tasks are removed from the table.
+     *
+     * @param now Current time.
+     * @return Map of task id to the requests of that task which timed out.
+     */
+    std::map<int, pending_requests_t> pop_expired(std::chrono::steady_clock::time_point now);
+
+private:
+    struct sRequestKey {
+        std::string agent_mac;
+        beerocks_message::eActionOp_CONTROL action_op;
+        int task_id;
+
+        bool operator==(const sRequestKey &other) const
+        {
+            return task_id == other.task_id && action_op == other.action_op &&
+                   agent_mac == other.agent_mac;
+        }
+    };
+
+    struct sRequestKeyHash {
+        size_t operator()(const sRequestKey &key) const
+        {
+            return std::hash<std::string>()(key.agent_mac) ^
+                   (std::hash<int>()(key.task_id) << 1) ^ (size_t(key.action_op) << 16);
+        }
+    };
+
+    void erase_task_request(int task_id, const std::string &agent_mac,
+                            beerocks_message::eActionOp_CONTROL action_op);
+
+    // Send times of the pending requests, identical requests may be pending more than once
+    std::unordered_map<sRequestKey, std::vector<std::chrono::steady_clock::time_point>,
+                       sRequestKeyHash>
+        m_requests;
+
+    // Pending requests per task, in the form handed to task::handle_responses_timeout()
+    std::unordered_map<int, pending_requests_t> m_task_requests;
+
+    std::multimap<std::chrono::steady_clock::time_point, int> m_deadline_queue;
+    std::unordered_map<int, std::multimap<std::chrono::steady_clock::time_point, int>::iterator>
+        m_task_deadlines;
+
+    // Round trip time and timeouts by agent mac, and total outstanding requests
+    beerocks::metrics::histogram_map<std::string> m_rtt;
+    std::unordered_map<std::string, beerocks::metrics::counter *> m_timeouts;
+    beerocks::metrics::gauge &m_outstanding;
+};
+
+} // namespace son
+
+#endif
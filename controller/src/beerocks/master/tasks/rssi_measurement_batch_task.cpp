@@ -0,0 +1,164 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "rssi_measurement_batch_task.h"
+#include "../son_actions.h"
+
+#include <bcl/beerocks_log.h>
+#include <bcl/network/network_utils.h>
+
+#include <beerocks/tlvf/beerocks_message.h>
+
+using namespace beerocks;
+using namespace net;
+using namespace son;
+
+#define MAX_REQUESTS_PER_BATCH 32
+
+rssi_measurement_batch_task::rssi_measurement_batch_task(db &database_,
+                                                         ieee1905_1::CmduMessageTx &cmdu_tx_,
+                                                         task_pool &tasks_)
+    : task("rssi measurement batch task"), database(database_), cmdu_tx(cmdu_tx_), tasks(tasks_)
+{
+}
+
+bool rssi_measurement_batch_task::send_request(db &database, ieee1905_1::CmduMessageTx &cmdu_tx,
+                                               task_pool &tasks,
+                                               rssi_measurement_request_event request)
+{
+    int batch_task_id = database.get_rssi_measurement_batch_task_id();
+    if (tasks.is_task_running(batch_task_id)) {
+        tasks.push_event(batch_task_id, RSSI_MEASUREMENT_REQUEST, &request);
+        tasks.execute_at_end_of_run(batch_task_id);
+        return true;
+    }
+
+    beerocks_message::sNodeRssiMeasurementBatchEntry entry;
+    entry.request_id = request.task_id;
+    entry.params     = request.params;
+    return send_single_request(database, cmdu_tx, request.agent_mac, request.radio_mac, entry);
+}
+
+void rssi_measurement_batch_task::work()
+{
+    switch (state) {
+    case START: {
+        int prev_task_id = database.get_rssi_measurement_batch_task_id();
+        tasks.kill_task(prev_task_id);
+        database.assign_rssi_measurement_batch_task_id(id);
+
+        state = FLUSH;
+        wait_for_event(RSSI_MEASUREMENT_REQUEST);
+        break;
+    }
+    case FLUSH: {
+        flush_batches();
+        wait_for_event(RSSI_MEASUREMENT_REQUEST);
+        break;
+    }
+    }
+}
+
+void rssi_measurement_batch_task::handle_event(int event_type, void *obj)
+{
+    switch (event_type) {
+    case RSSI_MEASUREMENT_REQUEST: {
+        if (!obj) {
+            TASK_LOG(ERROR) << "rssi measurement request event without a request";
+            break;
+        }
+        auto event_obj = (rssi_measurement_request_event *)obj;
+
+        beerocks_message::sNodeRssiMeasurementBatchEntry entry;
+        entry.request_id = event_obj->task_id;
+        entry.params     = event_obj->params;
+        pending_batches[std::make_pair(event_obj->agent_mac, event_obj->radio_mac)].push_back(
+            entry);
+        break;
+    }
+    default: {
+        TASK_LOG(ERROR) << "unknown event " << event_type;
+        break;
+    }
+    }
+}
+
+void rssi_measurement_batch_task::flush_batches()
+{
+    for (auto &batch : pending_batches) {
+        auto &agent_mac = batch.first.first;
+        auto &radio_mac = batch.first.second;
+        auto &entries   = batch.second;
+
+        // A single request is sent as is, agents handle it the same way.
+        // Agents that predate the batch request ignore it, they get one request per client.
+        if (entries.size() == 1 ||
+            !database.is_hostap_slave_feature_supported(
+                radio_mac, beerocks::SLAVE_FEATURE_RSSI_MEASUREMENT_BATCH)) {
+            for (const auto &entry : entries) {
+                send_single_request(database, cmdu_tx, agent_mac, radio_mac, entry);
+            }
+            continue;
+        }
+
+        for (size_t offset = 0; offset < entries.size(); offset += MAX_REQUESTS_PER_BATCH) {
+            auto last = std::min(entries.size(), offset + MAX_REQUESTS_PER_BATCH);
+            std::vector<beerocks_message::sNodeRssiMeasurementBatchEntry> chunk(
+                entries.begin() + offset, entries.begin() + last);
+            send_batch(agent_mac, radio_mac, chunk);
+        }
+    }
+    pending_batches.clear();
+}
+
+bool rssi_measurement_batch_task::send_batch(
+    const std::string &agent_mac, const std::string &radio_mac,
+    const std::vector<beerocks_message::sNodeRssiMeasurementBatchEntry> &entries)
+{
+    auto request = message_com::create_vs_message<
+        beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST>(cmdu_tx, id);
+    if (request == nullptr) {
+        LOG(ERROR)
+            << "Failed building ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_BATCH_REQUEST message!";
+        return false;
+    }
+
+    if (!request->alloc_requests(entries.size())) {
+        LOG(ERROR) << "Failed allocating " << entries.size() << " rx rssi measurement requests";
+        return false;
+    }
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        auto entry = request->requests(i);
+        if (!std::get<0>(entry)) {
+            LOG(ERROR) << "Failed to get rx rssi measurement request entry " << i;
+            return false;
+        }
+        std::get<1>(entry) = entries[i];
+    }
+
+    TASK_LOG(DEBUG) << "sending " << entries.size() << " rx rssi measurement requests to "
+                    << radio_mac;
+    return son_actions::send_cmdu_to_agent(agent_mac, cmdu_tx, database, radio_mac);
+}
+
+bool rssi_measurement_batch_task::send_single_request(
+    db &database, ieee1905_1::CmduMessageTx &cmdu_tx, const std::string &agent_mac,
+    const std::string &radio_mac, const beerocks_message::sNodeRssiMeasurementBatchEntry &entry)
+{
+    auto request = message_com::create_vs_message<
+        beerocks_message::cACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST>(cmdu_tx,
+                                                                              entry.request_id);
+    if (request == nullptr) {
+        LOG(ERROR) << "Failed building ACTION_CONTROL_CLIENT_RX_RSSI_MEASUREMENT_REQUEST message!";
+        return false;
+    }
+
+    request->params() = entry.params;
+    return son_actions::send_cmdu_to_agent(agent_mac, cmdu_tx, database, radio_mac);
+}
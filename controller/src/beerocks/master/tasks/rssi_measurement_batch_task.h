@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _RSSI_MEASUREMENT_BATCH_TASK_H_
+#define _RSSI_MEASUREMENT_BATCH_TASK_H_
+
+#include "../db/db.h"
+#include "task.h"
+#include "task_pool.h"
+
+#include <beerocks/tlvf/beerocks_message_common.h>
+
+#include <map>
+#include <vector>
+
+namespace son {
+
+/**
+ * Collects the client rx rssi measurement requests issued by other tasks and sends them
+ * to the agents as one batch request per radio, instead of one message per request.
+ * Requests queued during a task pool run are sent at the end of it, the batch task is
+ * executed after all the ready tasks of the run.
+ * Radios of agents that do not advertise SLAVE_FEATURE_RSSI_MEASUREMENT_BATCH get one
+ * request per client instead.
+ */
+class rssi_measurement_batch_task : public task {
+public:
+    struct rssi_measurement_request_event {
+        std::string agent_mac;
+        std::string radio_mac;
+        int task_id; // the measurement responses are sent to this task
+        beerocks_message::sNodeRssiMeasurementRequest params;
+    };
+
+    enum events {
+        RSSI_MEASUREMENT_REQUEST,
+    };
+
+    rssi_measurement_batch_task(db &database_, ieee1905_1::CmduMessageTx &cmdu_tx_,
+                                task_pool &tasks_);
+    virtual ~rssi_measurement_batch_task() {}
+
+    /**
+     * @brief Queue a client rx rssi measurement request on the batch task.
+     *
+     * The request is sent right away when the batch task is not running.
+     *
+     * @param request Request to send.
+     * @return true on success, false otherwise.
+     */
+    static bool send_request(db &database, ieee1905_1::CmduMessageTx &cmdu_tx, task_pool &tasks,
+                             rssi_measurement_request_event request);
+
+protected:
+    virtual void work() override;
+    virtual void handle_event(int event_type, void *obj) override;
+
+private:
+    static bool send_single_request(db &database, ieee1905_1::CmduMessageTx &cmdu_tx,
+                                    const std::string &agent_mac, const std::string &radio_mac,
+                                    const beerocks_message::sNodeRssiMeasurementBatchEntry &entry);
+    bool send_batch(const std::string &agent_mac, const std::string &radio_mac,
+                    const std::vector<beerocks_message::sNodeRssiMeasurementBatchEntry> &entries);
+    void flush_batches();
+
+    enum states {
+        START = 0,
+        FLUSH,
+    };
+    int state = START;
+
+    db &database;
+    ieee1905_1::CmduMessageTx &cmdu_tx;
+    task_pool &tasks;
+
+    // key = (agent mac, radio mac)
+    std::map<std::pair<std::string, std::string>,
+             std::vector<beerocks_message::sNodeRssiMeasurementBatchEntry>>
+        pending_batches;
+};
+
+} // namespace son
+
+#endif
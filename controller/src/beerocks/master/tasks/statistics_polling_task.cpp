@@ -14,7 +14,7 @@
 
 #include <beerocks/tlvf/beerocks_message.h>
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
 
 using namespace beerocks;
 using namespace son;
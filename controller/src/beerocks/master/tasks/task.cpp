@@ -8,8 +8,10 @@
 
 #include "task.h"
 
+#include <bcl/beerocks_log.h>
 #include <bcl/beerocks_utils.h>
-#include <easylogging++.h>
+
+#include <algorithm>
 
 using namespace beerocks;
 using namespace son;
@@ -27,22 +29,21 @@ task::task(std::string task_name_, std::string node_mac)
 void task::response_received(std::string mac,
                              std::shared_ptr<beerocks::beerocks_header> beerocks_header)
 {
-    // removing the responding mac with specific action_op from pending_macs
-    auto range = pending_macs.equal_range(mac);
-    for (auto it = range.first; it != range.second;) {
-        if ((it->second == beerocks_header->action_op()) && (it->first == mac)) {
-            it = pending_macs.erase(it);
-            handle_response(mac, beerocks_header);
-            return;
-        } else {
-            it++;
-        }
-    }
-
-    // Handle the response even if we are not expecting it
+    // The responding mac was already matched against the pending requests by the task pool,
+    // handle the response even if we are not expecting it
     handle_response(mac, beerocks_header);
 }
 
+void task::responses_timed_out(response_tracker::pending_requests_t timed_out_macs)
+{
+    if (!responses_timeout_set) {
+        return;
+    }
+    // TASK_LOG(DEBUG) << "responses timed out";
+    responses_timeout_set = false;
+    handle_responses_timeout(timed_out_macs);
+}
+
 void task::event_received(int event_type, void *obj)
 {
     auto range = pending_events.equal_range(event_type);
@@ -105,7 +106,12 @@ void task::set_task_timeout(int ms)
 
 void task::set_responses_timeout(int ms)
 {
-    responses_timeout     = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    if (!m_response_tracker) {
+        TASK_LOG(ERROR) << "task is not scheduled, can't set responses timeout";
+        return;
+    }
+    m_response_tracker->set_deadline(id, std::chrono::steady_clock::now() +
+                                             std::chrono::milliseconds(ms));
     responses_timeout_set = true;
 }
 
@@ -136,19 +142,16 @@ void task::execute()
             events_timeout_set = false;
             pending_events.clear();
         }
-        if (responses_timeout_set && now >= responses_timeout) {
-            // TASK_LOG(DEBUG) << "responses timed out";
-            handle_responses_timeout(pending_macs);
-            responses_timeout_set = false;
-            pending_macs.clear();
-        }
         if (waiting_for_events && pending_events.empty()) {
             TASK_LOG(DEBUG) << "done waiting for events";
             events_timeout_set = false;
             waiting_for_events = false;
         }
-        if (waiting_for_responses && pending_macs.empty()) {
+        if (waiting_for_responses && !pending_responses_count()) {
             // TASK_LOG(DEBUG) << "done waiting for responses";
+            if (responses_timeout_set) {
+                m_response_tracker->cancel_deadline(id);
+            }
             responses_timeout_set = false;
             waiting_for_responses = false;
         }
@@ -164,6 +167,44 @@ void task::execute()
 
 bool task::is_done() { return done; }
 
+std::chrono::steady_clock::time_point task::next_execution_time() const
+{
+    if (done || !waiting) {
+        return std::chrono::steady_clock::time_point::min();
+    }
+
+    auto next_time = std::chrono::steady_clock::time_point::max();
+    if ((waiting_for_events && pending_events.empty()) ||
+        (waiting_for_responses && !pending_responses_count()) ||
+        (!responses_timeout_set && !waiting_for_events && !waiting_for_responses &&
+         !waiting_for_pending_task)) {
+        // Waiting will end on the next execution
+        next_time = std::chrono::steady_clock::time_point::min();
+    } else {
+        // The responses timeout is tracked by the task pool which wakes the task up
+        if (waiting_for_pending_task) {
+            next_time = std::min(next_time, pending_task_timeout);
+        }
+        if (events_timeout_set && waiting_for_events) {
+            next_time = std::min(next_time, events_timeout);
+        }
+    }
+
+    // Nothing but the task timeout is checked before next_action_time
+    if (next_time != std::chrono::steady_clock::time_point::max()) {
+        next_time = std::max(next_time, next_action_time);
+    }
+    if (task_timeout_set) {
+        next_time = std::min(next_time, task_timeout);
+    }
+    return next_time;
+}
+
+int task::get_pending_task_id() const
+{
+    return waiting_for_pending_task ? pending_task_id : -1;
+}
+
 void task::kill()
 {
     TASK_LOG(DEBUG) << "killed!";
@@ -173,20 +214,30 @@ void task::kill()
 void task::add_pending_macs(std::set<std::string> macs,
                             beerocks_message::eActionOp_CONTROL action_op)
 {
-    for (auto it = macs.begin(); macs.end() != it; ++it) {
-        pending_macs.insert({*it, action_op});
+    for (const auto &mac : macs) {
+        add_pending_mac(mac, action_op);
     }
-
-    //pending_macs.insert(macs.begin(), macs.end());
-    waiting_for_responses = true;
-    waiting               = true;
 }
 
 void task::add_pending_mac(std::string mac, beerocks_message::eActionOp_CONTROL action_op)
 {
-    pending_macs.insert({mac, action_op});
+    if (!m_response_tracker) {
+        TASK_LOG(ERROR) << "task is not scheduled, can't wait for response from " << mac;
+        return;
+    }
+    m_response_tracker->add_request(id, mac, action_op);
     waiting_for_responses = true;
     waiting               = true;
 }
 
-void task::clear_pending_macs() { pending_macs.clear(); }
+void task::clear_pending_macs()
+{
+    if (m_response_tracker) {
+        m_response_tracker->clear_requests(id);
+    }
+}
+
+size_t task::pending_responses_count() const
+{
+    return m_response_tracker ? m_response_tracker->pending_count(id) : 0;
+}
@@ -9,7 +9,9 @@
 #ifndef _TASK_H_
 #define _TASK_H_
 
-#define TASK_LOG(a) (LOG(a) << "task " << task_name << " id " << id << ": ")
+#define TASK_LOG(a) LOG(a) << "task " << task_name << " id " << id << ": "
+
+#include "response_tracker.h"
 
 #include <beerocks/tlvf/beerocks_message.h>
 #include <beerocks/tlvf/beerocks_message_control.h>
@@ -30,11 +32,32 @@ public:
     void execute();
     void response_received(std::string mac,
                            std::shared_ptr<beerocks::beerocks_header> beerocks_header);
+    void responses_timed_out(response_tracker::pending_requests_t timed_out_macs);
     void event_received(int event_type, void *obj = nullptr);
     void pending_task_ended(int task_id);
     bool is_done();
     void kill();
 
+    /**
+     * @brief Get the earliest time at which execute() can make progress.
+     *
+     * Used by the task pool to schedule the task without polling it.
+     * time_point::min() means the task is ready now, time_point::max() means
+     * the task is idle until it receives an event, a response or a pending task ends.
+     *
+     * @return Time point of the next required execution.
+     */
+    std::chrono::steady_clock::time_point next_execution_time() const;
+
+    /**
+     * @brief Get the id of the task this task is waiting to end.
+     *
+     * @return Pending task id, or -1 if not waiting for any task.
+     */
+    int get_pending_task_id() const;
+
+    void set_response_tracker(response_tracker *tracker) { m_response_tracker = tracker; }
+
     std::string task_name;
     const std::string assigned_node;
     const int id;
@@ -45,6 +68,7 @@ protected:
                           beerocks_message::eActionOp_CONTROL action_op);
     void add_pending_mac(std::string mac, beerocks_message::eActionOp_CONTROL action_op);
     void clear_pending_macs();
+    size_t pending_responses_count() const;
     void wait_for(int ms);
     void set_task_timeout(int ms);
     void set_responses_timeout(int ms);
@@ -70,12 +94,12 @@ protected:
 
 private:
     bool done = false;
-    std::unordered_multimap<std::string, beerocks_message::eActionOp_CONTROL> pending_macs;
-    bool waiting               = false;
-    bool responses_timeout_set = false;
-    bool waiting_for_responses = false;
-    std::chrono::steady_clock::time_point responses_timeout;
-    bool task_timeout_set = false;
+    // Pending responses and their timeout are kept by the task pool
+    response_tracker *m_response_tracker = nullptr;
+    bool waiting                         = false;
+    bool responses_timeout_set           = false;
+    bool waiting_for_responses           = false;
+    bool task_timeout_set                = false;
 
     std::chrono::steady_clock::time_point events_timeout;
     std::multiset<int> pending_events;
@@ -8,16 +8,47 @@
 
 #include "task_pool.h"
 
-#include <easylogging++.h>
+#include <bcl/beerocks_log.h>
+
+#include <cstring>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 using namespace beerocks;
 using namespace son;
 
+task_pool::task_pool()
+    : m_run_time(metrics::registry::instance().get_histogram(
+          "beerocks_task_pool_run_seconds", "Time spent running the ready tasks of the task pool")),
+      m_task_execute_time("beerocks_task_execute_seconds",
+                          "Time spent executing a task, by task name"),
+      m_scheduled_tasks(metrics::registry::instance().get_gauge(
+          "beerocks_task_pool_tasks", "Number of tasks in the task pool")),
+      m_pending_jobs(metrics::registry::instance().get_gauge(
+          "beerocks_task_pool_pending_jobs", "Number of offloaded jobs waiting for a worker"))
+{
+}
+
+task_pool::~task_pool()
+{
+    // The workers signal the eventfd, stop them before closing it
+    m_worker_pool.stop();
+    if (m_job_results_fd != -1) {
+        close(m_job_results_fd);
+        m_job_results_fd = -1;
+    }
+}
+
 bool task_pool::add_task(std::shared_ptr<task> new_task)
 {
     LOG(TRACE) << "inserting new task, id=" << int(new_task->id)
                << " task_name=" << new_task->task_name;
-    return (scheduled_tasks.insert(std::make_pair(new_task->id, new_task))).second;
+    if (!(scheduled_tasks.insert(std::make_pair(new_task->id, new_task))).second) {
+        return false;
+    }
+    new_task->set_response_tracker(&m_response_tracker);
+    wake_task(new_task->id);
+    return true;
 }
 
 bool task_pool::is_task_running(int id)
@@ -36,6 +67,7 @@ void task_pool::kill_task(int id)
     if (it != scheduled_tasks.end() && it->second != nullptr) {
         LOG(DEBUG) << "killing task " << it->second->task_name << ", id " << it->first;
         it->second->kill();
+        wake_task(id);
     }
 }
 
@@ -45,6 +77,7 @@ void task_pool::push_event(int task_id, int event_type, void *obj)
     if (it != scheduled_tasks.end()) {
         if (it->second != nullptr) {
             it->second->event_received(event_type, obj);
+            wake_task(task_id);
         } else {
             LOG(ERROR) << "invalid task " << task_id;
         }
@@ -55,9 +88,22 @@ void task_pool::push_event(int task_id, int event_type, void *obj)
 
 void task_pool::pending_task_ended(int task_id)
 {
-    //TODO find a more efficient way for this
-    for (auto t : scheduled_tasks) {
-        t.second->pending_task_ended(task_id);
+    auto waiters = m_task_waiters.find(task_id);
+    if (waiters == m_task_waiters.end()) {
+        return;
+    }
+
+    // Take the waiters out first since a woken task may start waiting again
+    auto waiting_task_ids = std::move(waiters->second);
+    m_task_waiters.erase(waiters);
+
+    for (auto waiting_task_id : waiting_task_ids) {
+        auto it = scheduled_tasks.find(waiting_task_id);
+        if (it == scheduled_tasks.end()) {
+            continue;
+        }
+        it->second->pending_task_ended(task_id);
+        wake_task(waiting_task_id);
     }
 }
 
@@ -67,20 +113,207 @@ void task_pool::response_received(std::string mac,
     std::unordered_map<int, std::shared_ptr<task>>::const_iterator got =
         scheduled_tasks.find(beerocks_header->id());
     if (got != scheduled_tasks.end()) {
+        m_response_tracker.response_received(
+            got->first, mac, beerocks_message::eActionOp_CONTROL(beerocks_header->action_op()));
         got->second->response_received(mac, beerocks_header);
+        wake_task(got->first);
+    }
+}
+
+bool task_pool::start_workers(size_t workers_num)
+{
+    if (!workers_num) {
+        LOG(DEBUG) << "no task workers, offloaded jobs run inline";
+        return true;
+    }
+
+    if (m_job_results_fd == -1 && (m_job_results_fd = eventfd(0, EFD_NONBLOCK)) < 0) {
+        LOG(ERROR) << "Failed creating eventfd: " << strerror(errno);
+        return false;
+    }
+    return m_worker_pool.start(workers_num, "task_worker");
+}
+
+bool task_pool::offload_job(int task_id, int event_type,
+                            const std::function<std::shared_ptr<void>()> &job)
+{
+    auto job_result        = std::make_shared<sJobResult>();
+    job_result->task_id    = task_id;
+    job_result->event_type = event_type;
+
+    auto worker_job = [this, job, job_result]() {
+        job_result->result = job();
+        m_job_results.push(job_result);
+
+        // Wake up the owner thread. Not checked, as the workers do not log: on failure the
+        // result is still delivered by the next run.
+        uint64_t counter = 1;
+        auto written     = write(m_job_results_fd, &counter, sizeof(counter));
+        (void)written;
+    };
+
+    if (m_worker_pool.enqueue(worker_job)) {
+        return true;
     }
+
+    job_result->result = job();
+    m_job_results.push(job_result);
+    return false;
 }
 
 void task_pool::run_tasks()
 {
-    for (auto it = scheduled_tasks.begin(); it != scheduled_tasks.end();) {
-        it->second->execute();
-        if (it->second->is_done()) {
-            pending_task_ended(it->first);
-            LOG(DEBUG) << "erasing task " << it->second->task_name << ", id " << it->first;
-            it = scheduled_tasks.erase(it);
-        } else {
-            ++it;
+    metrics::scoped_timer timer(m_run_time);
+
+    deliver_job_results();
+
+    auto now = std::chrono::steady_clock::now();
+
+    // Move the tasks with an expired deadline to the run queue
+    while (!m_timer_queue.empty() && m_timer_queue.top().first <= now) {
+        auto timer = m_timer_queue.top();
+        m_timer_queue.pop();
+
+        auto deadline = m_task_deadlines.find(timer.second);
+        if (deadline == m_task_deadlines.end() || deadline->second != timer.first) {
+            continue; // stale entry, the task was rescheduled
+        }
+        m_task_deadlines.erase(deadline);
+        m_ready_tasks.insert(timer.second);
+    }
+
+    // Deliver the expired responses timeouts, all the requests of a task in one batch
+    for (auto &expired : m_response_tracker.pop_expired(now)) {
+        auto it = scheduled_tasks.find(expired.first);
+        if (it == scheduled_tasks.end()) {
+            continue;
+        }
+        for (const auto &request : expired.second) {
+            LOG(DEBUG) << "task " << it->second->task_name << ", id " << it->first
+                       << " response timeout, agent " << request.first;
+        }
+        it->second->responses_timed_out(std::move(expired.second));
+        wake_task(it->first);
+    }
+
+    // Tasks woken up by other tasks during this run are executed in the same run,
+    // but each task is executed at most once per run
+    std::set<int> executed_tasks;
+    std::set<int> next_run_tasks;
+    while (!m_ready_tasks.empty()) {
+        std::set<int> run_queue;
+        run_queue.swap(m_ready_tasks);
+        for (auto id : run_queue) {
+            if (m_end_of_run_tasks.find(id) != m_end_of_run_tasks.end()) {
+                continue; // executed below
+            }
+            if (!executed_tasks.insert(id).second) {
+                next_run_tasks.insert(id);
+                continue;
+            }
+            execute_task(id);
+        }
+    }
+
+    // Tasks deferred to the end of the run, the tasks they wake up are executed on the next run
+    std::set<int> end_of_run_tasks;
+    end_of_run_tasks.swap(m_end_of_run_tasks);
+    for (auto id : end_of_run_tasks) {
+        next_run_tasks.erase(id);
+        execute_task(id);
+    }
+    m_ready_tasks.insert(next_run_tasks.begin(), next_run_tasks.end());
+
+    m_scheduled_tasks.set(scheduled_tasks.size());
+    m_pending_jobs.set(m_worker_pool.pending_jobs());
+}
+
+void task_pool::execute_at_end_of_run(int id)
+{
+    if (scheduled_tasks.find(id) == scheduled_tasks.end()) {
+        return;
+    }
+    m_end_of_run_tasks.insert(id);
+}
+
+void task_pool::wake_task(int id)
+{
+    m_task_deadlines.erase(id);
+    m_ready_tasks.insert(id);
+}
+
+void task_pool::execute_task(int id)
+{
+    auto it = scheduled_tasks.find(id);
+    if (it == scheduled_tasks.end()) {
+        return;
+    }
+
+    // Keep a reference, the task may be erased from the pool during its own execution
+    auto current_task = it->second;
+    {
+        auto &execute_time = m_task_execute_time.get(current_task->task_name, [&]() {
+            return metrics::labels_t{{"task", current_task->task_name}};
+        });
+        metrics::scoped_timer timer(execute_time);
+        current_task->execute();
+    }
+    if (current_task->is_done()) {
+        LOG(DEBUG) << "erasing task " << current_task->task_name << ", id " << id;
+        scheduled_tasks.erase(id);
+        m_task_deadlines.erase(id);
+        m_response_tracker.remove_task(id);
+        pending_task_ended(id);
+        return;
+    }
+
+    schedule_task(current_task);
+}
+
+void task_pool::schedule_task(const std::shared_ptr<task> &scheduled_task)
+{
+    int id = scheduled_task->id;
+
+    int pending_task_id = scheduled_task->get_pending_task_id();
+    if (pending_task_id != -1) {
+        m_task_waiters[pending_task_id].insert(id);
+    }
+
+    auto next_execution_time = scheduled_task->next_execution_time();
+    if (next_execution_time == std::chrono::steady_clock::time_point::max()) {
+        // Idle until woken up
+        m_task_deadlines.erase(id);
+        return;
+    }
+    if (next_execution_time <= std::chrono::steady_clock::now()) {
+        wake_task(id);
+        return;
+    }
+
+    auto deadline = m_task_deadlines.find(id);
+    if (deadline != m_task_deadlines.end() && deadline->second == next_execution_time) {
+        return; // already queued
+    }
+    m_task_deadlines[id] = next_execution_time;
+    m_timer_queue.push(std::make_pair(next_execution_time, id));
+}
+
+void task_pool::deliver_job_results()
+{
+    // Reset the counter, the queue is drained below
+    if (m_job_results_fd != -1) {
+        uint64_t counter;
+        if (read(m_job_results_fd, &counter, sizeof(counter)) < 0 && errno != EAGAIN) {
+            LOG(ERROR) << "Failed reading eventfd counter: " << strerror(errno);
+        }
+    }
+
+    std::shared_ptr<sJobResult> job_result;
+    while ((job_result = m_job_results.pop(false))) {
+        if (scheduled_tasks.find(job_result->task_id) == scheduled_tasks.end()) {
+            LOG(DEBUG) << "task " << job_result->task_id << " ended, dropping job result";
+            continue;
         }
+        push_event(job_result->task_id, job_result->event_type, job_result->result.get());
     }
 }
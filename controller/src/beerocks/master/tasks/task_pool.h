@@ -11,15 +11,32 @@
 
 #include "task.h"
 
+#include <bcl/beerocks_metrics.h>
+#include <bcl/beerocks_thread_safe_queue.h>
+#include <bcl/beerocks_worker_pool.h>
 #include <beerocks/tlvf/beerocks_message_action.h>
 
+#include <functional>
+#include <queue>
+#include <vector>
+
 namespace son {
 
+/**
+ * The task pool only executes tasks that are ready to make progress.
+ * A task is ready when it is new, when it is not waiting, when one of its deadlines
+ * expired (tracked in a timer queue), or when it was woken up by an event, a response,
+ * a kill request or the end of a task it is waiting for.
+ * The responses the tasks are waiting for are tracked centrally by the task pool, which
+ * delivers expired responses timeouts to the tasks in batches.
+ * CPU heavy computations can be offloaded by the tasks to a pool of worker threads,
+ * their results are delivered back to the tasks as events.
+ */
 class task_pool {
 
 public:
-    task_pool() {}
-    ~task_pool() {}
+    task_pool();
+    ~task_pool();
 
     bool add_task(std::shared_ptr<task> new_task);
     bool is_task_running(int id);
@@ -30,8 +47,93 @@ public:
     void pending_task_ended(int task_id);
     void run_tasks();
 
+    /**
+     * @brief Defer the execution of a task to the end of the current run.
+     *
+     * The task is executed once, after all the tasks that are ready in this run, so that
+     * it sees the events pushed to it by any of them.
+     *
+     * @param id Id of the task.
+     */
+    void execute_at_end_of_run(int id);
+
+    /**
+     * @brief Start the worker threads used by offload_job().
+     *
+     * @param workers_num Number of worker threads, 0 runs the offloaded jobs inline.
+     * @return true on success, false otherwise.
+     */
+    bool start_workers(size_t workers_num);
+
+    /**
+     * @brief File descriptor signaled when a worker finished a job.
+     *
+     * The owner thread polls it, so that the results are delivered by the next run_tasks()
+     * instead of waiting for the select timeout. The counter is reset by run_tasks().
+     *
+     * @return The eventfd, -1 if no workers were started.
+     */
+    int get_job_results_fd() const { return m_job_results_fd; }
+
+    /**
+     * @brief Run a job on a worker thread and deliver its result to a task as an event.
+     *
+     * The job runs outside of the master thread, so it must not access the database or the
+     * task. It may only use the snapshot of the data it captured by value.
+     * The result is delivered on the master thread as an event of type event_type, with the
+     * result pointer as the event object. If no worker can take the job it is executed inline.
+     *
+     * @param task_id Id of the task to deliver the result to.
+     * @param event_type Type of the event delivering the result.
+     * @param job Computation to run, returns the result.
+     * @return true if the job was queued to a worker, false if it was executed inline.
+     */
+    bool offload_job(int task_id, int event_type,
+                     const std::function<std::shared_ptr<void>()> &job);
+
 private:
+    typedef std::pair<std::chrono::steady_clock::time_point, int> sTimerEntry;
+
+    typedef struct {
+        int task_id;
+        int event_type;
+        std::shared_ptr<void> result;
+    } sJobResult;
+
+    void wake_task(int id);
+    void execute_task(int id);
+    void schedule_task(const std::shared_ptr<task> &scheduled_task);
+    void deliver_job_results();
+
     std::unordered_map<int, std::shared_ptr<task>> scheduled_tasks;
+
+    // Ids of the tasks to execute on the next run, ordered by creation
+    std::set<int> m_ready_tasks;
+
+    // Ids of the tasks to execute once the ready tasks of the current run were executed
+    std::set<int> m_end_of_run_tasks;
+
+    // Earliest deadline first timer queue, entries not matching m_task_deadlines are stale
+    std::priority_queue<sTimerEntry, std::vector<sTimerEntry>, std::greater<sTimerEntry>>
+        m_timer_queue;
+    std::unordered_map<int, std::chrono::steady_clock::time_point> m_task_deadlines;
+
+    // Pending task id -> ids of the tasks waiting for it to end
+    std::unordered_map<int, std::set<int>> m_task_waiters;
+
+    response_tracker m_response_tracker;
+
+    // Run time of the pool and execution time of the tasks, by task name
+    beerocks::metrics::histogram &m_run_time;
+    beerocks::metrics::histogram_map<std::string> m_task_execute_time;
+    beerocks::metrics::gauge &m_scheduled_tasks;
+    beerocks::metrics::gauge &m_pending_jobs;
+
+    // Results of offloaded jobs, filled by the worker threads.
+    // Declared before the worker pool so that the workers are stopped first.
+    beerocks::thread_safe_queue<std::shared_ptr<sJobResult>> m_job_results;
+    int m_job_results_fd = -1;
+    beerocks::worker_pool m_worker_pool;
 };
 
 } // namespace son
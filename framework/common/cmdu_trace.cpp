@@ -0,0 +1,410 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <mapf/common/cmdu_trace.h>
+#include <mapf/common/logger.h>
+
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iomanip>
+#include <map>
+#include <new>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace mapf {
+namespace cmdu_trace {
+
+static std::atomic<sHeader *> g_header{nullptr};
+static std::string g_shm_name;
+static int g_fd = -1;
+
+static thread_local uint32_t t_trace_id = 0;
+
+static sRecord *records(sHeader *header)
+{
+    return reinterpret_cast<sRecord *>(reinterpret_cast<uint8_t *>(header) + sizeof(sHeader));
+}
+
+static uint32_t thread_id()
+{
+    static thread_local uint32_t t_tid = syscall(SYS_gettid);
+    return t_tid;
+}
+
+bool open(const std::string &process_name, uint32_t num_records)
+{
+    close();
+
+    if (!num_records) {
+        MAPF_ERR("CMDU trace needs at least one record");
+        return false;
+    }
+
+    auto shm_name = std::string(SHM_PREFIX) + process_name;
+
+    // A segment left by a previous instance is replaced, readers keep their mapping of it
+    shm_unlink(shm_name.c_str());
+
+    // Owner only, the trace exposes the message flow and timing of the process
+    g_fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (g_fd < 0) {
+        MAPF_ERR("failed creating shared memory " << shm_name << ": " << strerror(errno));
+        return false;
+    }
+
+    size_t size = sizeof(sHeader) + num_records * sizeof(sRecord);
+    if (ftruncate(g_fd, size) < 0) {
+        MAPF_ERR("failed resizing shared memory " << shm_name << ": " << strerror(errno));
+        ::close(g_fd);
+        g_fd = -1;
+        shm_unlink(shm_name.c_str());
+        return false;
+    }
+
+    auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, g_fd, 0);
+    if (addr == MAP_FAILED) {
+        MAPF_ERR("failed mapping shared memory " << shm_name << ": " << strerror(errno));
+        ::close(g_fd);
+        g_fd = -1;
+        shm_unlink(shm_name.c_str());
+        return false;
+    }
+
+    // The records are zeroed by ftruncate(), sequence 0 marks a record never written
+    auto header         = new (addr) sHeader();
+    header->magic       = MAGIC;
+    header->version     = VERSION;
+    header->header_len  = sizeof(sHeader);
+    header->num_records = num_records;
+    header->pid         = getpid();
+    strncpy(header->process_name, process_name.c_str(), sizeof(header->process_name) - 1);
+    header->next_record.store(0, std::memory_order_relaxed);
+
+    g_shm_name = shm_name;
+    g_header.store(header, std::memory_order_release);
+
+    MAPF_INFO("CMDU trace of " << num_records << " records in " << shm_name);
+    return true;
+}
+
+void close()
+{
+    if (!g_header.exchange(nullptr)) {
+        return;
+    }
+
+    // The segment stays mapped, threads may still be recording into it
+    shm_unlink(g_shm_name.c_str());
+    ::close(g_fd);
+    g_fd = -1;
+}
+
+bool enabled() { return g_header.load(std::memory_order_relaxed) != nullptr; }
+
+uint64_t now_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void write_record(eHop hop, uint32_t trace_id, uint16_t message_type, uint16_t mid,
+                         uint8_t action, uint8_t action_op, uint64_t timestamp_us,
+                         uint32_t duration_us)
+{
+    auto header = g_header.load(std::memory_order_acquire);
+    if (!header) {
+        return;
+    }
+
+    auto index   = header->next_record.fetch_add(1, std::memory_order_relaxed);
+    auto &record = records(header)[index % header->num_records];
+
+    // Another thread is still writing this record after the ring wrapped around, drop ours
+    auto sequence = record.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) ||
+        !record.sequence.compare_exchange_strong(sequence, sequence + 1,
+                                                 std::memory_order_relaxed)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record.trace_id     = trace_id;
+    record.timestamp_us = timestamp_us;
+    record.duration_us  = duration_us;
+    record.tid          = thread_id();
+    record.message_type = message_type;
+    record.mid          = mid;
+    record.hop          = uint8_t(hop);
+    record.action       = action;
+    record.action_op    = action_op;
+
+    record.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void record(eHop hop, uint32_t trace_id, uint16_t message_type, uint16_t mid, uint8_t action,
+            uint8_t action_op)
+{
+    if (!enabled()) {
+        return;
+    }
+    write_record(hop, trace_id, message_type, mid, action, action_op, now_us(), 0);
+}
+
+uint32_t current_trace_id() { return t_trace_id; }
+
+handle_scope::handle_scope(uint32_t trace_id, uint16_t message_type, uint16_t mid,
+                           uint8_t action, uint8_t action_op)
+    : previous_trace_id_(t_trace_id), trace_id_(trace_id), start_us_(0),
+      message_type_(message_type), mid_(mid), action_(action), action_op_(action_op)
+{
+    t_trace_id = trace_id;
+    if (enabled()) {
+        start_us_ = now_us();
+    }
+}
+
+handle_scope::~handle_scope()
+{
+    t_trace_id = previous_trace_id_;
+    if (start_us_) {
+        write_record(eHop::HANDLE, trace_id_, message_type_, mid_, action_, action_op_, start_us_,
+                     now_us() - start_us_);
+    }
+}
+
+std::vector<std::string> list()
+{
+    std::vector<std::string> names;
+
+    auto dir = opendir("/dev/shm");
+    if (!dir) {
+        MAPF_ERR("failed listing /dev/shm: " << strerror(errno));
+        return names;
+    }
+
+    // Names of the segments without the leading '/'
+    auto prefix = std::string(SHM_PREFIX + 1);
+    while (auto entry = readdir(dir)) {
+        if (std::string(entry->d_name).compare(0, prefix.size(), prefix) == 0) {
+            names.push_back(std::string("/") + entry->d_name);
+        }
+    }
+    closedir(dir);
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool read(const std::string &shm_name, std::string &process_name, uint32_t &pid,
+          std::vector<sEvent> &events)
+{
+    events.clear();
+
+    int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        MAPF_ERR("failed opening shared memory " << shm_name << ": " << strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || size_t(st.st_size) < sizeof(sHeader)) {
+        MAPF_ERR("invalid shared memory " << shm_name);
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = st.st_size;
+    auto addr   = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        MAPF_ERR("failed mapping shared memory " << shm_name << ": " << strerror(errno));
+        return false;
+    }
+
+    auto header = static_cast<sHeader *>(addr);
+    if (header->magic != MAGIC || header->version != VERSION ||
+        header->header_len != sizeof(sHeader) ||
+        sizeof(sHeader) + size_t(header->num_records) * sizeof(sRecord) > size) {
+        MAPF_ERR("unsupported trace segment " << shm_name);
+        munmap(addr, size);
+        return false;
+    }
+
+    process_name.assign(header->process_name,
+                        strnlen(header->process_name, sizeof(header->process_name)));
+    pid = header->pid;
+
+    for (uint32_t i = 0; i < header->num_records; i++) {
+        auto &record  = records(header)[i];
+        auto sequence = record.sequence.load(std::memory_order_acquire);
+        if (!sequence || (sequence & 1)) {
+            continue;
+        }
+
+        sEvent event;
+        event.trace_id     = record.trace_id;
+        event.timestamp_us = record.timestamp_us;
+        event.duration_us  = record.duration_us;
+        event.tid          = record.tid;
+        event.message_type = record.message_type;
+        event.mid          = record.mid;
+        event.hop          = eHop(record.hop);
+        event.action       = record.action;
+        event.action_op    = record.action_op;
+
+        // Skip the record if it was overwritten while copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (record.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        events.push_back(event);
+    }
+    munmap(addr, size);
+
+    // A HANDLE record is written at the end of the handling, but is timestamped at its start
+    std::stable_sort(events.begin(), events.end(), [](const sEvent &a, const sEvent &b) {
+        return a.timestamp_us < b.timestamp_us;
+    });
+    return true;
+}
+
+static void write_json_string(std::ostream &os, const std::string &str)
+{
+    os << '"';
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (uint8_t(c) < 0x20) {
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+static std::string hex(uint32_t value, int width)
+{
+    std::stringstream ss;
+    ss << "0x" << std::hex << std::setw(width) << std::setfill('0') << value;
+    return ss.str();
+}
+
+size_t write_chrome_json(std::ostream &os)
+{
+    struct sFlowPoint {
+        uint64_t timestamp_us;
+        uint32_t pid;
+        uint32_t tid;
+    };
+    std::map<uint32_t, std::vector<sFlowPoint>> flows;
+
+    size_t count = 0;
+    bool first   = true;
+    auto next    = [&]() {
+        os << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    std::string process_name;
+    uint32_t pid;
+    std::vector<sEvent> events;
+    for (const auto &shm_name : list()) {
+        if (!read(shm_name, process_name, pid, events)) {
+            continue;
+        }
+
+        next();
+        os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"name\":";
+        write_json_string(os, process_name);
+        os << "}}";
+
+        for (const auto &event : events) {
+            // Vendor specific messages are named by their beerocks action
+            std::string name = std::string(hop_to_string(event.hop)) + ' ' +
+                               hex(event.message_type, 4);
+            if (event.action || event.action_op) {
+                name += ' ' + std::to_string(event.action) + ':' + std::to_string(event.action_op);
+            }
+
+            next();
+            os << "{\"name\":\"" << name << "\",\"cat\":\"cmdu\",\"ph\":\"X\",\"ts\":"
+               << event.timestamp_us << ",\"dur\":" << event.duration_us << ",\"pid\":" << pid
+               << ",\"tid\":" << event.tid << ",\"args\":{\"trace_id\":\""
+               << hex(event.trace_id, 8) << "\",\"message_type\":\""
+               << hex(event.message_type, 4) << "\",\"mid\":" << event.mid;
+            if (event.action || event.action_op) {
+                os << ",\"action\":" << int(event.action)
+                   << ",\"action_op\":" << int(event.action_op);
+            }
+            os << "}}";
+            count++;
+
+            if (event.trace_id) {
+                flows[event.trace_id].push_back({event.timestamp_us, pid, event.tid});
+            }
+        }
+    }
+
+    // Link the hops of each trace id, across the processes
+    for (auto &flow : flows) {
+        auto &points = flow.second;
+        if (points.size() < 2) {
+            continue;
+        }
+        std::stable_sort(points.begin(), points.end(),
+                         [](const sFlowPoint &a, const sFlowPoint &b) {
+                             return a.timestamp_us < b.timestamp_us;
+                         });
+
+        for (size_t i = 0; i < points.size(); i++) {
+            const char *phase = (i == 0) ? "s" : (i == points.size() - 1) ? "f" : "t";
+            next();
+            os << "{\"name\":\"trace\",\"cat\":\"cmdu\",\"ph\":\"" << phase
+               << "\",\"bp\":\"e\",\"id\":" << flow.first << ",\"ts\":" << points[i].timestamp_us
+               << ",\"pid\":" << points[i].pid << ",\"tid\":" << points[i].tid << "}";
+        }
+    }
+
+    os << "\n]}\n";
+    return count;
+}
+
+const char *hop_to_string(eHop hop)
+{
+    switch (hop) {
+    case eHop::NET_RX:
+        return "NET_RX";
+    case eHop::NET_TX:
+        return "NET_TX";
+    case eHop::BUS_RX:
+        return "BUS_RX";
+    case eHop::BUS_TX:
+        return "BUS_TX";
+    case eHop::UDS_RX:
+        return "UDS_RX";
+    case eHop::UDS_TX:
+        return "UDS_TX";
+    case eHop::HANDLE:
+        return "HANDLE";
+    }
+    return "UNKNOWN";
+}
+
+} // namespace cmdu_trace
+} // namespace mapf
@@ -0,0 +1,195 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef __MAPF_COMMON_CMDU_TRACE_H__
+#define __MAPF_COMMON_CMDU_TRACE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mapf {
+
+/**
+ * @brief End-to-end tracing of the CMDUs through the prplMesh processes.
+ *
+ * Each process records the hops of the CMDUs it handles (received from the network, the local
+ * bus or a UDS socket, handled, sent) into a ring buffer in the /prplmesh_trace.<process>
+ * shared memory segment. Timestamps are taken from CLOCK_MONOTONIC, which is shared by all
+ * the processes of the device, so the segments are merged into a single timeline by
+ * write_chrome_json(), including those of processes which crashed.
+ *
+ * A trace id links the hops of a message, and of the messages sent while handling it:
+ * IEEE 1905.1 CMDUs entering a process from the local bus get the id of their message type and
+ * MID, the handler of a message runs in a scope with its trace id, and the messages sent from
+ * that scope carry it (in the UDS header) or record it (on the local bus).
+ *
+ * Tracing is disabled until open() is called. A disabled record() costs a single relaxed load.
+ */
+namespace cmdu_trace {
+
+enum class eHop : uint8_t {
+    NET_RX = 0, // Transport: received from the network
+    NET_TX,     // Transport: sent to the network
+    BUS_RX,     // Received from the local bus
+    BUS_TX,     // Published on the local bus
+    UDS_RX,     // Received on a UDS socket
+    UDS_TX,     // Sent on a UDS socket
+    HANDLE,     // Handled, with the handling duration
+};
+
+constexpr char SHM_PREFIX[] = "/prplmesh_trace.";
+constexpr uint32_t MAGIC    = 0x54524345; // "TRCE"
+constexpr uint16_t VERSION  = 1;
+
+// Shared memory layout: the header followed by num_records records
+struct sHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_len;
+    uint32_t num_records;
+    uint32_t pid;
+    char process_name[32];
+    std::atomic<uint64_t> next_record; // Index of the next record, modulo num_records
+};
+
+struct sRecord {
+    std::atomic<uint32_t> sequence; // Odd while the record is written, 0 if never written
+    uint32_t trace_id;
+    uint64_t timestamp_us; // CLOCK_MONOTONIC
+    uint32_t duration_us;  // HANDLE only
+    uint32_t tid;
+    uint16_t message_type;
+    uint16_t mid;
+    uint8_t hop;
+    uint8_t action; // Beerocks vendor specific messages only
+    uint8_t action_op;
+    uint8_t reserved;
+};
+
+// Copy of a record, read from a segment
+struct sEvent {
+    uint32_t trace_id;
+    uint64_t timestamp_us;
+    uint32_t duration_us;
+    uint32_t tid;
+    uint16_t message_type;
+    uint16_t mid;
+    eHop hop;
+    uint8_t action;
+    uint8_t action_op;
+};
+
+/**
+ * @brief Start tracing into the segment of the process, replacing a segment left by a previous
+ * instance of the process.
+ *
+ * @param process_name Name of the process, unique on the device.
+ * @param num_records Size of the ring buffer.
+ * @return true on success, false otherwise.
+ */
+bool open(const std::string &process_name, uint32_t num_records);
+
+/**
+ * @brief Stop tracing and remove the segment of the process.
+ */
+void close();
+
+bool enabled();
+
+/**
+ * @brief Current CLOCK_MONOTONIC time in microseconds.
+ */
+uint64_t now_us();
+
+/**
+ * @brief Trace id of an IEEE 1905.1 CMDU.
+ */
+inline uint32_t trace_id(uint16_t message_type, uint16_t mid)
+{
+    return (uint32_t(message_type) << 16) | mid;
+}
+
+/**
+ * @brief Record a hop of a CMDU, if tracing is enabled.
+ *
+ * @param hop Hop of the CMDU.
+ * @param trace_id Trace id of the CMDU, 0 if it has none.
+ * @param message_type CMDU message type.
+ * @param mid CMDU message id.
+ * @param action Beerocks action of a vendor specific message.
+ * @param action_op Beerocks action op of a vendor specific message.
+ */
+void record(eHop hop, uint32_t trace_id, uint16_t message_type, uint16_t mid, uint8_t action = 0,
+            uint8_t action_op = 0);
+
+/**
+ * @brief Trace id of the message handled by the calling thread, 0 outside of a handle_scope.
+ */
+uint32_t current_trace_id();
+
+/**
+ * @brief Scope of the handling of a CMDU.
+ *
+ * Sets the trace id of the calling thread for the messages sent while handling the CMDU, and
+ * records the HANDLE hop with the handling duration when destroyed.
+ */
+class handle_scope {
+public:
+    handle_scope(uint32_t trace_id, uint16_t message_type, uint16_t mid, uint8_t action = 0,
+                 uint8_t action_op = 0);
+    ~handle_scope();
+
+private:
+    uint32_t previous_trace_id_;
+    uint32_t trace_id_;
+    uint64_t start_us_;
+    uint16_t message_type_;
+    uint16_t mid_;
+    uint8_t action_;
+    uint8_t action_op_;
+};
+
+/**
+ * @brief Names of the trace segments of the device.
+ */
+std::vector<std::string> list();
+
+/**
+ * @brief Read the records of a trace segment, which may be written meanwhile.
+ *
+ * Records overwritten during the read are skipped.
+ *
+ * @param shm_name Name of the segment.
+ * @param[out] process_name Name of the process of the segment.
+ * @param[out] pid Process id of the process of the segment.
+ * @param[out] events Records of the segment, oldest first.
+ * @return true on success, false if the segment can not be read.
+ */
+bool read(const std::string &shm_name, std::string &process_name, uint32_t &pid,
+          std::vector<sEvent> &events);
+
+/**
+ * @brief Write the records of all the trace segments of the device in the Chrome trace event
+ * JSON format, which is loaded by Perfetto and chrome://tracing.
+ *
+ * Each process is a track, each record a slice and each trace id a flow linking its hops.
+ *
+ * @param os Output stream.
+ * @return Number of events written.
+ */
+size_t write_chrome_json(std::ostream &os);
+
+const char *hop_to_string(eHop hop);
+
+} // namespace cmdu_trace
+} // namespace mapf
+
+#endif // __MAPF_COMMON_CMDU_TRACE_H__
@@ -0,0 +1,125 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2016-2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include <mapf/common/cmdu_trace.h>
+#include <mapf/common/logger.h>
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+using namespace mapf;
+
+static bool check(int &errors, bool check, std::string message)
+{
+    if (check) {
+        MAPF_INFO(" OK  ") << message;
+    } else {
+        MAPF_ERR("FAIL ") << message;
+        errors++;
+    }
+    return check;
+}
+
+static bool read_trace(std::vector<cmdu_trace::sEvent> &events)
+{
+    std::string process_name;
+    uint32_t pid = 0;
+    return cmdu_trace::read(std::string(cmdu_trace::SHM_PREFIX) + "cmdu_trace_test", process_name,
+                            pid, events) &&
+           process_name == "cmdu_trace_test" && pid == uint32_t(getpid());
+}
+
+int main()
+{
+    mapf::Logger::Instance().LoggerInit("cmdu_trace_test");
+    int errors = 0;
+
+    MAPF_INFO("Start cmdu_trace test");
+
+    // Disabled: nothing is recorded, the handled trace id is still set
+    cmdu_trace::record(cmdu_trace::eHop::BUS_RX, 1, 0x8000, 1);
+    {
+        cmdu_trace::handle_scope scope(cmdu_trace::trace_id(0x8000, 1), 0x8000, 1);
+        check(errors, cmdu_trace::current_trace_id() == 0x80000001,
+              "trace id should be set while handling");
+    }
+    check(errors, cmdu_trace::current_trace_id() == 0, "trace id should be restored");
+
+    const uint32_t num_records = 8;
+    if (!check(errors, cmdu_trace::open("cmdu_trace_test", num_records), "open trace")) {
+        return errors;
+    }
+
+    // A message received from the bus, handled while sending a vendor specific message
+    auto trace_id = cmdu_trace::trace_id(0x8014, 42);
+    cmdu_trace::record(cmdu_trace::eHop::BUS_RX, trace_id, 0x8014, 42);
+    {
+        cmdu_trace::handle_scope scope(trace_id, 0x8014, 42);
+        cmdu_trace::record(cmdu_trace::eHop::UDS_TX, cmdu_trace::current_trace_id(), 0x0004, 0, 3,
+                           25);
+    }
+
+    std::vector<cmdu_trace::sEvent> events;
+    check(errors, read_trace(events), "read trace");
+    if (check(errors, events.size() == 3, "3 records expected")) {
+        auto &bus_rx = events[0];
+        auto handle  = std::find_if(events.begin(), events.end(), [](const cmdu_trace::sEvent &e) {
+            return e.hop == cmdu_trace::eHop::HANDLE;
+        });
+        auto uds_tx  = std::find_if(events.begin(), events.end(), [](const cmdu_trace::sEvent &e) {
+            return e.hop == cmdu_trace::eHop::UDS_TX;
+        });
+        check(errors, bus_rx.hop == cmdu_trace::eHop::BUS_RX, "BUS_RX first");
+        if (check(errors, handle != events.end() && uds_tx != events.end(),
+                  "HANDLE and UDS_TX recorded")) {
+            check(errors,
+                  handle->timestamp_us <= uds_tx->timestamp_us &&
+                      handle->timestamp_us + handle->duration_us >= uds_tx->timestamp_us,
+                  "UDS_TX should be within the handling");
+            check(errors, uds_tx->action == 3 && uds_tx->action_op == 25,
+                  "action and action op should be recorded");
+        }
+        check(errors,
+              std::all_of(events.begin(), events.end(),
+                          [&](const cmdu_trace::sEvent &e) { return e.trace_id == trace_id; }),
+              "all the records should have the trace id of the handled message");
+    }
+
+    // The ring buffer keeps the last records, also when written concurrently
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t]() {
+            for (uint16_t i = 0; i < 1000; i++) {
+                cmdu_trace::record(cmdu_trace::eHop::UDS_RX, t, 0x0004, i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    check(errors, read_trace(events), "read trace after wrap around");
+    check(errors, !events.empty() && events.size() <= num_records,
+          "only the last records should be kept");
+    check(errors, std::all_of(events.begin(), events.end(),
+                              [](const cmdu_trace::sEvent &e) {
+                                  return e.hop == cmdu_trace::eHop::UDS_RX;
+                              }),
+          "older records should be overwritten");
+
+    std::stringstream json;
+    auto count = cmdu_trace::write_chrome_json(json);
+    check(errors, count >= events.size(), "trace events should be written");
+    check(errors, json.str().find("\"cmdu_trace_test\"") != std::string::npos,
+          "the process should be named");
+
+    cmdu_trace::close();
+    check(errors, !read_trace(events), "segment should be removed on close");
+
+    return errors;
+}
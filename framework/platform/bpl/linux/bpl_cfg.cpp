@@ -8,6 +8,7 @@
 
 #include "../common/utils/utils.h"
 #include "../common/utils/utils_net.h"
+#include "bpl_cfg_store.h"
 #include "mapf/common/logger.h"
 #include <bpl/bpl_cfg.h>
 
@@ -29,40 +30,9 @@ namespace bpl {
 
 int cfg_get_param(const std::string &param, std::string &value)
 {
-    std::ifstream in_conf_file;
-    std::string line;
-    in_conf_file.open(PLATFORM_DB_PATH_TEMP);
-    if (!in_conf_file.is_open()) {
-        in_conf_file.open(PLATFORM_DB_PATH);
-        if (!in_conf_file.is_open()) {
-            MAPF_ERR("Failed oppening file " << PLATFORM_DB_PATH);
-            return RETURN_ERR;
-        }
-    }
+    static cfg_store store(PLATFORM_DB_PATH, PLATFORM_DB_PATH_TEMP);
 
-    while (std::getline(in_conf_file, line)) {
-        utils::trim(line);
-        if (line.empty())
-            continue; // Empty line
-        if (line.at(0) == '#')
-            continue; // Commented line
-        if (line.compare(0, param.size(), param) != 0)
-            continue; // Not the param we look for
-
-        std::string line_arg = line.substr(param.size(), line.size());
-        auto pos             = line_arg.find("#");
-        if (pos != std::string::npos) {
-            line_arg.erase(pos, line_arg.size());
-            utils::rtrim(line_arg);
-        }
-        if (line_arg.size() >= 1) {
-            value.assign(line_arg);
-            return RETURN_OK;
-        }
-        break;
-    }
-
-    return RETURN_ERR;
+    return store.get(param, value) ? RETURN_OK : RETURN_ERR;
 }
 
 int cfg_get_param_int(const std::string &param, int &value)
@@ -0,0 +1,192 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "bpl_cfg_store.h"
+#include "../common/utils/utils.h"
+#include "mapf/common/logger.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+using namespace mapf;
+
+namespace beerocks {
+namespace bpl {
+
+cfg_store::cfg_store(const std::string &db_path, const std::string &temp_db_path)
+    : m_db_path(db_path), m_temp_db_path(temp_db_path)
+{
+    m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify_fd < 0) {
+        MAPF_WARN("inotify_init1 failed: " << strerror(errno) << ", the DB will not be cached");
+        return;
+    }
+
+    if (!watch(m_temp_db_path) || !watch(m_db_path)) {
+        close(m_inotify_fd);
+        m_inotify_fd = -1;
+    }
+}
+
+cfg_store::~cfg_store()
+{
+    if (m_inotify_fd >= 0) {
+        close(m_inotify_fd);
+    }
+}
+
+bool cfg_store::watch(const std::string &path)
+{
+    // Watch the directory, the file may not exist yet or be replaced by a rename
+    auto pos         = path.rfind('/');
+    std::string dir  = (pos == std::string::npos) ? "." : path.substr(0, pos);
+    std::string name = (pos == std::string::npos) ? path : path.substr(pos + 1);
+
+    uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+    if (inotify_add_watch(m_inotify_fd, dir.c_str(), mask) < 0) {
+        MAPF_WARN("Failed watching " << dir << ": " << strerror(errno)
+                                     << ", the DB will not be cached");
+        return false;
+    }
+
+    m_watched_names.push_back(name);
+    return true;
+}
+
+bool cfg_store::changed()
+{
+    // Not watched, always reload
+    if (m_inotify_fd < 0) {
+        return true;
+    }
+
+    bool changed = false;
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t len;
+    while ((len = read(m_inotify_fd, buf, sizeof(buf))) > 0) {
+        for (char *ptr = buf; ptr < buf + len;) {
+            auto event = reinterpret_cast<struct inotify_event *>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                changed = true;
+            } else if (event->len > 0 &&
+                       std::find(m_watched_names.begin(), m_watched_names.end(), event->name) !=
+                           m_watched_names.end()) {
+                changed = true;
+            }
+        }
+    }
+
+    return changed;
+}
+
+bool cfg_store::load()
+{
+    m_params.clear();
+
+    if (load_file(m_temp_db_path.c_str()) || load_file(m_db_path.c_str())) {
+        return true;
+    }
+
+    MAPF_ERR("Failed oppening file " << m_db_path);
+    return false;
+}
+
+bool cfg_store::load_file(const char *path)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    // The file is small, read it at once and parse the copy: the file may be truncated in place
+    // by the next update while it is parsed
+    std::string content;
+    char buf[4096];
+    ssize_t len;
+    while ((len = read(fd, buf, sizeof(buf))) != 0) {
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            MAPF_ERR("Failed reading file " << path << ": " << strerror(errno));
+            close(fd);
+            return false;
+        }
+        content.append(buf, len);
+    }
+    close(fd);
+
+    const char *data = content.data();
+    const char *end = data + content.size();
+    for (const char *pos = data; pos < end;) {
+        auto eol = static_cast<const char *>(memchr(pos, '\n', end - pos));
+        if (!eol) {
+            eol = end;
+        }
+        std::string line(pos, eol);
+        pos = eol + 1;
+
+        utils::trim(line);
+        if (line.empty())
+            continue; // Empty line
+        if (line.at(0) == '#')
+            continue; // Commented line
+
+        auto sep = line.find('=');
+        if (sep == std::string::npos)
+            continue; // Not a parameter
+
+        std::string key = line.substr(0, sep);
+        std::string arg = line.substr(sep + 1);
+        auto comment    = arg.find('#');
+        if (comment != std::string::npos) {
+            arg.erase(comment);
+            utils::rtrim(arg);
+        }
+
+        // The first definition of a parameter applies
+        m_params.emplace(std::move(key), std::move(arg));
+    }
+
+    return true;
+}
+
+bool cfg_store::get(const std::string &key, std::string &value)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+
+    if (!m_loaded || changed()) {
+        m_loaded = load();
+        if (!m_loaded) {
+            return false;
+        }
+    }
+
+    // The getters pass the name with the '=' separator
+    std::string name(key);
+    if (!name.empty() && name.back() == '=') {
+        name.pop_back();
+    }
+
+    auto it = m_params.find(name);
+    if (it == m_params.end() || it->second.empty()) {
+        return false;
+    }
+
+    value.assign(it->second);
+    return true;
+}
+
+} // namespace bpl
+} // namespace beerocks
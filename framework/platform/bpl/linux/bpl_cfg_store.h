@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#ifndef _BPL_CFG_STORE_H_
+#define _BPL_CFG_STORE_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace beerocks {
+namespace bpl {
+
+/**
+ * Parsed platform DB, shared by all the cfg_* getters.
+ *
+ * The file is parsed once into a hash index, and parsed again only when inotify reports a
+ * change of the platform DB or of its temporary copy, which takes precedence. Lookups then
+ * only poll the (non-blocking) inotify descriptor instead of scanning the file.
+ */
+class cfg_store {
+public:
+    /**
+     * @param db_path Path of the platform DB.
+     * @param temp_db_path Path of the temporary copy of the platform DB, which takes precedence.
+     */
+    cfg_store(const std::string &db_path, const std::string &temp_db_path);
+    ~cfg_store();
+
+    /**
+     * @brief Get the value of a parameter.
+     *
+     * @param key Parameter name, with or without the trailing '='.
+     * @param value Value of the parameter.
+     * @return true if the parameter was found with a non empty value, false otherwise.
+     */
+    bool get(const std::string &key, std::string &value);
+
+private:
+    bool load();
+    bool load_file(const char *path);
+    bool watch(const std::string &path);
+    bool changed();
+
+    const std::string m_db_path;
+    const std::string m_temp_db_path;
+
+    std::mutex m_mtx;
+    bool m_loaded    = false;
+    int m_inotify_fd = -1;
+    std::vector<std::string> m_watched_names;
+    std::unordered_map<std::string, std::string> m_params;
+};
+
+} // namespace bpl
+} // namespace beerocks
+
+#endif // _BPL_CFG_STORE_H_
@@ -0,0 +1,106 @@
+/* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * This code is subject to the terms of the BSD+Patent license.
+ * See LICENSE file for more details.
+ */
+
+#include "../linux/bpl_cfg_store.h"
+
+#include <mapf/common/logger.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace beerocks::bpl;
+
+static bool check(int &errors, bool check, const std::string &message)
+{
+    if (check) {
+        MAPF_INFO(" OK  ") << message;
+    } else {
+        MAPF_ERR("FAIL ") << message;
+        errors++;
+    }
+    return check;
+}
+
+static bool write_file(const std::string &path, const char *content)
+{
+    FILE *f = fopen(path.c_str(), "w");
+    if (!f) {
+        MAPF_ERR("Failed opening " << path);
+        return false;
+    }
+    fputs(content, f);
+    fclose(f);
+    return true;
+}
+
+static std::string get_value(cfg_store &store, const std::string &key)
+{
+    std::string value;
+    if (!store.get(key, value)) {
+        return "<not found>";
+    }
+    return value;
+}
+
+/**
+ * Check the cached platform DB, on a temporary file: the parameters are found with and without
+ * the trailing '=', the file is parsed again once it is updated in place, and the temporary copy
+ * takes precedence while it exists.
+ */
+static void test_cfg_store(int &errors, const std::string &db_path)
+{
+    const std::string temp_db_path = db_path + ".temp";
+    cfg_store store(db_path, temp_db_path);
+
+    write_file(db_path, "# bpl_cfg_store_test\n"
+                        "management_mode=Multi-AP-Controller # comment\n"
+                        "stop_on_failure_attempts=3\n"
+                        "empty=\n");
+    check(errors, get_value(store, "management_mode=") == "Multi-AP-Controller",
+          "parameter with the trailing '=', without the comment");
+    check(errors, get_value(store, "stop_on_failure_attempts") == "3",
+          "parameter without the trailing '='");
+    check(errors, get_value(store, "empty") == "<not found>", "empty parameter is not found");
+    check(errors, get_value(store, "missing") == "<not found>", "missing parameter");
+
+    write_file(db_path, "management_mode=Multi-AP-Agent\nstop_on_failure_attempts=5\n");
+    check(errors, get_value(store, "management_mode") == "Multi-AP-Agent",
+          "DB updated in place is parsed again");
+    check(errors, get_value(store, "stop_on_failure_attempts") == "5",
+          "DB updated in place is parsed again (2)");
+
+    write_file(temp_db_path, "management_mode=Not-Multi-AP\n");
+    check(errors, get_value(store, "management_mode") == "Not-Multi-AP",
+          "temporary DB takes precedence");
+
+    remove(temp_db_path.c_str());
+    check(errors, get_value(store, "management_mode") == "Multi-AP-Agent",
+          "DB is used again once the temporary DB is removed");
+}
+
+int main()
+{
+    mapf::Logger::Instance().LoggerInit("bpl_cfg_store_test");
+    int errors = 0;
+
+    MAPF_INFO("Start bpl_cfg_store test");
+
+    char db_path[] = "/tmp/bpl_cfg_store_test.XXXXXX";
+    int fd         = mkstemp(db_path);
+    if (fd < 0) {
+        MAPF_ERR("Failed creating a temporary file");
+        return 1;
+    }
+    close(fd);
+
+    test_cfg_store(errors, db_path);
+
+    remove(db_path);
+    return errors;
+}
@@ -188,9 +188,12 @@ int cfg_get_wifi_params(const char iface[BPL_IFNAME_LEN], struct BPL_WLAN_PARAMS
         return RETURN_ERR;
     }
 
+    // Both settings are read from the same wireless package
+    uci_session session;
+
     // The UCI "disabled" setting is optional, defaults to false if not present
     bool disabled = false;
-    cfg_uci_get_wireless_bool(TYPE_RADIO, iface, "disabled", &disabled);
+    cfg_uci_get_wireless_bool(session, TYPE_RADIO, iface, "disabled", &disabled);
     wlan_params->enabled = !disabled;
 
     // The UCI "channel" setting is not documented as optional, but for Intel
@@ -198,7 +201,7 @@ int cfg_get_wifi_params(const char iface[BPL_IFNAME_LEN], struct BPL_WLAN_PARAMS
     // fail when wifi still works fine, so default to "auto" (0) and if
     // can't get the channel from UCI just move on.
     wlan_params->channel = 0;
-    cfg_get_channel(iface, &wlan_params->channel);
+    cfg_get_channel(session, iface, &wlan_params->channel);
 
     return RETURN_OK;
 }
@@ -245,13 +248,14 @@ int cfg_get_beerocks_credentials(const int radio_dir, char ssid[BPL_SSID_LEN],
                                  char pass[BPL_PASS_LEN], char sec[BPL_SEC_LEN])
 {
     int retVal = 0;
+    uci_session session;
 
-    retVal |= cfg_get_prplmesh_param("ssid", ssid, BPL_SSID_LEN);
-    retVal |= cfg_get_prplmesh_param("mode_enabled", sec, BPL_SEC_LEN);
+    retVal |= cfg_get_prplmesh_param(session, "ssid", ssid, BPL_SSID_LEN);
+    retVal |= cfg_get_prplmesh_param(session, "mode_enabled", sec, BPL_SEC_LEN);
     if (!strcmp(sec, "WEP-64") || !strcmp(sec, "WEP-128")) {
-        retVal |= cfg_get_prplmesh_param("wep_key", pass, BPL_PASS_LEN);
+        retVal |= cfg_get_prplmesh_param(session, "wep_key", pass, BPL_PASS_LEN);
     } else {
-        retVal |= cfg_get_prplmesh_param("key_passphrase", pass, BPL_PASS_LEN);
+        retVal |= cfg_get_prplmesh_param(session, "key_passphrase", pass, BPL_PASS_LEN);
     }
 
     return retVal;
@@ -288,14 +292,16 @@ int cfg_get_sta_iface(const char iface[BPL_IFNAME_LEN], char sta_iface[BPL_IFNAM
         return RETURN_ERR;
     }
 
+    uci_session session;
+
     //TODO: remove dependency in wireless section naming in UCI #801
     int index = -1;
-    if (cfg_get_index_from_interface(iface, &index) == RETURN_ERR) {
+    if (cfg_get_index_from_interface(session, iface, &index) == RETURN_ERR) {
         MAPF_ERR("cfg_get_sta_iface: Failed to get radio index from iface");
         return RETURN_ERR;
     }
 
-    return cfg_get_prplmesh_radio_param(index, "sta_iface", sta_iface, BPL_IFNAME_LEN);
+    return cfg_get_prplmesh_radio_param(session, index, "sta_iface", sta_iface, BPL_IFNAME_LEN);
 }
 
 int cfg_get_hostap_iface(int32_t radio_num, char hostap_iface[BPL_IFNAME_LEN])
@@ -329,9 +335,14 @@ int cfg_get_all_prplmesh_wifi_interfaces(BPL_WLAN_IFACE *interfaces, int *num_of
         return RETURN_ERR;
     }
 
+    // The prplmesh package is loaded once for all the radios
+    uci_session session;
+
     int interfaces_count = 0;
     for (int index = 0; index < *num_of_interfaces; index++) {
-        if (cfg_get_hostap_iface(index, interfaces[interfaces_count].ifname) == RETURN_ERR) {
+        if (cfg_get_prplmesh_radio_param(session, index, "hostap_iface",
+                                         interfaces[interfaces_count].ifname,
+                                         BPL_IFNAME_LEN) == RETURN_ERR) {
             MAPF_DBG("cfg_get_all_prplmesh_wifi_interfaces: failed to get wifi interface for radio"
                      << index << " or radio" << interfaces_count << ".hostap_iface doesn't exist");
         } else {
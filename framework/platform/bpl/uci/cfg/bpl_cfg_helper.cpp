@@ -17,6 +17,13 @@ namespace beerocks {
 namespace bpl {
 
 int cfg_get_index_from_interface(const std::string &inputIfName, int *nIndex)
+{
+    uci_session session;
+    return cfg_get_index_from_interface(session, inputIfName, nIndex);
+}
+
+int cfg_get_index_from_interface(uci_session &session, const std::string &inputIfName,
+                                 int *nIndex)
 {
     char ifname[BPL_IFNAME_LEN] = {0};
     int rpcIndex                = -1;
@@ -28,7 +35,7 @@ int cfg_get_index_from_interface(const std::string &inputIfName, int *nIndex)
 
     const paramType ifType = (inputIfName.find('.') != std::string::npos) ? TYPE_VAP : TYPE_RADIO;
 
-    if (cfg_uci_get_wireless_idx(ifname, &rpcIndex) == RETURN_OK) {
+    if (cfg_uci_get_wireless_idx(session, ifname, &rpcIndex) == RETURN_OK) {
         *nIndex = UCI_RETURN_INDEX(ifType, rpcIndex);
     } else {
         return RETURN_ERR;
@@ -38,6 +45,13 @@ int cfg_get_index_from_interface(const std::string &inputIfName, int *nIndex)
 }
 
 int cfg_get_prplmesh_param(const std::string &param, char *buf, size_t buf_len)
+{
+    uci_session session;
+    return cfg_get_prplmesh_param(session, param, buf, buf_len);
+}
+
+int cfg_get_prplmesh_param(uci_session &session, const std::string &param, char *buf,
+                           size_t buf_len)
 {
     char path[MAX_UCI_BUF_LEN] = {0};
 
@@ -48,11 +62,18 @@ int cfg_get_prplmesh_param(const std::string &param, char *buf, size_t buf_len)
     if (snprintf_s(path, MAX_UCI_BUF_LEN, "prplmesh.config.%s", param.c_str()) <= 0)
         return RETURN_ERR;
 
-    return cfg_uci_get(path, buf, buf_len);
+    return session.get(path, buf, buf_len);
 }
 
 int cfg_get_prplmesh_radio_param(int radio_id, const std::string &radio_param, char *buf,
                                  size_t buf_len)
+{
+    uci_session session;
+    return cfg_get_prplmesh_radio_param(session, radio_id, radio_param, buf, buf_len);
+}
+
+int cfg_get_prplmesh_radio_param(uci_session &session, int radio_id,
+                                 const std::string &radio_param, char *buf, size_t buf_len)
 {
     char path[MAX_UCI_BUF_LEN] = {0};
 
@@ -65,7 +86,7 @@ int cfg_get_prplmesh_radio_param(int radio_id, const std::string &radio_param, c
         return RETURN_ERR;
     }
 
-    return cfg_uci_get(path, buf, buf_len);
+    return session.get(path, buf, buf_len);
 }
 
 static int cfg_get_prplmesh_param_int_raw(const std::string &param, int *buf)
@@ -111,6 +132,12 @@ int cfg_get_prplmesh_param_int_default(const std::string &param, int *buf, int d
 }
 
 int cfg_get_channel(const std::string &interface_name, int *channel)
+{
+    uci_session session;
+    return cfg_get_channel(session, interface_name, channel);
+}
+
+int cfg_get_channel(uci_session &session, const std::string &interface_name, int *channel)
 {
     if (!channel) {
         return RETURN_ERR;
@@ -120,7 +147,8 @@ int cfg_get_channel(const std::string &interface_name, int *channel)
     char ifname[BPL_IFNAME_LEN]       = {0};
 
     utils::copy_string(ifname, interface_name.c_str(), BPL_IFNAME_LEN);
-    if (cfg_uci_get_wireless_from_ifname(TYPE_RADIO, ifname, "channel", channel_num) != RETURN_OK) {
+    if (cfg_uci_get_wireless_from_ifname(session, TYPE_RADIO, ifname, "channel", channel_num) !=
+        RETURN_OK) {
         return RETURN_ERR;
     }
 
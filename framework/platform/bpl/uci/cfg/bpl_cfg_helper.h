@@ -16,6 +16,8 @@
 namespace beerocks {
 namespace bpl {
 
+class uci_session;
+
 /**
  * Returns the index of interface from DB
  *
@@ -25,6 +27,8 @@ namespace bpl {
  * @return 0 on success or -1 on error.
  **/
 int cfg_get_index_from_interface(const std::string &inputIfName, int *nIndex);
+int cfg_get_index_from_interface(uci_session &session, const std::string &inputIfName,
+                                 int *nIndex);
 
 /**
  * Returns the value of requested param from DB
@@ -36,6 +40,8 @@ int cfg_get_index_from_interface(const std::string &inputIfName, int *nIndex);
  * @return 0 on success or -1 on error.
  **/
 int cfg_get_prplmesh_param(const std::string &param, char *buf, size_t buf_len);
+int cfg_get_prplmesh_param(uci_session &session, const std::string &param, char *buf,
+                           size_t buf_len);
 
 /**
  * Returns the value of requested param from DB for the specified radio
@@ -49,6 +55,8 @@ int cfg_get_prplmesh_param(const std::string &param, char *buf, size_t buf_len);
  **/
 int cfg_get_prplmesh_radio_param(int radio_id, const std::string &radio_param, char *buf,
                                  size_t buf_len);
+int cfg_get_prplmesh_radio_param(uci_session &session, int radio_id,
+                                 const std::string &radio_param, char *buf, size_t buf_len);
 
 /**
  * Returns the value of requested integer type param from DB
@@ -80,6 +88,7 @@ int cfg_get_prplmesh_param_int_default(const std::string &param, int *buf, int d
  * @return 0 on success or -1 on error.
  **/
 int cfg_get_channel(const std::string &interface_name, int *channel);
+int cfg_get_channel(uci_session &session, const std::string &interface_name, int *channel);
 
 /** API currently not implemented **/
 int cfg_get_wep_key(const std::string &interface_name, int keyIndex, char *key);
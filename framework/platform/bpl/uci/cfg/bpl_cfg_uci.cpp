@@ -49,33 +49,159 @@ static int dummy_to_radio_index(int index)
 namespace beerocks {
 namespace bpl {
 
-int cfg_uci_get(char *path, char *value, size_t length)
+uci_session::uci_session()
+{
+    m_ctx = uci_alloc_context();
+    if (!m_ctx) {
+        ERROR("%s, uci alloc context failed!\n", __FUNCTION__);
+    }
+}
+
+uci_session::~uci_session()
+{
+    if (!m_modified_packages.empty()) {
+        WARN("%s, discarding uncommitted changes\n", __FUNCTION__);
+    }
+
+    // Frees the loaded packages as well
+    if (m_ctx) {
+        uci_free_context(m_ctx);
+    }
+}
+
+struct uci_package *uci_session::get_package(const std::string &name)
 {
+    if (!m_ctx) {
+        return nullptr;
+    }
+
+    // The lookup only loads the package if it is not loaded in the context yet
     struct uci_ptr ptr;
-    struct uci_context *cont = uci_alloc_context();
+    std::string lookup_str(name);
+    if (uci_lookup_ptr(m_ctx, &ptr, &lookup_str[0], true) != UCI_OK || !ptr.p) {
+        ERROR("%s, uci lookup of %s failed!\n", __FUNCTION__, name.c_str());
+        return nullptr;
+    }
+
+    return ptr.p;
+}
 
-    if (!cont)
+int uci_session::get(const std::string &path, char *value, size_t length)
+{
+    if (!m_ctx) {
         return RETURN_ERR;
+    }
 
-    if (uci_lookup_ptr(cont, &ptr, path, true) != UCI_OK || !ptr.o) {
-        uci_free_context(cont);
+    struct uci_ptr ptr;
+    std::string lookup_str(path);
+    if (uci_lookup_ptr(m_ctx, &ptr, &lookup_str[0], true) != UCI_OK || !ptr.o ||
+        ptr.o->type != UCI_TYPE_STRING) {
         return RETURN_ERR;
     }
 
     strncpy_s(value, length, ptr.o->v.string, length - 1);
 
-    uci_free_context(cont);
+    return RETURN_OK;
+}
+
+struct uci_section *uci_session::get_wifi_iface(const char *interface_name)
+{
+    struct uci_package *p = get_package("wireless");
+    if (!p) {
+        return nullptr;
+    }
+
+    struct uci_element *e = nullptr;
+    struct uci_element *n = nullptr;
+    // Iterate over all wireless sections in the UCI DB
+    uci_foreach_element(&p->sections, e)
+    {
+        struct uci_section *s = uci_to_section(e);
+
+        if (strncmp(s->type, "wifi-iface", MAX_UCI_BUF_LEN))
+            continue;
+
+        // Iterate over all the options in the section
+        uci_foreach_element(&s->options, n)
+        {
+            struct uci_option *o = uci_to_option(n);
+
+            if (o->type != UCI_TYPE_STRING)
+                continue;
+
+            if (strncmp(n->name, "ifname", MAX_UCI_BUF_LEN))
+                continue;
+
+            if (strncmp(interface_name, o->v.string, MAX_UCI_BUF_LEN))
+                continue;
+
+            // We reached the section containing the requested ifname
+            return s;
+        }
+    }
+
+    return nullptr;
+}
+
+int uci_session::set(const std::string &package, const std::string &section,
+                     const std::string &option, const std::string &value)
+{
+    struct uci_package *p = get_package(package);
+    if (!p) {
+        return RETURN_ERR;
+    }
+
+    struct uci_ptr ptr = {};
+    ptr.p              = p;
+    ptr.s              = uci_lookup_section(m_ctx, p, section.c_str());
+    if (!ptr.s) {
+        ERROR("%s, section %s.%s not found\n", __FUNCTION__, package.c_str(), section.c_str());
+        return RETURN_ERR;
+    }
+    ptr.package = package.c_str();
+    ptr.section = section.c_str();
+    ptr.option  = option.c_str();
+    ptr.value   = value.c_str();
+
+    if (uci_set(m_ctx, &ptr) != UCI_OK) {
+        ERROR("%s, uci set of %s.%s.%s failed!\n", __FUNCTION__, package.c_str(),
+              section.c_str(), option.c_str());
+        return RETURN_ERR;
+    }
 
+    m_modified_packages.insert(package);
     return RETURN_OK;
 }
 
-int cfg_uci_get_wireless_int(enum paramType type, const char *interface_name, const char param[],
-                             int *value)
+int uci_session::commit()
+{
+    int ret = RETURN_OK;
+
+    for (const auto &package : m_modified_packages) {
+        struct uci_package *p = get_package(package);
+        if (!p || uci_commit(m_ctx, &p, false) != UCI_OK) {
+            ERROR("%s, uci commit of %s failed!\n", __FUNCTION__, package.c_str());
+            ret = RETURN_ERR;
+        }
+    }
+    m_modified_packages.clear();
+
+    return ret;
+}
+
+int cfg_uci_get(char *path, char *value, size_t length)
+{
+    uci_session session;
+    return session.get(path, value, length);
+}
+
+static int cfg_uci_get_wireless_int(uci_session &session, enum paramType type,
+                                    const char *interface_name, const char param[], int *value)
 {
     int status;
     char val[MAX_UCI_BUF_LEN] = "";
 
-    status = cfg_uci_get_wireless_from_ifname(type, interface_name, param, val);
+    status = cfg_uci_get_wireless_from_ifname(session, type, interface_name, param, val);
     if (status == RETURN_ERR)
         return RETURN_ERR;
 
@@ -166,73 +292,19 @@ int cfg_uci_get_wireless(enum paramType type, int index, const char param[], cha
     return status;
 }
 
-int cfg_uci_get_wireless_from_ifname(enum paramType type, const char *interface_name,
-                                     const char param[], char *value)
+int cfg_uci_get_wireless_from_ifname(uci_session &session, enum paramType type,
+                                     const char *interface_name, const char param[],
+                                     char *value)
 {
-    struct uci_context *ctx = uci_alloc_context();
-    if (!ctx) {
-        ERROR("%s, uci alloc context failed!\n", __FUNCTION__);
-        return RETURN_ERR;
-    }
-
-    char lookup_str[MAX_UCI_BUF_LEN] = "wireless";
-    struct uci_ptr ptr;
-    if ((uci_lookup_ptr(ctx, &ptr, lookup_str, true) != UCI_OK)) {
-        ERROR("%s, uci lookup failed!\n", __FUNCTION__);
-        uci_free_context(ctx);
-        return RETURN_ERR;
-    }
-
-    if (!ptr.p) {
-        ERROR("%s, returned pointer is null\n", __FUNCTION__);
-        uci_free_context(ctx);
-        return RETURN_ERR;
-    }
-
-    bool is_section_found = false;
-    struct uci_package *p = ptr.p;
-    struct uci_element *e = nullptr;
-    struct uci_element *n = nullptr;
-    struct uci_section *s = nullptr;
-    // Iterate over all wireless sections in the UCI DB
-    uci_foreach_element(&p->sections, e)
-    {
-        s = uci_to_section(e);
-
-        if (strncmp(s->type, "wifi-iface", MAX_UCI_BUF_LEN))
-            continue;
-
-        // Iterate over all the options in the section
-        uci_foreach_element(&s->options, n)
-        {
-            struct uci_option *o = uci_to_option(n);
-
-            if (o->type != UCI_TYPE_STRING)
-                continue;
-
-            if (strncmp(n->name, "ifname", MAX_UCI_BUF_LEN))
-                continue;
-
-            if (strncmp(interface_name, o->v.string, MAX_UCI_BUF_LEN))
-                continue;
-
-            // We reached the section containing the requested ifname
-            is_section_found = true;
-            break;
-        }
-
-        if (is_section_found) {
-            break;
-        }
-    }
+    struct uci_section *s = session.get_wifi_iface(interface_name);
 
     //if interface not found in wireless
-    if (!is_section_found) {
+    if (!s) {
         ERROR("%s, interface(%s) not found", __FUNCTION__, interface_name);
-        uci_free_context(ctx);
         return RETURN_ERR;
     }
 
+    struct uci_element *n = nullptr;
     if (type == TYPE_RADIO) {
         // create path to the param in the device: wireless.<device>.param
         bool device_option_exist = false;
@@ -249,7 +321,6 @@ int cfg_uci_get_wireless_from_ifname(enum paramType type, const char *interface_
                 break;
             }
         }
-        uci_free_context(ctx);
 
         if (!device_option_exist) {
             // radio not found
@@ -257,11 +328,9 @@ int cfg_uci_get_wireless_from_ifname(enum paramType type, const char *interface_
             return RETURN_ERR;
         }
 
-        char path[MAX_UCI_BUF_LEN] = "";
-        utils::copy_string(path, path_str.c_str(), MAX_UCI_BUF_LEN);
-
-        if (cfg_uci_get(path, value, MAX_UCI_BUF_LEN) != RETURN_OK) {
-            ERROR("%s option N/A. path=%s\n", __func__, path);
+        // Served from the wireless package already loaded by the session
+        if (session.get(path_str, value, MAX_UCI_BUF_LEN) != RETURN_OK) {
+            ERROR("%s option N/A. path=%s\n", __func__, path_str.c_str());
         }
 
         return RETURN_OK;
@@ -275,7 +344,6 @@ int cfg_uci_get_wireless_from_ifname(enum paramType type, const char *interface_
             // if param is found in options
             if (strncmp(n->name, param, MAX_UCI_BUF_LEN) == 0 && o->type == UCI_TYPE_STRING) {
                 strncpy_s(value, MAX_UCI_BUF_LEN, o->v.string, MAX_UCI_BUF_LEN - 1);
-                uci_free_context(ctx);
                 return RETURN_OK;
             }
         }
@@ -283,169 +351,107 @@ int cfg_uci_get_wireless_from_ifname(enum paramType type, const char *interface_
         // param not found in option
         ERROR("%s, interface(%s) found but param(%s) isn't configured\n", __FUNCTION__,
               interface_name, param);
-        uci_free_context(ctx);
         return RETURN_ERR;
     }
 }
 
-int cfg_uci_get_wireless_radio_idx(const char *interfaceName, int *radio_index)
+int cfg_uci_get_wireless_from_ifname(enum paramType type, const char *interface_name,
+                                     const char param[], char *value)
 {
-    struct uci_ptr ptr;
-    struct uci_context *ctx;
-    struct uci_package *p = NULL;
-    struct uci_element *e;
-    struct uci_section *s;
-    char lookup_str[MAX_UCI_BUF_LEN] = "wireless";
-    char tmp_deviceName[MAX_UCI_BUF_LEN];
-    char tmp_ifaceName[MAX_UCI_BUF_LEN];
-
-    ctx = uci_alloc_context();
-    if (!ctx)
-        return RETURN_ERR;
+    uci_session session;
+    return cfg_uci_get_wireless_from_ifname(session, type, interface_name, param, value);
+}
+
+int cfg_uci_get_wireless_radio_idx(uci_session &session, const char *interfaceName,
+                                   int *radio_index)
+{
+    char tmp_deviceName[MAX_UCI_BUF_LEN] = "";
 
-    if ((uci_lookup_ptr(ctx, &ptr, lookup_str, true) != UCI_OK)) {
-        ERROR("%s, uci lookup failed!\n", __FUNCTION__);
-        uci_free_context(ctx);
+    *radio_index = -1;
+
+    struct uci_section *s = session.get_wifi_iface(interfaceName);
+    if (!s) {
         return RETURN_ERR;
     }
 
-    p = ptr.p;
-
-    uci_foreach_element(&p->sections, e)
+    struct uci_element *n;
+    uci_foreach_element(&s->options, n)
     {
-        struct uci_element *n;
-        int scanf_res;
-
-        s = uci_to_section(e);
+        struct uci_option *o = uci_to_option(n);
 
-        if (strncmp(s->type, "wifi-iface", MAX_UCI_BUF_LEN))
-            continue;
-
-        tmp_deviceName[0] = '\0';
-        tmp_ifaceName[0]  = '\0';
-        uci_foreach_element(&s->options, n)
-        {
-            struct uci_option *o = uci_to_option(n);
-
-            if (strncmp(n->name, "device", MAX_UCI_BUF_LEN) == 0 && o->type == UCI_TYPE_STRING) {
-                strncpy_s(tmp_deviceName, MAX_UCI_BUF_LEN, o->v.string, MAX_UCI_BUF_LEN - 1);
-                continue;
-            }
-
-            if (strncmp(n->name, "ifname", MAX_UCI_BUF_LEN) == 0 && o->type == UCI_TYPE_STRING) {
-                strncpy_s(tmp_ifaceName, MAX_UCI_BUF_LEN, o->v.string, MAX_UCI_BUF_LEN - 1);
-                continue;
-            }
-        }
-
-        if (tmp_deviceName[0] != '\0' && tmp_ifaceName[0] != '\0' &&
-            strncmp(interfaceName, tmp_ifaceName, MAX_UCI_BUF_LEN) == 0) {
-
-            uci_free_context(ctx);
-
-            scanf_res = sscanf_s(tmp_deviceName, "radio%d", radio_index);
-
-            if (scanf_res < 1 || *radio_index < 0 || *radio_index > MAX_NUM_OF_RADIOS) {
-                *radio_index = -1;
-                return RETURN_ERR;
-            }
-
-            return RETURN_OK;
+        if (strncmp(n->name, "device", MAX_UCI_BUF_LEN) == 0 && o->type == UCI_TYPE_STRING) {
+            strncpy_s(tmp_deviceName, MAX_UCI_BUF_LEN, o->v.string, MAX_UCI_BUF_LEN - 1);
+            break;
         }
     }
 
-    *radio_index = -1;
-    uci_free_context(ctx);
-    return RETURN_ERR;
-}
-
-int cfg_uci_get_wireless_idx(char *interfaceName, int *rpc_index)
-{
-    struct uci_ptr ptr;
-    struct uci_context *ctx;
-    struct uci_package *p = NULL;
-    struct uci_element *e;
-    struct uci_section *s;
-    char lookup_str[MAX_UCI_BUF_LEN] = "wireless";
-
-    ctx = uci_alloc_context();
-    if (!ctx)
+    if (tmp_deviceName[0] == '\0') {
         return RETURN_ERR;
+    }
 
-    if ((uci_lookup_ptr(ctx, &ptr, lookup_str, true) != UCI_OK)) {
-        ERROR("%s, uci lookup failed!\n", __FUNCTION__);
-        uci_free_context(ctx);
+    int scanf_res = sscanf_s(tmp_deviceName, "radio%d", radio_index);
+    if (scanf_res < 1 || *radio_index < 0 || *radio_index > MAX_NUM_OF_RADIOS) {
+        *radio_index = -1;
         return RETURN_ERR;
     }
 
-    p = ptr.p;
-
-    uci_foreach_element(&p->sections, e)
-    {
-        struct uci_element *n;
-        int scanf_res;
-
-        s = uci_to_section(e);
-
-        if (strncmp(s->type, "wifi-iface", MAX_UCI_BUF_LEN))
-            continue;
-
-        uci_foreach_element(&s->options, n)
-        {
-            struct uci_option *o = uci_to_option(n);
+    return RETURN_OK;
+}
 
-            if (strncmp(n->name, "ifname", MAX_UCI_BUF_LEN))
-                continue;
+int cfg_uci_get_wireless_radio_idx(const char *interfaceName, int *radio_index)
+{
+    uci_session session;
+    return cfg_uci_get_wireless_radio_idx(session, interfaceName, radio_index);
+}
 
-            if (o->type != UCI_TYPE_STRING)
-                continue;
+int cfg_uci_get_wireless_idx(uci_session &session, const char *interfaceName, int *rpc_index)
+{
+    *rpc_index = -1;
 
-            if (strncmp(interfaceName, o->v.string, MAX_UCI_BUF_LEN))
-                continue;
+    struct uci_section *s = session.get_wifi_iface(interfaceName);
+    if (!s) {
+        return RETURN_ERR;
+    }
 
-            scanf_res = sscanf_s(s->e.name, "default_radio%d", rpc_index);
+    int scanf_res = sscanf_s(s->e.name, "default_radio%d", rpc_index);
 
 #ifdef BEEROCKS_RDKB
-            if (scanf_res < 1 || *rpc_index < 0) {
-                *rpc_index = -1;
-                uci_free_context(ctx);
-                return RETURN_ERR;
-            }
+    if (scanf_res < 1 || *rpc_index < 0) {
+        *rpc_index = -1;
+        return RETURN_ERR;
+    }
 
-            /* if it is dummy we want the radio index, not the dummy one */
-            if (uci_converter_is_dummy(*rpc_index)) {
-                *rpc_index = dummy_to_radio_index(*rpc_index);
-                if (*rpc_index == RETURN_ERR) {
-                    uci_free_context(ctx);
-                    return RETURN_ERR;
-                }
-            }
+    /* if it is dummy we want the radio index, not the dummy one */
+    if (uci_converter_is_dummy(*rpc_index)) {
+        *rpc_index = dummy_to_radio_index(*rpc_index);
+        if (*rpc_index == RETURN_ERR) {
+            return RETURN_ERR;
+        }
+    }
 #else
-            if (scanf_res < 1 || *rpc_index < 0 ||
-                *rpc_index > DUMMY_VAP_OFFSET + MAX_NUM_OF_RADIOS) {
-                *rpc_index = -1;
-                uci_free_context(ctx);
-                return RETURN_ERR;
-            }
+    if (scanf_res < 1 || *rpc_index < 0 || *rpc_index > DUMMY_VAP_OFFSET + MAX_NUM_OF_RADIOS) {
+        *rpc_index = -1;
+        return RETURN_ERR;
+    }
 
-            *rpc_index =
-                (*rpc_index >= DUMMY_VAP_OFFSET) ? (*rpc_index - DUMMY_VAP_OFFSET) : *rpc_index;
+    *rpc_index = (*rpc_index >= DUMMY_VAP_OFFSET) ? (*rpc_index - DUMMY_VAP_OFFSET) : *rpc_index;
 #endif
-            uci_free_context(ctx);
-            return RETURN_OK;
-        }
-    }
-    *rpc_index = -1;
-    uci_free_context(ctx);
-    return RETURN_ERR;
+
+    return RETURN_OK;
 }
 
-int cfg_uci_get_wireless_bool(enum paramType type, const char *interface_name, const char param[],
-                              bool *value)
+int cfg_uci_get_wireless_idx(char *interfaceName, int *rpc_index)
+{
+    uci_session session;
+    return cfg_uci_get_wireless_idx(session, interfaceName, rpc_index);
+}
+
+int cfg_uci_get_wireless_bool(uci_session &session, enum paramType type,
+                              const char *interface_name, const char param[], bool *value)
 {
     int res;
 
-    int status = cfg_uci_get_wireless_int(type, interface_name, param, &res);
+    int status = cfg_uci_get_wireless_int(session, type, interface_name, param, &res);
     if (status == RETURN_ERR)
         return RETURN_ERR;
 
@@ -454,5 +460,12 @@ int cfg_uci_get_wireless_bool(enum paramType type, const char *interface_name, c
     return RETURN_OK;
 }
 
+int cfg_uci_get_wireless_bool(enum paramType type, const char *interface_name, const char param[],
+                              bool *value)
+{
+    uci_session session;
+    return cfg_uci_get_wireless_bool(session, type, interface_name, param, value);
+}
+
 } // namespace bpl
 } // namespace beerocks
@@ -79,20 +79,98 @@ extern "C" {
 
 #endif
 
+#include <set>
+#include <string>
+
+struct uci_context;
+struct uci_package;
+struct uci_section;
+
 namespace beerocks {
 namespace bpl {
 
+/**
+ * UCI session, for a transaction made of several accesses to the UCI DB.
+ *
+ * Each package is loaded once, on its first access, and all the reads of the session are then
+ * served from the in-memory tree. Writes are applied to the tree, and only written back to the
+ * DB by commit(), all the modified packages at once. Uncommitted writes are discarded with the
+ * session.
+ */
+class uci_session {
+public:
+    uci_session();
+    ~uci_session();
+
+    uci_session(const uci_session &) = delete;
+    uci_session &operator=(const uci_session &) = delete;
+
+    /**
+     * @brief Get a package, loading it on first access.
+     *
+     * @param [in] name package name
+     * @return the package, nullptr on error.
+     */
+    struct uci_package *get_package(const std::string &name);
+
+    /**
+     * @brief Get the value of an option.
+     *
+     * @param [in] path option path (e.g. "prplmesh.config.enable")
+     * @param [out] value buffer to get the value of the option
+     * @param [in] length buffer length
+     * @return RETURN_OK on success, RETURN_ERR if the option does not exist.
+     */
+    int get(const std::string &path, char *value, size_t length);
+
+    /**
+     * @brief Get the wireless "wifi-iface" section of an interface.
+     *
+     * @param [in] interface_name interface name
+     * @return the section, nullptr if not found.
+     */
+    struct uci_section *get_wifi_iface(const char *interface_name);
+
+    /**
+     * @brief Set the value of an option of an existing section, until commit().
+     *
+     * @return RETURN_OK on success, RETURN_ERR otherwise.
+     */
+    int set(const std::string &package, const std::string &section, const std::string &option,
+            const std::string &value);
+
+    /**
+     * @brief Write back the modified packages to the DB.
+     *
+     * @return RETURN_OK on success, RETURN_ERR otherwise.
+     */
+    int commit();
+
+private:
+    struct uci_context *m_ctx = nullptr;
+    std::set<std::string> m_modified_packages;
+};
+
+// The functions without a session argument run in a session of their own
+int cfg_uci_get_wireless_idx(uci_session &session, const char *interfaceName, int *rpc_index);
 int cfg_uci_get_wireless_idx(char *interfaceName, int *rpc_index);
 int cfg_uci_get(char *path, char *value, size_t length);
 int cfg_uci_get_wireless(enum paramType type, int index, const char param[], char *value);
+int cfg_uci_get_wireless_bool(uci_session &session, enum paramType type,
+                              const char *interface_name, const char param[], bool *value);
 int cfg_uci_get_wireless_bool(enum paramType type, const char *interface_name, const char param[],
                               bool *value);
 
 int cfg_uci_get_radio_param_int(int index, const char param[], int *value);
 int cfg_uci_get_radio_param(int index, const char param[], char *value, size_t buf_len);
+int cfg_uci_get_wireless_radio_idx(uci_session &session, const char *interfaceName,
+                                   int *radio_index);
 int cfg_uci_get_wireless_radio_idx(const char *interfaceName, int *radio_index);
 int cfg_uci_get_radio_param_ulong(int index, const char param[], unsigned long *value);
 
+int cfg_uci_get_wireless_from_ifname(uci_session &session, enum paramType type,
+                                     const char *interface_name, const char param[],
+                                     char *value);
 int cfg_uci_get_wireless_from_ifname(enum paramType type, const char *interface_name,
                                      const char param[], char *value);
 
@@ -85,6 +85,10 @@ void Ieee1905Transport::handle_local_bus_cmdu_tx_message(CmduTxMessage &msg)
         }
     }
 
+    // keep the trace id of the message handled by the sender
+    packet.trace_id = msg.metadata()->trace_id;
+    trace_packet(cmdu_trace::eHop::BUS_RX, packet);
+
     counters_[CounterId::OUTGOING_LOCAL_BUS_PACKETS]++;
     handle_packet(packet);
 }
@@ -145,6 +149,9 @@ bool Ieee1905Transport::send_packet_to_local_bus(Packet &packet)
         msg.metadata()->relay    = 0;
     }
 
+    trace_packet(cmdu_trace::eHop::BUS_TX, packet);
+    msg.metadata()->trace_id = packet.trace_id;
+
     counters_[CounterId::INCOMMING_LOCAL_BUS_PACKETS]++;
 
     MAPF_DBG("publishing CmduRxMessage:" << std::endl << msg);
@@ -291,6 +291,8 @@ void Ieee1905Transport::handle_interface_pollin_event(int fd)
     packet.payload    = {.iov_base = buf + sizeof(struct ether_header),
                       .iov_len  = len - sizeof(struct ether_header)};
 
+    trace_packet(cmdu_trace::eHop::NET_RX, packet);
+
     counters_[CounterId::INCOMMING_NETWORK_PACKETS]++;
     handle_packet(packet);
 }
@@ -361,6 +363,8 @@ bool Ieee1905Transport::send_packet_to_network_interface(unsigned int if_index,
         return false;
     }
 
+    trace_packet(cmdu_trace::eHop::NET_TX, packet);
+
     return true;
 }
 
@@ -508,6 +508,24 @@ bool Ieee1905Transport::forward_packet(Packet &packet)
     return true;
 }
 
+// Record a hop of an IEEE1905 packet in the CMDU trace. A packet which is not part of a trace yet
+// gets the trace id of its messageType and messageId.
+void Ieee1905Transport::trace_packet(cmdu_trace::eHop hop, Packet &packet)
+{
+    if (!cmdu_trace::enabled() || packet.ether_type != ETH_P_1905_1 ||
+        packet.payload.iov_len < sizeof(Ieee1905CmduHeader)) {
+        return;
+    }
+
+    Ieee1905CmduHeader *ch = (Ieee1905CmduHeader *)packet.payload.iov_base;
+    uint16_t messageType   = ntohs(ch->messageType);
+    uint16_t messageId     = ntohs(ch->messageId);
+    if (!packet.trace_id) {
+        packet.trace_id = cmdu_trace::trace_id(messageType, messageId);
+    }
+    cmdu_trace::record(hop, packet.trace_id, messageType, messageId);
+}
+
 std::ostream &Ieee1905Transport::Packet::print(std::ostream &os) const
 {
     std::stringstream ss;
@@ -10,6 +10,7 @@
 #define MAP_TRANSPORT_IEEE1905_TRANSPORT_H_
 
 #include "ieee1905_transport_messages.h"
+#include <mapf/common/cmdu_trace.h>
 #include <mapf/common/poller.h>
 #include <mapf/local_bus.h>
 
@@ -134,6 +135,7 @@ private:
         uint16_t ether_type       = 0x0000;
         struct iovec header       = {.iov_base = NULL, .iov_len = 0};
         struct iovec payload      = {.iov_base = NULL, .iov_len = 0};
+        uint32_t trace_id         = 0; // CMDU trace id (see mapf/common/cmdu_trace.h)
 
         virtual std::ostream &print(std::ostream &os) const;
     };
@@ -265,6 +267,7 @@ private:
     bool de_fragment_packet(Packet &packet);
     bool fragment_and_send_packet_to_network_interface(unsigned int if_index, Packet &packet);
     bool forward_packet(Packet &packet);
+    void trace_packet(cmdu_trace::eHop hop, Packet &packet);
 };
 
 inline std::ostream &operator<<(std::ostream &os, const Ieee1905Transport::Packet &m)
@@ -54,6 +54,7 @@ public:
         uint32_t if_index = 0; // network interface index (set to 0 to let transport decide)
         uint16_t length =
             0; // payload length (including IEEE1905 header, excluding Ethernet header)
+        uint32_t trace_id = 0; // CMDU trace id, 0 if none (see mapf/common/cmdu_trace.h)
     };
 
     CmduXxMessage() : CmduXxMessage("", {}) {}
@@ -6,16 +6,46 @@
  * See LICENSE file for more details.
  */
 
+#include <mapf/common/cmdu_trace.h>
 #include <mapf/transport/ieee1905_transport.h>
 
+#include <cstdlib>
+#include <iostream>
 #include <net/if.h>
 #include <unistd.h>
 
 using namespace mapf;
 
+static void usage()
+{
+    std::cout << "usage: ieee1905_transport -[th]" << std::endl;
+    std::cout << "   t <records>  - trace the CMDUs into a ring buffer of <records> records"
+              << std::endl;
+    std::cout << "   h            - show this help menu" << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
     mapf::Logger::Instance().LoggerInit("transport");
+    uint32_t trace_records = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:h")) != EOF) {
+        switch (opt) {
+        case 't':
+            trace_records = std::strtoul(optarg, nullptr, 10);
+            break;
+        case 'h':
+        default:
+            usage();
+            return -1;
+        }
+    }
+
+    if (trace_records && !cmdu_trace::open("transport", trace_records)) {
+        MAPF_WARN("CMDU tracing is disabled");
+    }
+
     Ieee1905Transport ieee1905_transport;
 
     MAPF_INFO("starting main loop...");
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+# Copyright (c) 2016-2019 Intel Corporation
+#
+# This code is subject to the terms of the BSD+Patent license.
+# See LICENSE file for more details.
+
+"""Decode the binary logs written by LOG_BINARY() (see bcl/beerocks_log.h).
+
+The files are decoded in the given order, so pass the rolled over file first:
+    beerocks_blog_decoder.py beerocks_controller.blog.rollover beerocks_controller.blog
+"""
+
+import argparse
+import datetime
+import struct
+import sys
+
+MAGIC = b'BLOG'
+VERSION = 1
+SEVERITIES = ['TRACE', 'DEBUG', 'INFO', 'WARNING', 'ERROR', 'FATAL']
+ARG_FORMATS = {b'i': '=q', b'u': '=Q', b'd': '=d', b'b': '=B'}
+
+
+class Reader(object):
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def remaining(self):
+        return len(self.data) - self.pos
+
+    def read(self, fmt):
+        value = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += struct.calcsize(fmt)
+        return value[0]
+
+    def read_bytes(self, length):
+        value = self.data[self.pos:self.pos + length]
+        self.pos += length
+        return value
+
+    def read_string(self):
+        return self.read_bytes(self.read('=H')).decode('utf-8', 'replace')
+
+
+def decode_args(reader, count):
+    args = []
+    for _ in range(count):
+        if reader.remaining() < 1:
+            args.append('<truncated>')
+            continue
+        tag = reader.read_bytes(1)
+        try:
+            if tag == b's':
+                args.append(reader.read_string())
+            elif tag == b'b':
+                args.append('true' if reader.read('=B') else 'false')
+            else:
+                args.append(str(reader.read(ARG_FORMATS[tag])))
+        except (KeyError, struct.error):
+            args.append('<truncated>')
+    return args
+
+
+def format_message(fmt, args):
+    parts = fmt.split('{}')
+    message = parts[0]
+    for i, part in enumerate(parts[1:]):
+        message += (args[i] if i < len(args) else '{}') + part
+    return message
+
+
+def decode_file(path, formats, out):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data[:len(MAGIC)] != MAGIC or len(data) <= len(MAGIC):
+        sys.stderr.write('{}: not a binary log file\n'.format(path))
+        return False
+    if data[len(MAGIC)] != VERSION:
+        sys.stderr.write('{}: unsupported version {}\n'.format(path, data[len(MAGIC)]))
+        return False
+
+    pos = len(MAGIC) + 1
+    while pos + 2 <= len(data):
+        length = struct.unpack_from('=H', data, pos)[0]
+        if length < 3 or pos + length > len(data):
+            sys.stderr.write('{}: invalid record at offset {}\n'.format(path, pos))
+            return False
+        reader = Reader(data[pos + 2:pos + length])
+        pos += length
+
+        record_type = reader.read_bytes(1)
+        if record_type == b'F':
+            record_id = reader.read('=I')
+            severity = reader.read('=B')
+            line = reader.read('=I')
+            file_name = reader.read_string()
+            fmt = reader.read_string()
+            formats[record_id] = (severity, file_name.split('/')[-1], line, fmt)
+        elif record_type == b'E':
+            record_id = reader.read('=I')
+            timestamp = reader.read('=Q')
+            args = decode_args(reader, reader.read('=B'))
+            time_str = datetime.datetime.fromtimestamp(timestamp / 1e6).strftime('%H:%M:%S.%f')
+            if record_id not in formats:
+                out.write('? {} <unknown format {}> {}\n'.format(time_str, record_id, args))
+                continue
+            severity, file_name, line, fmt = formats[record_id]
+            out.write('{} {} {}[{}] --> {}\n'.format(
+                SEVERITIES[severity] if severity < len(SEVERITIES) else severity, time_str,
+                file_name, line, format_message(fmt, args)))
+        else:
+            sys.stderr.write('{}: unknown record type {}\n'.format(path, record_type))
+
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode prplMesh binary log files')
+    parser.add_argument('files', nargs='+', help='binary log files, oldest first')
+    args = parser.parse_args()
+
+    formats = {}
+    ok = True
+    for path in args.files:
+        ok = decode_file(path, formats, sys.stdout) and ok
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())